@@ -25,6 +25,7 @@
  *******************************************************************************/
 #include "include_inliner.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -88,6 +89,49 @@ void Bin2Hex(std::istream& source,
     }
 }
 
+std::string ContentHash(const std::string& content)
+{
+    // FNV-1a, 64 bit. Only used to detect changes of the generated files.
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for(const auto c : content)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+
+    std::ostringstream ss;
+    ss << "// addkernels content hash: " << std::hex << std::setw(16) << std::setfill('0')
+       << hash;
+    return ss.str();
+}
+
+/// Writes the generated source only when its content hash differs from the one
+/// recorded in the existing target. Untouched targets keep their timestamps,
+/// so the objects compiled from them are not rebuilt when kernels that went to
+/// other batches change, or when a kernel is touched without being modified. The build
+/// tracks the run itself with a separate stamp file.
+void WriteIfChanged(const std::string& path, const std::string& content)
+{
+    const auto hash = ContentHash(content);
+
+    {
+        std::ifstream existing(path, std::ios::in | std::ios::binary);
+        std::string existing_hash;
+        if(existing.good() && std::getline(existing, existing_hash) && existing_hash == hash)
+            return;
+    }
+
+    std::ofstream target(path, std::ios::out | std::ios::binary);
+    target << hash << std::endl << content;
+
+    if(!target.good())
+    {
+        std::cerr << "Failed to write: " << path << std::endl;
+        // NOLINTNEXTLINE (concurrency-mt-unsafe)
+        std::exit(1);
+    }
+}
+
 void PrintHelp()
 {
     std::cout << "Usage: addkernels {<option>}" << std::endl;
@@ -97,7 +141,9 @@ void PrintHelp()
     std::cout
         << "[REQUIRED] -s[ource] {<path to file>}: files to be processed. Must be last argument."
         << std::endl;
-    std::cout << "           -t[arget] <path>: target file. Default: std out." << std::endl;
+    std::cout << "           -t[arget] <path>: target file. Default: std out. The file is "
+                 "rewritten only if the content hash of the generated source changes."
+              << std::endl;
     std::cout << "           -l[ine-size] <number>: bytes in one line. Default: 16." << std::endl;
     std::cout << "           -b[uffer] <number>: read buffer size. Default: 512." << std::endl;
     std::cout << "           -g[uard] <string>: guard name. Default: no guard" << std::endl;
@@ -218,7 +264,8 @@ int main(int argsn, char** args)
     size_t bufferSize = 512;
     size_t lineSize   = 16;
 
-    std::ofstream targetFile;
+    std::string targetPath;
+    std::ostringstream targetBuffer;
     std::ostream* target = &std::cout;
     bool recurse         = true;
     bool as_extern       = false;
@@ -253,12 +300,15 @@ int main(int argsn, char** args)
                 *target << "#endif" << std::endl;
             }
 
+            if(!targetPath.empty())
+                WriteIfChanged(targetPath, targetBuffer.str());
+
             return 0;
         }
         else if(arg == "t" || arg == "target")
         {
-            targetFile.open(args[++i], std::ios::out);
-            target = &targetFile;
+            targetPath = args[++i];
+            target     = &targetBuffer;
         }
         else if(arg == "l" || arg == "line-size")
             lineSize = std::stol(args[++i]);
@@ -0,0 +1,363 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_BATCH_DRIVER_HPP
+#define GUARD_MIOPEN_BATCH_DRIVER_HPP
+
+#include "driver.hpp"
+#include "timer.hpp"
+
+#include <miopen/config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Batch mode replays a file of driver command lines, one per line, within a single process:
+//
+//   ./bin/MIOpenDriver --batch cmds.txt [--repeat N] [--warmup N] [--format csv|json]
+//                      [--output report_file]
+//
+// Lines logged with MIOPEN_ENABLE_LOGGING_CMD can be used as is, everything up to the driver name
+// is skipped. Empty lines and lines starting with '#' are ignored. All the drivers share one
+// handle, so the compiled kernels, the invokers and the loaded databases are reused between lines.
+//
+// A sample is the wall time of one RunForwardGPU() or RunBackwardGPU() call including the stream
+// synchronization, with the "iter" flag forced to 1. With the HIPNOGPU backend nothing reaches a
+// device, so the samples measure the host overhead only.
+
+struct BatchStats
+{
+    std::size_t runs = 0;
+    double min       = 0.0;
+    double mean      = 0.0;
+    double stddev    = 0.0;
+    double p50       = 0.0;
+    double p90       = 0.0;
+    double p99       = 0.0;
+};
+
+struct BatchResult
+{
+    std::string command;
+    std::string direction;
+    int rc = 0;
+    BatchStats stats;
+};
+
+struct BatchOptions
+{
+    std::string commands_file;
+    std::string output_file;
+    std::string format = "csv";
+    int repeat         = 10;
+    int warmup         = 1;
+};
+
+// Nearest-rank percentiles, the samples are in ms.
+inline BatchStats ComputeBatchStats(std::vector<double> samples)
+{
+    BatchStats stats;
+    if(samples.empty())
+        return stats;
+
+    std::sort(samples.begin(), samples.end());
+
+    const auto n          = samples.size();
+    const auto percentile = [&](double p) {
+        const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * n));
+        return samples[std::min(std::max<std::size_t>(rank, 1), n) - 1];
+    };
+
+    stats.runs = n;
+    stats.min  = samples.front();
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+
+    double sq_sum = 0.0;
+    for(const auto sample : samples)
+        sq_sum += (sample - stats.mean) * (sample - stats.mean);
+    stats.stddev = std::sqrt(sq_sum / n);
+
+    stats.p50 = percentile(50);
+    stats.p90 = percentile(90);
+    stats.p99 = percentile(99);
+    return stats;
+}
+
+// Splits a command line into {base_arg, flags...}. Returns nothing for lines to be skipped.
+inline std::vector<std::string> SplitBatchCommand(const std::string& line)
+{
+    std::vector<std::string> args;
+    std::istringstream ss(line);
+    std::string token;
+    while(ss >> token)
+        args.push_back(token);
+
+    if(args.empty() || args.front()[0] == '#')
+        return {};
+
+    const auto driver = std::find_if(args.begin(), args.end(), [](const std::string& arg) {
+        return miopen::EndsWith(arg, "MIOpenDriver");
+    });
+    if(driver != args.end())
+        args.erase(args.begin(), driver + 1);
+
+    return args;
+}
+
+inline void SyncDriverStream(Driver& drv)
+{
+#if MIOPEN_BACKEND_OPENCL
+    clFinish(drv.GetStream());
+#elif MIOPEN_BACKEND_HIP && !MIOPEN_MODE_NOGPU
+    hipStreamSynchronize(drv.GetStream());
+#else
+    std::ignore = drv;
+#endif
+}
+
+inline std::string QuoteCsv(const std::string& value)
+{
+    std::string quoted = "\"";
+    for(const auto c : value)
+    {
+        if(c == '"')
+            quoted += '"';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+inline std::string QuoteJson(const std::string& value)
+{
+    std::string quoted = "\"";
+    for(const auto c : value)
+    {
+        if(c == '"' || c == '\\')
+            quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+inline void WriteBatchCsv(std::ostream& os, const std::vector<BatchResult>& results)
+{
+    os << "command,direction,rc,runs,min_ms,mean_ms,stddev_ms,p50_ms,p90_ms,p99_ms" << std::endl;
+    for(const auto& r : results)
+    {
+        os << QuoteCsv(r.command) << ',' << r.direction << ',' << r.rc << ',' << r.stats.runs
+           << ',' << r.stats.min << ',' << r.stats.mean << ',' << r.stats.stddev << ','
+           << r.stats.p50 << ',' << r.stats.p90 << ',' << r.stats.p99 << std::endl;
+    }
+}
+
+inline void WriteBatchJson(std::ostream& os, const std::vector<BatchResult>& results)
+{
+    os << "[" << std::endl;
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        os << "  {\"command\": " << QuoteJson(r.command) << ", \"direction\": \"" << r.direction
+           << "\", \"rc\": " << r.rc << ", \"runs\": " << r.stats.runs
+           << ", \"min_ms\": " << r.stats.min << ", \"mean_ms\": " << r.stats.mean
+           << ", \"stddev_ms\": " << r.stats.stddev << ", \"p50_ms\": " << r.stats.p50
+           << ", \"p90_ms\": " << r.stats.p90 << ", \"p99_ms\": " << r.stats.p99 << "}"
+           << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    os << "]" << std::endl;
+}
+
+inline BatchOptions ParseBatchOptions(int argc, char* argv[])
+{
+    BatchOptions options;
+    if(argc < 3)
+    {
+        printf("FAILED: No commands file given for --batch\n");
+        Usage();
+    }
+    options.commands_file = argv[2];
+
+    for(int i = 3; i < argc; i += 2)
+    {
+        const std::string name = argv[i];
+        if(i + 1 >= argc)
+        {
+            printf("FAILED: No value for %s\n", name.c_str());
+            Usage();
+        }
+        const std::string value = argv[i + 1];
+
+        if(name == "--repeat")
+            options.repeat = std::max(std::atoi(value.c_str()), 1);
+        else if(name == "--warmup")
+            options.warmup = std::max(std::atoi(value.c_str()), 0);
+        else if(name == "--format" && (value == "csv" || value == "json"))
+            options.format = value;
+        else if(name == "--output")
+            options.output_file = value;
+        else
+        {
+            printf("FAILED: Invalid batch argument %s %s\n", name.c_str(), value.c_str());
+            Usage();
+        }
+    }
+    return options;
+}
+
+// Runs the requested directions of one command line and appends their results.
+inline int RunBatchCommand(Driver& drv,
+                            const std::vector<std::string>& args,
+                            const BatchOptions& options,
+                            std::vector<BatchResult>& results)
+{
+    const auto command = miopen::JoinStrings(args, " ");
+
+    std::vector<char*> argv;
+    std::string driver_name = "MIOpenDriver";
+    argv.push_back(&driver_name[0]);
+    auto args_copy = args;
+    for(auto& arg : args_copy)
+        argv.push_back(&arg[0]);
+
+    drv.AddCmdLineArgs();
+    int rc = drv.ParseCmdLineArgs(static_cast<int>(argv.size()), argv.data());
+    if(rc == 0)
+    {
+        // One sample is one call into the library
+        drv.GetInputFlags().SetValue("iter", "1");
+        drv.GetandSetData();
+        rc = drv.AllocateBuffersAndCopy();
+    }
+    if(rc != 0)
+    {
+        results.push_back({command, "none", rc, {}});
+        return rc;
+    }
+
+    const auto run = [&](const std::string& direction, const std::function<int()>& run_gpu) {
+        BatchResult result{command, direction, 0, {}};
+
+        for(int i = 0; i < options.warmup; ++i)
+        {
+            result.rc |= run_gpu();
+            SyncDriverStream(drv);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(options.repeat);
+        Timer t;
+        for(int i = 0; i < options.repeat; ++i)
+        {
+            t.start();
+            result.rc |= run_gpu();
+            SyncDriverStream(drv);
+            t.stop();
+            samples.push_back(t.gettime_ms());
+        }
+
+        result.stats = ComputeBatchStats(std::move(samples));
+        results.push_back(result);
+        rc |= result.rc;
+    };
+
+    if(RunsForwardGPU(args.front(), drv))
+        run("fwd", [&]() { return drv.RunForwardGPU(); });
+    if(RunsBackwardGPU(args.front(), drv))
+        run("bwd", [&]() { return drv.RunBackwardGPU(); });
+
+    return rc;
+}
+
+inline int RunBatch(int argc,
+                    char* argv[],
+                    const std::function<Driver*(const std::string&)>& make_driver)
+{
+    const auto options = ParseBatchOptions(argc, argv);
+
+    std::ifstream commands(options.commands_file);
+    if(!commands)
+    {
+        std::cout << "Cannot open the commands file: " << options.commands_file << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SharedDriverHandle() = CreateDriverHandle();
+
+    std::vector<BatchResult> results;
+    int cumulative_rc = 0;
+    std::string line;
+
+    while(std::getline(commands, line))
+    {
+        const auto args = SplitBatchCommand(line);
+        if(args.empty())
+            continue;
+
+        std::cout << "MIOpenDriver " << miopen::JoinStrings(args, " ") << std::endl;
+
+        const auto drv = std::unique_ptr<Driver>{make_driver(args.front())};
+        if(drv == nullptr)
+        {
+            std::cout << "Incorrect BaseArg: " << args.front() << std::endl;
+            results.push_back({miopen::JoinStrings(args, " "), "none", EXIT_FAILURE, {}});
+            cumulative_rc |= EXIT_FAILURE;
+            continue;
+        }
+
+        cumulative_rc |= RunBatchCommand(*drv, args, options, results);
+
+        // Drivers may enable profiling on the shared handle for their own timing
+        miopenEnableProfiling(SharedDriverHandle(), false);
+    }
+
+    std::ofstream output_file;
+    if(!options.output_file.empty())
+        output_file.open(options.output_file);
+    auto& os = options.output_file.empty() ? std::cout : output_file;
+
+    os << std::fixed << std::setprecision(4);
+    if(options.format == "json")
+        WriteBatchJson(os, results);
+    else
+        WriteBatchCsv(os, results);
+
+    miopenDestroy(SharedDriverHandle());
+    SharedDriverHandle() = nullptr;
+
+    return cumulative_rc;
+}
+
+#endif // GUARD_MIOPEN_BATCH_DRIVER_HPP
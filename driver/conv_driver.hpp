@@ -224,6 +224,7 @@ public:
     int ChkLayout_ShortName();
 
     int GetandSetData() override;
+    std::vector<miopenProblem_t> MakeProblems() override;
     std::vector<int> GetInputTensorLengthsFromCmdLine();
     std::vector<int> GetWeightTensorLengthsFromCmdLine();
     std::vector<int> GetBiasTensorLengthsFromCmdLine();
@@ -618,6 +619,30 @@ int ConvDriver<Tgpu, Tref>::ChkLayout_ShortName()
     }
 }
 
+template <typename Tgpu, typename Tref>
+std::vector<miopenProblem_t> ConvDriver<Tgpu, Tref>::MakeProblems()
+{
+    std::vector<miopenProblem_t> problems;
+
+    const auto add_problem = [&](miopenProblemDirection_t direction) {
+        miopenProblem_t problem;
+        miopenCreateConvProblem(&problem, convDesc, direction);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, inputTensor);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, weightTensor);
+        miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, outputTensor);
+        problems.push_back(problem);
+    };
+
+    if(is_fwd)
+        add_problem(miopenProblemDirectionForward);
+    if(is_bwd)
+        add_problem(miopenProblemDirectionBackward);
+    if(is_wrw)
+        add_problem(miopenProblemDirectionBackwardWeights);
+
+    return problems;
+}
+
 template <typename Tgpu, typename Tref>
 int ConvDriver<Tgpu, Tref>::GetandSetData()
 {
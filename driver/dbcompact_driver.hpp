@@ -0,0 +1,143 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DBCOMPACT_DRIVER_HPP
+#define GUARD_MIOPEN_DBCOMPACT_DRIVER_HPP
+
+#include "driver.hpp"
+
+#include <miopen/db_compaction.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Database compaction mode merges find or perf databases into one sorted database, as the system
+// databases are shipped, and drops the entries that went stale:
+//
+//   ./bin/MIOpenDriver --dbcompact merged.db gfx90a68.db ~/.config/miopen/gfx90a68_1.1.0.udb
+//
+// The first file is the output, the others are merged in order, so that later files override
+// the entries of earlier ones. Entries of solvers that are not registered anymore are dropped
+// unless "--keep-unknown 1" is given. With "--validate 1" the perf-db entries are also checked
+// against the performance configs their solvers accept on the current device, so the databases
+// of a device have to be validated on that device. Files ending with .db or .udb are SQLite perf
+// databases, the other files are text databases.
+
+struct DbCompactOptions
+{
+    std::string destination;
+    std::vector<std::string> sources;
+    miopen::DbKind kind = miopen::DbKind::Perf;
+    bool keep_unknown   = false;
+    bool validate       = false;
+};
+
+inline DbCompactOptions ParseDbCompactOptions(int argc, char* argv[])
+{
+    DbCompactOptions options;
+    if(argc < 4)
+    {
+        printf("FAILED: No output and input databases given for --dbcompact\n");
+        Usage();
+    }
+    options.destination = argv[2];
+
+    for(int i = 3; i < argc; ++i)
+    {
+        const std::string name = argv[i];
+        if(name.compare(0, 2, "--") != 0)
+        {
+            options.sources.push_back(name);
+            continue;
+        }
+
+        if(i + 1 >= argc)
+        {
+            printf("FAILED: No value for %s\n", name.c_str());
+            Usage();
+        }
+        const std::string value = argv[++i];
+
+        if(name == "--kind" && (value == "find" || value == "perf"))
+            options.kind = value == "find" ? miopen::DbKind::Find : miopen::DbKind::Perf;
+        else if(name == "--keep-unknown")
+            options.keep_unknown = std::atoi(value.c_str()) != 0;
+        else if(name == "--validate")
+            options.validate = std::atoi(value.c_str()) != 0;
+        else
+        {
+            printf("FAILED: Invalid dbcompact argument %s %s\n", name.c_str(), value.c_str());
+            Usage();
+        }
+    }
+
+    if(options.sources.empty())
+    {
+        printf("FAILED: No input databases given for --dbcompact\n");
+        Usage();
+    }
+    return options;
+}
+
+inline int RunDbCompact(int argc, char* argv[])
+{
+    const auto options = ParseDbCompactOptions(argc, argv);
+
+    miopen::DbCompactionOptions compaction;
+    compaction.kind                 = options.kind;
+    compaction.drop_unknown_solvers = !options.keep_unknown;
+
+    if(options.validate)
+    {
+        SharedDriverHandle() = CreateDriverHandle();
+        compaction.handle    = &miopen::deref(SharedDriverHandle());
+    }
+
+    int rc = 0;
+    try
+    {
+        const auto stats = miopen::CompactDbs(options.sources, options.destination, compaction);
+        std::cout << stats;
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cout << "Database compaction FAILED: " << ex.what() << std::endl;
+        rc = EXIT_FAILURE;
+    }
+
+    if(options.validate)
+    {
+        miopenDestroy(SharedDriverHandle());
+        SharedDriverHandle() = nullptr;
+    }
+    return rc;
+}
+
+#endif // GUARD_MIOPEN_DBCOMPACT_DRIVER_HPP
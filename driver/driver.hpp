@@ -40,6 +40,7 @@ using float16 = half_float::half;
 #include <memory>
 #include <miopen/miopen.h>
 #include <miopen/bfloat16.hpp>
+#include <miopen/stringutils.hpp>
 #include <numeric>
 #include <vector>
 
@@ -143,6 +144,16 @@ inline void PadBufferSize(size_t& sz, int datatype_sz)
            "pool[fp16], lrn[fp16], "
            "activ[fp16], softmax[fp16], bnorm[fp16], rnn[fp16], gemm, ctc, dropout[fp16], "
            "tensorop[fp16], reduce[fp16,fp64]\n");
+    printf("Batch mode: ./driver --batch *commands_file* [--repeat N] [--warmup N] "
+           "[--format csv|json] [--output *file*]\n");
+    printf("Warm start mode: ./driver --warmstart *manifest_file*\n");
+    printf("Database compaction mode: ./driver --dbcompact *output_db* *input_db*... "
+           "[--kind find|perf] [--keep-unknown 0|1] [--validate 0|1]\n");
+    printf("Perf database replay mode: ./driver --perfdb-replay *perf_db* [--neighbors N] "
+           "[--validate 0|1]\n");
+    printf("Tuning mode: ./driver --tuning enqueue|work|merge|status *queue_dir* "
+           "[*manifest_file*] [--slices N] [--worker *name*] [--lease seconds] "
+           "[--partial 0|1]\n");
     exit(0); // NOLINT (concurrency-mt-unsafe)
 }
 
@@ -162,7 +173,9 @@ inline std::string ParseBaseArg(int argc, char* argv[])
        arg != "softmax" && arg != "softmaxfp16" && arg != "bnorm" && arg != "bnormfp16" &&
        arg != "rnn" && arg != "rnnfp16" && arg != "gemm" /*&& arg != "gemmfp16"*/ && arg != "ctc" &&
        arg != "dropout" && arg != "dropoutfp16" && arg != "tensorop" && arg != "tensoropfp16" &&
-       arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "--version")
+       arg != "reduce" && arg != "reducefp16" && arg != "reducefp64" && arg != "--version" &&
+       arg != "--batch" && arg != "--warmstart" && arg != "--dbcompact" &&
+       arg != "--perfdb-replay" && arg != "--tuning")
     {
         printf("FAILED: Invalid Base Input Argument\n");
         Usage();
@@ -173,19 +186,43 @@ inline std::string ParseBaseArg(int argc, char* argv[])
         return arg;
 }
 
+inline miopenHandle_t CreateDriverHandle()
+{
+    miopenHandle_t handle;
+#if MIOPEN_BACKEND_OPENCL
+    miopenCreate(&handle);
+#elif MIOPEN_BACKEND_HIP
+    hipStream_t s;
+    hipStreamCreate(&s);
+    miopenCreateWithStream(&handle, s);
+#endif
+    return handle;
+}
+
+// When set, drivers use this handle instead of creating their own one, so that the kernel
+// caches and the databases loaded by the handle are reused between drivers (batch mode).
+inline miopenHandle_t& SharedDriverHandle()
+{
+    static miopenHandle_t handle = nullptr;
+    return handle;
+}
+
 class Driver
 {
 public:
     Driver()
     {
         data_type = miopenFloat;
-#if MIOPEN_BACKEND_OPENCL
-        miopenCreate(&handle);
-#elif MIOPEN_BACKEND_HIP
-        hipStream_t s;
-        hipStreamCreate(&s);
-        miopenCreateWithStream(&handle, s);
-#endif
+
+        if(SharedDriverHandle() != nullptr)
+        {
+            handle      = SharedDriverHandle();
+            owns_handle = false;
+        }
+        else
+        {
+            handle = CreateDriverHandle();
+        }
 
         miopenGetStream(handle, &q);
     }
@@ -198,7 +235,11 @@ public:
 #elif MIOPEN_BACKEND_HIP
     hipStream_t& GetStream() { return q; }
 #endif
-    virtual ~Driver() { miopenDestroy(handle); }
+    virtual ~Driver()
+    {
+        if(owns_handle)
+            miopenDestroy(handle);
+    }
 
     // TODO: add timing APIs
     virtual int AddCmdLineArgs()                         = 0;
@@ -211,10 +252,15 @@ public:
     virtual int RunBackwardGPU()                         = 0;
     virtual int VerifyBackward()                         = 0;
 
+    // Find 2.0 problems of the parsed command line, owned by the caller. Used by the warm start
+    // mode, drivers without problems return none.
+    virtual std::vector<miopenProblem_t> MakeProblems() { return {}; }
+
 protected:
     template <typename Tgpu>
     void InitDataType();
     miopenHandle_t handle;
+    bool owns_handle = true;
     miopenDataType_t data_type;
 
 #if MIOPEN_BACKEND_OPENCL
@@ -224,6 +270,24 @@ protected:
 #endif
 };
 
+// Directions requested by the "forw" flag of a parsed command line. CBAInfer has no such flag.
+inline int GetForwardArg(const std::string& base_arg, Driver& drv)
+{
+    return !miopen::StartsWith(base_arg, "CBAInfer") ? drv.GetInputFlags().GetValueInt("forw") : 1;
+}
+
+inline bool RunsForwardGPU(const std::string& base_arg, Driver& drv)
+{
+    const int fargval     = GetForwardArg(base_arg, drv);
+    const bool bnFwdInVer = (fargval == 2 && miopen::StartsWith(base_arg, "bnorm"));
+    return fargval & 1 || fargval == 0 || bnFwdInVer;
+}
+
+inline bool RunsBackwardGPU(const std::string& base_arg, Driver& drv)
+{
+    return GetForwardArg(base_arg, drv) != 1;
+}
+
 template <>
 inline void Driver::InitDataType<int8_t>()
 {
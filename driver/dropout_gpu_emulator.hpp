@@ -195,7 +195,7 @@ void RunDropoutForwardEmulator(miopenHandle_t handle,
                                const miopenDropoutDescriptor_t dropoutDesc,
                                const miopenTensorDescriptor_t noise_shape,
                                const miopenTensorDescriptor_t inputTensor,
-                               std::vector<Tgpu>& in,
+                               const std::vector<Tgpu>& in,
                                const miopenTensorDescriptor_t outputTensor,
                                std::vector<Tref>& out,
                                std::vector<unsigned char>& reservespace,
@@ -281,7 +281,7 @@ void RunDropoutForwardEmulator(miopenHandle_t handle,
 template <typename Tgpu, typename Tref = Tgpu>
 void RunDropoutBackwardEmulator(const miopenDropoutDescriptor_t dropoutDesc,
                                 const miopenTensorDescriptor_t outputTensor,
-                                std::vector<Tgpu>& dout,
+                                const std::vector<Tgpu>& dout,
                                 const miopenTensorDescriptor_t inputTensor,
                                 std::vector<Tref>& din,
                                 std::vector<unsigned char>& reservespace,
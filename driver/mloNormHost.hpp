@@ -29,6 +29,9 @@
 
 #include <cmath>
 #include <iomanip>
+#include <vector>
+
+#include <miopen/par_for.hpp>
 
 ////////////////////////////////////////////////////////////
 //
@@ -79,36 +82,39 @@ int mloLRNForwardRunHost(bool do_scale,
 
     if(norm_region == MLO_LRN_ACROSS_CHANNELS)
     {
-        for(int b = 0; b < n_batchs; b++)
-        {
+        miopen::par_for(n_batchs, miopen::min_grain{1}, [&](int b) {
             for(int j = 0; j < top_height; j++)
             {
-                for(int i = 0; i < top_width; i++)
+                // c-emulator
+                std::vector<Tcheck_> accum_scale(top_width, Tcheck_{0});
+                int head = 0;
+                while(head < pad)
                 {
-                    // c-emulator
-                    Tcheck_ accum_scale = Tcheck_{0};
-                    int head            = 0;
-                    Tcheck_ bot_val;
-                    while(head < pad)
+                    for(int i = 0; i < top_width; i++)
                     {
+                        Tcheck_ bot_val;
                         bot_val = (head < n_inputs)
                                       ? static_cast<Tcheck_>(
                                             bot_ptr[b * bot_batch_stride +
                                                     head * bot_channel_stride + j * bot_stride + i])
                                       : static_cast<Tcheck_>(0);
-                        accum_scale += bot_val * bot_val;
-                        ++head;
+                        accum_scale[i] += bot_val * bot_val;
                     }
-                    // until we reach size, nothing needs to be subtracted
-                    while(head < local_area)
+                    ++head;
+                }
+                // until we reach size, nothing needs to be subtracted
+                while(head < local_area)
+                {
+                    for(int i = 0; i < top_width; i++)
                     {
+                        Tcheck_ bot_val;
                         bot_val = (head < n_inputs)
                                       ? static_cast<Tcheck_>(
                                             bot_ptr[b * bot_batch_stride +
                                                     head * bot_channel_stride + j * bot_stride + i])
                                       : static_cast<Tcheck_>(0);
-                        accum_scale += bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
+                        accum_scale[i] += bot_val * bot_val;
+                        Tcheck_ scale = K + accum_scale[i] * alphaoverarea;
                         if((head - pad) >= 0 && (head - pad) < n_outputs && do_scale)
                         {
                             scale_v_ptr[b * scale_v_batch_stride +
@@ -128,23 +134,27 @@ int mloLRNForwardRunHost(bool do_scale,
                             top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
                                       j * top_v_stride + i] = c_val;
                         }
-                        ++head;
                     }
-                    // both add and subtract
-                    while(head < n_inputs)
+                    ++head;
+                }
+                // both add and subtract
+                while(head < n_inputs)
+                {
+                    for(int i = 0; i < top_width; i++)
                     {
+                        Tcheck_ bot_val;
                         bot_val = static_cast<Tcheck_>(
                             bot_ptr[b * bot_batch_stride + head * bot_channel_stride +
                                     j * bot_stride + i]);
-                        accum_scale += bot_val * bot_val;
+                        accum_scale[i] += bot_val * bot_val;
                         bot_val = ((head - local_area) >= 0)
                                       ? static_cast<Tcheck_>(
                                             bot_ptr[b * bot_batch_stride +
                                                     (head - local_area) * bot_channel_stride +
                                                     j * bot_stride + i])
                                       : static_cast<Tcheck_>(0);
-                        accum_scale -= bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
+                        accum_scale[i] -= bot_val * bot_val;
+                        Tcheck_ scale = K + accum_scale[i] * alphaoverarea;
                         if((head - pad) >= 0 && do_scale)
                         {
                             scale_v_ptr[b * scale_v_batch_stride +
@@ -164,19 +174,23 @@ int mloLRNForwardRunHost(bool do_scale,
                             top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
                                       j * top_v_stride + i] = c_val;
                         }
-                        ++head;
                     }
-                    // subtract only
-                    while(head < n_inputs + pad)
+                    ++head;
+                }
+                // subtract only
+                while(head < n_inputs + pad)
+                {
+                    for(int i = 0; i < top_width; i++)
                     {
+                        Tcheck_ bot_val;
                         bot_val = ((head - local_area) >= 0 && (head - local_area) < n_inputs)
                                       ? static_cast<Tcheck_>(
                                             bot_ptr[b * bot_batch_stride +
                                                     (head - local_area) * bot_channel_stride +
                                                     j * bot_stride + i])
                                       : static_cast<Tcheck_>(0);
-                        accum_scale -= bot_val * bot_val;
-                        Tcheck_ scale = K + accum_scale * alphaoverarea;
+                        accum_scale[i] -= bot_val * bot_val;
+                        Tcheck_ scale = K + accum_scale[i] * alphaoverarea;
                         if((head - pad) >= 0 && (head - pad) < n_outputs && do_scale)
                         {
                             scale_v_ptr[b * scale_v_batch_stride +
@@ -196,17 +210,15 @@ int mloLRNForwardRunHost(bool do_scale,
                             top_v_ptr[b * top_v_batch_stride + (head - pad) * top_v_channel_stride +
                                       j * top_v_stride + i] = c_val;
                         }
-                        ++head;
                     }
-
-                } // for (int i = 0; i < top_width; i++)
-            }     // for (int j = 0; j < top_height; j++)
-        }         // for (int b = 0; b < batch; b++)
+                    ++head;
+                }
+            } // for (int j = 0; j < top_height; j++)
+        });
     }
     else
     {
-        for(int b = 0; b < n_batchs; b++)
-        {
+        miopen::par_for(n_batchs, miopen::min_grain{1}, [&](int b) {
             for(int o = 0; o < n_outputs; o++)
             {
                 for(int j = 0; j < top_height; j++)
@@ -237,8 +249,8 @@ int mloLRNForwardRunHost(bool do_scale,
                             }
                         }
 
-                        alphaoverarea = alpha / adj_area_size;
-                        scale         = K + accum * alphaoverarea;
+                        Tcheck_ adj_alphaoverarea = alpha / adj_area_size;
+                        scale                     = K + accum * adj_alphaoverarea;
                         if(do_scale)
                         {
                             scale_v_ptr[b * scale_v_batch_stride + o * scale_v_channel_stride +
@@ -257,8 +269,8 @@ int mloLRNForwardRunHost(bool do_scale,
                     } // for (int i = 0; i < top_width; i++)
                 }     // for (int j = 0; j < top_height; j++)
             }         // for (int o = 0; o < outputs; o++)
-        }             // for (int b = 0; b < batch; b++)
-    }                 // (norm_region == ACROSS_CHANNELS)
+        });
+    } // (norm_region == ACROSS_CHANNELS)
 
     return (ret);
 }
@@ -316,19 +328,17 @@ int mloLRNBackwardRunHost(int norm_region,
         Tcheck_ ratio_dta_bwd =
             static_cast<Tcheck_>(2.) * alpha * beta / static_cast<Tcheck_>(local_area);
 
-        for(int b = 0; b < n_batchs; b++)
-        {
+        miopen::par_for(n_batchs, miopen::min_grain{1}, [&](int b) {
             for(int j = 0; j < bot_height; j++)
             {
-                for(int i = 0; i < bot_width; i++)
-                {
-
-                    // c-emulator
-                    int head            = 0;
-                    Tcheck_ accum_ratio = static_cast<Tcheck_>(0);
+                // c-emulator
+                int head = 0;
+                std::vector<Tcheck_> accum_ratio(bot_width, static_cast<Tcheck_>(0));
 
-                    // accumulate values
-                    while(head < pre_pad)
+                // accumulate values
+                while(head < pre_pad)
+                {
+                    for(int i = 0; i < bot_width; i++)
                     {
                         if(head < n_inputs)
                         {
@@ -343,16 +353,17 @@ int mloLRNBackwardRunHost(int norm_region,
                                     scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
                                               j * scale_stride + i]);
 
-                            accum_ratio += adder;
+                            accum_ratio[i] += adder;
                         }
-
-                        ++head;
                     }
+                    ++head;
+                }
 
-                    // until we reach size, nothing needs to be subtracted
-                    while(head < local_area)
+                // until we reach size, nothing needs to be subtracted
+                while(head < local_area)
+                {
+                    for(int i = 0; i < bot_width; i++)
                     {
-
                         if(head < n_inputs)
                         {
                             Tcheck_ adder =
@@ -366,7 +377,7 @@ int mloLRNBackwardRunHost(int norm_region,
                                     scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
                                               j * scale_stride + i]);
 
-                            accum_ratio += adder;
+                            accum_ratio[i] += adder;
                         }
 
                         if(head - pre_pad >= 0 && head - pre_pad < n_inputs)
@@ -388,15 +399,17 @@ int mloLRNBackwardRunHost(int norm_region,
                                         bot_ptr[b * bot_batch_stride +
                                                 (head - pre_pad) * bot_channel_stride +
                                                 j * bot_stride + i]) *
-                                    accum_ratio;
+                                    accum_ratio[i];
                         }
-                        ++head;
                     }
+                    ++head;
+                }
 
-                    // both add and subtract
-                    while(head < n_inputs)
+                // both add and subtract
+                while(head < n_inputs)
+                {
+                    for(int i = 0; i < bot_width; i++)
                     {
-
                         Tcheck_ adder =
                             static_cast<Tcheck_>(
                                 top_df_ptr[b * top_df_batch_stride + head * top_df_channel_stride +
@@ -408,7 +421,7 @@ int mloLRNBackwardRunHost(int norm_region,
                                 scale_ptr[b * scale_batch_stride + head * scale_channel_stride +
                                           j * scale_stride + i]);
 
-                        accum_ratio += adder;
+                        accum_ratio[i] += adder;
 
                         if(head - local_area >= 0)
                         {
@@ -426,7 +439,7 @@ int mloLRNBackwardRunHost(int norm_region,
                                               (head - local_area) * scale_channel_stride +
                                               j * scale_stride + i]);
 
-                            accum_ratio -= subs;
+                            accum_ratio[i] -= subs;
                         }
                         if(head - pre_pad >= 0)
                         {
@@ -447,13 +460,15 @@ int mloLRNBackwardRunHost(int norm_region,
                                         bot_ptr[b * bot_batch_stride +
                                                 (head - pre_pad) * bot_channel_stride +
                                                 j * bot_stride + i]) *
-                                    accum_ratio;
+                                    accum_ratio[i];
                         }
-
-                        ++head;
                     }
-                    // subtract only
-                    while(head < n_inputs + pre_pad)
+                    ++head;
+                }
+                // subtract only
+                while(head < n_inputs + pre_pad)
+                {
+                    for(int i = 0; i < bot_width; i++)
                     {
                         if(head - local_area >= 0 && head - local_area < n_inputs)
                         {
@@ -471,7 +486,7 @@ int mloLRNBackwardRunHost(int norm_region,
                                               (head - local_area) * scale_channel_stride +
                                               j * scale_stride + i]);
 
-                            accum_ratio -= subs;
+                            accum_ratio[i] -= subs;
                         }
                         if(head - pre_pad >= 0 && head - pre_pad < n_inputs)
                         {
@@ -492,20 +507,17 @@ int mloLRNBackwardRunHost(int norm_region,
                                         bot_ptr[b * bot_batch_stride +
                                                 (head - pre_pad) * bot_channel_stride +
                                                 j * bot_stride + i]) *
-                                    accum_ratio;
+                                    accum_ratio[i];
                         }
-
-                        ++head;
                     }
-
-                } // for (int i = 0; i < bot_width; i++)
-            }     // for (int j = 0; j < bot_height; j++)
-        }         // for (int b = 0; b < n_batchs; b++)
-    }             // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
+                    ++head;
+                }
+            } // for (int j = 0; j < bot_height; j++)
+        });
+    } // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
     else
     {
-        for(int b = 0; b < n_batchs; b++)
-        {
+        miopen::par_for(n_batchs, miopen::min_grain{1}, [&](int b) {
             for(int o = 0; o < n_inputs; o++)
             {
                 for(int j = 0; j < bot_height; j++)
@@ -563,7 +575,7 @@ int mloLRNBackwardRunHost(int norm_region,
                     }
                 }
             }
-        }
+        });
 
     } // if (norm_region == MLO_LRN_ACROSS_CHANNELS)
 
@@ -33,9 +33,13 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstring>
 #include <iomanip>
+#include <mutex>
+
+#include <miopen/par_for.hpp>
 
 #include "calcerr.hpp"
 
@@ -138,173 +142,193 @@ bool mloPoolingForwardRunHostAndVerify(int pooling_method,
     const int mask_c_stride           = mask_d_stride * top_depth;
     const int mask_n_stride           = mask_c_stride * n_outputs;
 
-    bool match = true;
+    std::atomic<bool> match{true};
+    std::mutex mutex;
     Tcheck_ MAX_VAL(3.402823466e+38);
     Tgpu_ G_MAX_VAL = (sizeof(Tgpu_) == 4 || sizeof(Tgpu_) == 8)
                           ? static_cast<Tgpu_>(3.402823466e+38)
                           : static_cast<Tgpu_>(65504);
-    // c-emulator
-    Tcheck_ res = static_cast<Tcheck_>(0);
 
-    for(int b = 0; b < n_batchs && match; b++)
-    {
-        for(int o = 0; o < n_outputs && match; o++)
+    // Checks one output point of image b, channel o.
+    const auto verify = [&](int b, int o, int k, int j, int i, pooling_math_stats& task_stats) {
+        // c-emulator
+        Tcheck_ res = static_cast<Tcheck_>(0);
+        if(pooling_method == MLO_POOLING_OP_MAX)
         {
-            for(int k = 0; k < top_depth && match; k++)
+            res = -MAX_VAL;
+        }
+        else if(pooling_method == MLO_POOLING_OP_AVE ||
+                pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+        {
+            res = static_cast<Tcheck_>(0);
+        }
+        int num_flops_per_res = 0;
+
+        int dstart = k * pool_stride_d - pad_d;
+        int hstart = j * pool_stride_h - pad_h;
+        int wstart = i * pool_stride_w - pad_w;
+        int dend   = std::min(dstart + filter_size_d, bot_depth);
+        int hend   = std::min(hstart + filter_size_h, bot_height);
+        int wend   = std::min(wstart + filter_size_w, bot_width);
+        dstart     = std::max(dstart, 0);
+        hstart     = std::max(hstart, 0);
+        wstart     = std::max(wstart, 0);
+
+        int pool_size;
+        if(pooling_method == MLO_POOLING_OP_AVE)
+            pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+        else
+            pool_size = filter_size_w * filter_size_h * filter_size_d;
+        pool_size            = (pool_size == 0) ? 1 : pool_size;
+        size_t res_index     = 0;
+        size_t res_index_gpu = 0;
+        bool found           = false;
+        for(int d = dstart; d < dend; ++d)
+        {
+            for(int h = hstart; h < hend; ++h)
             {
-                for(int j = 0; j < top_height && match; j++)
+                for(int w = wstart; w < wend; ++w)
                 {
-                    for(int i = 0; i < top_width && match; i++)
+                    size_t bot_index = b * bot_n_stride + o * bot_c_stride + d * bot_d_stride +
+                                       h * bot_h_stride + w * bot_w_stride;
+                    if(pooling_method == MLO_POOLING_OP_MAX)
                     {
-                        // c-emulator
-                        if(pooling_method == MLO_POOLING_OP_MAX)
+                        if(static_cast<Tcheck_>(bot_ptr[bot_index]) > res)
                         {
-                            res = -MAX_VAL;
+                            res = static_cast<Tcheck_>(bot_ptr[bot_index]);
+                            num_flops_per_res = 0;
+                            res_index         = bot_index;
+                            res_index_gpu =
+                                index_position == 1
+                                    ? (d * bot_height * bot_width + h * bot_width + w)
+                                    : ((d - k * pool_stride_d + pad_d) *
+                                       filter_size_w * filter_size_h) +
+                                          ((h - j * pool_stride_h + pad_h) *
+                                           filter_size_w) +
+                                          (w - i * pool_stride_w + pad_w);
+                            found = true;
                         }
-                        else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                        {
-                            res = static_cast<Tcheck_>(0);
-                        }
-                        int num_flops_per_res = 0;
-
-                        int dstart = k * pool_stride_d - pad_d;
-                        int hstart = j * pool_stride_h - pad_h;
-                        int wstart = i * pool_stride_w - pad_w;
-                        int dend   = std::min(dstart + filter_size_d, bot_depth);
-                        int hend   = std::min(hstart + filter_size_h, bot_height);
-                        int wend   = std::min(wstart + filter_size_w, bot_width);
-                        dstart     = std::max(dstart, 0);
-                        hstart     = std::max(hstart, 0);
-                        wstart     = std::max(wstart, 0);
-
-                        int pool_size;
-                        if(pooling_method == MLO_POOLING_OP_AVE)
-                            pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
-                        else
-                            pool_size = filter_size_w * filter_size_h * filter_size_d;
-                        pool_size            = (pool_size == 0) ? 1 : pool_size;
-                        size_t res_index     = 0;
-                        size_t res_index_gpu = 0;
-                        bool found           = false;
-                        for(int d = dstart; d < dend; ++d)
-                        {
-                            for(int h = hstart; h < hend; ++h)
-                            {
-                                for(int w = wstart; w < wend; ++w)
-                                {
-                                    size_t bot_index = b * bot_n_stride + o * bot_c_stride +
-                                                       d * bot_d_stride + h * bot_h_stride +
-                                                       w * bot_w_stride;
-                                    if(pooling_method == MLO_POOLING_OP_MAX)
-                                    {
-                                        if(static_cast<Tcheck_>(bot_ptr[bot_index]) > res)
-                                        {
-                                            res = static_cast<Tcheck_>(bot_ptr[bot_index]);
-                                            num_flops_per_res = 0;
-                                            res_index         = bot_index;
-                                            res_index_gpu =
-                                                index_position == 1
-                                                    ? (d * bot_height * bot_width + h * bot_width +
-                                                       w)
-                                                    : ((d - k * pool_stride_d + pad_d) *
-                                                       filter_size_w * filter_size_h) +
-                                                          ((h - j * pool_stride_h + pad_h) *
-                                                           filter_size_w) +
-                                                          (w - i * pool_stride_w + pad_w);
-                                            found = true;
-                                        }
-                                    }
-                                    else if(pooling_method == MLO_POOLING_OP_AVE ||
-                                            pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                                    {
+                    }
+                    else if(pooling_method == MLO_POOLING_OP_AVE ||
+                            pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+                    {
 #if MLO_POOLING_EMULATE_VALIDATION_FAILURE
-                                        if(num_flops_per_res %
-                                               MLO_POOLING_EMULATE_VALIDATION_FAILURE !=
-                                           0)
+                        if(num_flops_per_res % MLO_POOLING_EMULATE_VALIDATION_FAILURE != 0)
 #endif
-                                            res += static_cast<Tcheck_>(bot_ptr[bot_index]);
-                                        ++num_flops_per_res;
-                                    }
-                                    else
-                                    {
-                                        std::cout << "ERROR: unknown operator : layer: pooling."
-                                                  << std::endl;
-                                        match = false;
-                                        continue;
-                                    }
-                                }
-                            }
-                        }
-                        // special index value is used to mark top points which has no associated
-                        // bottom
-                        // points
-                        if(!found)
-                        {
-                            res_index     = std::numeric_limits<size_t>::max();
-                            res_index_gpu = std::numeric_limits<uint8_t>::max();
-                        }
-
-                        size_t top_index = b * top_n_stride + o * top_c_stride + k * top_d_stride +
-                                           j * top_h_stride + i * top_w_stride;
-                        size_t mask_gpu_index = b * mask_n_stride + o * mask_c_stride +
-                                                k * mask_d_stride + j * mask_h_stride +
-                                                i * mask_w_stride;
-                        if(pooling_method == MLO_POOLING_OP_MAX)
-                        {
-                            // the case with the odd input, the even kernel size and 2*pad == kernel
-                            // size
-                            mask_ptr[top_index] = res_index;
-                            if(do_backward)
-                            {
-                                size_t mg = mask_gpu[mask_gpu_index];
-                                if(mg != res_index_gpu)
-                                {
-                                    std::cout << "Mask mismatch, gpu " << mg << " cpu "
-                                              << res_index_gpu << "(" << res_index << ")"
-                                              << std::endl;
-                                    match = false;
-                                }
-                            }
-                        }
-                        if(pooling_method == MLO_POOLING_OP_AVE ||
-                           pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-                        {
-                            res /= pool_size;
-                            ++num_flops_per_res;
-                        }
-                        Tcheck_ c_val = res;
+                            res += static_cast<Tcheck_>(bot_ptr[bot_index]);
+                        ++num_flops_per_res;
+                    }
+                    else
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        std::cout << "ERROR: unknown operator : layer: pooling." << std::endl;
+                        match = false;
+                        continue;
+                    }
+                }
+            }
+        }
+        // special index value is used to mark top points which has no associated bottom points
+        if(!found)
+        {
+            res_index     = std::numeric_limits<size_t>::max();
+            res_index_gpu = std::numeric_limits<uint8_t>::max();
+        }
 
-                        Tgpu_ gg_val = (top_ptr[top_index]);
+        size_t top_index = b * top_n_stride + o * top_c_stride + k * top_d_stride +
+                           j * top_h_stride + i * top_w_stride;
+        size_t mask_gpu_index = b * mask_n_stride + o * mask_c_stride + k * mask_d_stride +
+                                j * mask_h_stride + i * mask_w_stride;
+        if(pooling_method == MLO_POOLING_OP_MAX)
+        {
+            // the case with the odd input, the even kernel size and 2*pad == kernel size
+            mask_ptr[top_index] = res_index;
+            if(do_backward)
+            {
+                size_t mg = mask_gpu[mask_gpu_index];
+                if(mg != res_index_gpu)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    std::cout << "Mask mismatch, gpu " << mg << " cpu " << res_index_gpu << "("
+                              << res_index << ")" << std::endl;
+                    match = false;
+                }
+            }
+        }
+        if(pooling_method == MLO_POOLING_OP_AVE || pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
+        {
+            res /= pool_size;
+            ++num_flops_per_res;
+        }
+        Tcheck_ c_val = res;
 
-                        gg_val = (Tgpu_(gg_val) == Tgpu_(-G_MAX_VAL)) ? Tgpu_(0) : Tgpu_(gg_val);
+        Tgpu_ gg_val = (top_ptr[top_index]);
 
-                        c_val = (c_val == -MAX_VAL) ? 0 : c_val;
+        gg_val = (Tgpu_(gg_val) == Tgpu_(-G_MAX_VAL)) ? Tgpu_(0) : Tgpu_(gg_val);
 
-                        Tcheck_ g_val(gg_val);
+        c_val = (c_val == -MAX_VAL) ? 0 : c_val;
 
-                        double err = std::abs(c_val - g_val);
+        Tcheck_ g_val(gg_val);
 
-                        if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) ||
-                           !std::isfinite(c_val) || !std::isfinite(g_val))
-                        {
-                            std::cout << "Difference " << err << " too large (> " << allowedEps
-                                      << ") at {" << b << ',' << o << ',' << j << ',' << i
-                                      << "}, cpu_val = " << c_val << " vs gpu_val = " << g_val
-                                      << std::endl;
-                            std::cout << "Number of flops used: " << num_flops_per_res
-                                      << ", pool_size: " << pool_size << std::endl;
-                            match = false;
-                        }
+        double err = std::abs(c_val - g_val);
 
-                        if(err > stats.max_error)
-                            stats.max_error = err;
-                        if(num_flops_per_res > stats.max_num_flops_per_res)
-                            stats.max_num_flops_per_res = num_flops_per_res;
-                    }
-                }
-            }
+        if(err > allowedEps || std::isnan(c_val) || std::isnan(g_val) || !std::isfinite(c_val) ||
+           !std::isfinite(g_val))
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::cout << "Difference " << err << " too large (> " << allowedEps << ") at {" << b
+                      << ',' << o << ',' << j << ',' << i << "}, cpu_val = " << c_val
+                      << " vs gpu_val = " << g_val << std::endl;
+            std::cout << "Number of flops used: " << num_flops_per_res
+                      << ", pool_size: " << pool_size << std::endl;
+            match = false;
         }
+
+        if(err > task_stats.max_error)
+            task_stats.max_error = err;
+        if(num_flops_per_res > task_stats.max_num_flops_per_res)
+            task_stats.max_num_flops_per_res = num_flops_per_res;
+    };
+
+    const auto merge = [&](const pooling_math_stats& task_stats) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.max_error = std::max(stats.max_error, task_stats.max_error);
+        stats.max_num_flops_per_res =
+            std::max(stats.max_num_flops_per_res, task_stats.max_num_flops_per_res);
+    };
+
+    // The first mismatch stops all tasks. NHWC tensors keep the channels innermost, so each of
+    // their tasks takes an output row of all channels and walks memory contiguously. Otherwise
+    // every (batch, channel) plane is a task.
+    if(bot_c_stride < bot_w_stride)
+    {
+        miopen::par_for(n_batchs * top_depth * top_height, miopen::min_grain{1}, [&](int row) {
+            const int b = row / (top_depth * top_height);
+            const int k = row / top_height % top_depth;
+            const int j = row % top_height;
+            pooling_math_stats row_stats;
+
+            for(int i = 0; i < top_width && match; i++)
+                for(int o = 0; o < n_outputs && match; o++)
+                    verify(b, o, k, j, i, row_stats);
+
+            merge(row_stats);
+        });
+    }
+    else
+    {
+        miopen::par_for(n_batchs * n_outputs, miopen::min_grain{1}, [&](int plane) {
+            const int b = plane / n_outputs;
+            const int o = plane % n_outputs;
+            pooling_math_stats plane_stats;
+
+            for(int k = 0; k < top_depth && match; k++)
+                for(int j = 0; j < top_height && match; j++)
+                    for(int i = 0; i < top_width && match; i++)
+                        verify(b, o, k, j, i, plane_stats);
+
+            merge(plane_stats);
+        });
     }
 
     return (match);
@@ -353,120 +377,124 @@ void mloPoolingBackwardRunHost(
     std::tie(top_df_n_stride, top_df_c_stride, top_df_d_stride, top_df_h_stride, top_df_w_stride) =
         miopen::GetNCDHW(spatial_dim, top_df.GetStrides());
 
+    if(pooling_method != MLO_POOLING_OP_MAX && pooling_method != MLO_POOLING_OP_AVE &&
+       pooling_method != MLO_POOLING_OP_AVE_INCLUSIVE)
+    {
+        std::cout << "ERROR: unknown operator : layer: pooling back-propagation." << std::endl;
+        return;
+    }
+
     std::vector<int> num_flops(bot_df.GetElementSize(), 0);
 
-    for(int b = 0; b < n_batchs; b++)
-    {
-        for(int o = 0; o < n_outputs; o++)
+    // Average pooling gathers every bottom point from the top points whose windows cover it.
+    const auto average = [&](int b, int o, int k, int j, int i) {
+        // c-emulator
+        const auto bot_idx    = b * bot_df_n_stride + o * bot_df_c_stride + k * bot_df_d_stride +
+                                j * bot_df_h_stride + i * bot_df_w_stride;
+        const auto top_df_off = b * top_df_n_stride + o * top_df_c_stride;
+
+        int d       = k + pad_d;
+        int h       = j + pad_h;
+        int w       = i + pad_w;
+        int pdstart = (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
+        int pdend   = std::min(d / pool_stride_d + 1, top_d);
+        int phstart = (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
+        int phend   = std::min(h / pool_stride_h + 1, top_h);
+        int pwstart = (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
+        int pwend   = std::min(w / pool_stride_w + 1, top_w);
+        Tcheck_ gradient     = static_cast<Tcheck_>(0);
+        int gradient_n_flops = 0;
+        for(int pd = pdstart; pd < pdend; ++pd)
         {
-            int bot_df_v_off = b * bot_df_n_stride + o * bot_df_c_stride;
-            int top_df_off   = b * top_df_n_stride + o * top_df_c_stride;
-
-            if(pooling_method == MLO_POOLING_OP_MAX)
+            for(int ph = phstart; ph < phend; ++ph)
             {
-                for(int k = 0; k < top_d; k++)
+                for(int pw = pwstart; pw < pwend; ++pw)
                 {
-                    for(int j = 0; j < top_h; j++)
-                    {
-                        for(int i = 0; i < top_w; i++)
-                        {
-                            size_t top_idx = top_df_off + k * top_df_d_stride +
-                                             j * top_df_h_stride + i * top_df_w_stride;
-                            size_t bot_idx = mask_ptr[top_idx];
-                            // skip top points that don't have associated bottom points
-                            if(bot_idx == std::numeric_limits<size_t>::max())
-                                continue;
-                            bot_df_v_ptr[bot_idx] += static_cast<Tcheck_>(top_df_ptr[top_idx]);
-                            ++num_flops[bot_idx];
-                        }
-                    }
+                    // figure out the pooling size
+                    int dstart = pd * pool_stride_d - pad_d;
+                    int hstart = ph * pool_stride_h - pad_h;
+                    int wstart = pw * pool_stride_w - pad_w;
+                    int dend   = std::min(dstart + filter_size_d, bot_d);
+                    int hend   = std::min(hstart + filter_size_h, bot_h);
+                    int wend   = std::min(wstart + filter_size_w, bot_w);
+                    dstart     = std::max(dstart, 0);
+                    hstart     = std::max(hstart, 0);
+                    wstart     = std::max(wstart, 0);
+
+                    int pool_size;
+                    if(pooling_method == MLO_POOLING_OP_AVE)
+                        pool_size = (dend - dstart) * (hend - hstart) * (wend - wstart);
+                    else
+                        pool_size = filter_size_w * filter_size_h * filter_size_d;
+                    pool_size = (pool_size == 0) ? 1 : pool_size;
+
+                    const auto top_idx = top_df_off + pd * top_df_d_stride + ph * top_df_h_stride +
+                                         pw * top_df_w_stride;
+
+                    gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]) /
+                                static_cast<Tcheck_>(pool_size);
+                    gradient_n_flops += 2; // pool_size is computed using
+                                           // integer ops, do not count those.
                 }
             }
-            else if(pooling_method == MLO_POOLING_OP_AVE ||
-                    pooling_method == MLO_POOLING_OP_AVE_INCLUSIVE)
-            {
+        }
+        bot_df_v_ptr[bot_idx] = gradient;
+        num_flops[bot_idx]    = gradient_n_flops;
+    };
 
-                for(int k = 0; k < bot_d; k++)
+    // Max pooling scatters each top point into the bottom plane it came from, so every
+    // (batch, channel) plane is a task of its own.
+    if(pooling_method == MLO_POOLING_OP_MAX)
+    {
+        miopen::par_for(n_batchs * n_outputs, miopen::min_grain{1}, [&](int plane) {
+            const int b          = plane / n_outputs;
+            const int o          = plane % n_outputs;
+            const int top_df_off = b * top_df_n_stride + o * top_df_c_stride;
+
+            for(int k = 0; k < top_d; k++)
+            {
+                for(int j = 0; j < top_h; j++)
                 {
-                    for(int j = 0; j < bot_h; j++)
+                    for(int i = 0; i < top_w; i++)
                     {
-                        for(int i = 0; i < bot_w; i++)
-                        {
-                            // c-emulator
-                            const auto bot_idx = bot_df_v_off + k * bot_df_d_stride +
-                                                 j * bot_df_h_stride + i * bot_df_w_stride;
-                            bot_df_v_ptr[bot_idx] = static_cast<Tcheck_>(0);
-                            num_flops[bot_idx]    = 0;
-
-                            int d = k + pad_d;
-                            int h = j + pad_h;
-                            int w = i + pad_w;
-                            int pdstart =
-                                (d < filter_size_d) ? 0 : (d - filter_size_d) / pool_stride_d + 1;
-                            int pdend = std::min(d / pool_stride_d + 1, top_d);
-                            int phstart =
-                                (h < filter_size_h) ? 0 : (h - filter_size_h) / pool_stride_h + 1;
-                            int phend = std::min(h / pool_stride_h + 1, top_h);
-                            int pwstart =
-                                (w < filter_size_w) ? 0 : (w - filter_size_w) / pool_stride_w + 1;
-                            int pwend            = std::min(w / pool_stride_w + 1, top_w);
-                            Tcheck_ gradient     = static_cast<Tcheck_>(0);
-                            int gradient_n_flops = 0;
-                            for(int pd = pdstart; pd < pdend; ++pd)
-                            {
-                                for(int ph = phstart; ph < phend; ++ph)
-                                {
-                                    for(int pw = pwstart; pw < pwend; ++pw)
-                                    {
-                                        // figure out the pooling size
-                                        int dstart = pd * pool_stride_d - pad_d;
-                                        int hstart = ph * pool_stride_h - pad_h;
-                                        int wstart = pw * pool_stride_w - pad_w;
-                                        int dend   = std::min(dstart + filter_size_d, bot_d);
-                                        int hend   = std::min(hstart + filter_size_h, bot_h);
-                                        int wend   = std::min(wstart + filter_size_w, bot_w);
-                                        dstart     = std::max(dstart, 0);
-                                        hstart     = std::max(hstart, 0);
-                                        wstart     = std::max(wstart, 0);
-
-                                        int pool_size;
-                                        if(pooling_method == MLO_POOLING_OP_AVE)
-                                            pool_size = ((dend - dstart) * (hend - hstart) *
-                                                             (wend - wstart) ==
-                                                         0)
-                                                            ? 1
-                                                            : (dend - dstart) * (hend - hstart) *
-                                                                  (wend - wstart);
-                                        else
-                                            pool_size =
-                                                (filter_size_w * filter_size_h * filter_size_d == 0)
-                                                    ? 1
-                                                    : filter_size_w * filter_size_h * filter_size_d;
-
-                                        const auto top_idx = top_df_off + pd * top_df_d_stride +
-                                                             ph * top_df_h_stride +
-                                                             pw * top_df_w_stride;
-
-                                        gradient += static_cast<Tcheck_>(top_df_ptr[top_idx]) /
-                                                    static_cast<Tcheck_>(pool_size);
-                                        gradient_n_flops += 2; // pool_size is computed using
-                                                               // integer ops, do not count those.
-                                    }
-                                }
-                            }
-                            bot_df_v_ptr[bot_idx] = gradient;
-                            num_flops[bot_idx]    = gradient_n_flops;
-                        }
+                        size_t top_idx = top_df_off + k * top_df_d_stride + j * top_df_h_stride +
+                                         i * top_df_w_stride;
+                        size_t bot_idx = mask_ptr[top_idx];
+                        // skip top points that don't have associated bottom points
+                        if(bot_idx == std::numeric_limits<size_t>::max())
+                            continue;
+                        bot_df_v_ptr[bot_idx] += static_cast<Tcheck_>(top_df_ptr[top_idx]);
+                        ++num_flops[bot_idx];
                     }
                 }
             }
-            else
-            {
-                std::cout << "ERROR: unknown operator : layer: pooling back-propagation."
-                          << std::endl;
-                continue;
-            }
-        }
+        });
+    }
+    else if(bot_df_c_stride < bot_df_w_stride)
+    {
+        // NHWC tensors keep the channels innermost, so each task takes a bottom row of all
+        // channels and walks memory contiguously.
+        miopen::par_for(n_batchs * bot_d * bot_h, miopen::min_grain{1}, [&](int row) {
+            const int b = row / (bot_d * bot_h);
+            const int k = row / bot_h % bot_d;
+            const int j = row % bot_h;
+
+            for(int i = 0; i < bot_w; i++)
+                for(int o = 0; o < n_outputs; o++)
+                    average(b, o, k, j, i);
+        });
+    }
+    else
+    {
+        miopen::par_for(n_batchs * n_outputs, miopen::min_grain{1}, [&](int plane) {
+            const int b = plane / n_outputs;
+            const int o = plane % n_outputs;
+
+            for(int k = 0; k < bot_d; k++)
+                for(int j = 0; j < bot_h; j++)
+                    for(int i = 0; i < bot_w; i++)
+                        average(b, o, k, j, i);
+        });
     }
     stats.max_num_flops_per_res = *(std::max_element(num_flops.begin(), num_flops.end()));
 }
@@ -25,6 +25,9 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifndef MLO_SOFTMAXHOST_H_
 #define MLO_SOFTMAXHOST_H_
 
+
+#include <miopen/par_for.hpp>
+
 ////////////////////////////////////////////////////////////
 //
 ///////////////////////////////////////////////////////////
@@ -42,6 +45,11 @@ T logaddexp(T x, T y, T neg_inf)
     return c <= neg_inf ? std::max(a, neg_inf) : std::max(T(a + log(T(1) + exp(b - a))), neg_inf);
 }
 
+// Both references run in parallel over independent slices of the tensor: whole images in the
+// instance mode and image rows in the channel mode. In the channel mode a row keeps one
+// accumulator per column, so the channel loop is the outer one and every inner loop walks a
+// contiguous row of the tensor.
+
 template <typename Tgpu, typename Tcheck /* the data type used in CPU checkings (usually double) */>
 int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                              miopenTensorDescriptor_t outputTensor,
@@ -61,16 +69,17 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
     (void)out_wstr;
 
     Tcheck max_val = (sizeof(Tgpu) == 4) ? 3.402823466e+38f : 65504.;
-    std::vector<Tcheck> channel_max((mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w),
-                                    static_cast<Tcheck>(-max_val));
+    Tcheck neg_inf = static_cast<Tcheck>(
+        miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16 : NEGATIVE_INF_FP32);
     std::vector<Tcheck> results(n * c * h * w, static_cast<Tcheck>(0.0));
 
     int ret = 0;
 
     if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
     {
-        for(int i = 0; i < n; i++)
-        {
+        miopen::par_for(n, miopen::min_grain{1}, [&](int i) {
+            Tcheck maxval = static_cast<Tcheck>(-max_val);
+
             if(algo == MIOPEN_SOFTMAX_FAST)
             {
                 for(int j = 0; j < c; j++)
@@ -87,10 +96,10 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                     for(int s0 = 0; s0 < h; s0++)
                         for(int s1 = 0; s1 < w; s1++)
                         {
-                            channel_max[i] =
+                            maxval =
                                 std::max(static_cast<Tcheck>(
                                              in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]),
-                                         channel_max[i]);
+                                         maxval);
                         }
 
                 for(int j = 0; j < c; j++)
@@ -100,23 +109,19 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                             results[(i * c + j) * h * w + s0 * w + s1] =
                                 static_cast<Tcheck>(
                                     in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]) -
-                                channel_max[i];
+                                maxval;
                         }
             }
 
             if(algo == MIOPEN_SOFTMAX_LOG)
             {
-                Tcheck neg_inf = static_cast<Tcheck>(
-                    miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16
-                                                                       : NEGATIVE_INF_FP32);
-                channel_max[i] = neg_inf;
+                maxval = neg_inf;
                 for(int j = 0; j < c; j++)
                     for(int s0 = 0; s0 < h; s0++)
                         for(int s1 = 0; s1 < w; s1++)
                         {
-                            channel_max[i] = logaddexp(results[(i * c + j) * h * w + s0 * w + s1],
-                                                       channel_max[i],
-                                                       neg_inf);
+                            maxval = logaddexp(
+                                results[(i * c + j) * h * w + s0 * w + s1], maxval, neg_inf);
                         }
 
                 for(int j = 0; j < c; j++)
@@ -124,21 +129,20 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                         for(int s1 = 0; s1 < w; s1++)
                         {
                             outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha *
-                                    (results[(i * c + j) * h * w + s0 * w + s1] - channel_max[i]) +
+                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] - maxval) +
                                 beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
                         }
             }
             else
             {
-                channel_max[i] = 0.0;
+                maxval = 0.0;
                 for(int j = 0; j < c; j++)
                     for(int s0 = 0; s0 < h; s0++)
                         for(int s1 = 0; s1 < w; s1++)
                         {
                             results[(i * c + j) * h * w + s0 * w + s1] =
                                 exp(results[(i * c + j) * h * w + s0 * w + s1]);
-                            channel_max[i] += results[(i * c + j) * h * w + s0 * w + s1];
+                            maxval += results[(i * c + j) * h * w + s0 * w + s1];
                         }
 
                 for(int j = 0; j < c; j++)
@@ -146,90 +150,70 @@ int mloSoftmaxForwardRunHost(miopenTensorDescriptor_t inputTensor,
                         for(int s1 = 0; s1 < w; s1++)
                         {
                             outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha *
-                                    (results[(i * c + j) * h * w + s0 * w + s1] / channel_max[i]) +
+                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] / maxval) +
                                 beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
                         }
             }
-        }
+        });
     }
     else
     {
-        for(int i = 0; i < n; i++)
-        {
-            for(int s0 = 0; s0 < h; s0++)
-                for(int s1 = 0; s1 < w; s1++)
-                {
-                    if(algo == MIOPEN_SOFTMAX_FAST)
-                    {
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] = static_cast<Tcheck>(
-                                in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]);
-                        }
-                    }
-                    else
-                    {
-                        for(int j = 0; j < c; j++)
-                        {
-                            channel_max[i * h * w + s0 * w + s1] =
-                                std::max(static_cast<Tcheck>(
-                                             in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]),
-                                         channel_max[i * h * w + s0 * w + s1]);
-                        }
+        std::vector<Tcheck> channel_max(n * h * w, static_cast<Tcheck>(-max_val));
+        miopen::par_for(n * h, [&](int row) {
+            const int i    = row / h;
+            const int s0   = row % h;
+            const Tgpu* x  = in + i * in_nstr + s0 * in_hstr;
+            Tcheck* y      = outhost + i * out_nstr + s0 * out_hstr;
+            Tcheck* res    = results.data() + i * c * h * w + s0 * w;
+            Tcheck* maxval = channel_max.data() + row * w;
 
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    in[i * in_nstr + j * in_cstr + s0 * in_hstr + s1]) -
-                                channel_max[i * h * w + s0 * w + s1];
-                        }
-                    }
+            if(algo == MIOPEN_SOFTMAX_FAST)
+            {
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        res[j * h * w + s1] = static_cast<Tcheck>(x[j * in_cstr + s1]);
+            }
+            else
+            {
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        maxval[s1] = std::max(static_cast<Tcheck>(x[j * in_cstr + s1]), maxval[s1]);
 
-                    if(algo == MIOPEN_SOFTMAX_LOG)
-                    {
-                        Tcheck neg_inf = static_cast<Tcheck>(
-                            miopen::deref(inputTensor).GetType() == miopenHalf ? NEGATIVE_INF_FP16
-                                                                               : NEGATIVE_INF_FP32);
-                        channel_max[i * h * w + s0 * w + s1] = results[i * c * h * w + s0 * w + s1];
-                        for(int j = 1; j < c; j++)
-                        {
-                            channel_max[i * h * w + s0 * w + s1] =
-                                logaddexp(results[(i * c + j) * h * w + s0 * w + s1],
-                                          channel_max[i * h * w + s0 * w + s1],
-                                          neg_inf);
-                        }
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        res[j * h * w + s1] = static_cast<Tcheck>(x[j * in_cstr + s1]) - maxval[s1];
+            }
 
-                        for(int j = 0; j < c; j++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] -
-                                         channel_max[i * h * w + s0 * w + s1]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
-                    }
-                    else
-                    {
-                        channel_max[i * h * w + s0 * w + s1] = 0.0;
-                        for(int j = 0; j < c; j++)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                exp(results[(i * c + j) * h * w + s0 * w + s1]);
-                            channel_max[i * h * w + s0 * w + s1] +=
-                                results[(i * c + j) * h * w + s0 * w + s1];
-                        }
+            if(algo == MIOPEN_SOFTMAX_LOG)
+            {
+                for(int s1 = 0; s1 < w; s1++)
+                    maxval[s1] = res[s1];
+                for(int j = 1; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        maxval[s1] = logaddexp(res[j * h * w + s1], maxval[s1], neg_inf);
 
-                        for(int j = 0; j < c; j++)
-                        {
-                            outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1] =
-                                alpha * (results[(i * c + j) * h * w + s0 * w + s1] /
-                                         channel_max[i * h * w + s0 * w + s1]) +
-                                beta * outhost[i * out_nstr + j * out_cstr + s0 * out_hstr + s1];
-                        }
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        y[j * out_cstr + s1] = alpha * (res[j * h * w + s1] - maxval[s1]) +
+                                               beta * y[j * out_cstr + s1];
+            }
+            else
+            {
+                for(int s1 = 0; s1 < w; s1++)
+                    maxval[s1] = 0.0;
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                    {
+                        res[j * h * w + s1] = exp(res[j * h * w + s1]);
+                        maxval[s1] += res[j * h * w + s1];
                     }
-                }
-        }
+
+                for(int j = 0; j < c; j++)
+                    for(int s1 = 0; s1 < w; s1++)
+                        y[j * out_cstr + s1] = alpha * (res[j * h * w + s1] / maxval[s1]) +
+                                               beta * y[j * out_cstr + s1];
+            }
+        });
     }
 
     return ret;
@@ -255,32 +239,30 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
     (void)in_wstr;
     (void)out_wstr;
 
-    std::vector<Tcheck> channel_dot((mode == MIOPEN_SOFTMAX_MODE_INSTANCE ? n : n * h * w),
-                                    static_cast<Tcheck>(0.0));
     std::vector<Tcheck> results(n * c * h * w, static_cast<Tcheck>(0.0));
 
     int ret = 0;
 
-    for(int i = 0; i < n; i++)
+    if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
     {
-        if(mode == MIOPEN_SOFTMAX_MODE_INSTANCE)
-        {
+        miopen::par_for(n, miopen::min_grain{1}, [&](int i) {
+            Tcheck dot = static_cast<Tcheck>(0.0);
+
             for(int j = 0; j < c; j++)
                 for(int s0 = 0; s0 < h; s0++)
                     for(int s1 = 0; s1 < w; s1++)
                     {
                         if(algo == MIOPEN_SOFTMAX_LOG)
                         {
-                            channel_dot[i] += static_cast<Tcheck>(
+                            dot += static_cast<Tcheck>(
                                 dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
                         }
                         else
                         {
-                            channel_dot[i] +=
-                                static_cast<Tcheck>(
-                                    out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) *
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
+                            dot += static_cast<Tcheck>(
+                                       out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) *
+                                   static_cast<Tcheck>(
+                                       dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
                         }
                     }
 
@@ -293,7 +275,7 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
                             results[(i * c + j) * h * w + s0 * w + s1] =
                                 static_cast<Tcheck>(
                                     dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i] *
+                                dot *
                                     std::exp(out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
                         }
                         else
@@ -301,7 +283,7 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
                             results[(i * c + j) * h * w + s0 * w + s1] =
                                 static_cast<Tcheck>(
                                     dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i];
+                                dot;
 
                             results[(i * c + j) * h * w + s0 * w + s1] *= static_cast<Tcheck>(
                                 out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
@@ -310,55 +292,47 @@ int mloSoftmaxBackwardRunHost(miopenTensorDescriptor_t dInputTensor,
                             alpha * results[(i * c + j) * h * w + s0 * w + s1] +
                             beta * dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1];
                     }
-        }
-        else
-        {
-            for(int s0 = 0; s0 < h; s0++)
+        });
+    }
+    else
+    {
+        std::vector<Tcheck> channel_dot(n * h * w, static_cast<Tcheck>(0.0));
+        miopen::par_for(n * h, [&](int row) {
+            const int i    = row / h;
+            const int s0   = row % h;
+            const Tgpu* y  = out + i * out_nstr + s0 * out_hstr;
+            const Tgpu* dy = dout + i * out_nstr + s0 * out_hstr;
+            Tcheck* dx     = dinhost + i * in_nstr + s0 * in_hstr;
+            Tcheck* res    = results.data() + i * c * h * w + s0 * w;
+            Tcheck* dot    = channel_dot.data() + row * w;
+
+            for(int j = 0; j < c; j++)
                 for(int s1 = 0; s1 < w; s1++)
                 {
-                    for(int j = 0; j < c; j++)
+                    if(algo == MIOPEN_SOFTMAX_LOG)
+                        dot[s1] += static_cast<Tcheck>(dy[j * out_cstr + s1]);
+                    else
+                        dot[s1] += static_cast<Tcheck>(y[j * out_cstr + s1]) *
+                                   static_cast<Tcheck>(dy[j * out_cstr + s1]);
+                }
+
+            for(int j = 0; j < c; j++)
+                for(int s1 = 0; s1 < w; s1++)
+                {
+                    if(algo == MIOPEN_SOFTMAX_LOG)
                     {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            channel_dot[i * h * w + s0 * w + s1] += static_cast<Tcheck>(
-                                dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            channel_dot[i * h * w + s0 * w + s1] +=
-                                static_cast<Tcheck>(
-                                    out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) *
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
+                        res[j * h * w + s1] = static_cast<Tcheck>(dy[j * out_cstr + s1]) -
+                                              dot[s1] * std::exp(y[j * out_cstr + s1]);
                     }
-
-                    for(int j = 0; j < c; j++)
+                    else
                     {
-                        if(algo == MIOPEN_SOFTMAX_LOG)
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i * h * w + s0 * w + s1] *
-                                    std::exp(out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        else
-                        {
-                            results[(i * c + j) * h * w + s0 * w + s1] =
-                                static_cast<Tcheck>(
-                                    dout[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]) -
-                                channel_dot[i * h * w + s0 * w + s1];
-
-                            results[(i * c + j) * h * w + s0 * w + s1] *= static_cast<Tcheck>(
-                                out[i * out_nstr + j * out_cstr + s0 * out_hstr + s1]);
-                        }
-                        dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1] =
-                            alpha * results[(i * c + j) * h * w + s0 * w + s1] +
-                            beta * dinhost[i * in_nstr + j * in_cstr + s0 * in_hstr + s1];
+                        res[j * h * w + s1] = static_cast<Tcheck>(dy[j * out_cstr + s1]) - dot[s1];
+                        res[j * h * w + s1] *= static_cast<Tcheck>(y[j * out_cstr + s1]);
                     }
+                    dx[j * in_cstr + s1] =
+                        alpha * res[j * h * w + s1] + beta * dx[j * in_cstr + s1];
                 }
-        }
+        });
     }
 
     return ret;
@@ -0,0 +1,112 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PERFDB_REPLAY_DRIVER_HPP
+#define GUARD_MIOPEN_PERFDB_REPLAY_DRIVER_HPP
+
+#include "driver.hpp"
+
+#include <miopen/db_compaction.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/perf_db_neighbors.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Perf-db replay mode measures how well the configs tuned for the nearest problems stand in for
+// the ones of a problem without a record (see MIOPEN_DEBUG_PERFDB_NEIGHBORS):
+//
+//   ./bin/MIOpenDriver --perfdb-replay gfx90a68.db --neighbors 4 --validate 1
+//
+// Every entry of the perf-db is looked up as if its record was missing, and the configs of its
+// neighbors are compared with the tuned one. With "--validate 1" they are also checked against
+// the configs the solver accepts on the current device, and the tuned configs are compared with
+// the defaults, which is what the solver gets without the lookup.
+
+inline int RunPerfDbReplay(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        printf("FAILED: No perf database given for --perfdb-replay\n");
+        Usage();
+    }
+
+    std::size_t count = 4;
+    bool validate     = false;
+    for(int i = 3; i < argc; i += 2)
+    {
+        const std::string name = argv[i];
+        if(i + 1 >= argc)
+        {
+            printf("FAILED: No value for %s\n", name.c_str());
+            Usage();
+        }
+        const std::string value = argv[i + 1];
+
+        if(name == "--neighbors")
+            count = std::max(std::atoi(value.c_str()), 1);
+        else if(name == "--validate")
+            validate = std::atoi(value.c_str()) != 0;
+        else
+        {
+            printf("FAILED: Invalid perfdb-replay argument %s %s\n", name.c_str(), value.c_str());
+            Usage();
+        }
+    }
+
+    miopen::Handle* handle = nullptr;
+    if(validate)
+    {
+        SharedDriverHandle() = CreateDriverHandle();
+        handle               = &miopen::deref(SharedDriverHandle());
+    }
+
+    int rc = 0;
+    try
+    {
+        auto contents = miopen::DbContents{};
+        auto stats    = miopen::DbCompactionStats{};
+        miopen::ReadDb(argv[2], miopen::DbKind::Perf, contents, stats);
+        std::cout << miopen::ReplayPerfDbNeighbors(contents, count, handle);
+    }
+    catch(const miopen::Exception& ex)
+    {
+        std::cout << "Perf database replay FAILED: " << ex.what() << std::endl;
+        rc = EXIT_FAILURE;
+    }
+
+    if(validate)
+    {
+        miopenDestroy(SharedDriverHandle());
+        SharedDriverHandle() = nullptr;
+    }
+    return rc;
+}
+
+#endif // GUARD_MIOPEN_PERFDB_REPLAY_DRIVER_HPP
@@ -0,0 +1,293 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TUNING_DRIVER_HPP
+#define GUARD_MIOPEN_TUNING_DRIVER_HPP
+
+#include "driver.hpp"
+#include "warmstart_driver.hpp"
+
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/tuning_queue.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Tuning mode splits the auto-tuning of a model into jobs that worker processes pull from a work
+// queue in a directory, one process per GPU:
+//
+//   ./bin/MIOpenDriver --tuning enqueue queue_dir manifest.txt --slices 4
+//   ./bin/MIOpenDriver --tuning work queue_dir --worker host0-gpu0
+//   ./bin/MIOpenDriver --tuning merge queue_dir
+//
+// The manifest has the format of warm start mode. Each job tunes one slice of the configs of a
+// tunable solver for one of its problems. The configs evaluated by a worker are checkpointed, so a
+// job of a preempted worker is resumed where it stopped, by the same worker when it restarts or
+// by any worker once its lease has expired. Merging writes the best config of every solver and
+// problem to the user perf-db, and "status" lists the jobs.
+
+struct TuningOptions
+{
+    std::string command;
+    std::string directory;
+    std::string manifest;
+    std::size_t slices = 1;
+    std::string worker;
+    int lease_seconds = 30 * 60;
+    bool partial      = false;
+};
+
+inline TuningOptions ParseTuningOptions(int argc, char* argv[])
+{
+    TuningOptions options;
+    if(argc < 4)
+    {
+        printf("FAILED: No command and queue directory given for --tuning\n");
+        Usage();
+    }
+    options.command   = argv[2];
+    options.directory = argv[3];
+
+    int i = 4;
+    if(options.command == "enqueue")
+    {
+        if(argc < 5)
+        {
+            printf("FAILED: No manifest file given for --tuning enqueue\n");
+            Usage();
+        }
+        options.manifest = argv[i++];
+    }
+    else if(options.command != "work" && options.command != "merge" &&
+            options.command != "status")
+    {
+        printf("FAILED: Invalid tuning command %s\n", options.command.c_str());
+        Usage();
+    }
+
+    for(; i < argc; i += 2)
+    {
+        const std::string name = argv[i];
+        if(i + 1 >= argc)
+        {
+            printf("FAILED: No value for %s\n", name.c_str());
+            Usage();
+        }
+        const std::string value = argv[i + 1];
+
+        if(name == "--slices")
+            options.slices = std::max(std::atoi(value.c_str()), 1);
+        else if(name == "--worker")
+            options.worker = value;
+        else if(name == "--lease")
+            options.lease_seconds = std::max(std::atoi(value.c_str()), 1);
+        else if(name == "--partial")
+            options.partial = std::atoi(value.c_str()) != 0;
+        else
+        {
+            printf("FAILED: Invalid tuning argument %s %s\n", name.c_str(), value.c_str());
+            Usage();
+        }
+    }
+
+    if(options.worker.empty())
+    {
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+        options.worker = std::string{host} + '-' + std::to_string(getpid());
+    }
+    return options;
+}
+
+inline int EnqueueTuning(const TuningOptions& options,
+                         miopen::TuningQueue& queue,
+                         const std::function<Driver*(const std::string&)>& make_driver)
+{
+    std::ifstream manifest(options.manifest);
+    if(!manifest)
+    {
+        std::cout << "Cannot open the manifest file: " << options.manifest << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<WarmStartEntry> layers;
+    int rc = 0;
+    std::string line;
+    while(std::getline(manifest, line))
+        rc |= ParseWarmStartLine(line, make_driver, layers);
+
+    auto jobs = std::vector<miopen::TuningJob>{};
+    for(const auto& layer : layers)
+    {
+        const auto layer_jobs = miopen::MakeTuningJobs(
+            miopen::deref(SharedDriverHandle()), miopen::deref(layer.problem), options.slices);
+        if(layer_jobs.empty())
+            std::cout << "No tunable solvers for: " << layer.source << std::endl;
+        jobs.insert(jobs.end(), layer_jobs.begin(), layer_jobs.end());
+        miopenDestroyProblem(layer.problem);
+    }
+
+    const auto added = queue.Enqueue(jobs);
+    std::cout << "Enqueued " << added << " of " << jobs.size() << " tuning jobs for "
+              << layers.size() << " problems" << std::endl;
+    return rc;
+}
+
+inline int WorkTuning(const TuningOptions& options, miopen::TuningQueue& queue)
+{
+    auto& handle = miopen::deref(SharedDriverHandle());
+    int rc       = 0;
+    auto done    = 0;
+
+    while(const auto job = queue.Claim(options.worker))
+    {
+        std::cout << "Tuning job " << *job << std::endl;
+        auto checkpoint = queue.OpenCheckpoint(*job);
+        try
+        {
+            if(!miopen::RunTuningJob(handle, *job, checkpoint))
+            {
+                // The job stays claimed, to be resumed by this or another worker.
+                std::cout << "Tuning job " << *job << " stopped after " << checkpoint.Size()
+                          << " configs" << std::endl;
+                break;
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            // Failed jobs are closed, or the worker would claim them again.
+            std::cout << "Tuning job " << *job << " FAILED: " << ex.what() << std::endl;
+            rc = EXIT_FAILURE;
+        }
+        queue.Complete(*job, options.worker);
+        ++done;
+    }
+
+    std::cout << "Worker " << options.worker << " completed " << done << " tuning jobs"
+              << std::endl;
+    return rc;
+}
+
+inline int MergeTuning(const TuningOptions& options, const miopen::TuningQueue& queue)
+{
+    auto results = queue.GetResults();
+    std::cout << std::fixed << std::setprecision(4);
+    for(const auto& result : results)
+    {
+        std::cout << result.solver << ' ' << result.config << ' ' << result.time << " ms";
+        if(result.slices_left != 0)
+            std::cout << ", " << result.slices_left << " slices left";
+        std::cout << std::endl;
+    }
+
+    // Results of unfinished searches are kept until all their slices are done.
+    if(!options.partial)
+    {
+        results.erase(std::remove_if(results.begin(),
+                                     results.end(),
+                                     [](const auto& result) { return result.slices_left != 0; }),
+                      results.end());
+    }
+
+    const auto stored = miopen::StoreTuningResults(miopen::deref(SharedDriverHandle()), results);
+    std::cout << "Stored " << stored << " of " << results.size() << " tuning results" << std::endl;
+    return stored == results.size() ? 0 : EXIT_FAILURE;
+}
+
+inline int ShowTuningStatus(const miopen::TuningQueue& queue)
+{
+    auto counts = std::map<miopen::TuningJobState, int>{};
+    std::cout << std::setw(8) << "job" << std::setw(10) << "slice" << std::setw(10) << "state"
+              << std::setw(12) << "evaluated"
+              << "  solver, worker" << std::endl;
+    for(const auto& status : queue.GetStatus())
+    {
+        const auto state = status.state == miopen::TuningJobState::Done      ? "done"
+                           : status.state == miopen::TuningJobState::Running ? "running"
+                                                                              : "pending";
+        ++counts[status.state];
+        std::cout << std::setw(8) << status.job.id << std::setw(10)
+                  << std::to_string(status.job.slice + 1) + '/' + std::to_string(status.job.slices)
+                  << std::setw(10) << state << std::setw(12) << status.evaluated << "  "
+                  << status.job.solver << ", " << status.worker << std::endl;
+    }
+    std::cout << "pending " << counts[miopen::TuningJobState::Pending] << ", running "
+              << counts[miopen::TuningJobState::Running] << ", done "
+              << counts[miopen::TuningJobState::Done] << std::endl;
+    return 0;
+}
+
+inline int RunTuning(int argc,
+                     char* argv[],
+                     const std::function<Driver*(const std::string&)>& make_driver)
+{
+    const auto options      = ParseTuningOptions(argc, argv);
+    const auto needs_device = options.command != "status";
+    if(needs_device)
+        SharedDriverHandle() = CreateDriverHandle();
+
+    int rc = 0;
+    try
+    {
+        auto queue =
+            miopen::TuningQueue{options.directory, std::chrono::seconds{options.lease_seconds}};
+        if(options.command == "enqueue")
+            rc = EnqueueTuning(options, queue, make_driver);
+        else if(options.command == "work")
+            rc = WorkTuning(options, queue);
+        else if(options.command == "merge")
+            rc = MergeTuning(options, queue);
+        else
+            rc = ShowTuningStatus(queue);
+    }
+    catch(const std::exception& ex)
+    {
+        std::cout << "Tuning " << options.command << " FAILED: " << ex.what() << std::endl;
+        rc = EXIT_FAILURE;
+    }
+
+    if(needs_device)
+    {
+        miopenDestroy(SharedDriverHandle());
+        SharedDriverHandle() = nullptr;
+    }
+    return rc;
+}
+
+#endif // GUARD_MIOPEN_TUNING_DRIVER_HPP
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARMSTART_DRIVER_HPP
+#define GUARD_MIOPEN_WARMSTART_DRIVER_HPP
+
+#include "batch_driver.hpp"
+#include "driver.hpp"
+#include "timer.hpp"
+
+#include <miopen/miopen.h>
+#include <miopen/miopen_internal.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Warm start mode compiles and caches the kernels of a whole model before its first run:
+//
+//   ./bin/MIOpenDriver --warmstart manifest.txt
+//
+// Each line of the manifest is either a Find 2.0 problem serialized as JSON (a line starting with
+// '{') or a driver command line, as in batch mode. Empty lines and lines starting with '#' are
+// ignored. The problems of all the lines are prepared together with miopenWarmStartProblems() on
+// one handle, and the time spent on each of them is reported.
+
+struct WarmStartEntry
+{
+    std::string source;
+    miopenProblem_t problem;
+};
+
+// Appends the problems of one manifest line. Returns non-zero if the line cannot be used.
+inline int ParseWarmStartLine(const std::string& line,
+                              const std::function<Driver*(const std::string&)>& make_driver,
+                              std::vector<WarmStartEntry>& layers)
+{
+    const auto first = line.find_first_not_of(" \t");
+    if(first != std::string::npos && line[first] == '{')
+    {
+        miopenProblem_t problem;
+        if(miopenLoadProblem(&problem, line.data() + first, line.size() - first) !=
+           miopenStatusSuccess)
+        {
+            std::cout << "Cannot load the problem: " << line << std::endl;
+            return EXIT_FAILURE;
+        }
+        layers.push_back({line.substr(first), problem});
+        return 0;
+    }
+
+    const auto args = SplitBatchCommand(line);
+    if(args.empty())
+        return 0;
+
+    const auto command = miopen::JoinStrings(args, " ");
+    const auto drv     = std::unique_ptr<Driver>{make_driver(args.front())};
+    if(drv == nullptr)
+    {
+        std::cout << "Incorrect BaseArg: " << args.front() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::vector<char*> argv;
+    std::string driver_name = "MIOpenDriver";
+    argv.push_back(&driver_name[0]);
+    auto args_copy = args;
+    for(auto& arg : args_copy)
+        argv.push_back(&arg[0]);
+
+    drv->AddCmdLineArgs();
+    const int rc = drv->ParseCmdLineArgs(static_cast<int>(argv.size()), argv.data());
+    if(rc != 0 || drv->GetandSetData() != 0)
+    {
+        std::cout << "Cannot parse: " << command << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const auto problems = drv->MakeProblems();
+    if(problems.empty())
+        std::cout << "No problems to warm up for: " << command << std::endl;
+    for(const auto problem : problems)
+        layers.push_back({command, problem});
+    return 0;
+}
+
+inline int RunWarmStart(int argc,
+                        char* argv[],
+                        const std::function<Driver*(const std::string&)>& make_driver)
+{
+    if(argc < 3)
+    {
+        printf("FAILED: No manifest file given for --warmstart\n");
+        Usage();
+    }
+
+    std::ifstream manifest(argv[2]);
+    if(!manifest)
+    {
+        std::cout << "Cannot open the manifest file: " << argv[2] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    SharedDriverHandle() = CreateDriverHandle();
+
+    std::vector<WarmStartEntry> layers;
+    int cumulative_rc = 0;
+    std::string line;
+
+    while(std::getline(manifest, line))
+        cumulative_rc |= ParseWarmStartLine(line, make_driver, layers);
+
+    std::vector<miopenProblem_t> problems;
+    for(const auto& layer : layers)
+        problems.push_back(layer.problem);
+
+    std::vector<float> layer_times(problems.size());
+    float compile_time = 0.f;
+
+    Timer t;
+    t.start();
+    const auto status = miopenWarmStartProblems(SharedDriverHandle(),
+                                                problems.data(),
+                                                problems.size(),
+                                                layer_times.data(),
+                                                &compile_time);
+    t.stop();
+
+    if(status != miopenStatusSuccess)
+    {
+        std::cout << "miopenWarmStartProblems() FAILED, status = " << status << std::endl;
+        cumulative_rc |= EXIT_FAILURE;
+    }
+    else
+    {
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << std::setw(8) << "layer" << std::setw(16) << "ms"
+                  << "  source" << std::endl;
+        for(std::size_t i = 0; i < layers.size(); ++i)
+        {
+            std::cout << std::setw(8) << i << std::setw(16);
+            if(layer_times[i] < 0)
+            {
+                std::cout << "FAILED";
+                cumulative_rc |= EXIT_FAILURE;
+            }
+            else
+            {
+                std::cout << layer_times[i];
+            }
+            std::cout << "  " << layers[i].source << std::endl;
+        }
+        std::cout << "Compilation of all layers: " << compile_time << " ms" << std::endl;
+        std::cout << "Warm start: " << t.gettime_ms() << " ms" << std::endl;
+    }
+
+    for(const auto problem : problems)
+        miopenDestroyProblem(problem);
+    miopenDestroy(SharedDriverHandle());
+    SharedDriverHandle() = nullptr;
+
+    return cumulative_rc;
+}
+
+#endif // GUARD_MIOPEN_WARMSTART_DRIVER_HPP
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/content_hash.hpp>
+#include <miopen/md5.hpp>
+
+#include <driver.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace content_hash {
+
+/// Compares the throughput of md5 and ContentHash on kernel-sized blobs. Pass an unpacked
+/// .kdb (e.g. from the installed db directory) with --file to hash real code objects.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(file, "file");
+    }
+
+    void run()
+    {
+        std::vector<std::pair<std::string, std::string>> blobs;
+        for(const auto size : {std::size_t{256}, std::size_t{64} << 10, std::size_t{4} << 20})
+            blobs.emplace_back(std::to_string(size) + " bytes", MakeBlob(size));
+        if(!file.empty())
+        {
+            std::ifstream in(file, std::ios::binary);
+            if(!in)
+            {
+                std::cout << "Cannot read " << file << std::endl;
+                return;
+            }
+            blobs.emplace_back(file, std::string{std::istreambuf_iterator<char>(in), {}});
+        }
+
+        std::cout << std::left << std::setw(32) << "blob" << std::right << std::setw(16)
+                  << "md5 MB/s" << std::setw(16) << "xxh64 MB/s" << std::endl;
+
+        for(const auto& blob : blobs)
+        {
+            const auto md5_rate  = Rate(blob.second, [](const auto& s) { return md5(s); });
+            const auto hash_rate = Rate(blob.second, [](const auto& s) { return ContentHash(s); });
+            std::cout << std::left << std::setw(32) << blob.first << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(16) << md5_rate << std::setw(16)
+                      << hash_rate << std::endl;
+        }
+    }
+
+private:
+    int iterations   = 20;
+    std::string file = "";
+
+    static std::string MakeBlob(std::size_t size)
+    {
+        std::string blob(size, 0);
+        for(std::size_t i = 0; i < size; i++)
+            blob[i] = static_cast<char>((i * 2654435761u) >> 13);
+        return blob;
+    }
+
+    template <class F>
+    double Rate(const std::string& blob, const F& hash) const
+    {
+        // Small blobs are hashed more often to get measurable times.
+        const auto repeats = iterations * std::max<std::size_t>(1, (1 << 20) / blob.size());
+
+        std::size_t sum  = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < repeats; i++)
+            sum += hash(blob).size();
+        const auto seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        SaveDeadCode(sum);
+
+        return static_cast<double>(blob.size()) * repeats / seconds / (1 << 20);
+    }
+
+    static void SaveDeadCode(std::size_t value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+};
+
+} // namespace content_hash
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::content_hash::SpeedTestDriver>(argc, argv);
+    return 0;
+}
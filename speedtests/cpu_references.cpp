@@ -0,0 +1,339 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include "../driver/miopen_BatchNormHost.hpp"
+#include "../driver/mloNormHost.hpp"
+#include "../driver/mloPoolingHost.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace cpu_references {
+
+/// Measures the CPU references MIOpenDriver verifies batch normalization, LRN and pooling
+/// against. For large problems they take most of the verification time.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(lengths, "lengths");
+    }
+
+    void run()
+    {
+        if(lengths.size() != 4)
+        {
+            std::cout << "Expected NCHW lengths" << std::endl;
+            return;
+        }
+
+        n = lengths[0];
+        c = lengths[1];
+        h = lengths[2];
+        w = lengths[3];
+
+        const std::size_t size         = std::size_t(n) * c * h * w;
+        const std::size_t channel_size = std::size_t(c) * h * w;
+
+        x.resize(size);
+        dy.resize(size);
+        y.resize(size);
+        scale_f.resize(channel_size);
+        for(std::size_t i = 0; i < size; i++)
+        {
+            x[i]  = static_cast<float>(i % 17) / 17.f + 0.1f;
+            dy[i] = static_cast<float>(i % 13) / 13.f - 0.5f;
+        }
+        for(std::size_t i = 0; i < channel_size; i++)
+            scale_f[i] = static_cast<float>(i % 7) / 7.f + 0.5f;
+        scale.assign(scale_f.begin(), scale_f.end());
+        bias.assign(channel_size, 0.1);
+        mean.resize(channel_size);
+        inv_var.resize(channel_size);
+        dscale.resize(channel_size);
+        dbias.resize(channel_size);
+
+        std::cout << std::left << std::setw(32) << "reference" << std::right << std::setw(12)
+                  << "ms/call" << std::endl;
+
+        RunBatchNorm(false);
+        RunBatchNorm(true);
+        RunLRN(MLO_LRN_WITHIN_CHANNEL);
+        RunLRN(MLO_LRN_ACROSS_CHANNELS);
+        RunPooling(false);
+        RunPooling(true);
+    }
+
+private:
+    int iterations              = 5;
+    std::vector<int> lengths    = {32, 64, 56, 56};
+    int n                       = 0;
+    int c                       = 0;
+    int h                       = 0;
+    int w                       = 0;
+    std::vector<float> x        = {};
+    std::vector<float> dy       = {};
+    std::vector<float> scale_f  = {};
+    std::vector<double> y       = {};
+    std::vector<double> scale   = {};
+    std::vector<double> bias    = {};
+    std::vector<double> mean    = {};
+    std::vector<double> inv_var = {};
+    std::vector<double> dscale  = {};
+    std::vector<double> dbias   = {};
+
+    void RunBatchNorm(bool spatial)
+    {
+        const std::string mode = spatial ? "spatial" : "per-activation";
+        const double eps       = 1e-5;
+
+        Report("bn fwd train " + mode, [&]() {
+            std::vector<double> run_mean(mean.size(), 0.), run_var(mean.size(), 1.);
+            const auto f = spatial ? miopenBNFwdTrainSpatialRunHost<float, double>
+                                   : miopenBNFwdTrainPerActivationRunHost<float, double>;
+            f(n,
+              c,
+              1,
+              h,
+              w,
+              x.data(),
+              y.data(),
+              scale.data(),
+              bias.data(),
+              eps,
+              true,
+              true,
+              mean.data(),
+              inv_var.data(),
+              run_mean.data(),
+              run_var.data(),
+              0.1);
+        });
+
+        Report("bn fwd infer " + mode, [&]() {
+            const auto f = spatial ? miopenBNFwdInferSpatialRunHost<float, double>
+                                   : miopenBNFwdInferPerActivationRunHost<float, double>;
+            f(n,
+              c,
+              1,
+              h,
+              w,
+              x.data(),
+              y.data(),
+              scale.data(),
+              bias.data(),
+              eps,
+              false,
+              mean.data(),
+              inv_var.data());
+        });
+
+        Report("bn bwd " + mode, [&]() {
+            std::fill(dscale.begin(), dscale.end(), 0.);
+            std::fill(dbias.begin(), dbias.end(), 0.);
+            const auto f = spatial ? miopenBNBwdSpatialRunHost<float, double, float>
+                                   : miopenBNBwdPerActivationRunHost<float, double, float>;
+            f(n,
+              c,
+              1,
+              h,
+              w,
+              x.data(),
+              dy.data(),
+              y.data(),
+              scale_f.data(),
+              dscale.data(),
+              dbias.data(),
+              eps,
+              false,
+              mean.data(),
+              inv_var.data());
+        });
+    }
+
+    void RunLRN(int region)
+    {
+        const std::string mode = region == MLO_LRN_ACROSS_CHANNELS ? "across" : "within";
+        const int local_area = 5;
+        const int pad        = (local_area - 1) / 2;
+        const double alpha   = 1e-4;
+        const double beta    = 0.75;
+        const double K       = 1.;
+        const int w_stride   = w;
+        const int c_stride   = h * w;
+        const int n_stride   = c * h * w;
+
+        std::vector<double> lrn_scale(y.size());
+
+        Report("lrn fwd " + mode, [&]() {
+            mloLRNForwardRunHost<float, double>(true,
+                                                region,
+                                                pad,
+                                                local_area,
+                                                alpha / local_area,
+                                                alpha,
+                                                beta,
+                                                K,
+                                                n,
+                                                c,
+                                                c,
+                                                h,
+                                                w,
+                                                w_stride,
+                                                c_stride,
+                                                n_stride,
+                                                h,
+                                                w,
+                                                w_stride,
+                                                c_stride,
+                                                n_stride,
+                                                w_stride,
+                                                c_stride,
+                                                n_stride,
+                                                x.data(),
+                                                lrn_scale.data(),
+                                                y.data());
+        });
+
+        const std::vector<float> top(y.begin(), y.end());
+        const std::vector<float> top_scale(lrn_scale.begin(), lrn_scale.end());
+        std::vector<double> dx(y.size());
+
+        Report("lrn bwd " + mode, [&]() {
+            mloLRNBackwardRunHost<float, double>(region,
+                                                 pad,
+                                                 local_area,
+                                                 alpha / local_area,
+                                                 alpha,
+                                                 beta,
+                                                 K,
+                                                 n,
+                                                 c,
+                                                 c,
+                                                 h,
+                                                 w,
+                                                 w_stride,
+                                                 c_stride,
+                                                 n_stride,
+                                                 w_stride,
+                                                 c_stride,
+                                                 n_stride,
+                                                 h,
+                                                 w,
+                                                 w_stride,
+                                                 c_stride,
+                                                 n_stride,
+                                                 w_stride,
+                                                 c_stride,
+                                                 n_stride,
+                                                 w_stride,
+                                                 c_stride,
+                                                 n_stride,
+                                                 top.data(),
+                                                 dy.data(),
+                                                 top_scale.data(),
+                                                 x.data(),
+                                                 dx.data());
+        });
+    }
+
+    /// Average pooling backward with a 3x3 window, stride 2 and padding 1.
+    void RunPooling(bool nhwc)
+    {
+        const std::string layout = nhwc ? "NHWC" : "NCHW";
+        const std::size_t out_h  = (h - 1) / 2 + 1;
+        const std::size_t out_w  = (w - 1) / 2 + 1;
+
+        const auto make_desc = [&](std::size_t height, std::size_t width) {
+            const auto lengths = std::vector<std::size_t>{
+                static_cast<std::size_t>(n), static_cast<std::size_t>(c), height, width};
+            if(!nhwc)
+                return miopen::TensorDescriptor{miopenFloat, lengths};
+            const auto strides =
+                std::vector<std::size_t>{height * width * c, 1, width * c, std::size_t(c)};
+            return miopen::TensorDescriptor{miopenFloat, lengths, strides};
+        };
+
+        auto bot                            = make_desc(h, w);
+        auto top                            = make_desc(out_h, out_w);
+        const miopenTensorDescriptor_t bot_ = &bot;
+        const miopenTensorDescriptor_t top_ = &top;
+
+        std::vector<double> dx(y.size());
+        pooling_math_stats stats;
+
+        Report("pooling bwd avg " + layout, [&]() {
+            mloPoolingBackwardRunHost<float, double>(MLO_POOLING_OP_AVE,
+                                                     1,
+                                                     0,
+                                                     1,
+                                                     3,
+                                                     1,
+                                                     2,
+                                                     3,
+                                                     1,
+                                                     2,
+                                                     bot_,
+                                                     top_,
+                                                     dx.data(),
+                                                     dy.data(),
+                                                     nullptr,
+                                                     stats);
+        });
+    }
+
+    template <class F>
+    void Report(const std::string& name, const F& f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; i++)
+            f();
+        const auto ms = std::chrono::duration<double, std::milli>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+        std::cout << std::left << std::setw(32) << name << std::right << std::setw(12)
+                  << std::fixed << std::setprecision(2) << ms / iterations << std::endl;
+    }
+};
+
+} // namespace cpu_references
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::cpu_references::SpeedTestDriver>(argc, argv);
+    return 0;
+}
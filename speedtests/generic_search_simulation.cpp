@@ -0,0 +1,239 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/any_solver.hpp>
+#include <miopen/config.h>
+#include <miopen/conv/context.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <driver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace generic_search_simulation {
+
+/// Runs the auto-tuning of every applicable tunable solver (or of "solver") for the forward
+/// convolutions over the test/network_data.hpp shapes against a cost model instead of the GPU,
+/// and compares the search strategies (or only "strategy"). Build with the HIPNOGPU backend and
+/// select the simulated device with MIOPEN_DEVICE_ARCH and MIOPEN_DEVICE_CU. The analytic model
+/// is used unless "recorded" names a file written with MIOPEN_DEBUG_TUNING_RECORD on a device.
+///
+/// Every search evaluates all configs (unless MIOPEN_DEBUG_TUNING_ITERATIONS_MAX is set). The
+/// best time of the random search is the exhaustive optimum, and each strategy is rated by the
+/// evaluations it needs to get within "within" percent of it, and by the quality (optimum over
+/// best time) it reaches within a budget of N configs.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(max_problems, "max-problems");
+        add(solver_name, "solver");
+        add(strategy_name, "strategy");
+        add(within, "within");
+        add(recorded, "recorded");
+        add(roughness, "roughness");
+        add(noise, "noise");
+    }
+
+    void run()
+    {
+        auto exec_ctx = ExecutionContext{&get_handle()};
+        exec_ctx.DetectRocm();
+        exec_ctx.do_search = true;
+        exec_ctx.db_update = true;
+
+        auto model = std::unique_ptr<solver::SearchCostModel>{};
+        if(recorded.empty())
+            model = std::make_unique<solver::AnalyticCostModel>(
+                get_handle().GetMaxComputeUnits(), 1.0f, roughness, noise);
+        else
+            model = std::make_unique<solver::RecordedCostModel>(recorded);
+
+        auto trace                 = solver::SearchTrace{*model};
+        exec_ctx.search_cost_model = &trace;
+
+        const auto db_dir = boost::filesystem::temp_directory_path() /
+                            boost::filesystem::unique_path("miopen-tuning-sim-%%%%-%%%%");
+        boost::filesystem::create_directories(db_dir);
+        auto db = PerformanceDb{"", (db_dir / "tuning.udb").string()};
+
+        auto results = std::vector<Result>{};
+        for(const auto& name : {"random", "local", "evolution", "surrogate"})
+        {
+            if(name == std::string{"random"} || strategy_name.empty() || name == strategy_name)
+                results.push_back({name});
+        }
+
+        auto problems = 0;
+        for(const auto& in : get_inputs())
+        {
+            for(const auto& wei : get_weights())
+            {
+                if(problems >= max_problems)
+                    break;
+                if(in[1] != wei[1] || in[2] < wei[2] || in[3] < wei[3])
+                    continue;
+
+                const auto x    = TensorDescriptor{miopenFloat, in};
+                const auto w    = TensorDescriptor{miopenFloat, wei};
+                const auto conv = ConvolutionDescriptor{};
+                const auto y    = conv.GetForwardOutputTensor(x, w);
+                const auto conv_problem =
+                    conv::ProblemDescription{x, w, y, conv, conv::Direction::Forward};
+                conv_problem.SetupFloats(exec_ctx);
+
+                const auto problem = ProblemDescription{conv_problem};
+                problems++;
+
+                for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+                {
+                    if(!solver_name.empty() && id.ToString() != solver_name)
+                        continue;
+                    const auto solver = id.GetSolver();
+                    if(solver.IsEmpty() || !solver.IsTunable() ||
+                       !solver.IsApplicable(ConvolutionContext{exec_ctx}, problem))
+                        continue;
+
+                    // The random search runs first and finds the optimum.
+                    auto optimum = 0.0f;
+                    for(auto& result : results)
+                    {
+                        auto ctx            = ConvolutionContext{exec_ctx};
+                        ctx.search_strategy = result.strategy;
+
+                        trace.Clear();
+                        std::ignore = solver.FindSolution(ctx, problem, db, AnyInvokeParams{});
+
+                        const auto stats = trace.GetStats();
+                        if(result.strategy == "random")
+                            optimum = stats.best;
+                        if(stats.evaluations_best == 0 || optimum <= 0.0f)
+                            break;
+                        result.Add(trace, stats, optimum, within);
+                    }
+                }
+            }
+        }
+
+        boost::filesystem::remove_all(db_dir);
+
+        std::cout << "problems: " << problems << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << std::setw(10) << "strategy" << std::setw(10) << "searches" << std::setw(12)
+                  << "configs/s" << std::setw(12) << "reached" << std::setw(12) << "evals"
+                  << std::setw(12) << "share";
+        for(const auto budget : Result::budgets)
+            std::cout << std::setw(11) << "after " << std::setw(4) << budget;
+        std::cout << std::endl;
+        for(const auto& result : results)
+            result.Print(std::cout);
+        std::cout << "reached: % of searches within " << within
+                  << "% of the optimum, evals/share: evaluations (share of configs) to get there"
+                  << std::endl;
+    }
+
+private:
+    struct Result
+    {
+        static constexpr std::array<std::size_t, 4> budgets = {8, 32, 128, 512};
+
+        std::string strategy;
+        int searches          = 0;
+        int reached           = 0;
+        std::size_t evaluated = 0;
+        double seconds        = 0.0;
+        double evaluations    = 0.0;
+        double share          = 0.0;
+        std::array<double, 4> quality{};
+
+        void Add(const solver::SearchTrace& trace,
+                 const solver::SearchTraceStats& stats,
+                 float optimum,
+                 float percent)
+        {
+            searches++;
+            evaluated += stats.evaluated;
+            seconds += stats.seconds;
+
+            const auto needed = trace.EvaluationsTo(optimum * (1.0f + percent / 100));
+            if(needed != 0)
+            {
+                reached++;
+                evaluations += needed;
+                share += static_cast<double>(needed) / stats.evaluated;
+            }
+            for(auto i = std::size_t{0}; i < budgets.size(); ++i)
+            {
+                const auto best = trace.BestAfter(budgets[i]);
+                quality[i] += best > 0.0f ? optimum / best : 0.0;
+            }
+        }
+
+        void Print(std::ostream& stream) const
+        {
+            const auto mean = [](double total, int count) {
+                return count > 0 ? total / count : 0.0;
+            };
+            stream << std::setw(10) << strategy << std::setw(10) << searches << std::setw(12)
+                   << (seconds > 0.0 ? evaluated / seconds : 0.0) << std::setw(12)
+                   << mean(100.0 * reached, searches) << std::setw(12) << mean(evaluations, reached)
+                   << std::setw(12) << mean(share, reached);
+            for(const auto q : quality)
+                stream << std::setw(15) << mean(q, searches);
+            stream << std::endl;
+        }
+    };
+
+    int max_problems          = 20;
+    std::string solver_name   = "";
+    std::string strategy_name = "";
+    float within              = 5.0f;
+    std::string recorded      = "";
+    float roughness           = 0.5f;
+    float noise               = 0.0f;
+};
+
+} // namespace generic_search_simulation
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::generic_search_simulation::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/handle.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/shared_program_cache.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace handle_creation {
+
+/// Measures what a new handle costs until it can launch its first kernels, as when a server
+/// creates one handle per stream. Run it with MIOPEN_SHARED_PROGRAM_CACHE unset and set to
+/// compare per-handle program loading with the process-wide shared program cache.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(handles, "handles"); }
+
+    void run()
+    {
+        std::cout << "shared program cache: "
+                  << (SharedProgramCache::IsEnabled() ? "enabled" : "disabled") << std::endl;
+        std::cout << std::setw(8) << "handle" << std::setw(16) << "create ms" << std::setw(16)
+                  << "kernels ms" << std::endl;
+
+        // Handles stay alive together, as they would in a server.
+        std::vector<std::unique_ptr<Handle>> alive;
+        for(auto i = 0; i < handles; i++)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            alive.push_back(std::make_unique<Handle>());
+            const auto created = std::chrono::steady_clock::now();
+            LoadKernels(*alive.back());
+            const auto loaded = std::chrono::steady_clock::now();
+
+            std::cout << std::setw(8) << i << std::fixed << std::setprecision(3) << std::setw(16)
+                      << Milliseconds(created - start) << std::setw(16)
+                      << Milliseconds(loaded - created) << std::endl;
+        }
+
+        std::cout << "shared programs: " << SharedProgramCache::Instance().Size() << std::endl;
+    }
+
+private:
+    int handles = 8;
+
+    static double Milliseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    static void LoadKernels(const Handle& handle)
+    {
+        const std::vector<size_t> vld = {256, 1, 1};
+        const std::vector<size_t> vgd = {256 * handle.GetMaxComputeUnits(), 1, 1};
+
+        for(const auto type : {miopenFloat, miopenHalf, miopenBFloat16})
+        {
+            // Empty algorithm and config keep the kernel out of the per-handle kernel map, so
+            // only the program caches are exercised.
+            handle.AddKernel("",
+                             "",
+                             "MIOpenCheckNumerics.cl",
+                             "MIOpenCheckNumerics",
+                             vld,
+                             vgd,
+                             GetDataTypeKernelParams(type));
+        }
+    }
+};
+
+} // namespace handle_creation
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::handle_creation::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/kernel.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace miopen {
+namespace kernel_sources {
+
+constexpr const char* exit_at_main = "--exit-at-main";
+
+/// Measures the start-up time of a process linked against the library, lookup time and
+/// resident memory growth caused by accessing the kernel sources embedded into the library.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(kernel, "kernel");
+        add(startups, "startups");
+    }
+
+    void run()
+    {
+        std::cout << "Process start-up: " << MeasureStartup() << " us" << std::endl;
+
+        const auto rss_before = GetRssKb();
+
+        const auto first = Measure([&]() { return GetKernelSrc(kernel).size(); });
+        std::cout << "First lookup: " << first << " us" << std::endl;
+
+        std::size_t total = 0;
+        const auto all    = Measure([&]() {
+            for(const auto& inc : GetKernelIncList())
+                total += GetKernelInc(inc).size();
+            return total;
+        });
+        std::cout << "All includes lookup: " << all << " us, " << total << " bytes" << std::endl;
+
+        const auto repeated = Measure([&]() {
+            std::size_t size = 0;
+            for(auto i = 0; i < iterations; i++)
+                size += GetKernelSrc(kernel).size();
+            return size;
+        });
+        std::cout << "Repeated lookup: " << repeated / iterations << " us per call" << std::endl;
+
+        std::cout << "RSS growth: " << GetRssKb() - rss_before << " KiB" << std::endl;
+    }
+
+private:
+    int iterations     = 100000;
+    std::string kernel = "MIOpenSoftmax.cl";
+    int startups       = 20;
+
+    /// Runs this executable up to main and back, which loads the library and runs its static
+    /// initializers. The index of the embedded kernels used to be built there.
+    double MeasureStartup() const
+    {
+        const auto self = std::string{"/proc/self/exe"};
+        const auto time = Measure([&]() {
+            for(auto i = 0; i < startups; i++)
+            {
+                const auto pid = fork();
+                if(pid == 0)
+                {
+                    execl(self.c_str(), self.c_str(), exit_at_main, nullptr);
+                    _exit(1);
+                }
+                auto status = 0;
+                waitpid(pid, &status, 0);
+            }
+            return std::size_t{0};
+        });
+        return time / startups;
+    }
+
+    template <class F>
+    static double Measure(const F& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        SaveDeadCode(f());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+                   .count() *
+               .001;
+    }
+
+    static void SaveDeadCode(std::size_t value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+
+    static long GetRssKb()
+    {
+        long pages = 0;
+        long rss   = 0;
+        std::ifstream statm("/proc/self/statm");
+        statm >> pages >> rss;
+        return rss * (sysconf(_SC_PAGESIZE) / 1024);
+    }
+};
+
+} // namespace kernel_sources
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    if(argc == 2 && std::string{argv[1]} == miopen::kernel_sources::exit_at_main)
+        return 0;
+    test_drive<miopen::kernel_sources::SpeedTestDriver>(argc, argv);
+    return 0;
+}
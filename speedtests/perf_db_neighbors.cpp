@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/perf_db_neighbors.hpp>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace perf_db_neighbors {
+
+/// Times building the perf-db neighbor index and looking up the nearest records of unseen
+/// problems, for a perf-db of random forward convolutions tuned for a few solvers.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(records, "records");
+        add(solvers, "solvers");
+        add(lookups, "lookups");
+        add(neighbors, "neighbors");
+    }
+
+    void run()
+    {
+        auto rng      = std::mt19937{42};
+        auto contents = DbContents{};
+        while(contents.size() < static_cast<std::size_t>(records))
+        {
+            auto& record = contents[Key(MakeProblem(rng))];
+            for(auto s = 0; s < solvers; s++)
+                record["Solver" + std::to_string(s)] = std::to_string(rng());
+        }
+
+        auto start       = std::chrono::steady_clock::now();
+        const auto index = PerfDbNeighborIndex{contents};
+        const auto build = std::chrono::steady_clock::now() - start;
+
+        auto queries = std::vector<conv::ProblemDescription>{};
+        for(auto i = 0; i < lookups; i++)
+            queries.push_back(MakeProblem(rng));
+
+        auto found = std::size_t{0};
+        start      = std::chrono::steady_clock::now();
+        for(auto i = 0; i < lookups; i++)
+            found += index.Find(queries[i], "Solver" + std::to_string(i % solvers), neighbors)
+                         .size();
+        const auto lookup = std::chrono::steady_clock::now() - start;
+
+        SaveDeadCode(found);
+
+        const auto ms = [](auto duration) {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        };
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "entries:       " << index.Size() << std::endl;
+        std::cout << "build ms:      " << ms(build) << std::endl;
+        std::cout << "us per lookup: " << 1000 * ms(lookup) / std::max(lookups, 1) << std::endl;
+    }
+
+private:
+    int records   = 20000;
+    int solvers   = 8;
+    int lookups   = 10000;
+    int neighbors = 4;
+
+    static conv::ProblemDescription MakeProblem(std::mt19937& rng)
+    {
+        const auto pick = [&](std::vector<std::size_t> values) {
+            return values[std::uniform_int_distribution<std::size_t>{0, values.size() - 1}(rng)];
+        };
+
+        const auto filter = pick({1, 3, 5, 7});
+        const auto pad    = static_cast<int>(filter / 2);
+        const auto stride = static_cast<int>(pick({1, 1, 2}));
+        const auto hw     = pick({7, 14, 17, 28, 35, 56, 73, 112, 149, 224});
+
+        const auto x = TensorDescriptor{miopenFloat, {pick({1, 2, 3, 8, 16, 24, 32, 64, 128}),
+                                                      pick({3, 16, 32, 64, 96, 128, 256, 512}),
+                                                      hw,
+                                                      hw}};
+        const auto w = TensorDescriptor{
+            miopenFloat, {pick({16, 32, 64, 128, 192, 256, 512, 1024}), x.GetLengths()[1], filter,
+                          filter}};
+        const auto conv = ConvolutionDescriptor{{pad, pad}, {stride, stride}, {1, 1}};
+        const auto y    = conv.GetForwardOutputTensor(x, w);
+        return conv::ProblemDescription{x, w, y, conv, conv::Direction::Forward};
+    }
+
+    static std::string Key(const conv::ProblemDescription& problem)
+    {
+        auto ss = std::ostringstream{};
+        problem.Serialize(ss);
+        return ss.str();
+    }
+
+    static void SaveDeadCode(std::size_t value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+};
+
+} // namespace perf_db_neighbors
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perf_db_neighbors::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <driver.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace ramdb_lease {
+
+/// Runs concurrent reader processes against one user db while another process keeps updating
+/// it, once validating the cache on every lookup and once with the lock file generation lease.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(readers, "readers");
+        add(seconds, "seconds");
+        add(write_interval_ms, "write-interval-ms");
+    }
+
+    void run()
+    {
+        const auto dir  = TmpDir{"ramdb_lease"};
+        const auto path = (dir.path / "lease.udb").string();
+
+        {
+            auto db = PlainTextDb{path, false};
+            for(auto i = 0; i < keys; i++)
+            {
+                auto record = DbRecord{Key(i)};
+                record.SetValues("solver", Field{"", i});
+                db.StoreRecord(record);
+            }
+        }
+
+        std::cout << std::left << std::setw(16) << "mode" << std::right << std::setw(20)
+                  << "lookups/s" << std::setw(12) << "writes" << std::endl;
+
+        // Children evaluate the lease time lazily, after the fork.
+        setenv("MIOPEN_DEBUG_RAMDB_LEASE_MS", "0", 1);
+        Report("validate", Run(path));
+        unsetenv("MIOPEN_DEBUG_RAMDB_LEASE_MS");
+        Report("lease", Run(path));
+    }
+
+private:
+    static constexpr int keys = 100;
+
+    int readers           = 4;
+    int seconds           = 2;
+    int write_interval_ms = 50;
+
+    struct Result
+    {
+        long long lookups = 0;
+        long long writes  = 0;
+    };
+
+    struct Field
+    {
+        std::string prefix;
+        long long value;
+
+        void Serialize(std::ostream& s) const { s << prefix << value; }
+    };
+
+    static Field Key(long long i) { return {"key", i}; }
+
+    void Report(const std::string& mode, const Result& result) const
+    {
+        std::cout << std::left << std::setw(16) << mode << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(20)
+                  << static_cast<double>(result.lookups) / seconds << std::setw(12)
+                  << result.writes << std::endl;
+    }
+
+    Result Run(const std::string& path) const
+    {
+        int fds[2];
+        if(pipe(fds) != 0)
+        {
+            std::cout << "Cannot create a pipe" << std::endl;
+            std::terminate();
+        }
+
+        auto children = std::vector<pid_t>{};
+        for(auto i = 0; i <= readers; i++)
+        {
+            const auto pid = fork();
+            if(pid == 0)
+            {
+                close(fds[0]);
+                const auto count = i == readers ? Write(path) : Read(path);
+                const auto value = static_cast<long long>(count) * (i == readers ? -1 : 1);
+                const auto written = write(fds[1], &value, sizeof(value));
+                _exit(written == sizeof(value) ? 0 : 1);
+            }
+            children.push_back(pid);
+        }
+        close(fds[1]);
+
+        auto result = Result{};
+        auto value  = 0LL;
+        while(read(fds[0], &value, sizeof(value)) == sizeof(value))
+            (value < 0 ? result.writes : result.lookups) += value < 0 ? -value : value;
+        close(fds[0]);
+
+        for(const auto pid : children)
+            waitpid(pid, nullptr, 0);
+        return result;
+    }
+
+    long long Read(const std::string& path) const
+    {
+        auto& db       = RamDb::GetCached(path, false);
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds{seconds};
+        auto lookups   = 0LL;
+        auto found     = 0LL;
+
+        while(std::chrono::steady_clock::now() < end)
+        {
+            for(auto i = 0; i < keys; i++, lookups++)
+                found += db.FindRecord(Key(i)) ? 1 : 0;
+        }
+
+        SaveDeadCode(found);
+        return lookups;
+    }
+
+    long long Write(const std::string& path) const
+    {
+        auto& db       = RamDb::GetCached(path, false);
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds{seconds};
+        auto writes    = 0LL;
+
+        while(std::chrono::steady_clock::now() < end)
+        {
+            auto record = DbRecord{Key(writes % keys)};
+            record.SetValues("writer", Field{"", writes});
+            db.UpdateRecord(record);
+            writes++;
+            std::this_thread::sleep_for(std::chrono::milliseconds{write_interval_ms});
+        }
+
+        return writes;
+    }
+
+    static void SaveDeadCode(long long value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+};
+
+} // namespace ramdb_lease
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::ramdb_lease::SpeedTestDriver>(argc, argv);
+    return 0;
+}
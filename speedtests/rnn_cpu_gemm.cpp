@@ -0,0 +1,172 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+
+#include <driver.hpp>
+
+#include <cpu_gemm.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace rnn_cpu_gemm {
+
+struct GemmShape
+{
+    std::string name;
+    std::size_t m;
+    std::size_t n;
+    std::size_t k;
+    bool transpose_a;
+    bool transpose_b;
+};
+
+/// Compares the blocked host GEMM the RNN references verify against with the naive triple
+/// loop it replaced, on the GEMMs an LSTM/GRU reference issues per layer and time step.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(hidden, "hidden");
+        add(batch, "batch");
+        add(seq_len, "seq-len");
+    }
+
+    void run()
+    {
+        const std::size_t h  = hidden;
+        const std::size_t b  = batch;
+        const std::size_t bt = batch * seq_len;
+
+        const std::vector<GemmShape> shapes = {
+            {"lstm fwd input", bt, 4 * h, h, false, true},
+            {"lstm fwd hidden", b, 4 * h, h, false, true},
+            {"lstm bwd data", bt, h, 4 * h, false, false},
+            {"lstm bwd weights", 4 * h, h, bt, true, false},
+            {"gru fwd hidden", b, 3 * h, h, false, true},
+        };
+
+        std::cout << std::left << std::setw(20) << "gemm" << std::right << std::setw(16)
+                  << "naive ms" << std::setw(16) << "blocked ms" << std::setw(12) << "match"
+                  << std::endl;
+
+        for(const auto& shape : shapes)
+        {
+            const auto lda = shape.transpose_a ? shape.m : shape.k;
+            const auto ldb = shape.transpose_b ? shape.k : shape.n;
+            std::vector<float> a(shape.m * shape.k);
+            std::vector<float> b_mat(shape.k * shape.n);
+            for(std::size_t i = 0; i < a.size(); i++)
+                a[i] = static_cast<float>(i % 17) / 17.f - 0.5f;
+            for(std::size_t i = 0; i < b_mat.size(); i++)
+                b_mat[i] = static_cast<float>(i % 13) / 13.f - 0.5f;
+
+            std::vector<float> naive(shape.m * shape.n, 1.f);
+            std::vector<float> blocked(shape.m * shape.n, 1.f);
+
+            const auto naive_ms = Time([&] {
+                Naive(shape, a.data(), lda, b_mat.data(), ldb, naive.data());
+            });
+            const auto blocked_ms = Time([&] {
+                cpu_gemm(shape.m,
+                         shape.n,
+                         shape.k,
+                         a.data(),
+                         lda,
+                         shape.transpose_a,
+                         b_mat.data(),
+                         ldb,
+                         shape.transpose_b,
+                         blocked.data(),
+                         shape.n,
+                         1,
+                         1);
+            });
+
+            std::cout << std::left << std::setw(20) << shape.name << std::right << std::fixed
+                      << std::setprecision(3) << std::setw(16) << naive_ms << std::setw(16)
+                      << blocked_ms << std::setw(12) << (naive == blocked ? "yes" : "NO")
+                      << std::endl;
+        }
+    }
+
+private:
+    int iterations = 5;
+    int hidden     = 512;
+    int batch      = 32;
+    int seq_len    = 50;
+
+    template <class F>
+    double Time(F f) const
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; i++)
+            f();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                         start)
+                   .count() /
+               iterations;
+    }
+
+    /// The loop RNN_mm_cpu used before it moved to cpu_gemm.
+    static void Naive(const GemmShape& shape,
+                      const float* a,
+                      std::size_t lda,
+                      const float* b,
+                      std::size_t ldb,
+                      float* c)
+    {
+        for(std::size_t i = 0; i < shape.m; ++i)
+        {
+            for(std::size_t j = 0; j < shape.n; ++j)
+            {
+                double acc = 0;
+                for(std::size_t p = 0; p < shape.k; ++p)
+                {
+                    const auto a_ip = shape.transpose_a ? a[p * lda + i] : a[i * lda + p];
+                    const auto b_pj = shape.transpose_b ? b[j * ldb + p] : b[p * ldb + j];
+                    acc += a_ip * b_pj;
+                }
+                c[i * shape.n + j] = c[i * shape.n + j] + acc;
+            }
+        }
+    }
+};
+
+} // namespace rnn_cpu_gemm
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::rnn_cpu_gemm::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/rnn_plan.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace rnn_gemm_batching {
+
+struct RNNConfig
+{
+    std::string name;
+    bool lstm;
+    int hy_h;
+    int layers;
+    bool bidirectional;
+    std::vector<int> batches;
+};
+
+/// Counts the GEMM launches of RNNForwardInference for typical LSTM/GRU shapes with and
+/// without folding the independent per-time-step GEMMs, and measures the host-side cost
+/// of the folding. The GEMMs come from RNNHiddenGemms, as queued by the inference path.
+/// Folding only applies when they resolve to a backend with a native strided batched GEMM.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(iterations, "iterations"); }
+
+    void run()
+    {
+        const std::vector<RNNConfig> configs = {
+            {"lstm h512 l1 uni b32", true, 512, 1, false, std::vector<int>(50, 32)},
+            {"lstm h512 l2 bi b32", true, 512, 2, true, std::vector<int>(50, 32)},
+            {"lstm h1024 l3 bi b16", true, 1024, 3, true, std::vector<int>(100, 16)},
+            {"lstm h512 l2 bi var", true, 512, 2, true, DescendingBatches(50, 32)},
+            {"gru h512 l1 uni b32", false, 512, 1, false, std::vector<int>(50, 32)},
+            {"gru h1024 l2 bi b64", false, 1024, 2, true, std::vector<int>(100, 64)},
+            {"gru h512 l2 bi var", false, 512, 2, true, DescendingBatches(50, 32)},
+        };
+
+        std::cout << "strided batched GEMM: "
+                  << (IsGemmStridedBatchedNative(miopenFloat, GemmBackend_t::miopengemm)
+                          ? "native, GEMMs are folded"
+                          : "sequential, GEMMs are not folded")
+                  << std::endl;
+        std::cout << std::left << std::setw(24) << "config" << std::right << std::setw(12)
+                  << "gemms" << std::setw(12) << "launches" << std::setw(16) << "ns/schedule"
+                  << std::endl;
+
+        for(const auto& config : configs)
+        {
+            const auto steps   = HiddenGemms(config);
+            const auto gemms   = CountInputGemms(config) + Count(steps, false);
+            const auto batched = CountInputGemms(config) + Count(steps, true);
+
+            const auto start = std::chrono::steady_clock::now();
+            std::size_t sum  = 0;
+            for(auto i = 0; i < iterations; i++)
+                for(const auto& step : steps)
+                    sum += BatchIndependentGemms(step).size();
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+            SaveDeadCode(sum);
+
+            std::cout << std::left << std::setw(24) << config.name << std::right
+                      << std::setw(12) << gemms << std::setw(12) << batched << std::setw(16)
+                      << ns / iterations << std::endl;
+        }
+    }
+
+private:
+    int iterations = 1000;
+
+    static std::vector<int> DescendingBatches(int seq_len, int max_batch)
+    {
+        std::vector<int> batches(seq_len);
+        for(auto i = 0; i < seq_len; i++)
+            batches[i] = max_batch - (i * (max_batch - 1)) / seq_len;
+        return batches;
+    }
+
+    static std::size_t CountInputGemms(const RNNConfig& config) { return config.layers; }
+
+    static std::size_t Count(const std::vector<std::vector<RNNGemmCall>>& steps, bool batched)
+    {
+        return std::accumulate(
+            steps.begin(), steps.end(), std::size_t{0}, [&](auto sum, const auto& step) {
+                return sum + (batched ? BatchIndependentGemms(step).size() : step.size());
+            });
+    }
+
+    /// GEMMs queued per layer and time step by RNNForwardInference with hx present.
+    static std::vector<std::vector<RNNGemmCall>> HiddenGemms(const RNNConfig& config)
+    {
+        static const float hx_storage        = 0;
+        static const float workspace_storage = 0;
+        static const float w_storage         = 0;
+
+        const auto seq_len    = static_cast<int>(config.batches.size());
+        const auto& in_n      = config.batches;
+        const auto bi         = config.bidirectional ? 2 : 1;
+        const auto hy_h       = config.hy_h;
+        const auto hy_n       = in_n.front();
+        const auto hy_stride  = hy_h * bi * (config.lstm ? 6 : 4);
+        const auto wei_stride = hy_h * bi * (config.lstm ? 4 : 3);
+        const auto in_h       = hy_h;
+        const auto batch_n    = std::accumulate(in_n.begin(), in_n.end(), 0);
+
+        std::vector<std::vector<RNNGemmCall>> steps;
+        for(auto li = 0; li < config.layers; li++)
+        {
+            const auto layer =
+                RNNHiddenGemmLayer{miopenFloat,
+                                   bi,
+                                   hy_h,
+                                   hy_n,
+                                   hy_h * (config.lstm ? 4 : 3),
+                                   bi * hy_h * (config.lstm ? 5 : 3),
+                                   hy_stride,
+                                   hy_h,
+                                   li * batch_n * hy_stride,
+                                   li * hy_n * bi * hy_h,
+                                   in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride,
+                                   DataCast(&hx_storage),
+                                   DataCast(&w_storage),
+                                   DataCast(const_cast<float*>(&workspace_storage))};
+
+            auto bacc   = 0;
+            auto baccbi = batch_n;
+            for(auto ti = 0; ti < seq_len; ti++)
+            {
+                baccbi -= in_n.at(seq_len - 1 - ti);
+                steps.push_back(RNNHiddenGemms(layer, in_n, bacc, baccbi, ti));
+                bacc += in_n.at(ti);
+            }
+        }
+        return steps;
+    }
+
+    static void SaveDeadCode(std::size_t value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+};
+
+} // namespace rnn_gemm_batching
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::rnn_gemm_batching::SpeedTestDriver>(argc, argv);
+    return 0;
+}
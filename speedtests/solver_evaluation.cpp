@@ -0,0 +1,117 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/config.h>
+#include <miopen/conv/context.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/invoke_params.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem_description.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace solver_evaluation {
+
+/// Times the solver enumeration of first-call Find (applicability checks and solution
+/// construction, without searching) for the forward convolutions over the test/network_data.hpp
+/// shapes. Build with the HIPNOGPU backend to measure only host work, and run it with
+/// MIOPEN_DEBUG_SOLVER_EVALUATION_THREADS unset and set to compare serial and concurrent
+/// evaluation. The solution count must not depend on the setting.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver() { add(max_problems, "max-problems"); }
+
+    void run()
+    {
+        auto exec_ctx = ExecutionContext{&get_handle()};
+        exec_ctx.DetectRocm();
+
+        auto problems  = 0;
+        auto solutions = std::size_t{0};
+        auto elapsed   = std::chrono::steady_clock::duration{};
+
+        for(const auto& in : get_inputs())
+        {
+            for(const auto& wei : get_weights())
+            {
+                if(problems >= max_problems)
+                    break;
+                if(in[1] != wei[1] || in[2] < wei[2] || in[3] < wei[3])
+                    continue;
+
+                const auto x    = TensorDescriptor{miopenFloat, in};
+                const auto w    = TensorDescriptor{miopenFloat, wei};
+                const auto conv = ConvolutionDescriptor{};
+                const auto y    = conv.GetForwardOutputTensor(x, w);
+                const auto conv_problem =
+                    conv::ProblemDescription{x, w, y, conv, conv::Direction::Forward};
+                conv_problem.SetupFloats(exec_ctx);
+
+                const auto ctx        = ConvolutionContext{exec_ctx};
+                const auto problem    = ProblemDescription{conv_problem};
+                const auto invoke_ctx = AnyInvokeParams{};
+
+                const auto start = std::chrono::steady_clock::now();
+                solutions += FindAllDirectSolutions(ctx, problem, invoke_ctx).size();
+                solutions += FindAllImplicitGemmSolutions(ctx, problem, invoke_ctx).size();
+                solutions += FindAllWinogradSolutions(ctx, problem, invoke_ctx).size();
+                solutions += FindAllFFTSolutions(ctx, problem, invoke_ctx).size();
+                solutions += FindAllImplicitGemmWorkspaceSizes(ctx, problem).size();
+                elapsed += std::chrono::steady_clock::now() - start;
+                problems++;
+            }
+        }
+
+        const auto ms = std::chrono::duration<double, std::milli>(elapsed).count();
+        std::cout << "threads:     " << GetSolverEvaluationThreads() << std::endl;
+        std::cout << "problems:    " << problems << std::endl;
+        std::cout << "solutions:   " << solutions << std::endl;
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "total ms:    " << ms << std::endl;
+        std::cout << "ms/problem:  " << (problems > 0 ? ms / problems : 0.0) << std::endl;
+    }
+
+private:
+    int max_problems = 200;
+};
+
+} // namespace solver_evaluation
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::solver_evaluation::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/config.h>
+#include <miopen/tensor.hpp>
+
+#include <driver.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace miopen {
+namespace tensor_descriptor {
+
+/// Measures the cost of creating, copying and querying tensor descriptors.
+struct SpeedTestDriver : public test_driver
+{
+    SpeedTestDriver()
+    {
+        add(iterations, "iterations");
+        add(lengths, "lengths");
+    }
+
+    void run()
+    {
+        const auto create = Measure([&]() {
+            std::size_t sum = 0;
+            for(auto i = 0; i < iterations; i++)
+                sum += TensorDescriptor{miopenFloat, lengths}.GetElementSpace();
+            return sum;
+        });
+        std::cout << "Create: " << create / iterations << " ns per descriptor" << std::endl;
+
+        const auto desc = TensorDescriptor{miopenFloat, lengths};
+        const auto copy = Measure([&]() {
+            std::size_t sum = 0;
+            for(auto i = 0; i < iterations; i++)
+            {
+                const auto copied = desc;
+                sum += copied.GetLengths().size();
+            }
+            return sum;
+        });
+        std::cout << "Copy: " << copy / iterations << " ns per descriptor" << std::endl;
+
+        const auto query = Measure([&]() {
+            std::size_t sum = 0;
+            for(auto i = 0; i < iterations; i++)
+                sum += desc.GetElementSpace() + desc.GetElementSize() + desc.IsPacked();
+            return sum;
+        });
+        std::cout << "Query: " << query / iterations << " ns per call" << std::endl;
+
+        const auto index = Measure([&]() {
+            std::size_t sum = 0;
+            for(auto i = 0; i < iterations; i++)
+                sum += desc.GetIndex(i % 2, 1, 1, 1);
+            return sum;
+        });
+        std::cout << "GetIndex: " << index / iterations << " ns per call" << std::endl;
+    }
+
+private:
+    int iterations                   = 1000000;
+    std::vector<std::size_t> lengths = {64, 256, 56, 56};
+
+    template <class F>
+    static double Measure(const F& f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        SaveDeadCode(f());
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    static void SaveDeadCode(std::size_t value)
+    {
+        static const std::string dead_code_saver;
+
+        if(dead_code_saver.data() == nullptr)
+        {
+            std::cout << value << std::endl;
+            std::terminate();
+        }
+    }
+};
+
+} // namespace tensor_descriptor
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::tensor_descriptor::SpeedTestDriver>(argc, argv);
+    return 0;
+}
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/miopen.h>
+#include <miopen/miopen_internal.h>
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
@@ -35,6 +36,7 @@
 #include <miopen/solution.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/type_name.hpp>
+#include <miopen/warm_start.hpp>
 
 #include <nlohmann/json.hpp>
 
@@ -70,6 +72,54 @@ miopenStatus_t miopenSetProblemTensorDescriptor(miopenProblem_t problem,
         [&] { miopen::deref(problem).RegisterTensorDescriptor(id, miopen::deref(descriptor)); });
 }
 
+miopenStatus_t miopenLoadProblem(miopenProblem_t* problem, const char* data, size_t size)
+{
+    MIOPEN_LOG_FUNCTION(problem, data, size);
+
+    return miopen::try_([&] {
+        if(data == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Data parameter should not be a nullptr.");
+
+        auto json               = nlohmann::json::parse(data, data + size);
+        auto& problem_ptr_deref = miopen::deref(problem);
+        problem_ptr_deref       = new miopen::Problem{json.get<miopen::Problem>()};
+    });
+}
+
+miopenStatus_t miopenWarmStartProblems(miopenHandle_t handle,
+                                       const miopenProblem_t* problems,
+                                       size_t numProblems,
+                                       float* layerTimes,
+                                       float* compileTime)
+{
+    MIOPEN_LOG_FUNCTION(handle, problems, numProblems, layerTimes, compileTime);
+
+    return miopen::try_([&] {
+        auto& handle_deref = miopen::deref(handle);
+
+        auto problems_deref = std::vector<miopen::Problem>{};
+        problems_deref.reserve(numProblems);
+        for(std::size_t i = 0; i < numProblems; ++i)
+            problems_deref.push_back(miopen::deref(problems[i]));
+
+        const auto report = miopen::WarmStart(handle_deref, problems_deref);
+
+        if(layerTimes != nullptr)
+        {
+            for(std::size_t i = 0; i < numProblems; ++i)
+            {
+                const auto& layer = report.layers[i];
+                layerTimes[i] =
+                    layer.error.empty() ? static_cast<float>(layer.resolve_ms + layer.prepare_ms)
+                                        : -1.f;
+            }
+        }
+
+        if(compileTime != nullptr)
+            *compileTime = static_cast<float>(report.compile_ms);
+    });
+}
+
 miopenStatus_t miopenCreateFindOptions(miopenFindOptions_t* options)
 {
     MIOPEN_LOG_FUNCTION(options);
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/caching_allocator.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace miopen {
+
+std::ostream& operator<<(std::ostream& os, const CachingAllocatorStats& stats)
+{
+    return os << "requested " << stats.requested_bytes << ", in use " << stats.in_use_bytes
+              << ", cached " << stats.cached_bytes << ", peak reserved "
+              << stats.peak_reserved_bytes << ", hits " << stats.hits << ", misses "
+              << stats.misses << ", releases " << stats.releases << ", fragmentation "
+              << stats.Fragmentation();
+}
+
+CachingAllocator::CachingAllocator(miopenAllocatorFunction backing_allocator_,
+                                   miopenDeallocatorFunction backing_deallocator_,
+                                   void* backing_context_,
+                                   std::size_t limit_,
+                                   StreamGetter get_stream_)
+    : backing_allocator(backing_allocator_),
+      backing_deallocator(backing_deallocator_),
+      backing_context(backing_context_),
+      limit(limit_),
+      get_stream(std::move(get_stream_))
+{
+    if(backing_allocator == nullptr || backing_deallocator == nullptr)
+        MIOPEN_THROW(miopenStatusBadParm, "Caching allocator needs a backing allocator");
+}
+
+CachingAllocator::~CachingAllocator()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    MIOPEN_LOG_I("Caching allocator: " << stats);
+    if(!in_use.empty())
+        MIOPEN_LOG_W(in_use.size() << " buffers outlive the caching allocator");
+    TrimUnsafe();
+}
+
+std::size_t CachingAllocator::SizeClass(std::size_t size)
+{
+    constexpr std::size_t min_class = 256;
+    constexpr std::size_t max_class = std::numeric_limits<std::size_t>::max() / 2 + 1;
+
+    if(size <= min_class)
+        return min_class;
+    if(size > max_class)
+        return size;
+
+    auto size_class = min_class;
+    while(size_class < size)
+        size_class <<= 1;
+    return size_class;
+}
+
+void* CachingAllocator::Allocate(std::size_t size)
+{
+    if(size == 0)
+        return nullptr;
+
+    const auto size_class = SizeClass(size);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto stream = CurrentStream();
+
+    void* ptr     = nullptr;
+    const auto it = free_lists.find({stream, size_class});
+    if(it != free_lists.end() && !it->second.empty())
+    {
+        ptr = it->second.back();
+        it->second.pop_back();
+        stats.cached_bytes -= size_class;
+        ++stats.hits;
+    }
+    else
+    {
+        if(stats.ReservedBytes() + size_class > limit)
+            TrimUnsafe();
+        ptr = AllocateBackingUnsafe(size_class);
+        if(ptr == nullptr)
+            return nullptr;
+        ++stats.misses;
+    }
+
+    in_use.emplace(ptr, Block{size_class, size, stream});
+    stats.in_use_bytes += size_class;
+    stats.requested_bytes += size;
+    stats.peak_reserved_bytes = std::max(stats.peak_reserved_bytes, stats.ReservedBytes());
+    return ptr;
+}
+
+void CachingAllocator::Deallocate(void* ptr)
+{
+    if(ptr == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = in_use.find(ptr);
+    if(it == in_use.end())
+        MIOPEN_THROW(miopenStatusInternalError, "Caching allocator does not own the buffer");
+
+    const auto block = it->second;
+    in_use.erase(it);
+    stats.in_use_bytes -= block.size_class;
+    stats.requested_bytes -= block.requested;
+
+    if(detached || stats.ReservedBytes() + block.size_class > limit)
+    {
+        backing_deallocator(backing_context, ptr);
+        stats.releases++;
+        return;
+    }
+
+    free_lists[{block.stream, block.size_class}].push_back(ptr);
+    stats.cached_bytes += block.size_class;
+}
+
+void CachingAllocator::Trim()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    TrimUnsafe();
+}
+
+void CachingAllocator::Detach()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    detached   = true;
+    get_stream = nullptr;
+    TrimUnsafe();
+}
+
+CachingAllocatorStats CachingAllocator::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void* CachingAllocator::AllocateCallback(void* self, std::size_t size)
+{
+    return static_cast<CachingAllocator*>(self)->Allocate(size);
+}
+
+void CachingAllocator::DeallocateCallback(void* self, void* ptr)
+{
+    static_cast<CachingAllocator*>(self)->Deallocate(ptr);
+}
+
+void* CachingAllocator::AllocateBackingUnsafe(std::size_t size_class)
+{
+    if(stats.cached_bytes == 0)
+        return backing_allocator(backing_context, size_class);
+
+    // Cached buffers of other sizes or streams may be what stands between us and success.
+    try
+    {
+        auto ptr = backing_allocator(backing_context, size_class);
+        if(ptr != nullptr)
+            return ptr;
+    }
+    catch(const Exception&)
+    {
+    }
+
+    MIOPEN_LOG_I2("Caching allocator: retrying allocation of " << size_class
+                                                               << " after trimming the cache");
+    TrimUnsafe();
+    return backing_allocator(backing_context, size_class);
+}
+
+void CachingAllocator::TrimUnsafe()
+{
+    for(auto& free_list : free_lists)
+    {
+        for(auto ptr : free_list.second)
+        {
+            backing_deallocator(backing_context, ptr);
+            stats.releases++;
+        }
+    }
+    free_lists.clear();
+    stats.cached_bytes = 0;
+}
+
+} // namespace miopen
@@ -31,6 +31,11 @@
 #include <miopen/tensor.hpp>
 #include <miopen/datatype.hpp>
 
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <vector>
+
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_CHECK_NUMERICS)
@@ -53,59 +58,70 @@ struct CheckNumericsResult
     int hasInf  = 0;
 };
 
-bool checkNumericsImpl(
-    const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
-{
-    int numElements = dDesc.GetElementSize();
-
-    // TODO - some constants we should get from the device:
-    const int blockSize             = 256;
-    const auto numBlocks            = handle.GetMaxComputeUnits() * 6;
-    const size_t numGlobalWorkItems = blockSize * numBlocks;
-
-    const int computeStats = (mode & CheckNumerics::ComputeStats);
+// Sub-buffer offsets have to be aligned for OpenCL, so each result gets a padded slot.
+constexpr std::size_t CheckNumericsSlotSize = 256;
+// Checks that can be in flight on one handle before their results have to be read back.
+constexpr std::size_t CheckNumericsPoolSize = 256;
 
-    CheckNumericsResult abnormal_h;
+struct CheckNumericsPool
+{
+    struct Check
+    {
+        TensorDescriptor desc;
+        ConstData_t data;
+        bool isInput;
+        int mode;
+        std::size_t batch;
+    };
 
-    auto abnormal_d =
-        handle.Create(sizeof(CheckNumericsResult)); // TODO - someday avoid slow malloc/free here
-    handle.WriteTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+    Allocator::ManageDataPtr results = nullptr;
+    std::vector<Check> pending;
+    std::size_t batches = 0;
+};
 
-    std::string params            = GetDataTypeKernelParams(dDesc.GetType());
-    std::string program_name      = "MIOpenCheckNumerics.cl";
-    std::string kernel_name       = "MIOpenCheckNumerics";
-    const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
-    const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
-    handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, params)(
-        data, numElements, abnormal_d.get(), computeStats);
+static CheckNumericsPool& GetCheckNumericsPool(const Handle& handle)
+{
+    if(!handle.check_numerics_pool)
+    {
+        auto pool     = std::make_shared<CheckNumericsPool>();
+        pool->results = handle.Create(CheckNumericsPoolSize * CheckNumericsSlotSize);
+        handle.check_numerics_pool = pool;
+    }
+    return *handle.check_numerics_pool;
+}
 
-    handle.ReadTo(&abnormal_h, abnormal_d, sizeof(CheckNumericsResult));
+static bool ReportCheckNumerics(const CheckNumericsPool::Check& check,
+                                const CheckNumericsResult& result)
+{
+    const int numElements  = check.desc.GetElementSize();
+    const int computeStats = (check.mode & CheckNumerics::ComputeStats);
 
-    bool isAbnormal = (abnormal_h.hasNan != 0) || (abnormal_h.hasInf != 0);
+    bool isAbnormal = (result.hasNan != 0) || (result.hasInf != 0);
 
-    if(((mode & CheckNumerics::Info) != 0) || (((mode & CheckNumerics::Warn) != 0) && isAbnormal))
+    if(((check.mode & CheckNumerics::Info) != 0) ||
+       (((check.mode & CheckNumerics::Warn) != 0) && isAbnormal))
     {
         MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
-                   (isInput ? "INPUT " : "OUTPUT")
-                       << " ptr=" << data << " zeros=" << abnormal_h.hasZero
-                       << " nans=" << abnormal_h.hasNan << " infs=" << abnormal_h.hasInf << "  {"
-                       << dDesc << "}");
+                   (check.isInput ? "INPUT " : "OUTPUT")
+                       << " ptr=" << check.data << " zeros=" << result.hasZero
+                       << " nans=" << result.hasNan << " infs=" << result.hasInf << "  {"
+                       << check.desc << "}");
         if(computeStats != 0)
         {
             assert(numElements != 0);
             MIOPEN_LOG((isAbnormal ? miopen::LoggingLevel::Warning : miopen::LoggingLevel::Info),
-                       "Stats: mean=" << (abnormal_h.sum / numElements)
-                                      << " absmean=" << (abnormal_h.absSum / numElements)
-                                      << " min=" << abnormal_h.min << " max=" << abnormal_h.max);
+                       "Stats: mean=" << (result.sum / numElements)
+                                      << " absmean=" << (result.absSum / numElements)
+                                      << " min=" << result.min << " max=" << result.max);
         }
     }
 
     if(isAbnormal)
     {
 
-        if((mode & CheckNumerics::Throw) != 0)
+        if((check.mode & CheckNumerics::Throw) != 0)
         {
-            if(isInput)
+            if(check.isInput)
             {
                 MIOPEN_THROW(miopenStatusInternalError,
                              "abnormal checkNumerics result detected on INPUT");
@@ -116,14 +132,136 @@ bool checkNumericsImpl(
                              "abnormal checkNumerics result detected on OUTPUT");
             }
         }
-        if((mode & CheckNumerics::Abort) != 0)
+        if((check.mode & CheckNumerics::Abort) != 0)
         {
             abort();
         }
     }
 
     return isAbnormal;
-};
+}
+
+// Reads back and reports all pending checks of the handle at once.
+// Returns: true if one of the checks queued by the given batch was abnormal
+static bool DrainCheckNumerics(const Handle& handle, CheckNumericsPool& pool, std::size_t batch)
+{
+    if(pool.pending.empty())
+        return false;
+
+    // Taken off the pool first: the readback finishes the handle, which drains it again.
+    const auto checks = std::move(pool.pending);
+    pool.pending.clear();
+
+    std::vector<char> slots(checks.size() * CheckNumericsSlotSize);
+    handle.ReadTo(slots.data(), pool.results, slots.size());
+
+    // Every check is reported before the first failure is thrown.
+    std::exception_ptr failure;
+    bool isAbnormal = false;
+    for(std::size_t i = 0; i < checks.size(); ++i)
+    {
+        CheckNumericsResult result;
+        std::memcpy(&result, &slots[i * CheckNumericsSlotSize], sizeof(result));
+        try
+        {
+            if(ReportCheckNumerics(checks[i], result) && checks[i].batch == batch)
+                isAbnormal = true;
+        }
+        catch(...)
+        {
+            if(!failure)
+                failure = std::current_exception();
+        }
+    }
+    if(failure)
+        std::rethrow_exception(failure);
+    return isAbnormal;
+}
+
+void FlushCheckNumerics(const Handle& handle)
+{
+    if(handle.check_numerics_pool)
+        DrainCheckNumerics(handle, *handle.check_numerics_pool, 0);
+}
+
+CheckNumericsBatch::CheckNumericsBatch(const Handle& handle_)
+    : CheckNumericsBatch(handle_, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})))
+{
+}
+
+CheckNumericsBatch::CheckNumericsBatch(const Handle& handle_, int mode_)
+    : handle(handle_), mode(mode_), batch(++GetCheckNumericsPool(handle_).batches)
+{
+}
+
+void CheckNumericsBatch::Input(const TensorDescriptor& dDesc, ConstData_t data)
+{
+    Queue(dDesc, data, true);
+}
+
+void CheckNumericsBatch::Output(const TensorDescriptor& dDesc, ConstData_t data)
+{
+    Queue(dDesc, data, false);
+}
+
+void CheckNumericsBatch::Queue(const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
+{
+    auto& pool = GetCheckNumericsPool(handle);
+
+    if(pool.pending.size() == CheckNumericsPoolSize)
+        abnormal |= DrainCheckNumerics(handle, pool, batch);
+
+    if(pool.pending.empty())
+    {
+        // Slots are cleared once per fill of the pool rather than once per check.
+        std::vector<char> slots(CheckNumericsPoolSize * CheckNumericsSlotSize);
+        const CheckNumericsResult initial;
+        for(std::size_t i = 0; i < CheckNumericsPoolSize; ++i)
+            std::memcpy(&slots[i * CheckNumericsSlotSize], &initial, sizeof(initial));
+        handle.WriteTo(slots.data(), pool.results, slots.size());
+    }
+
+    int numElements = dDesc.GetElementSize();
+
+    // TODO - some constants we should get from the device:
+    const int blockSize             = 256;
+    const auto numBlocks            = handle.GetMaxComputeUnits() * 6;
+    const size_t numGlobalWorkItems = blockSize * numBlocks;
+
+    const int computeStats = (mode & CheckNumerics::ComputeStats);
+
+    const auto slot = handle.CreateSubBuffer(pool.results.get(),
+                                             pool.pending.size() * CheckNumericsSlotSize,
+                                             sizeof(CheckNumericsResult));
+
+    std::string params            = GetDataTypeKernelParams(dDesc.GetType());
+    std::string program_name      = "MIOpenCheckNumerics.cl";
+    std::string kernel_name       = "MIOpenCheckNumerics";
+    const std::vector<size_t> vld = {size_t{blockSize}, size_t{1}, size_t{1}};
+    const std::vector<size_t> vgd = {numGlobalWorkItems, size_t{1}, size_t{1}};
+    handle.AddKernel("MIOpenCheckNumerics", "", program_name, kernel_name, vld, vgd, params)(
+        data, numElements, slot.get(), computeStats);
+
+    pool.pending.push_back({dDesc, data, isInput, mode, batch});
+}
+
+bool CheckNumericsBatch::Collect()
+{
+    if((mode & CheckNumerics::Deferred) == 0)
+        abnormal |= DrainCheckNumerics(handle, GetCheckNumericsPool(handle), batch);
+    return abnormal;
+}
+
+bool checkNumericsImpl(
+    const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput)
+{
+    CheckNumericsBatch checks(handle, mode);
+    if(isInput)
+        checks.Input(dDesc, data);
+    else
+        checks.Output(dDesc, data);
+    return checks.Collect();
+}
 
 // Checks data for input
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
@@ -133,12 +271,10 @@ bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, Con
         handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, true);
 }
 
-// Synchronizes to wait for kernel to finish, then checks data for output:
+// Checks data for output, queued behind the kernel that produced it
 // Returns: 1 if abnormal value (inf or nan) detected in specified data, 0 otherwise
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data)
 {
-    handle.Finish();
-
     return checkNumericsImpl(
         handle, static_cast<int>(miopen::Value(MIOPEN_CHECK_NUMERICS{})), dDesc, data, false);
 }
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/content_hash.hpp>
+#include <miopen/md5.hpp>
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::uint64_t prime1 = 11400714785074694791ULL;
+constexpr std::uint64_t prime2 = 14029467366897019727ULL;
+constexpr std::uint64_t prime3 = 1609587929392839161ULL;
+constexpr std::uint64_t prime4 = 9650029242287828579ULL;
+constexpr std::uint64_t prime5 = 2870177450012600261ULL;
+
+const std::string xxh64_tag = "xxh64_";
+
+inline std::uint64_t rotl(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t read64(const unsigned char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint32_t read32(const unsigned char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * prime2;
+    acc = rotl(acc, 31);
+    return acc * prime1;
+}
+
+inline std::uint64_t merge_round(std::uint64_t acc, std::uint64_t value)
+{
+    acc ^= round(0, value);
+    return acc * prime1 + prime4;
+}
+
+} // namespace
+
+// Follows the XXH64 specification; reads assume a little-endian host, like the rest of the
+// on-disk formats.
+std::uint64_t xxh64(const void* data, std::size_t size, std::uint64_t seed)
+{
+    const auto* p         = static_cast<const unsigned char*>(data);
+    const auto* const end = p + size;
+    std::uint64_t h;
+
+    if(size >= 32)
+    {
+        // Four independent lanes, so the multiplies of one stripe overlap.
+        std::uint64_t v1 = seed + prime1 + prime2;
+        std::uint64_t v2 = seed + prime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - prime1;
+        const auto* const limit = end - 32;
+        do
+        {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+            p += 32;
+        } while(p <= limit);
+
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge_round(h, v1);
+        h = merge_round(h, v2);
+        h = merge_round(h, v3);
+        h = merge_round(h, v4);
+    }
+    else
+    {
+        h = seed + prime5;
+    }
+
+    h += size;
+
+    for(; p + 8 <= end; p += 8)
+    {
+        h ^= round(0, read64(p));
+        h = rotl(h, 27) * prime1 + prime4;
+    }
+    if(p + 4 <= end)
+    {
+        h ^= std::uint64_t{read32(p)} * prime1;
+        h = rotl(h, 23) * prime2 + prime3;
+        p += 4;
+    }
+    for(; p < end; ++p)
+    {
+        h ^= *p * prime5;
+        h = rotl(h, 11) * prime1;
+    }
+
+    h ^= h >> 33;
+    h *= prime2;
+    h ^= h >> 29;
+    h *= prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string ContentHash(const std::string& s)
+{
+    std::ostringstream ss;
+    ss << xxh64_tag << std::hex << std::setw(16) << std::setfill('0') << xxh64(s.data(), s.size());
+    return ss.str();
+}
+
+bool VerifyContentHash(const std::string& s, const std::string& hash)
+{
+    if(hash.compare(0, xxh64_tag.size(), xxh64_tag) == 0)
+        return ContentHash(s) == hash;
+    return md5(s) == hash;
+}
+
+} // namespace miopen
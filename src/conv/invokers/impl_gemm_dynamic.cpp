@@ -506,36 +506,36 @@ InvokerFactory MakeImplGemmDynamicForwardXdlopsNHWCInvokerFactory(
     bool need_set_zero                 = config.gemm_k_global_split > 0;
     bool use_fp32_global_split_on_fp16 = config.vector_store == 1 && config.gemm_k_global_split > 0;
 
-    std::vector<OpKernelArg> opArgs;
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(hi);
-    opArgs.emplace_back(wi);
-    opArgs.emplace_back(n / splits_4G);
-    opArgs.emplace_back(k / group);
-    opArgs.emplace_back(c_karg);
-    opArgs.emplace_back(ho);
-    opArgs.emplace_back(wo);
-    opArgs.emplace_back(stride_h);
-    opArgs.emplace_back(stride_w);
-    opArgs.emplace_back(dilation_h);
-    opArgs.emplace_back(dilation_w);
-    opArgs.emplace_back(pad_h);
-    opArgs.emplace_back(pad_w);
-    opArgs.emplace_back(y_karg);
-    opArgs.emplace_back(x_karg);
-    opArgs.emplace_back(group);
-    opArgs.emplace_back(mdiv_0.magic);
-    opArgs.emplace_back(mdiv_1.magic);
-    opArgs.emplace_back(mdiv_2.magic);
-    opArgs.emplace_back(mdiv_3.magic);
-    opArgs.emplace_back(mdiv_4.magic);
-    opArgs.emplace_back(mdiv_5.magic);
-    opArgs.emplace_back(shift_pack_0);
-    opArgs.emplace_back(shift_pack_1);
-    opArgs.emplace_back(config.gemm_k_global_split);
-    opArgs.emplace_back(pack0);
+    // The buffers are set before each launch.
+    auto opArgs = PackKernelArgs(ConstData_t{},
+                                 ConstData_t{},
+                                 ConstData_t{},
+                                 hi,
+                                 wi,
+                                 n / splits_4G,
+                                 k / group,
+                                 c_karg,
+                                 ho,
+                                 wo,
+                                 stride_h,
+                                 stride_w,
+                                 dilation_h,
+                                 dilation_w,
+                                 pad_h,
+                                 pad_w,
+                                 y_karg,
+                                 x_karg,
+                                 group,
+                                 mdiv_0.magic,
+                                 mdiv_1.magic,
+                                 mdiv_2.magic,
+                                 mdiv_3.magic,
+                                 mdiv_4.magic,
+                                 mdiv_5.magic,
+                                 shift_pack_0,
+                                 shift_pack_1,
+                                 config.gemm_k_global_split,
+                                 pack0);
 
     std::vector<std::vector<OpKernelArg>> opArgsTrans;
 
@@ -688,15 +688,13 @@ InvokerFactory MakeImplGemmDynamicForwardXdlopsNHWCInvokerFactory(
                 }
             }
 
-            opArgs[0] = (is_nchw && !trans_input_skippable) ? OpKernelArg(trans_input_buf.get())
-                                                            : OpKernelArg(tensors.in);
-            opArgs[1] = (is_nchw && !trans_weight_skippable) ? OpKernelArg(trans_weight_buf.get())
-                                                             : OpKernelArg(tensors.w);
-
-            opArgs[2] = need_cast ? OpKernelArg(cast_buf.get())
-                                  : ((is_nchw && !trans_output_skippable)
-                                         ? OpKernelArg(trans_output_buf.get())
-                                         : OpKernelArg(tensors.out));
+            opArgs.Set<0>((is_nchw && !trans_input_skippable) ? trans_input_buf.get()
+                                                              : tensors.in);
+            opArgs.Set<1>((is_nchw && !trans_weight_skippable) ? trans_weight_buf.get()
+                                                               : tensors.w);
+            opArgs.Set<2>(need_cast ? cast_buf.get()
+                                    : ((is_nchw && !trans_output_skippable) ? trans_output_buf.get()
+                                                                            : tensors.out));
             ker(opArgs);
             if(handle.IsProfilingEnabled())
                 elapsed += handle.GetKernelTime();
@@ -813,49 +811,46 @@ InvokerFactory MakeImplGemmDynamicBackwardDataXdlopsNHWCInvokerFactory(
         need_set_zero = true;
     need_set_zero |= config.gemm_k_global_split > 0;
 
-    std::vector<OpKernelArg> opArgs;
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(hi);
-    opArgs.emplace_back(wi);
-    opArgs.emplace_back(n_in_1_block);
-    opArgs.emplace_back(k / group);
-    opArgs.emplace_back(c / group);
-    opArgs.emplace_back(ho);
-    opArgs.emplace_back(wo);
-    opArgs.emplace_back(stride_h);
-    opArgs.emplace_back(stride_w);
-    opArgs.emplace_back(dilation_h);
-    opArgs.emplace_back(dilation_w);
-    opArgs.emplace_back(pad_h);
-    opArgs.emplace_back(pad_w);
-    opArgs.emplace_back(y);
-    opArgs.emplace_back(x);
-
-    opArgs.emplace_back(dtile_iy);
-    opArgs.emplace_back(dtile_ix);
-    opArgs.emplace_back(dilation_h / gcd_stride_dilation_h);
-    opArgs.emplace_back(dilation_w / gcd_stride_dilation_w);
-    opArgs.emplace_back(y_tilda);
-    opArgs.emplace_back(x_tilda);
-    opArgs.emplace_back(dtile_h);
-    opArgs.emplace_back(dtile_w);
-    opArgs.emplace_back(dslice_y);
-    opArgs.emplace_back(dslice_x);
-
-    opArgs.emplace_back(h_tilda_slice);
-    opArgs.emplace_back(w_tilda_slice);
-    opArgs.emplace_back(h_tilda_left);
-    opArgs.emplace_back(w_tilda_left);
-    opArgs.emplace_back(group);
-
-    opArgs.emplace_back(mdiv_0.magic);
-    opArgs.emplace_back(mdiv_1.magic);
-    opArgs.emplace_back(mdiv_2.magic);
-    opArgs.emplace_back(mdiv_3.magic);
-    opArgs.emplace_back(shift_pack_0);
-    opArgs.emplace_back(config.gemm_k_global_split);
+    // The buffers are set before each launch.
+    auto opArgs = PackKernelArgs(ConstData_t{},
+                                 ConstData_t{},
+                                 ConstData_t{},
+                                 hi,
+                                 wi,
+                                 n_in_1_block,
+                                 k / group,
+                                 c / group,
+                                 ho,
+                                 wo,
+                                 stride_h,
+                                 stride_w,
+                                 dilation_h,
+                                 dilation_w,
+                                 pad_h,
+                                 pad_w,
+                                 y,
+                                 x,
+                                 dtile_iy,
+                                 dtile_ix,
+                                 dilation_h / gcd_stride_dilation_h,
+                                 dilation_w / gcd_stride_dilation_w,
+                                 y_tilda,
+                                 x_tilda,
+                                 dtile_h,
+                                 dtile_w,
+                                 dslice_y,
+                                 dslice_x,
+                                 h_tilda_slice,
+                                 w_tilda_slice,
+                                 h_tilda_left,
+                                 w_tilda_left,
+                                 group,
+                                 mdiv_0.magic,
+                                 mdiv_1.magic,
+                                 mdiv_2.magic,
+                                 mdiv_3.magic,
+                                 shift_pack_0,
+                                 config.gemm_k_global_split);
 
     std::vector<std::vector<OpKernelArg>> opArgsTrans;
 
@@ -1007,14 +1002,13 @@ InvokerFactory MakeImplGemmDynamicBackwardDataXdlopsNHWCInvokerFactory(
                 }
             }
 
-            opArgs[0] = need_cast ? OpKernelArg(cast_buf.get())
-                                  : ((is_nchw && !trans_input_skippable)
-                                         ? OpKernelArg(trans_input_buf.get())
-                                         : OpKernelArg(tensors.out));
-            opArgs[1] = (is_nchw && !trans_weight_skippable) ? OpKernelArg(trans_weight_buf.get())
-                                                             : OpKernelArg(tensors.w);
-            opArgs[2] = (is_nchw && !trans_output_skippable) ? OpKernelArg(trans_output_buf.get())
-                                                             : OpKernelArg(tensors.in);
+            opArgs.Set<0>(need_cast ? cast_buf.get()
+                                    : ((is_nchw && !trans_input_skippable) ? trans_input_buf.get()
+                                                                           : tensors.out));
+            opArgs.Set<1>((is_nchw && !trans_weight_skippable) ? trans_weight_buf.get()
+                                                               : tensors.w);
+            opArgs.Set<2>((is_nchw && !trans_output_skippable) ? trans_output_buf.get()
+                                                               : tensors.in);
 
             ker(opArgs);
             if(handle.IsProfilingEnabled())
@@ -1133,36 +1127,36 @@ InvokerFactory MakeImplGemmDynamicForwardDlopsNCHWCInvokerFactory(
     shift_pack_0 = magic_div_u32_pack_shift(mdiv_0.shift, mdiv_1.shift, mdiv_2.shift, mdiv_3.shift);
     shift_pack_1 = magic_div_u32_pack_shift(mdiv_4.shift, mdiv_5.shift, mdiv_6.shift, mdiv_7.shift);
 
-    std::vector<OpKernelArg> opArgs;
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(0); // placeholder
-    opArgs.emplace_back(tile_hw);
-    opArgs.emplace_back(ntile_hw);
-    opArgs.emplace_back(hi);
-    opArgs.emplace_back(wi);
-    opArgs.emplace_back(n / splits_4G);
-    opArgs.emplace_back(k / group);
-    opArgs.emplace_back(c / group);
-    opArgs.emplace_back(group);
-    opArgs.emplace_back(ks);
-    opArgs.emplace_back(ho);
-    opArgs.emplace_back(wo);
-    opArgs.emplace_back(stride_hw);
-    opArgs.emplace_back(dilation_hw);
-    opArgs.emplace_back(pad_hw);
-    opArgs.emplace_back(wei_hw);
-    opArgs.emplace_back(move_slice_k);
-    opArgs.emplace_back(mdiv_0.magic);
-    opArgs.emplace_back(mdiv_1.magic);
-    opArgs.emplace_back(mdiv_2.magic);
-    opArgs.emplace_back(mdiv_3.magic);
-    opArgs.emplace_back(mdiv_4.magic);
-    opArgs.emplace_back(mdiv_5.magic);
-    opArgs.emplace_back(mdiv_6.magic);
-    opArgs.emplace_back(mdiv_7.magic);
-    opArgs.emplace_back(shift_pack_0);
-    opArgs.emplace_back(shift_pack_1);
+    // The buffers are set before each launch.
+    auto opArgs = PackKernelArgs(ConstData_t{},
+                                 ConstData_t{},
+                                 ConstData_t{},
+                                 tile_hw,
+                                 ntile_hw,
+                                 hi,
+                                 wi,
+                                 n / splits_4G,
+                                 k / group,
+                                 c / group,
+                                 group,
+                                 ks,
+                                 ho,
+                                 wo,
+                                 stride_hw,
+                                 dilation_hw,
+                                 pad_hw,
+                                 wei_hw,
+                                 move_slice_k,
+                                 mdiv_0.magic,
+                                 mdiv_1.magic,
+                                 mdiv_2.magic,
+                                 mdiv_3.magic,
+                                 mdiv_4.magic,
+                                 mdiv_5.magic,
+                                 mdiv_6.magic,
+                                 mdiv_7.magic,
+                                 shift_pack_0,
+                                 shift_pack_1);
 
     return [=](const std::vector<Kernel>& kernels) mutable {
         return [=](const Handle& handle, const AnyInvokeParams& primitive_parameters) mutable {
@@ -1170,9 +1164,9 @@ InvokerFactory MakeImplGemmDynamicForwardDlopsNCHWCInvokerFactory(
             const auto& tensors     = data_ctx.tensors;
             const auto ker          = handle.Run(kernels[0]);
 
-            opArgs[0] = OpKernelArg(tensors.in);
-            opArgs[1] = OpKernelArg(tensors.w);
-            opArgs[2] = OpKernelArg(tensors.out);
+            opArgs.Set<0>(tensors.in);
+            opArgs.Set<1>(tensors.w);
+            opArgs.Set<2>(tensors.out);
             ker(opArgs);
 
             if(handle.IsProfilingEnabled())
@@ -239,6 +239,9 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    // Bumped before touching the file, so even a failed write invalidates reader leases.
+    lock_file.BumpGeneration();
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
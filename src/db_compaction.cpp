@@ -0,0 +1,642 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_compaction.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/perf_field.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tensor_layout.hpp>
+
+#if MIOPEN_ENABLE_SQLITE
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+
+namespace miopen {
+
+namespace {
+
+/// Everything a perf-db key holds. The input is the input of the direction, i.e. dy for the
+/// backward directions, as in conv::ProblemDescription.
+struct ConvDbFields
+{
+    int spatial_dims = 2;
+    int in_channels  = 0;
+    std::vector<int> in_dhw;
+    std::vector<int> weights_dhw;
+    int out_channels = 0;
+    std::vector<int> out_dhw;
+    int batch = 0;
+    std::vector<int> pads;
+    std::vector<int> strides;
+    std::vector<int> dilations;
+    int bias = 0;
+    std::vector<std::string> layouts;
+    std::vector<miopenDataType_t> data_types;
+    conv::Direction direction = conv::Direction::Forward;
+    int group_count           = 1;
+};
+
+bool ParseInt(const std::string& str, int& value)
+{
+    if(str.empty() || str.size() > 9 ||
+       !std::all_of(str.begin(), str.end(), [](char c) { return std::isdigit(c) != 0; }))
+        return false;
+    value = std::stoi(str);
+    return true;
+}
+
+bool ParseInts(const std::string& str, char sep, std::size_t count, std::vector<int>& values)
+{
+    const auto items = SplitDelim(str, sep);
+    if(items.size() != count)
+        return false;
+    values.resize(count);
+    for(std::size_t i = 0; i < count; ++i)
+        if(!ParseInt(items[i], values[i]))
+            return false;
+    return true;
+}
+
+bool ParseDataTypes(const std::string& str, std::vector<miopenDataType_t>& types)
+{
+    // Longest names first, so that INT8x4 is not taken for INT8.
+    static const miopenDataType_t known[] = {miopenInt8x4,
+                                             miopenInt32,
+                                             miopenFloat,
+                                             miopenHalf,
+                                             miopenBFloat16,
+                                             miopenDouble,
+                                             miopenInt8};
+
+    types.clear();
+    for(std::size_t pos = 0; pos < str.size();)
+    {
+        const auto match = std::find_if(std::begin(known), std::end(known), [&](auto type) {
+            return str.compare(pos, GetDataTypeName(type).size(), GetDataTypeName(type)) == 0;
+        });
+        if(match == std::end(known))
+            return false;
+        types.push_back(*match);
+        pos += GetDataTypeName(*match).size();
+    }
+
+    if(types.size() == 1)
+        types.resize(3, types.front());
+    return types.size() == 3;
+}
+
+bool ParseDirection(const std::string& str, conv::Direction& direction)
+{
+    if(str == "F")
+        direction = conv::Direction::Forward;
+    else if(str == "B")
+        direction = conv::Direction::BackwardData;
+    else if(str == "W")
+        direction = conv::Direction::BackwardWeights;
+    else
+        return false;
+    return true;
+}
+
+bool FieldsFromKey(const std::string& key, ConvDbFields& fields)
+{
+    auto main_part      = key;
+    const auto optional = key.find('_');
+    if(optional != std::string::npos)
+    {
+        main_part             = key.substr(0, optional);
+        const auto group_part = key.substr(optional + 1);
+        if(group_part.size() < 2 || group_part[0] != 'g' ||
+           !ParseInt(group_part.substr(1), fields.group_count))
+            return false;
+    }
+
+    const auto parts = SplitDelim(main_part, '-');
+    if(parts.size() < 4)
+        return false;
+
+    const auto s        = parts[3].find('x') != std::string::npos ? 2 : 3;
+    const auto n_layout = static_cast<int>(parts.size()) - (2 * s + 10);
+    if(n_layout != 1 && n_layout != 3)
+        return false;
+
+    fields.spatial_dims = s;
+    fields.in_dhw.resize(s);
+    fields.out_dhw.resize(s);
+
+    auto ok = ParseInt(parts[0], fields.in_channels);
+    for(auto i = 0; i < s; ++i)
+    {
+        ok = ok && ParseInt(parts[1 + i], fields.in_dhw[i]);
+        ok = ok && ParseInt(parts[s + 3 + i], fields.out_dhw[i]);
+    }
+    ok = ok && ParseInts(parts[s + 1], 'x', s, fields.weights_dhw);
+    ok = ok && ParseInt(parts[s + 2], fields.out_channels);
+    ok = ok && ParseInt(parts[2 * s + 3], fields.batch);
+    ok = ok && ParseInts(parts[2 * s + 4], 'x', s, fields.pads);
+    ok = ok && ParseInts(parts[2 * s + 5], 'x', s, fields.strides);
+    ok = ok && ParseInts(parts[2 * s + 6], 'x', s, fields.dilations);
+    ok = ok && ParseInt(parts[2 * s + 7], fields.bias);
+    ok = ok && ParseDataTypes(parts[parts.size() - 2], fields.data_types);
+    ok = ok && ParseDirection(parts.back(), fields.direction);
+    if(!ok)
+        return false;
+
+    fields.layouts.assign(parts.begin() + 2 * s + 8, parts.end() - 2);
+    if(n_layout == 1)
+        fields.layouts.resize(3, fields.layouts.front());
+    return true;
+}
+
+bool MakeProblem(const ConvDbFields& fields, conv::ProblemDescription& problem)
+{
+    const auto s              = fields.spatial_dims;
+    const auto default_layout = std::string{s == 2 ? "NCHW" : "NCDHW"};
+    const auto is_forward     = fields.direction == conv::Direction::Forward;
+
+    // Weights are KxC/g for every direction, and the input of a backward direction has K
+    // channels.
+    const auto k = is_forward ? fields.out_channels : fields.in_channels;
+    const auto c = is_forward ? fields.in_channels : fields.out_channels;
+    if(fields.group_count < 1 || c % fields.group_count != 0)
+        return false;
+
+    const auto make_lens = [&](int n, int channels, const std::vector<int>& dhw) {
+        auto lens = std::vector<std::size_t>{static_cast<std::size_t>(n),
+                                             static_cast<std::size_t>(channels)};
+        lens.insert(lens.end(), dhw.begin(), dhw.end());
+        return lens;
+    };
+
+    const std::vector<std::size_t> lens[] = {
+        make_lens(fields.batch, fields.in_channels, fields.in_dhw),
+        make_lens(k, c / fields.group_count, fields.weights_dhw),
+        make_lens(fields.batch, fields.out_channels, fields.out_dhw),
+    };
+
+    std::vector<TensorDescriptor> tensors;
+    for(auto i = 0; i < 3; ++i)
+    {
+        const auto& layout = fields.layouts[i];
+        if(layout.size() != default_layout.size() ||
+           !std::is_permutation(layout.begin(), layout.end(), default_layout.begin()))
+            return false;
+
+        auto strides = std::vector<std::size_t>{};
+        tensor_layout_to_strides(lens[i], default_layout, layout, strides);
+        tensors.emplace_back(fields.data_types[i], lens[i], strides);
+    }
+
+    const auto conv = ConvolutionDescriptor{static_cast<std::size_t>(s),
+                                            miopenConvolution,
+                                            miopenPaddingDefault,
+                                            fields.pads,
+                                            fields.strides,
+                                            fields.dilations,
+                                            std::vector<int>(s, 0),
+                                            fields.group_count};
+
+    problem = conv::ProblemDescription{
+        tensors[0], tensors[1], tensors[2], conv, fields.direction, fields.bias};
+    return true;
+}
+
+bool IsSQLite(const std::string& path)
+{
+    const auto extension = boost::filesystem::path(path).extension().string();
+    return extension == ".db" || extension == ".udb";
+}
+
+void EraseEmptyRecords(DbContents& contents)
+{
+    for(auto it = contents.begin(); it != contents.end();)
+        it = it->second.empty() ? contents.erase(it) : std::next(it);
+}
+
+template <class F>
+void EraseInvalid(DbContents::value_type& record, DbCompactionStats& stats, F is_invalid)
+{
+    auto& pairs = record.second;
+    for(auto it = pairs.begin(); it != pairs.end();)
+    {
+        if(!is_invalid(it->first, it->second))
+        {
+            ++it;
+            continue;
+        }
+        MIOPEN_LOG_I2("Invalid values of " << it->first << " at " << record.first << ": "
+                                           << it->second);
+        ++stats.invalid_values;
+        it = pairs.erase(it);
+    }
+}
+
+#if MIOPEN_ENABLE_SQLITE
+/// Values already serialized, in the form SQLitePerfDb stores.
+struct RawValues
+{
+    std::string str;
+    void Serialize(std::ostream& stream) const { stream << str; }
+};
+
+bool FieldsFromConfig(const std::unordered_map<std::string, std::string>& row,
+                      ConvDbFields& fields)
+{
+    const auto get = [&](const std::string& name, int& value) {
+        const auto it = row.find(name);
+        return it != row.end() && ParseInt(it->second, value);
+    };
+
+    auto ok = get("spatial_dim", fields.spatial_dims) &&
+              (fields.spatial_dims == 2 || fields.spatial_dims == 3);
+    if(!ok)
+        return false;
+
+    const auto s   = fields.spatial_dims;
+    const auto dhw = [&](const std::string& prefix, std::vector<int>& values) {
+        values.resize(s);
+        auto dhw_ok = get(prefix + "h", values[s - 2]) && get(prefix + "w", values[s - 1]);
+        return dhw_ok && (s == 2 || get(prefix + "d", values[0]));
+    };
+
+    ok = get("in_channels", fields.in_channels) && get("out_channels", fields.out_channels) &&
+         get("batchsize", fields.batch) && get("bias", fields.bias) &&
+         get("group_count", fields.group_count) && dhw("in_", fields.in_dhw) &&
+         dhw("fil_", fields.weights_dhw) && dhw("pad_", fields.pads) &&
+         dhw("conv_stride_", fields.strides) && dhw("dilation_", fields.dilations);
+
+    const auto layout    = row.find("layout");
+    const auto data_type = row.find("data_type");
+    const auto direction = row.find("direction");
+
+    ok = ok && layout != row.end() && data_type != row.end() && direction != row.end() &&
+         ParseDataTypes(data_type->second, fields.data_types) &&
+         ParseDirection(direction->second, fields.direction);
+    if(!ok)
+        return false;
+
+    fields.layouts.assign(3, layout->second);
+
+    // The output size is not stored. For the backward directions the input is dy, and an output
+    // that strides do not divide evenly is taken as the smallest one.
+    fields.out_dhw.resize(s);
+    for(auto i = 0; i < s; ++i)
+    {
+        const auto extent = fields.dilations[i] * (fields.weights_dhw[i] - 1) + 1;
+        if(fields.strides[i] < 1)
+            return false;
+        fields.out_dhw[i] =
+            fields.direction == conv::Direction::Forward
+                ? (fields.in_dhw[i] + 2 * fields.pads[i] - extent) / fields.strides[i] + 1
+                : (fields.in_dhw[i] - 1) * fields.strides[i] - 2 * fields.pads[i] + extent;
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& stream, const DbCompactionStats& stats)
+{
+    stream << "files: " << stats.files << std::endl;
+    stream << "records read: " << stats.records_read << std::endl;
+    stream << "ill-formed: " << stats.ill_formed << std::endl;
+    stream << "duplicate keys: " << stats.duplicate_keys << std::endl;
+    stream << "overridden entries: " << stats.overridden << std::endl;
+    stream << "unknown solvers: " << stats.unknown_solvers << std::endl;
+    stream << "invalid values: " << stats.invalid_values << std::endl;
+    stream << "unchecked entries: " << stats.unchecked << std::endl;
+    stream << "records written: " << stats.records_written << std::endl;
+    stream << "entries written: " << stats.entries_written << std::endl;
+    return stream;
+}
+
+void ReadTextDb(std::istream& stream, DbContents& contents, DbCompactionStats& stats)
+{
+    auto line = std::string{};
+    while(std::getline(stream, line))
+    {
+        if(line.empty())
+            continue;
+
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0)
+        {
+            ++stats.ill_formed;
+            continue;
+        }
+
+        ++stats.records_read;
+        const auto key = line.substr(0, key_size);
+        const auto it  = contents.find(key);
+        if(it != contents.end())
+            ++stats.duplicate_keys;
+        auto& record = it != contents.end() ? it->second : contents[key];
+
+        for(const auto& pair : SplitDelim(line.substr(key_size + 1), ';'))
+        {
+            const auto id_size = pair.find(':');
+            if(id_size == std::string::npos || id_size == 0)
+            {
+                ++stats.ill_formed;
+                continue;
+            }
+
+            const auto id = pair.substr(0, id_size);
+            if(record.count(id) != 0)
+                ++stats.overridden;
+            record[id] = pair.substr(id_size + 1);
+        }
+    }
+    EraseEmptyRecords(contents);
+}
+
+void WriteTextDb(std::ostream& stream, const DbContents& contents)
+{
+    for(const auto& record : contents)
+    {
+        if(record.second.empty())
+            continue;
+
+        stream << record.first << '=';
+        auto first = true;
+        for(const auto& pair : record.second)
+        {
+            if(!first)
+                stream << ';';
+            first = false;
+            stream << pair.first << ':' << pair.second;
+        }
+        stream << '\n';
+    }
+}
+
+#if MIOPEN_ENABLE_SQLITE
+void ReadSQLitePerfDb(const std::string& path, DbContents& contents, DbCompactionStats& stats)
+{
+    const auto sql = SQLite{path, true};
+    if(!sql.Valid())
+        MIOPEN_THROW(miopenStatusInternalError, "Cannot open database file: " + path);
+
+    // clang-format off
+    const auto rows = sql.Exec(
+        "SELECT config.*, perf_db.solver, perf_db.params "
+        "FROM perf_db "
+        "INNER JOIN config ON perf_db.config = config.id "
+        "ORDER BY perf_db.rowid;");
+    // clang-format on
+
+    auto keys = std::map<std::string, std::string>{};
+    for(const auto& row : rows)
+    {
+        auto fields  = ConvDbFields{};
+        auto problem = conv::ProblemDescription{};
+        if(!FieldsFromConfig(row, fields) || !MakeProblem(fields, problem))
+        {
+            ++stats.ill_formed;
+            continue;
+        }
+
+        auto ss = std::ostringstream{};
+        problem.Serialize(ss);
+        const auto key = ss.str();
+
+        auto& record = contents[key];
+        if(keys.emplace(row.at("id"), key).second)
+            ++stats.records_read;
+
+        const auto& id = row.at("solver");
+        if(record.count(id) != 0)
+            ++stats.overridden;
+        record[id] = row.at("params");
+    }
+}
+
+void WriteSQLitePerfDb(const std::string& path,
+                       const DbContents& contents,
+                       DbCompactionStats& stats)
+{
+    auto db = SQLitePerfDb{path, false};
+    db.sql.Exec("BEGIN TRANSACTION;");
+
+    for(const auto& record : contents)
+    {
+        auto problem = conv::ProblemDescription{};
+        if(!ParsePerfDbKey(record.first, problem))
+        {
+            MIOPEN_LOG_W("Skipping a record that cannot be stored in SQLite: " << record.first);
+            continue;
+        }
+
+        const auto legacy_problem = ProblemDescription{problem};
+        for(const auto& pair : record.second)
+            db.Update(legacy_problem, pair.first, RawValues{pair.second});
+        ++stats.records_written;
+        stats.entries_written += record.second.size();
+    }
+
+    db.sql.Exec("COMMIT;");
+}
+#endif
+
+bool ParsePerfDbKey(const std::string& key, conv::ProblemDescription& problem)
+{
+    auto fields = ConvDbFields{};
+    if(!FieldsFromKey(key, fields) || !MakeProblem(fields, problem))
+        return false;
+
+    // Whatever the key does not pin down exactly, e.g. a layout that the strides cannot tell
+    // apart, shows up as a different key.
+    auto ss = std::ostringstream{};
+    problem.Serialize(ss);
+    return ss.str() == key;
+}
+
+void DropUnknownSolvers(DbContents& contents, DbCompactionStats& stats)
+{
+    for(auto& record : contents)
+    {
+        auto& pairs = record.second;
+        for(auto it = pairs.begin(); it != pairs.end();)
+        {
+            if(solver::Id{it->first}.IsValid())
+            {
+                ++it;
+                continue;
+            }
+            MIOPEN_LOG_I2("Unknown solver " << it->first << " at " << record.first);
+            ++stats.unknown_solvers;
+            it = pairs.erase(it);
+        }
+    }
+    EraseEmptyRecords(contents);
+}
+
+void DropInvalidValues(DbKind kind, Handle* handle, DbContents& contents, DbCompactionStats& stats)
+{
+    if(kind == DbKind::Find)
+    {
+        for(auto& record : contents)
+            EraseInvalid(record, stats, [](const auto&, const auto& values) {
+                return !FindDbData{}.Deserialize(values);
+            });
+    }
+    else if(handle != nullptr)
+    {
+        auto base_ctx = ExecutionContext{handle};
+        base_ctx.DetectRocm();
+
+        for(auto& record : contents)
+        {
+            auto problem = conv::ProblemDescription{};
+            if(!ParsePerfDbKey(record.first, problem))
+            {
+                stats.unchecked += record.second.size();
+                continue;
+            }
+
+            auto ctx = ConvolutionContext{base_ctx};
+            problem.SetupFloats(ctx);
+            const auto legacy_problem = ProblemDescription{problem};
+
+            EraseInvalid(record, stats, [&](const auto& id_str, const auto& values) {
+                const auto id = solver::Id{id_str};
+                const auto solver =
+                    id.IsValid() && id.GetPrimitive() == solver::Primitive::Convolution
+                        ? id.GetSolver()
+                        : solver::AnySolver{};
+                if(solver.IsEmpty() || !solver.IsApplicable(ctx, legacy_problem))
+                {
+                    ++stats.unchecked;
+                    return false;
+                }
+                return !solver.TestPerfCfgParams(ctx, legacy_problem, values);
+            });
+        }
+    }
+    EraseEmptyRecords(contents);
+}
+
+void ReadDb(const std::string& path, DbKind kind, DbContents& contents, DbCompactionStats& stats)
+{
+    if(IsSQLite(path))
+    {
+#if MIOPEN_ENABLE_SQLITE
+        if(kind != DbKind::Perf)
+            MIOPEN_THROW(miopenStatusBadParm, "Only perf databases are stored in SQLite.");
+        ReadSQLitePerfDb(path, contents, stats);
+#else
+        std::ignore = kind;
+        MIOPEN_THROW(miopenStatusNotImplemented, "Built without SQLite: " + path);
+#endif
+    }
+    else
+    {
+        auto file = std::ifstream{path};
+        if(!file)
+            MIOPEN_THROW(miopenStatusBadParm, "Cannot read " + path);
+        ReadTextDb(file, contents, stats);
+    }
+}
+
+DbCompactionStats CompactDbs(const std::vector<std::string>& sources,
+                             const std::string& destination,
+                             const DbCompactionOptions& options)
+{
+    auto stats    = DbCompactionStats{};
+    auto contents = DbContents{};
+
+    for(const auto& source : sources)
+    {
+        ReadDb(source, options.kind, contents, stats);
+        ++stats.files;
+    }
+
+    if(options.drop_unknown_solvers)
+        DropUnknownSolvers(contents, stats);
+    DropInvalidValues(options.kind, options.handle, contents, stats);
+
+    // The output is written next to the destination and then renamed over it, so that an
+    // existing destination, which may also be one of the sources, keeps no stale entries.
+    const auto destination_path = boost::filesystem::absolute(destination);
+    const auto temp_path =
+        destination_path.parent_path() /
+        boost::filesystem::unique_path(destination_path.filename().string() + ".%%%%-%%%%.tmp");
+    try
+    {
+        if(IsSQLite(destination))
+        {
+#if MIOPEN_ENABLE_SQLITE
+            if(options.kind != DbKind::Perf)
+                MIOPEN_THROW(miopenStatusBadParm, "Only perf databases are stored in SQLite.");
+            WriteSQLitePerfDb(temp_path.string(), contents, stats);
+#else
+            MIOPEN_THROW(miopenStatusNotImplemented, "Built without SQLite: " + destination);
+#endif
+        }
+        else
+        {
+            auto file = std::ofstream{temp_path.string()};
+            if(!file)
+                MIOPEN_THROW(miopenStatusBadParm, "Cannot write " + destination);
+            WriteTextDb(file, contents);
+            file.close();
+            if(!file)
+                MIOPEN_THROW(miopenStatusBadParm, "Cannot write " + destination);
+            stats.records_written = contents.size();
+            for(const auto& record : contents)
+                stats.entries_written += record.second.size();
+        }
+        boost::filesystem::rename(temp_path, destination_path);
+    }
+    catch(...)
+    {
+        auto ec = boost::system::error_code{};
+        boost::filesystem::remove(temp_path, ec);
+        throw;
+    }
+    return stats;
+}
+
+} // namespace miopen
@@ -35,6 +35,7 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <ostream>
 #include <cstdlib>
 #include <cstring>
@@ -42,6 +43,7 @@
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_ENFORCE)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_FIND_ONLY_SOLVER)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_FIND_MODE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_SOLVER_EVALUATION_THREADS)
 
 namespace miopen {
 
@@ -158,6 +160,11 @@ boost::optional<std::vector<solver::Id>> GetEnvFindOnlySolver()
     return once;
 }
 
+std::size_t GetSolverEvaluationThreads()
+{
+    return std::max<std::size_t>(1, Value(MIOPEN_DEBUG_SOLVER_EVALUATION_THREADS{}, 1));
+}
+
 namespace {
 
 const char* ToCString(const FindMode::Values mode)
@@ -233,6 +233,12 @@ static GemmBackend_t enforce_gemm_backend(miopenDataType_t data_type,
     return gemm_backend_enforced;
 }
 
+bool IsGemmStridedBatchedNative(miopenDataType_t data_type, GemmBackend_t gemm_backend)
+{
+    const auto backend = enforce_gemm_backend(data_type, gemm_backend);
+    return backend == GemmBackend_t::rocblas || backend == GemmBackend_t::miopentensile;
+}
+
 miopenStatus_t CallGemmTimeMeasure(const Handle& handle,
                                    GemmDescriptor gemm_desc,
                                    ConstData_t A,
@@ -50,9 +50,11 @@ std::chrono::milliseconds GetTuningTimeMax()
 
 std::size_t GetTuningThreadsMax()
 {
-#if MIOPEN_USE_COMGR
+#if MIOPEN_USE_COMGR && !MIOPEN_USE_HIPRTC
     const auto def_max = 1; // COMGR is not parallelizable
 #else
+    // hipRTC builds run concurrently, while COMGR builds are serialized
+    // by HIPOCProgramImpl::BuildCodeObjectInMemory() anyway.
     const int def_max = std::thread::hardware_concurrency() / 2;
 #endif
     return Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, def_max);
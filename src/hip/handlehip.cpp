@@ -28,6 +28,8 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/caching_allocator.hpp>
+#include <miopen/check_numerics.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/gemm_geometry.hpp>
@@ -36,6 +38,7 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/rocm_features.hpp>
+#include <miopen/shared_program_cache.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/timer.hpp>
@@ -62,6 +65,8 @@
     (MIOPEN_USE_COMGR && BUILD_SHARED_LIBS && (HIP_PACKAGE_VERSION_FLAT < 4003000000ULL))
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEVICE_CU)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CACHING_ALLOCATOR)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_CACHING_ALLOCATOR_LIMIT_MB)
 
 namespace miopen {
 
@@ -167,6 +172,13 @@ struct HandleImpl
 
     HandleImpl() { hipInit(0); }
 
+    // Buffers that outlive the handle must not look up its streams when they are freed.
+    ~HandleImpl()
+    {
+        if(caching_allocator)
+            caching_allocator->Detach();
+    }
+
     StreamPtr create_stream()
     {
         hipStream_t result;
@@ -201,6 +213,13 @@ struct HandleImpl
 
     void set_ctx() const { miopen::set_device(this->device); }
 
+    // Modules loaded for one device can be used by every handle on it.
+    void share_programs()
+    {
+        if(SharedProgramCache::IsEnabled())
+            cache.SharePrograms("hip:" + std::to_string(device) + ":" + target_properties.DbId());
+    }
+
     std::string get_device_name() const
     {
         hipDeviceProp_t props{};
@@ -249,10 +268,22 @@ struct HandleImpl
     MultiStreamResourses* ms_resourse_ptr;
     std::map<miopenAcceleratorQueue_t, MultiStreamResourses> extra_stream_map;
 
+    hipStream_t get_stream()
+    {
+        if(meopenHandle_current_stream_id == 0)
+            return root_stream.get();
+        // locking only if handle in multistream mode
+        std::shared_lock<std::shared_timed_mutex> lock(stream_pool_mutex);
+        return ms_resourse_ptr->stream_pool.at(meopenHandle_current_stream_id - 1).get();
+    }
+
     bool enable_profiling  = false;
     float profiling_result = 0.0;
     int device             = -1;
     Allocator allocator{};
+    // Kept once created, as buffers from it may outlive a switch to another allocator. Buffers
+    // share it, so it also outlives the handle while they exist.
+    std::shared_ptr<CachingAllocator> caching_allocator;
     KernelCache cache;
     TargetProperties target_properties;
 };
@@ -277,6 +308,7 @@ Handle::Handle(miopenAcceleratorQueue_t stream) : impl(std::make_unique<HandleIm
     this->impl->rhandle_ = CreateRocblasHandle(stream);
 #endif
     this->impl->target_properties.Init(this);
+    this->impl->share_programs();
     MIOPEN_LOG_NQI(*this);
 }
 
@@ -301,10 +333,22 @@ Handle::Handle() : impl(std::make_unique<HandleImpl>())
     this->impl->rhandle_ = CreateRocblasHandle(root_stream);
 #endif
     this->impl->target_properties.Init(this);
+    this->impl->share_programs();
     MIOPEN_LOG_NQI(*this);
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    // Deferred numerics checks are reported here at the latest. Nothing may escape a destructor.
+    try
+    {
+        FlushCheckNumerics(*this);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+}
 
 // not MT safe
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
@@ -345,23 +389,39 @@ void Handle::ReserveExtraStreamsInPool(int cnt) const
         }
 }
 
-miopenAcceleratorQueue_t Handle::GetStream() const
-{
-    if(meopenHandle_current_stream_id == 0)
-        return impl->root_stream.get();
-    // locking only if handle in multistream mode
-    std::shared_lock<std::shared_timed_mutex> lock(this->impl->stream_pool_mutex);
-    return this->impl->ms_resourse_ptr->stream_pool.at(meopenHandle_current_stream_id - 1).get();
-}
+miopenAcceleratorQueue_t Handle::GetStream() const { return impl->get_stream(); }
 
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
 {
+    if(allocator == nullptr && deallocator == nullptr &&
+       miopen::IsEnabled(MIOPEN_DEBUG_CACHING_ALLOCATOR{}))
+    {
+        if(!this->impl->caching_allocator)
+        {
+            const auto limit_mb = Value(MIOPEN_DEBUG_CACHING_ALLOCATOR_LIMIT_MB{}, 2048);
+            this->impl->caching_allocator =
+                std::make_shared<CachingAllocator>(default_allocator,
+                                                   default_deallocator,
+                                                   nullptr,
+                                                   limit_mb << 20,
+                                                   [impl = this->impl.get()]() -> const void* {
+                                                       return impl->get_stream();
+                                                   });
+        }
+        this->impl->allocator.allocator   = CachingAllocator::AllocateCallback;
+        this->impl->allocator.deallocator = CachingAllocator::DeallocateCallback;
+        this->impl->allocator.context     = this->impl->caching_allocator.get();
+        this->impl->allocator.owner       = this->impl->caching_allocator;
+        return;
+    }
+
     this->impl->allocator.allocator   = allocator == nullptr ? default_allocator : allocator;
     this->impl->allocator.deallocator = deallocator == nullptr ? default_deallocator : deallocator;
 
     this->impl->allocator.context = allocatorContext;
+    this->impl->allocator.owner   = nullptr;
 }
 
 void Handle::EnableProfiling(bool enable) const { this->impl->enable_profiling = enable; }
@@ -568,6 +628,7 @@ void Handle::Finish() const
     if(status != hipSuccess)
         MIOPEN_THROW_HIP_STATUS(status, "Failed hip sychronization");
 #endif
+    FlushCheckNumerics(*this);
 }
 void Handle::Flush() const {}
 
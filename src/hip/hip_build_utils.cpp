@@ -33,6 +33,7 @@
 #include <miopen/rocm_features.hpp>
 #include <miopen/solver/implicitgemm_util.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/timer.hpp>
 #include <boost/optional.hpp>
 #include <sstream>
 #include <string>
@@ -42,6 +43,20 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_HIP_DUMP)
 
 namespace miopen {
 
+/// The embedded HIP include files never change during the process lifetime,
+/// so they are written to the filesystem only once and shared by all builds
+/// instead of being re-exported into the temporary directory of each kernel.
+static const boost::filesystem::path& GetHipIncludeDir()
+{
+    static const TmpDir dir = [] {
+        TmpDir inc_dir{"hip-include"};
+        for(const auto& inc_file : GetHipKernelIncList())
+            WriteFile(GetKernelInc(inc_file), inc_dir.path / inc_file);
+        return inc_dir;
+    }();
+    return dir.path;
+}
+
 static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const std::string& filename,
                                             std::string src,
@@ -50,19 +65,11 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                                             const bool testing_mode)
 {
 #ifdef __linux__
-    // Write out the include files
+    CompileTimer ct;
+
     // Let's assume includes are overkill for feature tests & optimize'em out.
     if(!testing_mode)
-    {
-        auto inc_list = GetHipKernelIncList();
-        auto inc_path = tmp_dir->path;
-        boost::filesystem::create_directories(inc_path);
-        for(const auto& inc_file : inc_list)
-        {
-            auto inc_src = GetKernelInc(inc_file);
-            WriteFile(inc_src, inc_path / inc_file);
-        }
-    }
+        params += " -I" + GetHipIncludeDir().string();
 
     src += "\nint main() {}\n";
     WriteFile(src, tmp_dir->path / filename);
@@ -115,9 +122,11 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
                      params + filename + " -o " + bin_file.string() + redirector);
     if(!boost::filesystem::exists(bin_file))
         MIOPEN_THROW(filename + " failed to compile");
+    ct.Log("HipBuild compile", filename);
 
 #if defined(MIOPEN_OFFLOADBUNDLER_BIN) && !MIOPEN_BACKEND_HIP
     // Unbundling is not required for HIP runtime && hip-clang
+    const auto hsaco_file = tmp_dir->path / (filename + ".o.hsaco");
     tmp_dir->Execute(MIOPEN_OFFLOADBUNDLER_BIN,
                      "--type=o "
 #if(HIP_PACKAGE_VERSION_FLAT >= 4001021072ULL && HIP_PACKAGE_VERSION_FLAT < 4002000000ULL) || \
@@ -131,18 +140,13 @@ static boost::filesystem::path HipBuildImpl(boost::optional<TmpDir>& tmp_dir,
 #else
                          + (std::string{'-'} + lots.device + lots.xnack)
 #endif
-                         + " --inputs=" + bin_file.string() + " --outputs=" + bin_file.string() +
-                         ".hsaco --unbundle");
-
-    auto hsaco = std::find_if(boost::filesystem::directory_iterator{tmp_dir->path},
-                              {},
-                              [](auto entry) { return (entry.path().extension() == ".hsaco"); });
+                         + " --inputs=" + bin_file.string() + " --outputs=" + hsaco_file.string() +
+                         " --unbundle");
 
-    if(hsaco == boost::filesystem::directory_iterator{})
-    {
-        MIOPEN_LOG_E("failed to find *.hsaco in " << hsaco->path().string());
-    }
-    return hsaco->path();
+    if(!boost::filesystem::exists(hsaco_file))
+        MIOPEN_THROW(filename + " failed to unbundle");
+    ct.Log("HipBuild unbundle", filename);
+    return hsaco_file;
 #endif
     return bin_file;
 #else
@@ -157,7 +161,7 @@ static bool
 HipBuildTest(const std::string& program_name, std::string params, const TargetProperties& target)
 {
     boost::optional<miopen::TmpDir> dir(program_name);
-    std::string source = miopen::GetKernelSrc(program_name);
+    const std::string source{miopen::GetKernelSrc(program_name)};
     try
     {
         std::ignore = HipBuildImpl(dir, program_name, source, params, target, true);
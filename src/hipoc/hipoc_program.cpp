@@ -36,6 +36,7 @@
 #include <miopen/stringutils.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/timer.hpp>
 #include <miopen/write_file.hpp>
 #include <miopen/env.hpp>
 #include <miopen/comgr.hpp>
@@ -68,6 +69,34 @@ MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_USE_HIPRTC)
 
 namespace miopen {
 
+namespace {
+
+std::mutex& CodeObjectBuilderMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+CodeObjectBuilder& CodeObjectBuilderOverride()
+{
+    static CodeObjectBuilder builder;
+    return builder;
+}
+
+CodeObjectBuilder GetCodeObjectBuilder()
+{
+    std::lock_guard<std::mutex> lock(CodeObjectBuilderMutex());
+    return CodeObjectBuilderOverride();
+}
+
+} // namespace
+
+void SetCodeObjectBuilder(CodeObjectBuilder builder)
+{
+    std::lock_guard<std::mutex> lock(CodeObjectBuilderMutex());
+    CodeObjectBuilderOverride() = std::move(builder);
+}
+
 #if !MIOPEN_USE_COMGR
 namespace {
 
@@ -204,6 +233,8 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
     : program(program_name), target(target_)
 {
     BuildCodeObject(params, is_kernel_str, kernel_src);
+    Timer timer;
+    timer.start();
     if(!binary.empty())
     {
         module = CreateModuleInMem(binary);
@@ -216,6 +247,8 @@ HIPOCProgramImpl::HIPOCProgramImpl(const std::string& program_name,
             module = CreateModule(hsaco_file);
         }
     }
+    stage_times.load_ms = timer.elapsed_ms();
+    MIOPEN_LOG_I2(program << " load, ms: " << stage_times.load_ms);
 }
 
 #if !MIOPEN_USE_COMGR
@@ -276,6 +309,14 @@ void HIPOCProgramImpl::BuildCodeObjectInMemory(const std::string& params,
         binary.resize(sz);
         std::memcpy(&binary[0], src.c_str(), sz);
     }
+#if MIOPEN_USE_HIPRTC
+    // hipRTC is thread-safe, so HIP builds may run concurrently
+    // with each other and with a comgr build.
+    else if(miopen::EndsWith(filename, ".cpp") && !miopen::IsDisabled(MIOPEN_DEBUG_USE_HIPRTC{}))
+    {
+        hiprtc::BuildHip(filename, src, params, target, binary);
+    }
+#endif // MIOPEN_USE_HIPRTC
     else
     {
 #if MIOPEN_WORKAROUND_ROCM_COMPILER_SUPPORT_ISSUE_27
@@ -284,12 +325,7 @@ void HIPOCProgramImpl::BuildCodeObjectInMemory(const std::string& params,
 #endif
         if(miopen::EndsWith(filename, ".cpp"))
         {
-#if MIOPEN_USE_HIPRTC
-            if(!miopen::IsDisabled(MIOPEN_DEBUG_USE_HIPRTC{}))
-                hiprtc::BuildHip(filename, src, params, target, binary);
-            else
-#endif // MIOPEN_USE_HIPRTC
-                comgr::BuildHip(filename, src, params, target, binary);
+            comgr::BuildHip(filename, src, params, target, binary);
         }
         else if(miopen::EndsWith(filename, ".s"))
             comgr::BuildAsm(filename, src, params, target, binary);
@@ -309,6 +345,8 @@ void HIPOCProgramImpl::BuildCodeObject(std::string params,
                                        bool is_kernel_str,
                                        const std::string& kernel_src)
 {
+    Timer timer;
+    timer.start();
     std::string filename = is_kernel_str ? "tinygemm.cl" // Fixed name for miopengemm.
                                          : program;
     const auto src       = [&]() -> std::string {
@@ -318,8 +356,9 @@ void HIPOCProgramImpl::BuildCodeObject(std::string params,
             return kernel_src;
         if(is_kernel_str)
             return program;
-        return GetKernelSrc(program);
+        return std::string{GetKernelSrc(program)};
     }();
+    stage_times.source_ms = timer.elapsed_ms();
 
     if(miopen::EndsWith(filename, ".cpp"))
     {
@@ -339,11 +378,24 @@ void HIPOCProgramImpl::BuildCodeObject(std::string params,
 #endif
     }
 
+    timer.start();
+    if(const auto builder = GetCodeObjectBuilder())
+    {
+        builder(filename, src, params, target, binary);
+        if(binary.empty())
+            MIOPEN_THROW("Code object build failed. Source: " + filename);
+    }
+    else
+    {
 #if MIOPEN_USE_COMGR /// \todo Refactor when functionality stabilize.
-    BuildCodeObjectInMemory(params, src, filename);
+        BuildCodeObjectInMemory(params, src, filename);
 #else
-    BuildCodeObjectInFile(params, src, filename);
+        BuildCodeObjectInFile(params, src, filename);
 #endif
+    }
+    stage_times.compile_ms = timer.elapsed_ms();
+    MIOPEN_LOG_I2(filename << " source, ms: " << stage_times.source_ms
+                           << ", compile, ms: " << stage_times.compile_ms);
 }
 
 HIPOCProgram::HIPOCProgram() {}
@@ -394,4 +446,6 @@ void HIPOCProgram::FreeCodeObjectFileStorage()
 
 bool HIPOCProgram::IsCodeObjectInMemory() const { return !impl->binary.empty(); };
 
+const BuildStageTimes& HIPOCProgram::GetBuildStageTimes() const { return impl->stage_times; }
+
 } // namespace miopen
@@ -2,6 +2,7 @@
 #define GUARD_MLOPEN_ALLOCATOR_HPP
 
 #include <cassert>
+#include <memory>
 
 #include <miopen/common.hpp>
 #include <miopen/errors.hpp>
@@ -14,6 +15,8 @@ struct AllocatorDeleter
 {
     miopenDeallocatorFunction deallocator;
     void* context;
+    // Keeps the context alive as long as its buffers, when the library owns it.
+    std::shared_ptr<void> owner = nullptr;
 
     template <class T>
     void operator()(T* x) const
@@ -30,6 +33,7 @@ struct Allocator
     miopenAllocatorFunction allocator;
     miopenDeallocatorFunction deallocator;
     void* context;
+    std::shared_ptr<void> owner = nullptr;
 
     using ManageDataPtr =
         std::unique_ptr<typename std::remove_pointer<Data_t>::type, AllocatorDeleter>;
@@ -44,7 +48,7 @@ struct Allocator
             MIOPEN_THROW("Custom allocator failed to allocate memory for buffer size " +
                          std::to_string(n) + ": ");
         }
-        return ManageDataPtr{DataCast(result), AllocatorDeleter{deallocator, context}};
+        return ManageDataPtr{DataCast(result), AllocatorDeleter{deallocator, context, owner}};
     }
 };
 
@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CACHING_ALLOCATOR_HPP_
+#define GUARD_MIOPEN_CACHING_ALLOCATOR_HPP_
+
+#include <miopen/miopen.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct CachingAllocatorStats
+{
+    /// Bytes requested by the buffers in use.
+    std::size_t requested_bytes = 0;
+    /// Bytes of the size classes backing the buffers in use.
+    std::size_t in_use_bytes = 0;
+    /// Bytes of freed buffers kept for reuse.
+    std::size_t cached_bytes = 0;
+    /// High-water mark of in_use_bytes + cached_bytes.
+    std::size_t peak_reserved_bytes = 0;
+    std::size_t hits     = 0;
+    std::size_t misses   = 0;
+    std::size_t releases = 0;
+
+    std::size_t ReservedBytes() const { return in_use_bytes + cached_bytes; }
+
+    /// Share of the in-use bytes lost to rounding up to size classes.
+    double Fragmentation() const
+    {
+        return in_use_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(requested_bytes) / in_use_bytes;
+    }
+};
+
+std::ostream& operator<<(std::ostream& os, const CachingAllocatorStats& stats);
+
+/**
+ * @brief Keeps freed buffers of a backing allocator for reuse
+ *
+ * Sizes are rounded up to powers of two, and a freed buffer is only reused by allocations of
+ * its size class on the stream it was allocated on, which is where its users queue their work.
+ * Work on one stream runs in order, so the next user of the buffer cannot overlap with the
+ * previous one, even if the current stream has changed since. Buffers are
+ * returned to the backing allocator instead of being cached when the reserved bytes would
+ * exceed the limit, and cached ones are returned before a new allocation could exceed it.
+ *
+ * Buffers must be freed before the allocator is destroyed. The handle shares the allocator with
+ * the deleters of its buffers, so buffers may outlive the handle.
+ */
+class CachingAllocator
+{
+public:
+    using StreamGetter = std::function<const void*()>;
+
+    CachingAllocator(miopenAllocatorFunction backing_allocator_,
+                     miopenDeallocatorFunction backing_deallocator_,
+                     void* backing_context_,
+                     std::size_t limit_,
+                     StreamGetter get_stream_ = nullptr);
+
+    CachingAllocator(const CachingAllocator&) = delete;
+    CachingAllocator& operator=(const CachingAllocator&) = delete;
+    ~CachingAllocator();
+
+    void* Allocate(std::size_t size);
+    void Deallocate(void* ptr);
+
+    /// Returns all cached buffers to the backing allocator.
+    void Trim();
+
+    /// Called when the streams go away: trims the cache, stops querying the stream, and returns
+    /// buffers freed later to the backing allocator right away.
+    void Detach();
+
+    CachingAllocatorStats GetStats() const;
+
+    static std::size_t SizeClass(std::size_t size);
+
+    /// miopenAllocatorFunction and miopenDeallocatorFunction taking the allocator as context.
+    static void* AllocateCallback(void* self, std::size_t size);
+    static void DeallocateCallback(void* self, void* ptr);
+
+private:
+    struct Block
+    {
+        std::size_t size_class;
+        std::size_t requested;
+        const void* stream;
+    };
+
+    using FreeListKey = std::pair<const void*, std::size_t>;
+
+    miopenAllocatorFunction backing_allocator;
+    miopenDeallocatorFunction backing_deallocator;
+    void* backing_context;
+    std::size_t limit;
+    StreamGetter get_stream;
+
+    mutable std::mutex mutex;
+    bool detached = false;
+    std::unordered_map<void*, Block> in_use;
+    std::map<FreeListKey, std::vector<void*>> free_lists;
+    CachingAllocatorStats stats;
+
+    void* AllocateBackingUnsafe(std::size_t size_class);
+    void TrimUnsafe();
+    const void* CurrentStream() const { return get_stream ? get_stream() : nullptr; }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CACHING_ALLOCATOR_HPP_
@@ -15,6 +15,7 @@ struct CheckNumerics
     static const int Throw        = 0x04; // MIOPEN_THROW on abnormal result
     static const int Abort        = 0x08; // abort on abnormal result (to drop into debugger)
     static const int ComputeStats = 0x10; // Print mean/absmean/min/max (slow)
+    static const int Deferred     = 0x20; // report on a later readback instead of stalling
 };
 bool CheckNumericsEnabled(int bitMask = -1);
 
@@ -22,6 +23,36 @@ bool checkNumericsInput(const Handle& handle, const TensorDescriptor& dDesc, Con
 bool checkNumericsOutput(const Handle& handle, const TensorDescriptor& dDesc, ConstData_t data);
 bool checkNumericsImpl(
     const Handle& handle, int mode, const TensorDescriptor& dDesc, ConstData_t data, bool isInput);
+
+/// Reports the checks still pending on the handle. Throws the first failure after all of
+/// them have been reported. Called by Handle::Finish().
+void FlushCheckNumerics(const Handle& handle);
+
+/// Queues the checks of one call into a results buffer pooled per handle. All of them are
+/// read back at once by Collect(), instead of one blocking readback per tensor.
+///
+/// With CheckNumerics::Deferred Collect() does not wait: results stay on the device until
+/// the pool fills up, a non-deferred check runs or the handle is finished or destroyed,
+/// and are reported then.
+struct CheckNumericsBatch
+{
+    CheckNumericsBatch(const Handle& handle_);
+    CheckNumericsBatch(const Handle& handle_, int mode_);
+
+    void Input(const TensorDescriptor& dDesc, ConstData_t data);
+    void Output(const TensorDescriptor& dDesc, ConstData_t data);
+
+    /// Returns true if abnormal values were found by the checks reported so far.
+    bool Collect();
+
+private:
+    const Handle& handle;
+    int mode;
+    std::size_t batch;
+    bool abnormal = false;
+
+    void Queue(const TensorDescriptor& dDesc, ConstData_t data, bool isInput);
+};
 } // namespace miopen
 
 #endif // GUARD_MIOPEN_CHECK_NUMERICS_HPP
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONTENT_HASH_HPP
+#define GUARD_MIOPEN_CONTENT_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// XXH64 of the given bytes. Not cryptographic; used to detect corruption and to key caches.
+std::uint64_t xxh64(const void* data, std::size_t size, std::uint64_t seed = 0);
+
+/// Returns the hash of s in the current on-disk format, "<algorithm>_<hex digest>". The tag
+/// lets readers tell it apart from hashes written by other versions.
+std::string ContentHash(const std::string& s);
+
+/// Checks s against a hash written by ContentHash, or by older MIOpen versions that stored
+/// an untagged md5.
+bool VerifyContentHash(const std::string& s, const std::string& hash);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONTENT_HASH_HPP
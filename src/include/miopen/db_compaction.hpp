@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/config.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+enum class DbKind
+{
+    Find,
+    Perf,
+};
+
+/// Key -> solver id -> values. Ordered, so that compacted databases are sorted and diffable.
+using DbContents = std::map<std::string, std::map<std::string, std::string>>;
+
+struct DbCompactionStats
+{
+    std::size_t files = 0;
+    /// Records read from all the sources, before merging.
+    std::size_t records_read = 0;
+    std::size_t ill_formed   = 0;
+    /// Records whose key was already read from the same or an earlier source.
+    std::size_t duplicate_keys = 0;
+    /// Solver entries replaced by a later occurrence of the same key and id.
+    std::size_t overridden = 0;
+    /// Solver entries of ids that are no longer registered.
+    std::size_t unknown_solvers = 0;
+    /// Find-db entries that do not parse, perf-db entries that are not a valid performance
+    /// config of their solver.
+    std::size_t invalid_values = 0;
+    /// Perf-db entries that have not been validated because their key did not parse or their
+    /// solver is not applicable on the device.
+    std::size_t unchecked = 0;
+    std::size_t records_written = 0;
+    std::size_t entries_written = 0;
+
+    friend std::ostream& operator<<(std::ostream& stream, const DbCompactionStats& stats);
+};
+
+struct DbCompactionOptions
+{
+    DbKind kind               = DbKind::Perf;
+    bool drop_unknown_solvers = true;
+    /// Perf-db entries are checked against the performance configs of their solvers on the
+    /// device of the handle. Nothing is checked if null.
+    Handle* handle = nullptr;
+};
+
+/// Reads "key=id:values;id:values" lines. Later records override earlier ones id by id.
+void ReadTextDb(std::istream& stream, DbContents& contents, DbCompactionStats& stats);
+void WriteTextDb(std::ostream& stream, const DbContents& contents);
+
+#if MIOPEN_ENABLE_SQLITE
+void ReadSQLitePerfDb(const std::string& path, DbContents& contents, DbCompactionStats& stats);
+/// Records whose key does not restore a problem are skipped, as the configs are stored by field.
+void WriteSQLitePerfDb(const std::string& path,
+                       const DbContents& contents,
+                       DbCompactionStats& stats);
+#endif
+
+/// Reads a database in the format its extension tells, see CompactDbs().
+void ReadDb(const std::string& path, DbKind kind, DbContents& contents, DbCompactionStats& stats);
+
+/// Restores the problem of a perf-db key. Returns false for keys it cannot restore exactly, such
+/// as the ones of vectorized layouts.
+bool ParsePerfDbKey(const std::string& key, conv::ProblemDescription& problem);
+
+void DropUnknownSolvers(DbContents& contents, DbCompactionStats& stats);
+void DropInvalidValues(DbKind kind, Handle* handle, DbContents& contents, DbCompactionStats& stats);
+
+/// Merges the sources in order, so that the user databases are listed after the system one they
+/// update, drops stale entries and writes the result sorted by key. The format of each file is
+/// chosen by its extension: .db and .udb are SQLite perf databases, anything else is text.
+DbCompactionStats CompactDbs(const std::vector<std::string>& sources,
+                             const std::string& destination,
+                             const DbCompactionOptions& options);
+
+} // namespace miopen
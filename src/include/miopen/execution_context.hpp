@@ -69,6 +69,11 @@ namespace conv {
 struct ProblemDescription;
 } // namespace conv
 
+namespace solver {
+class SearchCheckpoint;
+class SearchCostModel;
+} // namespace solver
+
 struct ExecutionContext
 {
     // Solution-specific
@@ -90,6 +95,14 @@ struct ExecutionContext
     // performance config.
     bool disable_perfdb_access      = false;
     bool use_dynamic_solutions_only = false;
+    // When set, GenericSearch asks the model for the kernel times instead of running the kernels.
+    // Not owned.
+    solver::SearchCostModel* search_cost_model = nullptr;
+    // The GenericSearch strategy. Empty selects MIOPEN_DEBUG_TUNING_STRATEGY, or "random".
+    std::string search_strategy;
+    // When set, GenericSearch only evaluates the slice of the configs given by the checkpoint and
+    // skips those it already holds. Not owned.
+    solver::SearchCheckpoint* search_checkpoint = nullptr;
 
     inline Handle& GetStream() const { return *stream; }
     inline void SetStream(Handle* stream_) { stream = stream_; }
@@ -32,6 +32,7 @@
 
 #include <boost/optional.hpp>
 
+#include <cstddef>
 #include <ostream>
 
 namespace miopen {
@@ -105,6 +106,10 @@ public:
 
 boost::optional<std::vector<solver::Id>> GetEnvFindOnlySolver();
 
+/// Number of threads SolverContainer evaluates solvers with, set by
+/// MIOPEN_DEBUG_SOLVER_EVALUATION_THREADS. The default of 1 keeps the evaluation serial.
+std::size_t GetSolverEvaluationThreads();
+
 class FindMode
 {
 public:
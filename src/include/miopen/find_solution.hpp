@@ -32,10 +32,19 @@
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/perf_db_neighbors.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/solver.hpp>
 
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <type_traits>
 #include <vector>
 
 namespace miopen {
@@ -44,6 +53,39 @@ struct AnyInvokeParams;
 
 namespace solver {
 
+/// Loads the first valid config among the ones tuned for the nearest problems, see
+/// GetPerfDbNeighborCount().
+template <class Solver, class Context, class PerformanceConfig>
+bool LoadNeighborConfig(const Solver& s,
+                        const Context& context,
+                        const ProblemDescription& problem,
+                        PerformanceConfig& config)
+{
+    const auto count = GetPerfDbNeighborCount();
+    if(count == 0)
+        return false;
+
+    const auto& index = PerfDbNeighborIndex::GetCached(context);
+    for(const auto& neighbor : index.Find(problem.conv_problem, s.SolverDbId(), count))
+    {
+        if(config.Deserialize(neighbor.values) &&
+           s.IsValidPerformanceConfig(context, problem, config))
+        {
+            MIOPEN_LOG_I("Perf Db: neighbor record loaded: " << s.SolverDbId() << ": "
+                                                             << neighbor.key);
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Only convolutions have neighbors so far.
+template <class Solver, class Context, class Problem, class PerformanceConfig>
+bool LoadNeighborConfig(const Solver&, const Context&, const Problem&, PerformanceConfig&)
+{
+    return false;
+}
+
 template <class Solver, class Context, class Problem, class Db>
 auto FindSolutionImpl(rank<1>,
                       Solver s,
@@ -112,6 +154,12 @@ auto FindSolutionImpl(rank<1>,
             {
                 MIOPEN_LOG_I("Perf Db: record not found for: " << s.SolverDbId());
             }
+
+            if(!context.do_search && !enforce.IsSearch(context) &&
+               LoadNeighborConfig(s, context, problem, config))
+            {
+                return s.GetSolution(context, problem, config);
+            }
         }
 
         if(context.do_search || enforce.IsSearch(context)) // TODO: Make it a customization point
@@ -120,7 +168,11 @@ auto FindSolutionImpl(rank<1>,
             try
             {
                 auto c = s.Search(context, problem, invoke_ctx);
-                db.Update(problem, s.SolverDbId(), c);
+                // Configs chosen on simulated times are not tuning results.
+                if(context.search_cost_model == nullptr)
+                    db.Update(problem, s.SolverDbId(), c);
+                else
+                    MIOPEN_LOG_I("Perf Db: simulated search not stored: " << s.SolverDbId());
                 return s.GetSolution(context, problem, c);
             }
             catch(const miopen::Exception& ex)
@@ -168,6 +220,39 @@ ConvSolution FindSolution(Solver s,
     return solution;
 }
 
+/// Serializes the perf db accesses of solvers which are evaluated concurrently.
+template <class Db>
+class SerializedDb
+{
+public:
+    explicit SerializedDb(Db& db_) : db(db_) {}
+
+    template <class... Args>
+    auto Load(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Load(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    auto Update(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Update(std::forward<Args>(args)...);
+    }
+
+    template <class... Args>
+    auto Remove(Args&&... args)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return db.Remove(std::forward<Args>(args)...);
+    }
+
+private:
+    Db& db;
+    std::mutex mutex;
+};
+
 template <class... Solvers>
 struct SolverContainer
 {
@@ -180,51 +265,47 @@ struct SolverContainer
                           const AnyInvokeParams& invoke_ctx,
                           std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
-        std::vector<Solution> ss;
-        std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
-        miopen::each_args(
-            [&](auto solver) {
-                if(count >= limit)
-                    return;
-                if(find_only &&
-                   (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
-                    find_only->end()))
-                { // Do nothing (and keep silence for the sake of Tuna), just skip.
-                }
-                // For better performance, check IsDynamic() first, because
-                // it is much faster than IsApplicable().
-                else if(ctx.use_dynamic_solutions_only && !solver.IsDynamic())
-                {
-                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
-                }
-                else if(!solver.IsApplicable(ctx, problem))
-                {
-                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
-                }
-                else
+        const FindEnforce enforce;
+        // Searching launches kernels on the handle, so it is never done concurrently.
+        const auto threads = ctx.do_search || enforce.IsSearch(ctx) || enforce.IsDbClean(ctx)
+                                 ? 1
+                                 : GetSolverEvaluationThreads();
+        auto serialized_db = SerializedDb<std::remove_reference_t<Db>>{db};
+
+        return Evaluate<Solution>(threads, limit, [&](auto solver) -> boost::optional<Solution> {
+            if(find_only &&
+               (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
+                find_only->end()))
+            { // Do nothing (and keep silence for the sake of Tuna), just skip.
+            }
+            // For better performance, check IsDynamic() first, because
+            // it is much faster than IsApplicable().
+            else if(ctx.use_dynamic_solutions_only && !solver.IsDynamic())
+            {
+                MIOPEN_LOG_I2(solver.SolverDbId() << ": Skipped (non-dynamic)");
+            }
+            else if(!solver.IsApplicable(ctx, problem))
+            {
+                MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
+            }
+            else
+            {
+                const Solution s = FindSolution(solver, ctx, problem, serialized_db, invoke_ctx);
+                if(s.Succeeded())
                 {
-                    const Solution s = FindSolution(solver, ctx, problem, db, invoke_ctx);
-                    if(s.Succeeded())
-                    {
-                        ++count;
-                        ss.push_back(s);
-                        MIOPEN_LOG_I2(solver.SolverDbId() << ": Success.");
-                    }
-                    else
-                    {
-                        /// \todo If Solver is applicable it must provide an appropriate Solution.
-                        /// This is not the case for some 20x5 convolutions (and possibly others).
-                        /// Normally we should not get here and message level should be Error.
-                        /// For now, let's use Info (not Warning) level to avoid
-                        /// flooding the console.
-                        MIOPEN_LOG_I(solver.SolverDbId()
-                                     << ": [Warning] Applicable Solver not succeeded.");
-                    }
+                    MIOPEN_LOG_I2(solver.SolverDbId() << ": Success.");
+                    return s;
                 }
-            },
-            Solvers{}...);
-        return ss;
+                /// \todo If Solver is applicable it must provide an appropriate Solution.
+                /// This is not the case for some 20x5 convolutions (and possibly others).
+                /// Normally we should not get here and message level should be Error.
+                /// For now, let's use Info (not Warning) level to avoid
+                /// flooding the console.
+                MIOPEN_LOG_I(solver.SolverDbId() << ": [Warning] Applicable Solver not succeeded.");
+            }
+            return boost::none;
+        });
     }
 
     // Search for all applicable solutions among many solvers
@@ -234,13 +315,10 @@ struct SolverContainer
                        const Problem& problem,
                        std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
-        std::vector<Solution> ss;
-        std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
-        miopen::each_args(
-            [&](auto solver) {
-                if(count >= limit)
-                    return;
+
+        return Evaluate<Solution>(
+            GetSolverEvaluationThreads(), limit, [&](auto solver) -> boost::optional<Solution> {
                 if(find_only &&
                    (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
                     find_only->end()))
@@ -258,18 +336,13 @@ struct SolverContainer
                     s.solver_id = solver.SolverDbId();
                     if(s.Succeeded())
                     {
-                        ++count;
-                        ss.push_back(s);
                         MIOPEN_LOG_I2(solver.SolverDbId() << ": Success.");
+                        return s;
                     }
-                    else
-                    {
-                        MIOPEN_LOG_E(solver.SolverDbId() << ": Applicable Solver not succeeded.");
-                    }
+                    MIOPEN_LOG_E(solver.SolverDbId() << ": Applicable Solver not succeeded.");
                 }
-            },
-            Solvers{}...);
-        return ss;
+                return boost::none;
+            });
     }
 
     template <class Context, class Problem>
@@ -278,14 +351,11 @@ struct SolverContainer
                       const Problem& problem,
                       std::size_t limit = std::numeric_limits<std::size_t>::max()) const
     {
-        std::vector<std::pair<std::string, size_t>> res;
+        using Result         = std::pair<std::string, size_t>;
         const auto find_only = GetEnvFindOnlySolver();
-        std::size_t count    = 0;
-        miopen::each_args(
-            [&](auto solver) {
-                if(count >= limit)
-                    return;
 
+        return Evaluate<Result>(
+            GetSolverEvaluationThreads(), limit, [&](auto solver) -> boost::optional<Result> {
                 if(find_only &&
                    (std::find(find_only->begin(), find_only->end(), Id{solver.SolverDbId()}) ==
                     find_only->end()))
@@ -301,14 +371,12 @@ struct SolverContainer
                     MIOPEN_LOG_I2(solver.SolverDbId() << ": Not applicable");
                 else
                 {
-                    ++count;
                     auto sz = solver.GetWorkspaceSize(ctx, problem);
-                    res.push_back(std::make_pair(solver.SolverDbId(), sz));
                     MIOPEN_LOG_I2(solver.SolverDbId() << ": " << sz);
+                    return std::make_pair(solver.SolverDbId(), sz);
                 }
-            },
-            Solvers{}...);
-        return res;
+                return boost::none;
+            });
     }
 
     // Search for all applicable solutions among many solvers
@@ -374,6 +442,69 @@ struct SolverContainer
         handle.RegisterInvoker(invoker, network_config, sln.solver_id, algo);
         invoker(handle, invoke_params);
     }
+
+private:
+    // Visits the solvers in order until `limit` of them have produced a result. With several
+    // threads, solvers are visited concurrently in waves; results and errors are still taken in
+    // the order of the solvers, so the outcome is the same as with the serial evaluation.
+    template <class Result, class Visit>
+    static std::vector<Result> Evaluate(std::size_t threads, std::size_t limit, const Visit& visit)
+    {
+        std::vector<Result> results;
+
+        if(threads <= 1)
+        {
+            miopen::each_args(
+                [&](auto solver) {
+                    if(results.size() >= limit)
+                        return;
+                    if(auto result = visit(solver))
+                        results.push_back(std::move(*result));
+                },
+                Solvers{}...);
+            return results;
+        }
+
+        std::vector<std::function<boost::optional<Result>()>> visits;
+        miopen::each_args(
+            [&](auto solver) {
+                visits.emplace_back([&visit, solver]() { return visit(solver); });
+            },
+            Solvers{}...);
+
+        // A small limit is usually reached by the first solvers, so later ones are not visited
+        // in vain.
+        const auto wave_size = limit >= visits.size() ? visits.size() : threads;
+
+        for(std::size_t begin = 0; begin < visits.size() && results.size() < limit;
+            begin += wave_size)
+        {
+            const auto size = std::min(wave_size, visits.size() - begin);
+            std::vector<boost::optional<Result>> wave(size);
+            std::vector<std::exception_ptr> errors(size);
+
+            par_for_strided(size, max_threads{threads}, [&](auto i) {
+                try
+                {
+                    wave[i] = visits[begin + i]();
+                }
+                catch(...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            });
+
+            for(std::size_t i = 0; i < size && results.size() < limit; ++i)
+            {
+                if(errors[i])
+                    std::rethrow_exception(errors[i]);
+                if(wave[i])
+                    results.push_back(std::move(*wave[i]));
+            }
+        }
+
+        return results;
+    }
 };
 
 } // namespace solver
@@ -125,6 +125,10 @@ CallGemmStridedBatchedSequential(const Handle& handle,
                                  GemmBackend_t gemm_backend = GemmBackend_t::miopentensile,
                                  bool gfx90a_alt_impl       = false);
 
+// Whether CallGemmStridedBatched runs as one launch for the backend the call resolves to.
+// MIOpenGEMM falls back to CallGemmStridedBatchedSequential, one launch per batch.
+bool IsGemmStridedBatchedNative(miopenDataType_t data_type, GemmBackend_t gemm_backend);
+
 // GEMM parameters for Convolution (using Im2Col) Fwd
 // y = w * Im2Col(x)
 GemmDescriptor CreateGemmDescriptorConvFwd(const TensorDescriptor& wDesc,
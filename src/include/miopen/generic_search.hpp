@@ -39,6 +39,9 @@
 #include <miopen/type_traits.hpp>
 #include <miopen/mt_queue.hpp>
 #include <miopen/generic_search_controls.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/tuning_queue.hpp>
 
 #include <algorithm>
 #include <vector>
@@ -48,6 +51,7 @@
 #include <chrono>
 #include <cassert>
 #include <random>
+#include <thread>
 
 namespace miopen {
 namespace solver {
@@ -303,6 +307,11 @@ std::size_t GetTuningIterationsMax();
 std::chrono::milliseconds GetTuningTimeMax(); // returns the max allowed time in milliseconds
 std::size_t GetTuningThreadsMax();
 
+/// A config, its solution, whether the compile agent ran out of time instead, and the index
+/// of the config in the batch.
+template <typename PerformanceConfig>
+using CompiledConfig = std::tuple<PerformanceConfig, ConvSolution, bool, std::size_t>;
+
 template <typename PerformanceConfig, typename Solver, typename Context, typename Problem>
 void CompileAgent(size_t thread_index,
                   size_t total_threads,
@@ -310,7 +319,7 @@ void CompileAgent(size_t thread_index,
                   const Context& context,
                   const Problem& problem,
                   std::vector<PerformanceConfig>& data,
-                  ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>>& comp_queue)
+                  ThreadSafeQueue<CompiledConfig<PerformanceConfig>>& comp_queue)
 {
     const auto start_time =
         std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now());
@@ -326,11 +335,10 @@ void CompileAgent(size_t thread_index,
         if(current_time - start_time > time_budget)
         {
             MIOPEN_LOG_I2("Thread: " << thread_index << " Done, exhausted time budget");
-            auto tmp = std::make_tuple<PerformanceConfig, ConvSolution, bool>({}, {}, true);
-            comp_queue.push(std::move(tmp));
+            comp_queue.push(CompiledConfig<PerformanceConfig>{{}, {}, true, 0});
             break;
         }
-        auto& current_config          = data.at(idx);
+        const auto& current_config    = data.at(idx);
         ConvSolution current_solution = s.GetSolution(context, problem, current_config);
         for(const auto& kernel : current_solution.construction_params)
         {
@@ -338,9 +346,9 @@ void CompileAgent(size_t thread_index,
                 continue;
             std::ignore = profile_h.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
         }
-        auto tup = std::make_tuple<PerformanceConfig, ConvSolution, bool>(
-            std::move(current_config), std::move(current_solution), false);
-        comp_queue.push(std::move(tup));
+        // The index tells results apart when a batch holds the same config more than once.
+        comp_queue.push(CompiledConfig<PerformanceConfig>{
+            current_config, std::move(current_solution), false, idx});
     }
     MIOPEN_LOG_I2("Thread: " << thread_index << " Done, completed tuning");
 }
@@ -360,29 +368,92 @@ auto GenericSearch(const Solver s,
     auto context                  = context_;
     context.is_for_generic_search = true;
 
+    // With a cost model nothing is compiled or run, and the configs are measured one by one.
+    auto* const cost_model = context.search_cost_model;
+    const auto simulated   = cost_model != nullptr;
+    const auto is_recorded = !simulated && IsSearchRecordEnabled();
+
     using PerformanceConfig = decltype(s.GetDefaultPerformanceConfig(context, problem));
     PerformanceConfig best_config;
     const auto default_solution =
         s.GetSolution(context, problem, s.GetDefaultPerformanceConfig(context, problem));
-    const auto invoke_ctx = [invoke_ctx_]() {
+    const auto invoke_ctx = [&]() {
         auto copy = invoke_ctx_;
-        copy.SetInvokeType(InvokeType::AutoTune);
+        if(!simulated) // Simulated searches need no buffers.
+            copy.SetInvokeType(InvokeType::AutoTune);
         return copy;
     }();
 
     auto& profile_h = context.GetStream();
     const AutoEnableProfiling enableProfiling{profile_h};
 
+    const auto problem_key =
+        simulated || is_recorded ? SerializeSearchKey(problem) : std::string{};
+    const auto measure = [&](const ConvSolution& solution,
+                             const PerformanceConfig& config,
+                             const Invoker& invoker,
+                             std::size_t index,
+                             int repeat) {
+        auto candidate = SearchCandidate{};
+        if(simulated || is_recorded)
+        {
+            candidate.solver     = s.SolverDbId();
+            candidate.problem    = problem_key;
+            candidate.config     = SerializeSearchKey(config);
+            candidate.solution   = &solution;
+            candidate.index      = index;
+            candidate.repeat     = repeat;
+            candidate.is_default = &solution == &default_solution;
+        }
+        if(simulated)
+            return cost_model->Measure(candidate);
+
+        invoker(profile_h, invoke_ctx);
+        const auto time = profile_h.GetKernelTime();
+        if(is_recorded)
+            RecordSearchTime(candidate, time);
+        return time;
+    };
+
     auto tmp_all_configs = GetAllConfigs(s, context, problem);
     // For random access
     std::vector<PerformanceConfig> all_configs;
     std::copy(tmp_all_configs.begin(), tmp_all_configs.end(), std::back_inserter(all_configs));
-    // shuffle the configs
-    std::random_device rd{};
-    auto rng = std::default_random_engine{rd()};
-    std::shuffle(all_configs.begin(), all_configs.end(), rng);
+
+    // A checkpointed search evaluates only its slice of the configs, and only the configs it did
+    // not evaluate before it was interrupted.
+    auto* const checkpoint = context.search_checkpoint;
+    std::vector<std::pair<PerformanceConfig, float>> restored;
+    if(checkpoint != nullptr)
+    {
+        const auto range = checkpoint->GetRange(all_configs.size());
+        std::vector<PerformanceConfig> remaining;
+        for(auto i = range.first; i < range.second; ++i)
+        {
+            const auto time = checkpoint->Find(SerializeSearchKey(all_configs[i]));
+            if(time)
+                restored.emplace_back(all_configs[i], *time);
+            else
+                remaining.push_back(all_configs[i]);
+        }
+        MIOPEN_LOG_I(s.SolverDbId() << ": Checkpointed slice [" << range.first << ", "
+                                    << range.second << "), " << restored.size()
+                                    << " configs evaluated before");
+        all_configs = std::move(remaining);
+    }
     const std::size_t n_runs_total = std::min(all_configs.size(), GetTuningIterationsMax());
-    all_configs.resize(n_runs_total);
+
+    // Compile-only runs build the kernels of every config, in random order.
+    const auto compile_only = !simulated && IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{});
+    const auto strategy     = [&]() {
+        std::vector<std::string> keys;
+        keys.reserve(all_configs.size());
+        for(const auto& config : all_configs)
+            keys.push_back(SerializeSearchKey(config));
+        const auto name = compile_only ? std::string{"random"} : GetSearchStrategyName(context);
+        return MakeSearchStrategy(name, keys, std::random_device{}());
+    }();
+    MIOPEN_LOG_I(s.SolverDbId() << ": search strategy: " << strategy->Name());
 
     bool is_passed  = false; // left false only if all iterations failed.
     float best_time = std::numeric_limits<float>::max();
@@ -391,33 +462,79 @@ auto GenericSearch(const Solver s,
     HeartBeat<PerformanceConfig> heartbeat;
     heartbeat.Start();
 
-    const auto total_threads = GetTuningThreadsMax();
-
-    ThreadSafeQueue<std::tuple<PerformanceConfig, ConvSolution, bool>> solution_queue;
-    std::vector<std::thread> compile_agents;
-    compile_agents.reserve(total_threads);
-    for(auto idx = 0; idx < total_threads; ++idx)
+    for(const auto& config_time : restored)
     {
-        compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
-                                    idx,
-                                    total_threads,
-                                    std::cref(s),
-                                    std::cref(context),
-                                    std::cref(problem),
-                                    std::ref(all_configs),
-                                    std::ref(solution_queue));
+        if(config_time.second >= 0.0f && config_time.second < best_time)
+        {
+            is_passed   = true;
+            best_config = config_time.first;
+            best_time   = config_time.second;
+        }
     }
 
-    if(!IsEnabled(MIOPEN_DEBUG_COMPILE_ONLY{}))
+    const auto total_threads = simulated ? 0 : GetTuningThreadsMax();
+    const auto start_time    = std::chrono::steady_clock::now();
+    size_t n_current         = 0;
+    bool is_out_of_time      = false;
+
+    // Adaptive strategies need the times of a batch to propose the next one, so their configs
+    // are compiled one batch at a time.
+    while(n_current < n_runs_total && !is_out_of_time)
     {
-        size_t n_current       = 0;
+        if(std::chrono::steady_clock::now() - start_time > GetTuningTimeMax())
+        {
+            MIOPEN_LOG_I2("Done, exhausted time budget");
+            break;
+        }
+
+        const auto batch_size =
+            strategy->IsAdaptive() ? std::max<std::size_t>(total_threads, 1) : n_runs_total;
+        const auto batch = strategy->Propose(std::min(batch_size, n_runs_total - n_current));
+        if(batch.empty())
+            break;
+
+        std::vector<PerformanceConfig> batch_configs;
+        batch_configs.reserve(batch.size());
+        for(const auto index : batch)
+            batch_configs.push_back(all_configs[index]);
+
+        ThreadSafeQueue<CompiledConfig<PerformanceConfig>> solution_queue;
+        std::vector<std::thread> compile_agents;
+        compile_agents.reserve(total_threads);
+        for(auto idx = 0; idx < total_threads; ++idx)
+        {
+            compile_agents.emplace_back(CompileAgent<PerformanceConfig, Solver, Context, Problem>,
+                                        idx,
+                                        total_threads,
+                                        std::cref(s),
+                                        std::cref(context),
+                                        std::cref(problem),
+                                        std::ref(batch_configs),
+                                        std::ref(solution_queue));
+        }
+
+        if(compile_only)
+        {
+            for(auto& agent : compile_agents)
+                agent.join();
+            MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
+                         "Running kernels on GPU is disabled. Search skipped");
+        }
+
+        size_t n_batch         = 0;
         auto threads_remaining = total_threads;
-        while(true)
+        while(n_batch < batch.size())
         {
-            if(n_current >= n_runs_total)
-                break;
-            MIOPEN_LOG_I2("Waiting for item in queue");
-            const auto kinder     = solution_queue.pop();
+            const auto kinder = [&]() {
+                if(simulated)
+                {
+                    const auto& config = batch_configs[n_batch];
+                    return CompiledConfig<PerformanceConfig>{
+                        config, s.GetSolution(context, problem, config), false, n_batch};
+                }
+                MIOPEN_LOG_I2("Waiting for item in queue");
+                return solution_queue.pop();
+            }();
             auto current_config   = std::get<0>(kinder);
             auto current_solution = std::get<1>(kinder);
 
@@ -425,7 +542,10 @@ auto GenericSearch(const Solver s,
             {
                 threads_remaining--;
                 if(threads_remaining == 0)
+                {
+                    is_out_of_time = true;
                     break;
+                }
                 else
                 {
                     continue;
@@ -450,10 +570,10 @@ auto GenericSearch(const Solver s,
                                      << " != " << current_solution.workspace_sz);
                 }
 
-                invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
-                                                   current_solution.construction_params);
-                invoker(profile_h, invoke_ctx);
-                elapsed_time = profile_h.GetKernelTime();
+                if(!simulated)
+                    invoker = profile_h.PrepareInvoker(*current_solution.invoker_factory,
+                                                       current_solution.construction_params);
+                elapsed_time = measure(current_solution, current_config, invoker, n_current, 0);
             }
             catch(const std::exception& e)
             {
@@ -484,10 +604,10 @@ auto GenericSearch(const Solver s,
 
                     try
                     {
-                        for(int i = 0; i < 4; ++i)
+                        for(int i = 1; i <= 4; ++i)
                         {
-                            invoker(profile_h, invoke_ctx);
-                            elapsed_time += profile_h.GetKernelTime();
+                            elapsed_time +=
+                                measure(current_solution, current_config, invoker, n_current, i);
                         }
                     }
                     catch(...)
@@ -520,8 +640,11 @@ auto GenericSearch(const Solver s,
             // Banchmarked kernels will not be used anymore.
             // Now we can delete Program objects that belong to OCL/HIP
             // runtime and free the associated resources (memory, file handles...)
-            for(const auto& kernelInfo : current_solution.construction_params)
-                profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+            if(!simulated)
+            {
+                for(const auto& kernelInfo : current_solution.construction_params)
+                    profile_h.ClearProgram(kernelInfo.kernel_file, kernelInfo.comp_options);
+            }
 
             if(ret != 0)
             {
@@ -536,17 +659,18 @@ auto GenericSearch(const Solver s,
                               n_failed,
                               n_runs_total,
                               current_config);
+            if(checkpoint != nullptr)
+                checkpoint->Record(SerializeSearchKey(current_config),
+                                   ret == 0 ? elapsed_time : -1.0f);
+
+            strategy->Report(batch[std::get<3>(kinder)], elapsed_time, ret != 0);
             ++n_current;
+            ++n_batch;
         }
-    }
-    else
-    {
-        MIOPEN_THROW(miopenStatusGpuOperationsSkipped,
-                     "Running kernels on GPU is disabled. Search skipped");
-    }
 
-    for(auto& agent : compile_agents)
-        agent.join();
+        for(auto& agent : compile_agents)
+            agent.join();
+    }
 
     MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
                           << n_best << ' ' << best_time << ' ' << best_config);
@@ -555,10 +679,15 @@ auto GenericSearch(const Solver s,
         MIOPEN_THROW("Search failed");
     // Run once with the default config and show score.
 
-    const auto& invoker = profile_h.PrepareInvoker(*default_solution.invoker_factory,
-                                                   default_solution.construction_params);
-    invoker(profile_h, invoke_ctx);
-    const auto default_time = profile_h.GetKernelTime();
+    const auto invoker =
+        simulated ? Invoker{}
+                  : profile_h.PrepareInvoker(*default_solution.invoker_factory,
+                                             default_solution.construction_params);
+    const auto default_time = measure(default_solution,
+                                      s.GetDefaultPerformanceConfig(context, problem),
+                                      invoker,
+                                      n_runs_total,
+                                      0);
     const auto score        = (best_time > 0.0f) ? default_time / best_time : 0.0f;
     MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
 
@@ -62,6 +62,7 @@
 namespace miopen {
 
 struct HandleImpl;
+struct CheckNumericsPool;
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -224,6 +225,7 @@ public:
 #if MIOPEN_USE_MIOPENGEMM
     std::unordered_map<GemmKey, std::unique_ptr<GemmGeometry>, SimpleHash> geo_map;
 #endif
+    mutable std::shared_ptr<CheckNumericsPool> check_numerics_pool;
 
     Invoker PrepareInvoker(const InvokerFactory& factory,
                            const std::vector<solver::KernelInfo>& kernels) const;
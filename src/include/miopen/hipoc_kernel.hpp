@@ -158,6 +158,13 @@ struct HIPOCKernelInvoke
         run(hip_args, sz_left);
     }
 
+    template <class... Ts>
+    void operator()(const PackedKernelArgs<Ts...>& args) const
+    {
+        // The launch only reads the buffer.
+        run(const_cast<char*>(args.data()), args.size()); // NOLINT
+    }
+
     template <class... Ts>
     void operator()(Ts... xs) const
     {
@@ -63,6 +63,7 @@ struct HIPOCProgram
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
     void FreeCodeObjectFileStorage();
+    const BuildStageTimes& GetBuildStageTimes() const;
 };
 } // namespace miopen
 
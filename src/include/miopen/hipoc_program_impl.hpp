@@ -33,9 +33,35 @@
 #include <boost/optional.hpp>
 #include <hip/hip_runtime_api.h>
 
+#include <functional>
+#include <string>
+#include <vector>
+
 namespace miopen {
 
 using hipModulePtr = MIOPEN_MANAGE_PTR(hipModule_t, hipModuleUnload);
+
+/// Wall-clock time spent in each stage of building a program.
+struct BuildStageTimes
+{
+    float source_ms  = 0.0f; ///< Obtaining the kernel source.
+    float compile_ms = 0.0f; ///< Producing the code object.
+    float load_ms    = 0.0f; ///< Loading the code object into a module.
+};
+
+/// Builds a code object from the source text. Fills the binary or leaves it
+/// empty on failure.
+using CodeObjectBuilder = std::function<void(const std::string& filename,
+                                             const std::string& src,
+                                             const std::string& params,
+                                             const TargetProperties& target,
+                                             std::vector<char>& binary)>;
+
+/// Replaces the compiler used by HIPOCProgramImpl::BuildCodeObject().
+/// Intended for testing the build pipeline without a GPU or compiler.
+/// An empty builder restores the default behavior.
+void SetCodeObjectBuilder(CodeObjectBuilder builder);
+
 struct HIPOCProgramImpl
 {
     HIPOCProgramImpl(){};
@@ -55,6 +81,7 @@ struct HIPOCProgramImpl
     hipModulePtr module;
     boost::optional<TmpDir> dir;
     std::vector<char> binary;
+    BuildStageTimes stage_times;
 
 #if !MIOPEN_USE_COMGR
     void
@@ -32,7 +32,7 @@
 
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
-#include <miopen/md5.hpp>
+#include <miopen/content_hash.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
@@ -129,15 +129,14 @@ public:
         if(rc == SQLITE_ROW)
         {
             auto compressed_blob           = stmt.ColumnBlob(0);
-            auto md5_hash                  = stmt.ColumnText(1);
+            auto kernel_hash               = stmt.ColumnText(1);
             auto uncompressed_size         = stmt.ColumnInt64(2);
             std::string& decompressed_blob = compressed_blob;
             if(uncompressed_size != 0)
             {
                 decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
             }
-            auto new_md5 = md5(decompressed_blob);
-            if(new_md5 != md5_hash)
+            if(!VerifyContentHash(decompressed_blob, kernel_hash))
                 MIOPEN_THROW(miopenStatusInternalError, "Possible database corruption");
             return decompressed_blob;
         }
@@ -156,7 +155,7 @@ public:
         auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
                             "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
-        auto md5_sum           = md5(problem_config.kernel_blob);
+        auto kernel_hash       = ContentHash(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
         auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
@@ -173,7 +172,7 @@ public:
             stmt.BindBlob(3, compressed_blob);
             stmt.BindInt64(5, uncompressed_size);
         }
-        stmt.BindText(4, md5_sum);
+        stmt.BindText(4, kernel_hash);
 
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
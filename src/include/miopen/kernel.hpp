@@ -26,17 +26,45 @@
 #ifndef GUARD_MIOPEN_KERNEL_HPP
 #define GUARD_MIOPEN_KERNEL_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <miopen/config.h>
 
 namespace miopen {
-std::string GetKernelSrc(std::string name);
-std::string GetKernelInc(std::string key);
-const std::string* GetKernelIncPtr(std::string key);
-std::vector<std::string> GetKernelIncList();
-std::vector<std::string> GetHipKernelIncList();
+
+/// Kernel source or include file embedded into the library by addkernels.
+/// The embedded text is always followed by a terminating zero, so the
+/// data of the view returned by Text() can be used as a C string.
+struct EmbeddedFile
+{
+    std::string_view name;
+    const unsigned char* data = nullptr;
+    const std::size_t* size   = nullptr;
+
+    std::string_view Text() const { return {reinterpret_cast<const char*>(data), *size}; }
+};
+
+/// Binary search in a range of embedded files sorted by name.
+inline const EmbeddedFile*
+FindEmbeddedFile(const EmbeddedFile* begin, const EmbeddedFile* end, std::string_view name)
+{
+    const auto it = std::lower_bound(
+        begin, end, name, [](const EmbeddedFile& file, std::string_view key) {
+            return file.name < key;
+        });
+    if(it == end || it->name != name)
+        return nullptr;
+    return it;
+}
+
+std::string_view GetKernelSrc(std::string_view name);
+std::string_view GetKernelInc(std::string_view key);
+const std::vector<std::string>& GetKernelIncList();
+const std::vector<std::string>& GetHipKernelIncList();
 } // namespace miopen
 
 #if MIOPEN_BACKEND_OPENCL
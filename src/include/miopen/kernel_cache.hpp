@@ -46,8 +46,10 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace miopen {
@@ -88,11 +90,22 @@ public:
 
     void AddProgram(Program prog, const std::string& program_name, std::string params);
 
+    /// Takes programs from and publishes them to the process-wide SharedProgramCache, under a
+    /// scope which identifies the device and target they are built for.
+    void SharePrograms(std::string scope);
+
     KernelCache();
+    KernelCache(const KernelCache&) = delete;
+    KernelCache& operator=(const KernelCache&) = delete;
+    ~KernelCache();
 
 private:
     KernelMap kernel_map;
     ProgramMap program_map;
+    std::string shared_scope;
+    std::unordered_set<Key, SimpleHash> shared_programs;
+
+    Program AcquireSharedProgram(const Key& key, const std::function<Program()>& load);
 };
 
 } // namespace miopen
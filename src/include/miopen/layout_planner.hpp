@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct Problem;
+
+struct LayoutChoice
+{
+    std::string layout;
+    /// Estimated time of the operation in this layout, only used to break ties.
+    float time = 0;
+};
+
+/// One operation of a chain in which the output of each operation is the input of the next one.
+struct LayoutPlanStep
+{
+    /// Layouts the operation runs in without transposing, the output has the same layout as the
+    /// input.
+    std::vector<LayoutChoice> layouts;
+    std::size_t input_bytes  = 0;
+    std::size_t output_bytes = 0;
+};
+
+struct LayoutTransform
+{
+    /// The transform runs before this step, steps.size() is after the last step.
+    std::size_t position;
+    std::string from;
+    std::string to;
+    std::size_t bytes;
+};
+
+struct LayoutPlan
+{
+    std::vector<std::string> layouts;
+    std::vector<LayoutTransform> transforms;
+    /// Bytes read and written by the planned transforms.
+    std::size_t bytes_moved = 0;
+    /// Bytes read and written if every operation transposed its input and output on its own, as
+    /// the transposing solvers do.
+    std::size_t unplanned_bytes_moved = 0;
+
+    friend std::ostream& operator<<(std::ostream& stream, const LayoutPlan& plan);
+};
+
+/// Chooses the layout each step runs in so that the chain moves the least bytes through
+/// transposes, then does the fewest transposes, then takes the least estimated time. The chain
+/// takes input_layout and has to produce output_layout. Throws if a step has no layouts.
+LayoutPlan PlanLayouts(const std::vector<LayoutPlanStep>& steps,
+                       const std::string& input_layout,
+                       const std::string& output_layout);
+
+/// Same for a chain of Find 2.0 problems, with each step's layouts taken from the immediate mode
+/// solutions of the problem for each layout in candidates. Weights are expected to be converted
+/// once ahead of time, so only the activations count.
+LayoutPlan PlanLayouts(Handle& handle,
+                       const std::vector<Problem>& problems,
+                       const std::vector<std::string>& candidates,
+                       const std::string& input_layout,
+                       const std::string& output_layout);
+
+} // namespace miopen
@@ -33,9 +33,14 @@
 #include <boost/date_time/posix_time/ptime.hpp>
 #include <boost/date_time/time.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
+#include <boost/optional.hpp>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <map>
@@ -122,6 +127,27 @@ public:
         access_mutex.unlock_shared();
     }
 
+    // Takes only the in-process side of a shared lock. This is for readers that know from
+    // GetGeneration() that no other process has written since they last held the file lock.
+    void lock_shared_local() { access_mutex.lock_shared(); }
+    void unlock_shared_local() { access_mutex.unlock_shared(); }
+
+    // Counter of writes under this lock, kept in the lock file and mapped into every process
+    // using it, so reading it costs no syscall. Empty if the file could not be mapped.
+    boost::optional<std::uint64_t> GetGeneration() const
+    {
+        if(generation == nullptr)
+            return boost::none;
+        return generation->load(std::memory_order_acquire);
+    }
+
+    // Has to be called by writers while they hold the exclusive lock.
+    void BumpGeneration()
+    {
+        if(generation != nullptr)
+            generation->fetch_add(1, std::memory_order_acq_rel);
+    }
+
     static LockFile& Get(const char* path);
 
     template <class TDuration>
@@ -168,6 +194,13 @@ private:
     const char* path; // For logging purposes
     std::shared_timed_mutex access_mutex;
     boost::interprocess::file_lock flock;
+    boost::interprocess::mapped_region generation_region;
+    std::atomic<std::uint64_t>* generation = nullptr;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "The generation counter is shared between processes");
+
+    void MapGeneration();
 
     static std::map<std::string, LockFile>& LockFiles()
     {
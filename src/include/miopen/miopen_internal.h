@@ -104,6 +104,44 @@ MIOPEN_EXPORT miopenStatus_t miopenGetConvolutionFindMode(
 
 /* End of Find Mode API */
 
+/* Begin of Warm Start API */
+
+/*! @brief Loads a Find 2.0 problem from its JSON serialization.
+ *
+ * @param problem    Pointer to the problem to initialize (output)
+ * @param data       JSON text of the problem (input)
+ * @param size       Size of the JSON text (input)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenLoadProblem(miopenProblem_t* problem,
+                                               const char* data,
+                                               size_t size);
+
+/*! @brief Compiles and caches the kernels of a model's problems before their first use.
+ *
+ * The solution of each problem is taken from the Find-db, or from the Immediate mode fallback on
+ * a miss; nothing is benchmarked. The kernels of all the problems are compiled in parallel, then
+ * the invokers are prepared and cached in the handle, so that the subsequent Find and Immediate
+ * mode calls with these problems skip compilation and loading. A problem that cannot be prepared
+ * does not stop the others.
+ *
+ * @param handle       MIOpen handle (input)
+ * @param problems     Problems of the model (input)
+ * @param numProblems  Number of problems (input)
+ * @param layerTimes   Time in ms spent on each problem, excluding the shared compilation, or -1 if
+ *                     the problem could not be prepared. Ignored if null (output)
+ * @param compileTime  Time in ms spent compiling the kernels of all the problems. Ignored if null
+ *                     (output)
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWarmStartProblems(miopenHandle_t handle,
+                                                     const miopenProblem_t* problems,
+                                                     size_t numProblems,
+                                                     float* layerTimes,
+                                                     float* compileTime);
+
+/* End of Warm Start API */
+
 #ifdef __cplusplus
 }
 #endif
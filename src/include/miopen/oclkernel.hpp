@@ -111,6 +111,24 @@ struct OCLKernelInvoke
         run();
     }
 
+    template <class... Ts>
+    void operator()(const PackedKernelArgs<Ts...>& args) const
+    {
+        using Layout = typename PackedKernelArgs<Ts...>::Layout;
+        for(size_t idx = 0; idx < Layout::count; idx++)
+        {
+            const cl_int status = clSetKernelArg(
+                kernel.get(), idx, Layout::sizes[idx], args.data() + Layout::offsets[idx]);
+            if(status != CL_SUCCESS)
+            {
+                MIOPEN_THROW("Error setting argument #" + std::to_string(idx) +
+                             " to kernel (size = " + std::to_string(Layout::sizes[idx]) +
+                             "): " + OpenCLErrorMessage(status));
+            }
+        }
+        run();
+    }
+
     template <class... Ts>
     void operator()(const Ts&... xs) const
     {
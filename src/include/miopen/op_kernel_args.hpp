@@ -1,8 +1,12 @@
 #ifndef MIOPEN_GUARD_MLOPEN_OP_KERNEL_ARGS_HPP
 #define MIOPEN_GUARD_MLOPEN_OP_KERNEL_ARGS_HPP
 
-#include <type_traits>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
 #include <half.hpp>
 #include <boost/container/small_vector.hpp>
 
@@ -32,4 +36,87 @@ struct OpKernelArg
     bool is_ptr = false;
 };
 
+namespace detail {
+
+template <std::size_t N>
+constexpr std::array<std::size_t, N> KernelArgOffsets(const std::array<std::size_t, N>& sizes)
+{
+    // Same rule as the std::vector<OpKernelArg> launch: each argument is aligned to its size.
+    std::array<std::size_t, N> offsets{};
+    std::size_t end = 0;
+    for(std::size_t i = 0; i < N; ++i)
+    {
+        end += (sizes[i] - (end % sizes[i])) % sizes[i];
+        offsets[i] = end;
+        end += sizes[i];
+    }
+    return offsets;
+}
+
+} // namespace detail
+
+template <class... Ts>
+struct KernelArgsLayout
+{
+    static_assert(sizeof...(Ts) > 0, "Kernel must have arguments");
+
+    static constexpr std::size_t count                     = sizeof...(Ts);
+    static constexpr std::array<std::size_t, count> sizes   = {sizeof(Ts)...};
+    static constexpr std::array<std::size_t, count> offsets = detail::KernelArgOffsets(sizes);
+    static constexpr std::size_t size                      = offsets.back() + sizes.back();
+};
+
+/// Kernel arguments packed into the buffer passed to the launch, with the layout computed at
+/// compile time. Invokers pack the arguments that do not change between launches once and only
+/// Set() the buffer pointers before each launch, instead of rebuilding and repacking a
+/// std::vector<OpKernelArg>.
+template <class... Ts>
+class PackedKernelArgs
+{
+    template <std::size_t I>
+    using Arg = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+public:
+    using Layout = KernelArgsLayout<Ts...>;
+
+    PackedKernelArgs(Ts... xs) // NOLINT
+    {
+        std::size_t i = 0;
+        (Store(Layout::offsets[i++], xs), ...);
+    }
+
+    template <std::size_t I>
+    void Set(Arg<I> x)
+    {
+        Store(Layout::offsets[I], x);
+    }
+
+    template <std::size_t I>
+    Arg<I> Get() const
+    {
+        Arg<I> x;
+        std::memcpy(&x, buffer + Layout::offsets[I], sizeof(x));
+        return x;
+    }
+
+    const char* data() const { return buffer; }
+    static constexpr std::size_t size() { return Layout::size; }
+
+private:
+    template <class T>
+    void Store(std::size_t offset, const T& x)
+    {
+        static_assert(std::is_trivially_copyable<T>{}, "Only for trivially copyable types");
+        std::memcpy(buffer + offset, &x, sizeof(T));
+    }
+
+    alignas(std::max_align_t) char buffer[Layout::size] = {};
+};
+
+template <class... Ts>
+PackedKernelArgs<Ts...> PackKernelArgs(Ts... xs)
+{
+    return {xs...};
+}
+
 #endif
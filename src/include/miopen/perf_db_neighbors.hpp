@@ -0,0 +1,149 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/db_compaction.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+struct Handle;
+
+namespace conv {
+struct ProblemDescription;
+} // namespace conv
+
+struct PerfDbNeighbor
+{
+    std::string key;
+    std::string values;
+    /// Distance between the problems in the log scaled feature space of the index.
+    float distance = 0;
+};
+
+/// Perf-db records indexed by the geometry of their problems, so that a solver without a record
+/// for a problem can start from the configs tuned for the closest ones. Only records of the same
+/// solver, direction, data types, layouts and number of spatial dims are neighbors. Each of these
+/// groups is a KD-tree over the log2 of the tensor sizes, filter sizes, strides, dilations, pads
+/// and group count.
+class PerfDbNeighborIndex
+{
+public:
+    PerfDbNeighborIndex() = default;
+    /// Records whose key does not restore a problem are left out.
+    explicit PerfDbNeighborIndex(const DbContents& contents);
+
+    /// Up to count records of the solver, nearest first. The record of the problem itself is
+    /// skipped, so that the index can be evaluated on the records it holds.
+    std::vector<PerfDbNeighbor> Find(const conv::ProblemDescription& problem,
+                                     const std::string& solver,
+                                     std::size_t count) const;
+
+    std::size_t Size() const { return records.size(); }
+
+    /// The index of the system and user perf-dbs of the context. It is built on first use and
+    /// not updated with the records tuned afterwards.
+    static const PerfDbNeighborIndex& GetCached(const ExecutionContext& ctx);
+
+private:
+    using Features = std::array<float, 19>;
+
+    struct Point
+    {
+        Features features;
+        std::size_t record;
+    };
+
+    /// Points are ordered so that each range is split at its middle point, along the feature
+    /// stored for it.
+    struct Tree
+    {
+        std::vector<Point> points;
+        std::vector<std::uint8_t> split;
+    };
+
+    using Heap = std::priority_queue<std::pair<float, std::size_t>>;
+
+    std::vector<std::pair<std::string, std::string>> records;
+    std::unordered_map<std::string, Tree> trees;
+
+    static Features GetFeatures(const conv::ProblemDescription& problem);
+    static std::string GetGroup(const conv::ProblemDescription& problem, const std::string& solver);
+    static void Build(Tree& tree, std::size_t begin, std::size_t end);
+    void Search(const Tree& tree,
+                const Features& features,
+                const std::string& skip_key,
+                std::size_t count,
+                std::size_t begin,
+                std::size_t end,
+                Heap& heap) const;
+};
+
+/// How many of the nearest tuned configs FindSolution() tries when a solver has no valid record
+/// of a problem, before it falls back to the default config. Set with
+/// MIOPEN_DEBUG_PERFDB_NEIGHBORS, 0 (the default) disables the lookup.
+std::size_t GetPerfDbNeighborCount();
+
+struct PerfDbReplayStats
+{
+    std::size_t entries = 0;
+    /// Entries for which the index had at least one neighbor.
+    std::size_t found = 0;
+    /// Entries whose values are the ones of the nearest neighbor.
+    std::size_t nearest_match = 0;
+    /// Entries whose values are the ones of any of the neighbors.
+    std::size_t any_match = 0;
+    /// Entries whose values are the default config of the solver. Only counted with a handle.
+    std::size_t default_match = 0;
+    /// Entries for which one of the neighbors is a valid config. Only counted with a handle.
+    std::size_t valid = 0;
+    /// Entries that have not been checked with a handle, as their solver is not applicable.
+    std::size_t unchecked = 0;
+    /// Mean distance to the nearest neighbor.
+    double distance = 0;
+
+    friend std::ostream& operator<<(std::ostream& stream, const PerfDbReplayStats& stats);
+};
+
+/// Replays the lookup for every entry as if its record was missing, and compares the configs of
+/// the neighbors with the tuned one. With a handle, the neighbors are also checked against the
+/// performance configs the solver accepts on its device, and the tuned configs are compared with
+/// the defaults.
+PerfDbReplayStats
+ReplayPerfDbNeighbors(const DbContents& contents, std::size_t count, Handle* handle);
+
+} // namespace miopen
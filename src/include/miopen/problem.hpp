@@ -30,6 +30,7 @@
 
 #include <miopen/allocator.hpp>
 #include <miopen/convolution.hpp>
+#include <miopen/layout_planner.hpp>
 #include <miopen/object.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/tensor.hpp>
@@ -88,6 +89,12 @@ struct Problem : miopenProblem
 
     Problem MakeTransposed() const;
 
+    /// The problem as a step of a layout plan: the candidate layouts in which it has immediate mode
+    /// solutions once all its tensors are changed to that layout. Solutions of solvers that
+    /// transpose to another layout internally don't count.
+    LayoutPlanStep MakeLayoutPlanStep(Handle& handle,
+                                      const std::vector<std::string>& candidates) const;
+
     static void ValidateGroupCount(const TensorDescriptor& xDesc,
                                    const TensorDescriptor& wDesc,
                                    const ConvolutionDescriptor& conv);
@@ -109,6 +116,10 @@ private:
                                             const ConvolutionDescriptor& conv_desc) const;
 
     void TransposeImpl(const ConvolutionDescriptor& conv_desc);
+
+    LayoutPlanStep MakeLayoutPlanStepImpl(Handle& handle,
+                                          const std::vector<std::string>& candidates,
+                                          const ConvolutionDescriptor& conv_desc) const;
 };
 
 } // namespace miopen
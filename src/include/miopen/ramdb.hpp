@@ -31,6 +31,7 @@
 #include <boost/optional.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <sstream>
@@ -131,9 +132,16 @@ private:
     ramdb_clock::time_point file_read_time;
     std::map<std::string, CacheItem> cache;
 
+    // While the lease holds, the cache is known to be valid and lookups take only the in-process
+    // shared lock. It is dropped as soon as any process writes under the lock file.
+    boost::optional<std::uint64_t> lease_generation;
+    ramdb_clock::time_point lease_expiry;
+
     boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
 
     bool ValidateUnsafe();
+    bool HasLeaseUnsafe();
+    void RenewLeaseUnsafe();
     void Prefetch();
 
 #if MIOPEN_DB_CACHE_WRITE_THROUGH
@@ -0,0 +1,451 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/errors.hpp>
+#include <miopen/miopen.h>
+#include <miopen/reduce_tunables.hpp>
+
+#include <cassert>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include <../composable_kernel/composable_kernel/include/utility/data_type_enum.hpp>
+#include <../composable_kernel/composable_kernel/include/utility/reduction_enums.hpp>
+
+namespace miopen {
+
+namespace reduce {
+
+enum ReductionMethod_t
+{
+    Reduce_DirectThreadWise = 1,
+    Reduce_DirectWarpWise   = 2,
+    Reduce_BlockWise        = 3,
+    Reduce_MultiBlock       = 4
+};
+
+namespace detail {
+
+struct ReductionKernelConfigurator
+{
+    ReductionKernelConfigurator() = default;
+
+    ReductionKernelConfigurator(int blockSize, int warpSize)
+        : blockSize_(blockSize), warpSize_(warpSize)
+    {
+        GredDirectThreadWiseUpperReductionLen = warpSize;
+        GredDirectWarpWiseUpperReductionLen   = blockSize;
+        GredBlockWiseUpperReductionLen        = static_cast<size_t>(blockSize) * 4;
+        GredUpperNumBlocksPerReduction        = 32;
+
+        numWarpsPerBlock = blockSize / warpSize;
+    };
+
+    int blockSize_;
+    int warpSize_;
+    int numWarpsPerBlock;
+
+    std::size_t GredDirectThreadWiseUpperReductionLen;
+    std::size_t GredDirectWarpWiseUpperReductionLen;
+    std::size_t GredBlockWiseUpperReductionLen;
+    std::size_t GredUpperNumBlocksPerReduction;
+
+    std::size_t getGridSize(std::size_t invariantLength, std::size_t toReduceLength) const
+    {
+        assert(invariantLength > 0 && toReduceLength > 1);
+
+        if(invariantLength == 1)
+        {
+            if(toReduceLength <=
+               GredBlockWiseUpperReductionLen) // let one block to do this only reduction
+                return (1);
+            else
+                return ((toReduceLength + blockSize_ - 1) /
+                        blockSize_); // let multiple blocks to do this only reduction
+        }
+        else
+        {
+            if(toReduceLength <=
+               GredDirectThreadWiseUpperReductionLen) // let one thread to do each reduction
+                return ((invariantLength + blockSize_ - 1) / blockSize_);
+            else if(toReduceLength <=
+                    GredDirectWarpWiseUpperReductionLen) // let one warp to do each reduction
+                return ((invariantLength + numWarpsPerBlock - 1) / numWarpsPerBlock);
+            else if(toReduceLength <=
+                    GredBlockWiseUpperReductionLen) // let one block to do each reduction
+                return (invariantLength);
+            else
+            { // let multiple blocks to do each reduction
+                std::size_t expBlocksPerReduction =
+                    (toReduceLength + GredBlockWiseUpperReductionLen - 1) /
+                    GredBlockWiseUpperReductionLen;
+
+                if(expBlocksPerReduction > GredUpperNumBlocksPerReduction)
+                    return (invariantLength * GredUpperNumBlocksPerReduction);
+                else
+                    return (invariantLength * expBlocksPerReduction);
+            };
+        };
+    };
+
+    ReductionMethod_t getReductionMethod(std::size_t invariantLength,
+                                         std::size_t toReduceLength) const
+    {
+        assert(invariantLength > 0 && toReduceLength > 1);
+
+        if(invariantLength == 1)
+        {
+            if(toReduceLength <=
+               GredBlockWiseUpperReductionLen) // let one block to do this only reduction
+                return (Reduce_BlockWise);
+            else // let multiple blocks to do this only reduction
+                return (Reduce_MultiBlock);
+        }
+        else
+        {
+            if(toReduceLength <=
+               GredDirectThreadWiseUpperReductionLen) // let one thread to do each reduction
+                return (Reduce_DirectThreadWise);
+            else if(toReduceLength <=
+                    GredDirectWarpWiseUpperReductionLen) // let one warp to do each reduction
+                return (Reduce_DirectWarpWise);
+            else if(toReduceLength <=
+                    GredBlockWiseUpperReductionLen) // let one block to do each reduction
+                return (Reduce_BlockWise);
+            else
+                return (Reduce_MultiBlock); // let multiple blocks to do each reduction
+        };
+    };
+
+    std::size_t getWorkspaceSize(std::size_t invariantLength, std::size_t toReduceLength) const
+    {
+        assert(invariantLength > 0 && toReduceLength > 1);
+
+        if(getReductionMethod(invariantLength, toReduceLength) == Reduce_MultiBlock)
+        {
+            auto gridSize = getGridSize(invariantLength, toReduceLength);
+
+            return (gridSize);
+        };
+
+        return (0);
+    };
+
+    std::size_t getGridSize_2(std::size_t invariantLength, std::size_t toReduceLength) const
+    {
+        if(toReduceLength <= warpSize_ / 4) // let one thread to do each reduction
+            return ((invariantLength + blockSize_ - 1) / blockSize_);
+        else if(toReduceLength <= blockSize_) // let one warp to do each reduction
+            return ((invariantLength + numWarpsPerBlock - 1) / numWarpsPerBlock);
+        else
+            return (invariantLength); // let one block to do each reduction
+    };
+
+    ReductionMethod_t GetReductionMethod_2(std::size_t toReduceLength) const
+    {
+        if(toReduceLength <= warpSize_ / 4) // let one thread to do each reduction
+            return (Reduce_DirectThreadWise);
+        else if(toReduceLength <= blockSize_) // let one warp to do each reduction
+            return (Reduce_DirectWarpWise);
+        else
+            return (Reduce_BlockWise);
+    };
+};
+
+inline int GetIndicesTypeSize(miopenIndicesType_t t)
+{
+    switch(t)
+    {
+    case MIOPEN_32BIT_INDICES: return (4);
+    case MIOPEN_64BIT_INDICES: return (8);
+    case MIOPEN_16BIT_INDICES: return (2);
+    case MIOPEN_8BIT_INDICES: return (1);
+    }
+    MIOPEN_THROW("Unknown data type");
+}
+
+inline int GetDataTypeSize(miopenDataType_t t)
+{
+    switch(t)
+    {
+    case miopenHalf: return (2);
+    case miopenFloat: return (4);
+    case miopenDouble: return (8);
+    case miopenInt8: return (1);
+    case miopenInt8x4: return (4);
+    case miopenBFloat16: return (2);
+    case miopenInt32: return (4);
+    default:
+        MIOPEN_THROW("Only float, half, double, bfloat16, int8, int8x4 data type is supported.");
+    };
+};
+
+// workspace_size is in elements of the source type, as returned by
+// ReductionKernelConfigurator::getWorkspaceSize()
+inline std::size_t
+GetWorkspaceSizeInBytes(std::size_t workspace_size, miopenDataType_t srcType, bool need_indices)
+{
+    if(!need_indices)
+        return workspace_size * GetDataTypeSize(srcType);
+
+    return workspace_size * (GetDataTypeSize(srcType) + sizeof(int)) + 64 + sizeof(int);
+};
+
+}; // end of namespace detail
+
+namespace detailStatic {
+
+struct get_tunable_reduction_kernel_constants
+{
+    int GredThreadBufferLength;
+    int GredAccessesPerThreadInBlock;
+    int GredAccessesPerThreadInWarp;
+
+    get_tunable_reduction_kernel_constants(ReductionMethod_t reduceImpl)
+    {
+        switch(reduceImpl)
+        {
+        case Reduce_DirectThreadWise:
+            GredThreadBufferLength       = 8;
+            GredAccessesPerThreadInBlock = 0;
+            GredAccessesPerThreadInWarp  = 0;
+            break;
+        case Reduce_BlockWise:
+            GredThreadBufferLength       = 0;
+            GredAccessesPerThreadInBlock = 2;
+            GredAccessesPerThreadInWarp  = 0;
+            break;
+        case Reduce_DirectWarpWise:
+            GredThreadBufferLength       = 0;
+            GredAccessesPerThreadInBlock = 0;
+            GredAccessesPerThreadInWarp  = 2;
+            break;
+        case Reduce_MultiBlock:
+            GredThreadBufferLength =
+                8; // needed since the second-time reduction could be DirectThreadWise
+            GredAccessesPerThreadInBlock =
+                2; // needed since the second-time reduction could be BlockWise
+            GredAccessesPerThreadInWarp =
+                2; // needed since the second-time reduction could be DirectWarpWise
+            break;
+        };
+    };
+};
+
+inline int GetDataTypeId(miopenDataType_t t)
+{
+    switch(t)
+    {
+    case miopenHalf: return (static_cast<int>('H'));
+    case miopenFloat: return (static_cast<int>('F'));
+    case miopenBFloat16: return (static_cast<int>('B'));
+    case miopenDouble: return (static_cast<int>('D'));
+    case miopenInt8:
+    case miopenInt8x4:
+    case miopenInt32: return (static_cast<int>('O'));
+    default: MIOPEN_THROW("Only float, half, bfloat16 data type is supported.");
+    };
+};
+
+inline int GetReduceTensorOpId(miopenReduceTensorOp_t t)
+{
+    switch(t)
+    {
+    case MIOPEN_REDUCE_TENSOR_ADD: return (656868);   // 'A' * 10000 + 'D' * 100 + 'D'
+    case MIOPEN_REDUCE_TENSOR_MUL: return (778576);   // 'M' * 10000 + 'U' * 100 + 'L'
+    case MIOPEN_REDUCE_TENSOR_MIN: return (777378);   // 'M' * 10000 + 'I' * 100 + 'N'
+    case MIOPEN_REDUCE_TENSOR_MAX: return (776588);   // 'M' * 10000 + 'A' * 100 + 'X'
+    case MIOPEN_REDUCE_TENSOR_AMAX: return (657788);  // 'A' * 10000 + 'M' * 100 + 'X'
+    case MIOPEN_REDUCE_TENSOR_AVG: return (658671);   // 'A' * 10000 + 'V' * 100 + 'G'
+    case MIOPEN_REDUCE_TENSOR_NORM1: return (788201); // 'N' * 10000 + 'R' * 100 + '1'
+    case MIOPEN_REDUCE_TENSOR_NORM2: return (788202); // 'N' * 10000 + 'R' * 100 + '2'
+
+    default: MIOPEN_THROW("Operation is not supported");
+    };
+};
+
+}; // end of namespace detailStatic
+
+namespace detailDynamic {
+
+inline ck::DataTypeEnum_t mapDataTypeId(miopenDataType_t t)
+{
+    using ck::DataTypeEnum_t;
+
+    switch(t)
+    {
+    case miopenHalf: return DataTypeEnum_t::Half;
+    case miopenFloat: return DataTypeEnum_t::Float;
+    case miopenBFloat16: return DataTypeEnum_t::BFloat16;
+    case miopenDouble: return DataTypeEnum_t::Double;
+    case miopenInt8: return DataTypeEnum_t::Int8;
+    case miopenInt8x4: return DataTypeEnum_t::Int8x4;
+    case miopenInt32: return DataTypeEnum_t::Int32;
+    default: MIOPEN_THROW("Only float, half, double data type is supported.");
+    };
+};
+
+inline ck::ReduceTensorOp_t mapReduceOpId(miopenReduceTensorOp_t t)
+{
+    using ck::ReduceTensorOp_t;
+
+    switch(t)
+    {
+    case MIOPEN_REDUCE_TENSOR_ADD: return ReduceTensorOp_t::ADD;
+    case MIOPEN_REDUCE_TENSOR_MUL: return ReduceTensorOp_t::MUL;
+    case MIOPEN_REDUCE_TENSOR_MIN: return ReduceTensorOp_t::MIN;
+    case MIOPEN_REDUCE_TENSOR_MAX: return ReduceTensorOp_t::MAX;
+    case MIOPEN_REDUCE_TENSOR_AMAX: return ReduceTensorOp_t::AMAX;
+    case MIOPEN_REDUCE_TENSOR_AVG: return ReduceTensorOp_t::AVG;
+    case MIOPEN_REDUCE_TENSOR_NORM1: return ReduceTensorOp_t::NORM1;
+    case MIOPEN_REDUCE_TENSOR_NORM2: return ReduceTensorOp_t::NORM2;
+
+    default: MIOPEN_THROW("Operation is not supported");
+    };
+};
+
+inline std::string get_definition_string_from_type_enums(miopenDataType_t TSrc,
+                                                         miopenDataType_t TComp,
+                                                         miopenDataType_t TDst)
+{
+    std::ostringstream outs;
+
+    outs << " -DCK_PARAM_SRC_DATATYPE=" << mapDataTypeId(TSrc);
+    outs << " -DCK_PARAM_DST_DATATYPE=" << mapDataTypeId(TDst);
+    outs << " -DCK_PARAM_REDUCE_COMPTYPE=" << mapDataTypeId(TComp);
+
+    return (outs.str());
+};
+
+inline std::string get_definition_string_from_tunable(const tunable_generic_reduction* pt)
+{
+    std::ostringstream outs;
+
+    outs << " -DCK_PARAM_BLOCKSIZE=" << pt->BlockSize;
+    outs << " -DCK_PARAM_THREAD_BUFFER_LENGTH=" << pt->GredThreadBufferLength;
+    outs << " -DCK_PARAM_ACCESSES_PER_THREAD_INBLOCK=" << pt->GredAccessesPerThreadInBlock;
+    outs << " -DCK_PARAM_ACCESSES_PER_THREAD_INWARP=" << pt->GredAccessesPerThreadInWarp;
+
+    return (outs.str());
+};
+
+inline std::string get_definition_string_from_options(miopenNanPropagation_t nanPropaOpt,
+                                                      miopenReduceTensorIndices_t reduceIndicesOpt)
+{
+    std::ostringstream outs;
+
+    outs << " -DCK_PARAM_NAN_PROPAGATE=" << ((nanPropaOpt == MIOPEN_PROPAGATE_NAN) ? 1 : 0);
+    outs << " -DCK_PARAM_REDUCE_INDICES="
+         << ((reduceIndicesOpt == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES) ? 1 : 0);
+
+    return (outs.str());
+};
+
+inline std::string getReductionMethodStr(ReductionMethod_t reduceImpl)
+{
+    switch(reduceImpl)
+    {
+    case Reduce_DirectThreadWise: return {"threadwise"};
+    case Reduce_DirectWarpWise: return {"warpwise"};
+    case Reduce_BlockWise: return {"blockwise"};
+    case Reduce_MultiBlock: return {"multiblock"};
+    default: MIOPEN_THROW("Invalid reduction method ID!"); break;
+    };
+};
+
+inline std::pair<bool, bool> get_padding_need(ReductionMethod_t reduceImpl,
+                                              size_t invariantLen,
+                                              size_t toReduceLen,
+                                              int GridSize,
+                                              int BlockSize,
+                                              int warpSize,
+                                              int BlkGroupSize,
+                                              const tunable_generic_reduction* tunable)
+{
+    bool src_need_padding = false;
+    bool dst_need_padding = false;
+    int copySliceLen;
+    int reduceSizePerBlock;
+
+    switch(reduceImpl)
+    {
+    case Reduce_DirectThreadWise:
+        copySliceLen     = tunable->GredThreadBufferLength;
+        src_need_padding = (invariantLen < static_cast<size_t>(GridSize) * BlockSize ||
+                            toReduceLen % copySliceLen > 0);
+        dst_need_padding = (invariantLen < static_cast<size_t>(GridSize) * BlockSize);
+        break;
+    case Reduce_DirectWarpWise:
+        copySliceLen = warpSize * tunable->GredAccessesPerThreadInWarp;
+        src_need_padding =
+            (invariantLen < GridSize * BlockSize / warpSize || toReduceLen % copySliceLen > 0);
+        dst_need_padding = (invariantLen < GridSize * BlockSize / warpSize);
+        break;
+    case Reduce_BlockWise:
+        copySliceLen     = BlockSize * tunable->GredAccessesPerThreadInBlock;
+        src_need_padding = (toReduceLen % copySliceLen > 0);
+        break;
+    case Reduce_MultiBlock:
+        copySliceLen = BlockSize * tunable->GredAccessesPerThreadInBlock;
+        reduceSizePerBlock =
+            (((toReduceLen + BlkGroupSize - 1) / BlkGroupSize + copySliceLen - 1) / copySliceLen) *
+            copySliceLen;
+        src_need_padding = (toReduceLen < static_cast<size_t>(reduceSizePerBlock) * BlkGroupSize);
+        break;
+    default: MIOPEN_THROW("Invalid reduction method ID!"); break;
+    };
+
+    return (std::make_pair(src_need_padding, dst_need_padding));
+};
+
+inline std::string get_kernel_file_name(const bool isFirstCall,
+                                        const ReductionMethod_t reduceImpl,
+                                        const bool allDimsReduced)
+{
+    std::ostringstream outs;
+
+    if(isFirstCall)
+        outs << "gridwise_generic_reduction_first_call_" << getReductionMethodStr(reduceImpl);
+    else
+        outs << "gridwise_generic_reduction_second_call_" << getReductionMethodStr(reduceImpl);
+
+    if(allDimsReduced)
+        outs << "_reduce_all_dims.cpp";
+    else
+        outs << "_reduce_partial_dims.cpp";
+
+    return (outs.str());
+};
+
+}; // end of namespace detailDynamic
+
+} // namespace reduce
+
+} // namespace miopen
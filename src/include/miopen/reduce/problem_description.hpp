@@ -0,0 +1,83 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/problem_description_base.hpp>
+#include <miopen/reducetensor.hpp>
+#include <miopen/tensor.hpp>
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct NetworkConfig;
+
+namespace reduce {
+
+// The dimensions of a reduction problem are folded before anything else looks at them:
+// unit-length dimensions are dropped and neighbouring dimensions of the same kind (both reduced
+// or both kept) are merged when they are laid out contiguously in the input and in the output.
+// Reducing HW of a packed NCHW tensor thus becomes a (NC)x(HW) problem. Folding keeps the order
+// in which elements are visited, so flattened reduction indices are not affected.
+struct ProblemDescription : ProblemDescriptionBase
+{
+    ProblemDescription(const ReduceTensorDescriptor& reduce_,
+                       const TensorDescriptor& xDesc_,
+                       const TensorDescriptor& yDesc_);
+
+    const ReduceTensorDescriptor& GetReduceDesc() const { return reduce; }
+    // Folded descriptors
+    const TensorDescriptor& GetXDesc() const { return xDesc; }
+    const TensorDescriptor& GetYDesc() const { return yDesc; }
+
+    // Positions of the kept and of the reduced dimensions in the folded descriptors
+    const std::vector<int>& GetInvariantDims() const { return invariantDims; }
+    const std::vector<int>& GetToReduceDims() const { return toReduceDims; }
+
+    bool IsAllDimsReduced() const { return invariantDims.empty(); }
+    bool NeedIndices() const;
+
+    std::size_t GetInvariantLength() const { return yDesc.GetElementSize(); }
+    std::size_t GetToReduceLength() const { return xDesc.GetElementSize() / GetInvariantLength(); }
+
+    NetworkConfig MakeNetworkConfig() const;
+    // Key of the perf-db records
+    void Serialize(std::ostream& stream) const;
+
+private:
+    ReduceTensorDescriptor reduce;
+    TensorDescriptor xDesc;
+    TensorDescriptor yDesc;
+    std::vector<int> invariantDims;
+    std::vector<int> toReduceDims;
+};
+
+} // namespace reduce
+
+} // namespace miopen
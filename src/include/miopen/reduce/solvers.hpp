@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/solver.hpp>
+
+#include <miopen/reduce/invoke_params.hpp>
+#include <miopen/reduce/problem_description.hpp>
+#include <miopen/reduce_tunables.hpp>
+
+namespace miopen {
+
+namespace solver {
+
+namespace reduce {
+
+using ReduceSolver = NonTunableSolverBase<ExecutionContext, miopen::reduce::ProblemDescription>;
+
+struct PerformanceConfigGenericReduction : PerfConfigBase<PerformanceConfigGenericReduction>
+{
+    int block_size;                  // [128..512], power of 2
+    int thread_buffer_length;        // [4..16], power of 2, used by thread-wise reduction
+    int accesses_per_thread_inblock; // [1..4], power of 2, used by block-wise reduction
+    int accesses_per_thread_inwarp;  // [1..4], power of 2, used by warp-wise reduction
+
+    PerformanceConfigGenericReduction(int bs, int tbl, int apt_block, int apt_warp);
+    PerformanceConfigGenericReduction() : PerformanceConfigGenericReduction(-1, -1, -1, -1) {}
+    PerformanceConfigGenericReduction(bool) : PerformanceConfigGenericReduction(128, 4, 1, 1) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.block_size, "block_size");
+        f(self.thread_buffer_length, "thread_buffer_length");
+        f(self.accesses_per_thread_inblock, "accesses_per_thread_inblock");
+        f(self.accesses_per_thread_inwarp, "accesses_per_thread_inwarp");
+    }
+
+    tunable_generic_reduction GetTunable() const;
+
+    void HeuristicInit(const ExecutionContext&, const miopen::reduce::ProblemDescription&);
+    bool IsValidValue() const;
+    bool SetNextValue(const miopen::reduce::ProblemDescription&);
+    bool IsValid(const ExecutionContext&, const miopen::reduce::ProblemDescription&) const;
+    bool operator==(const PerformanceConfigGenericReduction& other) const;
+};
+
+// Kernels with the tensor descriptors compiled in, used with MIOPEN_DEBUG_DYNAMIC_REDUCTION=0.
+struct GenericReductionStatic final : ReduceSolver
+{
+    const std::string& SolverDbId() const override
+    {
+        return GetSolverDbId<GenericReductionStatic>();
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::reduce::ProblemDescription& problem) const override;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::reduce::ProblemDescription& problem) const override;
+    std::size_t GetWorkspaceSize(const ExecutionContext& context,
+                                 const miopen::reduce::ProblemDescription& problem) const override;
+    bool MayNeedWorkspace() const override { return true; }
+};
+
+// Kernels which get the tensor descriptors at run time. The kernel parameters are tunable and the
+// tuned values are kept in a separate reduction perf-db next to the convolution one.
+struct GenericReductionDynamic final : ReduceSolver
+{
+    const std::string& SolverDbId() const override
+    {
+        return GetSolverDbId<GenericReductionDynamic>();
+    }
+
+    bool IsApplicable(const ExecutionContext& context,
+                      const miopen::reduce::ProblemDescription& problem) const override;
+    // Uses the perf-db record of the problem if there is one, the default config otherwise.
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::reduce::ProblemDescription& problem) const override;
+    // The workspace is sized for the most demanding config of the tuning space, so that any
+    // config found later by tuning fits into a workspace allocated before.
+    std::size_t GetWorkspaceSize(const ExecutionContext& context,
+                                 const miopen::reduce::ProblemDescription& problem) const override;
+    bool MayNeedWorkspace() const override { return true; }
+
+    PerformanceConfigGenericReduction
+    GetDefaultPerformanceConfig(const ExecutionContext& context,
+                                const miopen::reduce::ProblemDescription& problem) const;
+    bool IsValidPerformanceConfig(const ExecutionContext& context,
+                                  const miopen::reduce::ProblemDescription& problem,
+                                  const PerformanceConfigGenericReduction& config) const;
+    PerformanceConfigGenericReduction Search(const ExecutionContext& context,
+                                             const miopen::reduce::ProblemDescription& problem,
+                                             const AnyInvokeParams& invoke_ctx) const;
+    ConvSolution GetSolution(const ExecutionContext& context,
+                             const miopen::reduce::ProblemDescription& problem,
+                             const PerformanceConfigGenericReduction& config) const;
+
+    // There is no Find API for reductions, so tuning is driven by MIOPEN_FIND_ENFORCE only:
+    // SEARCH tunes problems which have no perf-db record yet, SEARCH_DB_UPDATE retunes them
+    // and DB_CLEAN removes the record from the user perf-db.
+    void ApplyFindEnforce(const ExecutionContext& context,
+                          const miopen::reduce::ProblemDescription& problem,
+                          const AnyInvokeParams& invoke_ctx) const;
+};
+
+} // namespace reduce
+
+} // namespace solver
+
+} // namespace miopen
@@ -56,12 +56,12 @@ struct ReduceTensorDescriptor : miopenReduceTensorDescriptor
     miopenReduceTensorIndices_t reduceTensorIndices_;
     miopenIndicesType_t reduceTensorIndicesType_;
 
-    std::size_t GetWorkspaceSize(const Handle& handle,
+    std::size_t GetWorkspaceSize(Handle& handle,
                                  const TensorDescriptor& inDesc,
                                  const TensorDescriptor& outDesc) const;
     std::size_t GetIndicesSize(const TensorDescriptor& inDesc,
                                const TensorDescriptor& outDesc) const;
-    void ReduceTensor(const Handle& handle,
+    void ReduceTensor(Handle& handle,
                       Data_t indices,
                       size_t indicesSizeInBytes,
                       Data_t workspace,
@@ -38,6 +38,7 @@
 
 #include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -45,6 +46,9 @@ namespace miopen {
 
 struct Handle;
 struct TensorDescriptor;
+struct RNNPlanCache;
+
+std::shared_ptr<RNNPlanCache> MakeRNNPlanCache();
 
 template <class T>
 struct c_array_view
@@ -102,6 +106,8 @@ struct RNNDescriptor : miopenRNNDescriptor
     miopenDataType_t dataType;
     std::size_t typeSize;
     miopenDropoutDescriptor_t dropoutDesc{};
+    /// Launch sequences recorded for the shapes this descriptor has been run with.
+    std::shared_ptr<RNNPlanCache> plans = MakeRNNPlanCache();
 
     size_t biasOffsetCalculation(const TensorDescriptor& xDesc, int layer, int biasID) const;
 
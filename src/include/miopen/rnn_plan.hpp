@@ -0,0 +1,333 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_RNN_PLAN_HPP_
+#define GUARD_MIOPEN_RNN_PLAN_HPP_
+
+#include <miopen/activ.hpp>
+#include <miopen/common.hpp>
+#include <miopen/gemm_v2.hpp>
+#include <miopen/tensor.hpp>
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// User buffers an RNN plan step may refer to. Plans never store raw pointers;
+/// every step names the buffer it reads or writes and gets the actual pointer
+/// from the bindings of the call being replayed.
+enum class RNNPlanBuffer
+{
+    X,
+    W,
+    Y,
+    Hx,
+    Cx,
+    Hy,
+    Cy,
+    Workspace,
+    Reserve,
+    Count,
+};
+
+enum class RNNPlanOp
+{
+    Gemm,
+    GemmStridedBatched,
+    OpTensor,
+    CopyTensor,
+    SetTensor,
+    Activation,
+    LSTMHiddenStateUpdate,
+    Count,
+};
+
+struct RNNPlanBindings
+{
+    void Set(RNNPlanBuffer buffer, ConstData_t ptr);
+    Data_t Get(RNNPlanBuffer buffer) const { return ptrs[static_cast<std::size_t>(buffer)]; }
+
+    /// Looks up the buffer bound to ptr. Fails for null and unknown pointers and
+    /// for pointers bound to more than one buffer, since a replay could not tell
+    /// the aliases apart.
+    bool Find(ConstData_t ptr, RNNPlanBuffer& buffer) const;
+
+private:
+    std::array<Data_t, static_cast<std::size_t>(RNNPlanBuffer::Count)> ptrs{};
+};
+
+/// Everything the launch sequence of an RNN call depends on besides the
+/// RNNDescriptor itself.
+struct RNNPlanKey
+{
+    bool is_inference          = true;
+    miopenDataType_t data_type = miopenFloat;
+    int in_h                   = 0;
+    int hy_d                   = 0;
+    int hy_n                   = 0;
+    int hy_h                   = 0;
+    int out_h                  = 0;
+    std::vector<int> batches   = {};
+    std::size_t workspace_size = 0;
+    std::size_t reserve_size   = 0;
+    unsigned present_buffers   = 0; ///< Bitmask of non-null optional buffers.
+
+    friend bool operator<(const RNNPlanKey& l, const RNNPlanKey& r);
+};
+
+/// A recorded RNN launch sequence. All descriptors and offsets are computed when
+/// the plan is recorded, so Run() only issues the launches.
+struct RNNPlan
+{
+    using Step = std::function<void(Handle&, const RNNPlanBindings&)>;
+
+    /// merged_gemms is the number of GEMMs a GemmStridedBatched step stands for.
+    void Add(RNNPlanOp op, Step step, std::size_t merged_gemms = 0);
+    void Run(Handle& handle, const RNNPlanBindings& bindings) const;
+
+    std::size_t GetLaunchCount() const { return steps.size(); }
+    std::size_t GetLaunchCount(RNNPlanOp op) const
+    {
+        return launch_counts[static_cast<std::size_t>(op)];
+    }
+    /// Number of GEMMs that are issued as part of strided batched launches.
+    std::size_t GetMergedGemmCount() const { return merged_gemm_count; }
+
+private:
+    std::vector<Step> steps;
+    std::array<std::size_t, static_cast<std::size_t>(RNNPlanOp::Count)> launch_counts{};
+    std::size_t merged_gemm_count = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const RNNPlan& plan);
+
+/// Thread-safe, bounded cache of plans shared by all copies of an RNNDescriptor.
+struct RNNPlanCache
+{
+    explicit RNNPlanCache(std::size_t capacity_ = 64) : capacity(capacity_) {}
+
+    std::shared_ptr<const RNNPlan> Find(const RNNPlanKey& key) const;
+    void Insert(const RNNPlanKey& key, std::shared_ptr<const RNNPlan> plan);
+    std::size_t Size() const;
+
+private:
+    using Entry = std::pair<RNNPlanKey, std::shared_ptr<const RNNPlan>>;
+
+    std::size_t capacity;
+    mutable std::mutex mutex;
+    mutable std::list<Entry> entries; // most recently used first
+    std::map<RNNPlanKey, std::list<Entry>::iterator> index;
+};
+
+/// A GEMM launch as issued by the RNN implementation.
+struct RNNGemmCall
+{
+    GemmDescriptor desc;
+    ConstData_t A;
+    int a_offset;
+    ConstData_t B;
+    int b_offset;
+    Data_t C;
+    int c_offset;
+    GemmBackend_t backend;
+};
+
+/// Folds mutually independent GEMMs that differ only in their offsets into strided
+/// batched GEMMs. A call joins an earlier run if its A, B and C offsets advance from the
+/// last call of that run by the run's strides; strides must be non-negative and C must
+/// advance. Runs are returned in the order of their first calls.
+std::vector<RNNGemmCall> BatchIndependentGemms(const std::vector<RNNGemmCall>& calls);
+
+/// Direction `ri` at time step `ti` of the forward pass over a layer, where `bacc` and
+/// `baccbi` are the rows preceding the step in forward and reverse order.
+struct RNNTimeStep
+{
+    RNNTimeStep(const std::vector<int>& in_n,
+                int hid_shift,
+                int hy_stride,
+                int bacc,
+                int baccbi,
+                int ti,
+                int ri);
+
+    int cur_time;
+    int offset;
+    /// Step read by this one; its batch size is the number of rows carried over.
+    int use_time = 0;
+    /// Offset of the step read by this one, 0 at the first step.
+    int pretime_shift = 0;
+};
+
+/// Shape and buffers of the hidden state GEMMs of one layer in RNNForwardInference.
+struct RNNHiddenGemmLayer
+{
+    miopenDataType_t data_type;
+    int bi;
+    int hy_h;
+    int hy_n;
+    int wei_len;
+    int hid_off;
+    int hy_stride;
+    int uni_stride;
+    int hid_shift;
+    int hx_shift;
+    int wei_shift;
+    ConstData_t hx;
+    ConstData_t w;
+    Data_t workspace;
+};
+
+/// The hidden state GEMMs of both directions at time step `ti`. They only read the
+/// previous time step, so they are independent of each other.
+std::vector<RNNGemmCall> RNNHiddenGemms(const RNNHiddenGemmLayer& layer,
+                                        const std::vector<int>& in_n,
+                                        int bacc,
+                                        int baccbi,
+                                        int ti);
+
+/// Drop-in replacement for the launch calls of the RNN implementation: every
+/// call is issued immediately and, if recording, also appended to a plan.
+/// Recording is abandoned if any buffer can not be mapped to its binding.
+struct RNNPlanRecorder
+{
+    RNNPlanRecorder(Handle& handle_, const RNNPlanBindings& bindings_, bool record);
+
+    miopenStatus_t CallGemm(const GemmDescriptor& gemm_desc,
+                            ConstData_t A,
+                            int a_offset,
+                            ConstData_t B,
+                            int b_offset,
+                            Data_t C,
+                            int c_offset,
+                            GemmBackend_t gemm_backend);
+
+    miopenStatus_t CallGemmStridedBatched(const GemmDescriptor& gemm_desc,
+                                          ConstData_t A,
+                                          int a_offset,
+                                          ConstData_t B,
+                                          int b_offset,
+                                          Data_t C,
+                                          int c_offset,
+                                          GemmBackend_t gemm_backend);
+
+    /// Defers a GEMM that does not depend on any other GEMM queued before the next
+    /// FlushGemms(), so that independent GEMMs can share a launch.
+    void QueueGemm(const GemmDescriptor& gemm_desc,
+                   ConstData_t A,
+                   int a_offset,
+                   ConstData_t B,
+                   int b_offset,
+                   Data_t C,
+                   int c_offset,
+                   GemmBackend_t gemm_backend);
+
+    /// Issues the queued GEMMs, adding their kernel time to ctime as profileRNNkernels()
+    /// does. Returns the first failure, if any.
+    miopenStatus_t FlushGemms(float& ctime);
+
+    void OpTensor(miopenTensorOp_t tensorOp,
+                  float alpha0,
+                  const TensorDescriptor& aDesc,
+                  ConstData_t A,
+                  float alpha1,
+                  const TensorDescriptor& bDesc,
+                  ConstData_t B,
+                  float beta,
+                  const TensorDescriptor& cDesc,
+                  Data_t C,
+                  std::size_t Aoffset,
+                  std::size_t Boffset,
+                  std::size_t Coffset);
+
+    void CopyTensor(const TensorDescriptor& srcDesc,
+                    ConstData_t src,
+                    const TensorDescriptor& dstDesc,
+                    Data_t dst,
+                    int srcOffset,
+                    int dstOffset);
+
+    void SetTensor(const TensorDescriptor& yDesc, Data_t y, float value, int offset = 0);
+
+    void ActivationForward(const ActivationDescriptor& activDesc,
+                           float alpha,
+                           const TensorDescriptor& xDesc,
+                           ConstData_t x,
+                           float beta,
+                           const TensorDescriptor& yDesc,
+                           Data_t y,
+                           std::size_t xOffset,
+                           std::size_t yOffset);
+
+    void LSTMForwardHiddenStateUpdate(miopenDataType_t rnn_data_type,
+                                      bool is_inference,
+                                      bool is_seq_begin,
+                                      int direction,
+                                      int max_batch,
+                                      int cur_batch,
+                                      int use_batch,
+                                      int hy_h,
+                                      int hy_stride,
+                                      int wei_len,
+                                      int wei_stride,
+                                      ConstData_t cx,
+                                      std::size_t cx_offset,
+                                      Data_t reserve_space,
+                                      std::size_t i_offset,
+                                      std::size_t f_offset,
+                                      std::size_t o_offset,
+                                      std::size_t c_offset,
+                                      std::size_t cell_offset,
+                                      std::size_t cell_offset_pre,
+                                      std::size_t activ_cell_offset,
+                                      std::size_t hidden_offset);
+
+    bool IsRecording() const { return plan != nullptr; }
+
+    /// Returns the recorded plan, or nullptr if nothing was recorded.
+    std::shared_ptr<const RNNPlan> Finish();
+
+private:
+    bool Resolve(ConstData_t ptr, RNNPlanBuffer& buffer);
+
+    Handle& handle;
+    const RNNPlanBindings& bindings;
+    std::shared_ptr<RNNPlan> plan;
+    std::vector<RNNGemmCall> queued_gemms;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_RNN_PLAN_HPP_
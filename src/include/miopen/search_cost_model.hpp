@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv_solution.hpp>
+#include <miopen/type_traits.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// One benchmark run of GenericSearch.
+struct SearchCandidate
+{
+    std::string solver;  // SolverDbId()
+    std::string problem; // Perf-db key of the problem.
+    std::string config;  // Serialized PerformanceConfig.
+    const ConvSolution* solution = nullptr; // Only valid during Measure().
+    std::size_t index            = 0; // Position in the search order.
+    int repeat                   = 0; // 0 for the first run, 1..4 for the runs smoothing jitter.
+    bool is_default              = false;
+};
+
+/// Measures the candidates of GenericSearch instead of running their kernels on the GPU, so a
+/// tuning loop runs without a device (for example, with the HIPNOGPU backend). Nothing is
+/// compiled when a model is used.
+class SearchCostModel
+{
+public:
+    virtual ~SearchCostModel() = default;
+
+    /// Returns the kernel time in ms. Throws when the candidate cannot run; GenericSearch counts
+    /// that as a failed config.
+    virtual float Measure(const SearchCandidate& candidate) = 0;
+};
+
+/// Estimates kernel times from the launch geometry of the solution: the lanes idle in partial
+/// wavefronts, the tail of the last round of workgroups and the launch overhead of each kernel.
+/// A deterministic factor per config in [1, 1 + roughness) keeps configs with the same geometry
+/// apart, and noise adds a jitter to every run. The result is a synthetic landscape to develop
+/// search strategies against, not a prediction of real kernel times.
+class AnalyticCostModel : public SearchCostModel
+{
+public:
+    AnalyticCostModel(std::size_t cu_count_,
+                      float work_ms_   = 1.0f,
+                      float roughness_ = 0.5f,
+                      float noise_     = 0.0f);
+
+    float Measure(const SearchCandidate& candidate) override;
+
+private:
+    std::size_t cu_count;
+    float work_ms; // Time of the whole problem at full device utilization.
+    float roughness;
+    float noise;
+    std::size_t runs = 0;
+};
+
+/// Replays kernel times recorded by GenericSearch on a device with MIOPEN_DEBUG_TUNING_RECORD.
+/// Every line of the file holds the problem key, the solver, the config and the time, separated
+/// by spaces. Times recorded several times for a config are averaged. Configs without a recorded
+/// time fail.
+class RecordedCostModel : public SearchCostModel
+{
+public:
+    RecordedCostModel(const std::string& path);
+
+    float Measure(const SearchCandidate& candidate) override;
+    std::size_t Size() const { return times.size(); }
+
+private:
+    std::map<std::tuple<std::string, std::string, std::string>, float> times;
+};
+
+/// Appends the time of the candidate to the MIOPEN_DEBUG_TUNING_RECORD file, if it is set.
+void RecordSearchTime(const SearchCandidate& candidate, float time);
+bool IsSearchRecordEnabled();
+
+struct SearchTraceStats
+{
+    std::size_t evaluated = 0;
+    std::size_t failed    = 0;
+    double seconds        = 0.0;
+    /// Best average time and the number of evaluations and seconds it took to find it.
+    float best                   = 0.0f;
+    std::size_t evaluations_best = 0;
+    double seconds_best          = 0.0;
+    float default_time           = 0.0f;
+
+    double EvaluationsPerSecond() const { return seconds > 0.0 ? evaluated / seconds : 0.0; }
+};
+
+std::ostream& operator<<(std::ostream& stream, const SearchTraceStats& stats);
+
+/// Forwards to another model and records every run, to evaluate search strategies: how many
+/// configs are evaluated per second, how long it takes to find the best one and how good the
+/// best config found within a budget of evaluations is.
+class SearchTrace : public SearchCostModel
+{
+public:
+    SearchTrace(SearchCostModel& model_) : model(model_) {}
+
+    float Measure(const SearchCandidate& candidate) override;
+
+    void Clear();
+    SearchTraceStats GetStats() const;
+    /// Best average time among the first evaluations, or 0 if none of them passed.
+    float BestAfter(std::size_t evaluations) const;
+    /// Number of evaluations until one reached the time, or 0 if none did.
+    std::size_t EvaluationsTo(float time) const;
+
+private:
+    struct Evaluation
+    {
+        std::chrono::steady_clock::duration start;
+        float total = 0.0f;
+        int runs    = 0;
+        bool failed = false;
+
+        float Average() const { return total / runs; }
+    };
+
+    SearchCostModel& model;
+    std::chrono::steady_clock::time_point begin;
+    std::chrono::steady_clock::duration end{};
+    std::vector<Evaluation> evaluations;
+    float default_time = 0.0f;
+    bool started       = false;
+};
+
+template <class T>
+using SerializeSearchKey_t =
+    decltype(std::declval<const T&>().Serialize(std::declval<std::ostream&>()));
+
+template <class T>
+std::string SerializeSearchKey(const T& data, std::true_type)
+{
+    std::ostringstream ss;
+    data.Serialize(ss);
+    return ss.str();
+}
+
+template <class T>
+std::string SerializeSearchKey(const T&, std::false_type)
+{
+    return {};
+}
+
+/// Returns the text perf-db key of a problem or config. Problems keyed only by SQLite fields
+/// (fusions in SQLite builds) get an empty key.
+template <class T>
+std::string SerializeSearchKey(const T& data)
+{
+    return SerializeSearchKey(data, HasMember<SerializeSearchKey_t, T>{});
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct ExecutionContext;
+
+namespace solver {
+
+/// Chooses the performance configs GenericSearch evaluates, and in which order. Configs are
+/// identified by their index in the list of all valid configs and described by the fields of
+/// their serialized form (separated by ',', ':' or ';'), so that strategies can move between
+/// configs that differ in a few parameters instead of treating them as a flat list.
+class SearchStrategy
+{
+public:
+    SearchStrategy(const std::vector<std::string>& keys, unsigned seed);
+    virtual ~SearchStrategy() = default;
+
+    virtual std::string Name() const = 0;
+    /// Whether the strategy needs the times of evaluated configs to propose more. GenericSearch
+    /// compiles configs of non-adaptive strategies all at once, and of adaptive ones in batches.
+    virtual bool IsAdaptive() const { return true; }
+    /// Returns up to count configs that were not proposed before. Returns nothing when every
+    /// config has been proposed.
+    virtual std::vector<std::size_t> Propose(std::size_t count) = 0;
+    /// Reports the time of a proposed config.
+    virtual void Report(std::size_t index, float time, bool failed);
+
+protected:
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    std::size_t Size() const { return fields.size(); }
+    std::size_t Distance(std::size_t a, std::size_t b) const;
+    std::size_t Distance(const std::vector<int>& a, std::size_t b) const;
+    /// Marks and returns a random config that was not proposed, or none.
+    std::size_t ProposeRandom();
+    /// Marks and returns the config nearest to the fields among those not proposed, or none.
+    std::size_t ProposeNearest(const std::vector<int>& target);
+    void MarkProposed(std::size_t index);
+
+    /// The fields of every config, each numbered by the distinct values in its position.
+    std::vector<std::vector<int>> fields;
+    std::vector<bool> proposed;
+    std::vector<bool> failed;
+    std::vector<float> times;
+    std::size_t proposed_count = 0;
+    std::mt19937 rng;
+
+private:
+    std::vector<std::size_t> random_order;
+};
+
+/// Evaluates configs in random order. This is the exhaustive search GenericSearch always did.
+class RandomSearchStrategy : public SearchStrategy
+{
+public:
+    using SearchStrategy::SearchStrategy;
+
+    std::string Name() const override { return "random"; }
+    bool IsAdaptive() const override { return false; }
+    std::vector<std::size_t> Propose(std::size_t count) override;
+};
+
+/// Hill climbing with random restarts: evaluates the configs nearest to the best config of the
+/// current climb (those differing in one field, or two if there are none) and moves to any that
+/// is faster. Restarts from a random config at a local optimum.
+class LocalSearchStrategy : public SearchStrategy
+{
+public:
+    using SearchStrategy::SearchStrategy;
+
+    std::string Name() const override { return "local"; }
+    std::vector<std::size_t> Propose(std::size_t count) override;
+    void Report(std::size_t index, float time, bool failed) override;
+
+private:
+    std::size_t current = none;
+};
+
+/// Steady-state genetic search: children take every field from one of two parents picked by
+/// tournament, with a field now and then taken from a random config instead, and are mapped to
+/// the nearest config not evaluated yet. Faster children replace the slowest member of the
+/// population.
+class EvolutionSearchStrategy : public SearchStrategy
+{
+public:
+    using SearchStrategy::SearchStrategy;
+
+    std::string Name() const override { return "evolution"; }
+    std::vector<std::size_t> Propose(std::size_t count) override;
+    void Report(std::size_t index, float time, bool failed) override;
+
+private:
+    static constexpr std::size_t population_size = 16;
+
+    std::size_t Tournament();
+
+    std::vector<std::size_t> population;
+};
+
+/// Surrogate model search: predicts the log time of a config from its nearest evaluated configs
+/// and evaluates the ones with the lowest prediction less the spread of those neighbors, which
+/// trades exploiting good regions against exploring uncertain ones. Failed configs count as
+/// slower than any that passed.
+class SurrogateSearchStrategy : public SearchStrategy
+{
+public:
+    using SearchStrategy::SearchStrategy;
+
+    std::string Name() const override { return "surrogate"; }
+    std::vector<std::size_t> Propose(std::size_t count) override;
+
+private:
+    static constexpr std::size_t initial    = 8;
+    static constexpr std::size_t neighbors  = 5;
+    static constexpr std::size_t candidates = 512;
+};
+
+/// Returns the strategy of the context, else the one set with MIOPEN_DEBUG_TUNING_STRATEGY, else
+/// "random".
+std::string GetSearchStrategyName(const ExecutionContext& context);
+
+/// Throws for unknown names.
+std::unique_ptr<SearchStrategy>
+MakeSearchStrategy(const std::string& name, const std::vector<std::string>& keys, unsigned seed);
+
+} // namespace solver
+} // namespace miopen
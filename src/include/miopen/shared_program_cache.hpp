@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SHARED_PROGRAM_CACHE_HPP_
+#define GUARD_MIOPEN_SHARED_PROGRAM_CACHE_HPP_
+
+#include <miopen/kernel.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace miopen {
+
+/**
+ * @brief Process-wide cache of programs shared by the kernel caches of several handles
+ *
+ * Programs are keyed by the scope they are valid in (device and target), the program name and
+ * the build parameters. Each handle holds a reference on the programs it uses, and a program
+ * is dropped from the cache once the last handle releases it. Kernels are still created per
+ * handle from the shared programs.
+ */
+class SharedProgramCache
+{
+public:
+    using Key = std::tuple<std::string, std::string, std::string>;
+
+    static SharedProgramCache& Instance();
+
+    /// Whether handles shall use the shared cache, i.e. MIOPEN_SHARED_PROGRAM_CACHE is enabled.
+    static bool IsEnabled();
+
+    /// Returns the program cached under the key, or builds it with load(). Concurrent callers
+    /// with the same key wait for a single build. Every successful call takes a reference.
+    Program Acquire(const Key& key, const std::function<Program()>& load);
+
+    void Release(const Key& key);
+
+    bool Contains(const Key& key) const;
+    std::size_t Size() const;
+
+private:
+    struct Entry
+    {
+        std::shared_future<Program> program;
+        std::size_t references = 0;
+    };
+
+    mutable std::mutex mutex;
+    std::map<Key, Entry> entries;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SHARED_PROGRAM_CACHE_HPP_
@@ -39,6 +39,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
 #include <numeric>
 #include <vector>
 
@@ -226,7 +227,7 @@ struct TensorDescriptor : miopenTensorDescriptor
     {
         if(*(labels.end() - 1) != 'c')
         {
-            if(labels.size() != strides.size())
+            if(labels.size() != GetStrides().size())
             {
                 MIOPEN_THROW(
                     "Invalid labels size. Layout labels size must be equavalent to stride size");
@@ -235,20 +236,20 @@ struct TensorDescriptor : miopenTensorDescriptor
             // Copy construct the result string from labels. This allocates the space at one go
             // and is faster than calling push_back in transform.
             auto result = labels;
-            auto p      = find_permutation(lens, strides);
+            auto p      = find_permutation(GetLengths(), GetStrides());
             std::transform(p.begin(), p.end(), result.begin(), [&](auto i) { return labels[i]; });
             return result;
         }
         else
         {
             const std::string base_label = labels.substr(0, labels.size() - 1);
-            if(base_label.size() != strides.size())
+            if(base_label.size() != GetStrides().size())
             {
                 MIOPEN_THROW(
                     "Invalid labels size. Layout labels size must be equavalent to stride size");
             }
             auto result = base_label;
-            auto p      = find_permutation(lens, strides);
+            auto p      = find_permutation(GetLengths(), GetStrides());
             std::transform(p.begin(), p.end(), result.begin(), [&](auto i) { return labels[i]; });
             return result + 'c';
         }
@@ -259,25 +260,39 @@ struct TensorDescriptor : miopenTensorDescriptor
     friend void to_json(nlohmann::json& j, const TensorDescriptor& descriptor);
     friend void from_json(const nlohmann::json& j, TensorDescriptor& descriptor);
 
-    void SetStrideNd(const std::string& layout);
-    void LensReorder(const std::string& layout);
-
 private:
+    /// Lengths, strides and the quantities derived from them. The geometry is
+    /// immutable once a descriptor is constructed, so copies of the descriptor
+    /// share it instead of reallocating the vectors.
+    struct Geometry
+    {
+        std::vector<std::size_t> lens;
+        std::vector<std::size_t> strides;
+        std::size_t element_size  = 0;
+        std::size_t element_space = 0;
+        bool packed               = true;
+
+        void CalculateDerived(std::size_t vector_length);
+    };
+
+    static const std::shared_ptr<const Geometry>& EmptyGeometry();
+
+    void SetStrideNd(Geometry& g, const std::string& layout) const;
+    void LensReorder(Geometry& g, const std::string& layout) const;
+
     TensorDescriptor(miopenDataType_t t,
                      miopenTensorLayout_t layout_in,
                      const std::vector<std::size_t>& lens_in,
                      const std::vector<std::size_t>& strides_in,
                      bool use_strides);
 
-    void CalculateStrides();
+    void CalculateStrides(Geometry& g) const;
     void CalculateVectorLength();
 
     static miopenTensorLayout_t GetDefaultLayout() { return miopenTensorNCHW; };
 
-    std::vector<std::size_t> lens;
-    std::vector<std::size_t> strides;
+    std::shared_ptr<const Geometry> geometry = EmptyGeometry();
 
-    bool packed;
     std::size_t vector_length = 1;
 
     miopenDataType_t type             = miopenFloat;
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TENSOR_DUMP_HPP
+#define GUARD_MIOPEN_TENSOR_DUMP_HPP
+
+#include <miopen/common.hpp>
+
+#include <string>
+
+namespace miopen {
+
+struct Handle;
+struct TensorDescriptor;
+
+/// Decides whether the current group of dumps (e.g. x/w/y of one convolution call) is
+/// written, according to MIOPEN_DUMP_TENSOR_EVERY_N and MIOPEN_DUMP_TENSOR_MAX_COUNT.
+/// Call it once per group.
+bool TensorDumpSelected();
+
+/// Reads the tensor back into a reused staging buffer and queues it for a background
+/// writer. Next to the data file, a "<filename>.txt" describes its type, lengths and
+/// strides. The call only blocks while MIOPEN_DUMP_TENSOR_QUEUE_MB of dumps are pending.
+void DumpTensorToFileAsync(const Handle& handle,
+                           const TensorDescriptor& tDesc,
+                           ConstData_t dData,
+                           const std::string& filename);
+
+/// Waits until all queued dumps are written.
+void FlushTensorDumps();
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_TENSOR_DUMP_HPP
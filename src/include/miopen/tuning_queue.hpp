@@ -0,0 +1,185 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <ctime>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct Problem;
+
+namespace solver {
+
+/// Restricts GenericSearch to a slice of the configs of a solver and keeps the time of every
+/// config it evaluates, so that a search can be split across processes and resumed after it was
+/// interrupted. Configs are identified by their serialized form.
+class SearchCheckpoint
+{
+public:
+    virtual ~SearchCheckpoint() = default;
+
+    /// The first and past-the-last of the total valid configs, in enumeration order, to evaluate.
+    virtual std::pair<std::size_t, std::size_t> GetRange(std::size_t total) = 0;
+    /// The time of a config evaluated before, negative if it failed.
+    virtual boost::optional<float> Find(const std::string& config) const = 0;
+    /// Called as soon as a config is evaluated, with a negative time if it failed.
+    virtual void Record(const std::string& config, float time) = 0;
+};
+
+} // namespace solver
+
+/// The auto-tuning of one slice of the configs of a solver for a Find 2.0 problem.
+struct TuningJob
+{
+    std::size_t id = 0;
+    std::string solver;  // SolverDbId()
+    std::string problem; // Problem serialized as JSON.
+    /// The job evaluates the configs in [total * slice / slices, total * (slice + 1) / slices).
+    std::size_t slice  = 0;
+    std::size_t slices = 1;
+
+    friend std::ostream& operator<<(std::ostream& stream, const TuningJob& job);
+};
+
+/// A checkpoint file of a job: one "config<TAB>time" line per evaluated config, appended and
+/// flushed as soon as the config is evaluated. Time is -1 for failed configs.
+class TuningCheckpoint : public solver::SearchCheckpoint
+{
+public:
+    TuningCheckpoint(const boost::filesystem::path& path_, std::size_t slice_, std::size_t slices_);
+
+    std::pair<std::size_t, std::size_t> GetRange(std::size_t total) override;
+    boost::optional<float> Find(const std::string& config) const override;
+    void Record(const std::string& config, float time) override;
+
+    /// True once every config of the slice has been evaluated. Only known after GetRange().
+    bool IsComplete() const;
+    /// Whether a search has asked for its range.
+    bool IsSliced() const { return expected.is_initialized(); }
+    /// The fastest config evaluated so far, or none if all of them failed.
+    boost::optional<std::pair<std::string, float>> GetBest() const;
+    std::size_t Size() const { return times.size(); }
+
+private:
+    boost::filesystem::path path;
+    std::size_t slice;
+    std::size_t slices;
+    boost::optional<std::size_t> expected;
+    std::unordered_map<std::string, float> times;
+};
+
+enum class TuningJobState
+{
+    Pending,
+    Running,
+    Done,
+};
+
+struct TuningJobStatus
+{
+    TuningJob job;
+    TuningJobState state = TuningJobState::Pending;
+    std::string worker; // The last worker that claimed the job.
+    std::size_t evaluated = 0;
+};
+
+/// The best config found for a solver and problem over all the slices of the queue.
+struct TuningResult
+{
+    std::string solver;
+    std::string problem;
+    std::string config;
+    float time = 0;
+    /// Slices that were not done yet when the result was taken.
+    std::size_t slices_left = 0;
+};
+
+/// A work queue of tuning jobs in a directory, shared by the worker processes of a host:
+///
+/// - "jobs" holds one "id<TAB>solver<TAB>slice<TAB>slices<TAB>problem" line per job.
+/// - "log" holds one "claim|done<TAB>id<TAB>worker<TAB>unix time" line per event.
+/// - "checkpoints/<id>" is the TuningCheckpoint of each claimed job.
+///
+/// Both files are only appended to, under a lock file. A claimed job is taken over by another
+/// worker once neither the claim nor its checkpoint has been written for the lease, so the jobs of
+/// a preempted worker are resumed from their checkpoints.
+class TuningQueue
+{
+public:
+    explicit TuningQueue(const boost::filesystem::path& directory_,
+                         std::chrono::seconds lease_ = std::chrono::minutes{30});
+
+    /// Adds the jobs that are not in the queue yet. The ids of the jobs are assigned here.
+    /// Returns the number of jobs added.
+    std::size_t Enqueue(std::vector<TuningJob> jobs);
+    /// Claims the first pending job, a running job of the same worker or a job whose lease has
+    /// expired, in that order of preference. Returns none when no job can be claimed.
+    boost::optional<TuningJob> Claim(const std::string& worker);
+    void Complete(const TuningJob& job, const std::string& worker);
+
+    std::vector<TuningJobStatus> GetStatus() const;
+    /// The best config of every solver and problem with at least one evaluated config.
+    std::vector<TuningResult> GetResults() const;
+    TuningCheckpoint OpenCheckpoint(const TuningJob& job) const;
+
+private:
+    boost::filesystem::path directory;
+    std::chrono::seconds lease;
+
+    boost::filesystem::path CheckpointPath(std::size_t id) const;
+    /// Also returns when each job was last claimed.
+    std::vector<TuningJobStatus> ReadStatus(std::vector<std::time_t>& claimed) const;
+    void AppendEvent(const std::string& event, std::size_t id, const std::string& worker);
+};
+
+/// False for the solvers whose search is not a GenericSearch, which cannot be split in slices.
+bool SearchesInSlices(const std::string& solver);
+
+/// One job per slice of every tunable solver applicable to the problem. Solvers that cannot
+/// search in slices get a single job.
+std::vector<TuningJob> MakeTuningJobs(Handle& handle, const Problem& problem, std::size_t slices);
+
+/// Evaluates the configs of the job that its checkpoint does not hold yet. Returns true when the
+/// job is complete, false if the search stopped early, e.g. because of the tuning time limit.
+bool RunTuningJob(Handle& handle, const TuningJob& job, TuningCheckpoint& checkpoint);
+
+/// Writes the results to the user perf-db of the handle's device. Results whose config is not
+/// valid for the solver and problem on this device are skipped. Returns the number written.
+std::size_t StoreTuningResults(Handle& handle, const std::vector<TuningResult>& results);
+
+} // namespace miopen
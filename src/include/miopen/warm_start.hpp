@@ -0,0 +1,67 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/solver_id.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct Problem;
+
+struct WarmStartLayer
+{
+    solver::Id solver;
+    /// False when the find-db had no record and the immediate mode fallback chose the solver.
+    bool find_db_hit = false;
+    /// Choosing the solver and constructing its solution.
+    double resolve_ms = 0;
+    /// Loading the precompiled programs and preparing the invoker.
+    double prepare_ms = 0;
+    /// Empty if the layer is ready.
+    std::string error;
+};
+
+struct WarmStartReport
+{
+    std::vector<WarmStartLayer> layers;
+    /// Compiling the kernels of all the layers in parallel.
+    double compile_ms = 0;
+    double total_ms   = 0;
+};
+
+/// Compiles and caches in the handle the invokers of the best solution of each problem, so that
+/// the first Find or immediate mode call of a model does not pay for them. Solutions come from
+/// the find-db, or from the immediate mode fallback on a miss; nothing is benchmarked. A layer
+/// that fails is reported and does not stop the others.
+WarmStartReport WarmStart(Handle& handle, const std::vector<Problem>& problems);
+
+} // namespace miopen
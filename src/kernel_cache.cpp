@@ -43,6 +43,7 @@
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/shared_program_cache.hpp>
 #include <miopen/stringutils.hpp>
 
 #include <iostream>
@@ -74,21 +75,42 @@ const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
     const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    if(program_map.count(key) > 0)
+        return true;
+    return !shared_scope.empty() &&
+           SharedProgramCache::Instance().Contains({shared_scope, name, params});
 }
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
-    {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
-    }
+    const auto key = std::make_pair(name, params);
+    program_map.erase(key);
+    if(shared_programs.erase(key) > 0)
+        SharedProgramCache::Instance().Release({shared_scope, name, params});
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    const auto key = std::make_pair(program_name, params);
+    if(!shared_scope.empty() && shared_programs.count(key) == 0)
+        prog = AcquireSharedProgram(key, [&]() { return prog; });
+    program_map[key] = prog;
+}
+
+void KernelCache::SharePrograms(std::string scope)
+{
+    if(!shared_programs.empty())
+        MIOPEN_THROW("Programs are already shared within " + shared_scope);
+    MIOPEN_LOG_I2("Sharing programs within " << scope);
+    shared_scope = std::move(scope);
+}
+
+Program KernelCache::AcquireSharedProgram(const Key& key, const std::function<Program()>& load)
+{
+    auto program =
+        SharedProgramCache::Instance().Acquire({shared_scope, key.first, key.second}, load);
+    shared_programs.insert(key);
+    return program;
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -119,8 +141,12 @@ Kernel KernelCache::AddKernel(const Handle& h,
         if(!is_kernel_miopengemm_str) // default value
             is_kernel_miopengemm_str = algorithm.find("ImplicitGEMM") == std::string::npos &&
                                        algorithm.find("GEMM") != std::string::npos;
-        program = h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        const auto load = [&]() {
+            return h.LoadProgram(program_name, params, is_kernel_miopengemm_str, kernel_src);
+        };
+        const auto program_key = std::make_pair(program_name, params);
+        program = shared_scope.empty() ? load() : AcquireSharedProgram(program_key, load);
+        program_map[program_key] = program;
     }
 
     Kernel kernel{};
@@ -168,4 +194,10 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
 
 KernelCache::KernelCache() {}
 
+KernelCache::~KernelCache()
+{
+    for(const auto& key : shared_programs)
+        SharedProgramCache::Instance().Release({shared_scope, key.first, key.second});
+}
+
 } // namespace miopen
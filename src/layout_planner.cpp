@@ -0,0 +1,194 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/layout_planner.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/problem.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace miopen {
+
+namespace {
+
+struct PlanCost
+{
+    std::size_t bytes      = 0;
+    std::size_t transforms = 0;
+    float time             = 0;
+
+    PlanCost Add(bool transform, std::size_t tensor_bytes, float step_time) const
+    {
+        auto ret = *this;
+        if(transform)
+        {
+            // Read and write of the whole tensor.
+            ret.bytes += 2 * tensor_bytes;
+            ret.transforms++;
+        }
+        ret.time += step_time;
+        return ret;
+    }
+
+    bool operator<(const PlanCost& other) const
+    {
+        return std::tie(bytes, transforms, time) <
+               std::tie(other.bytes, other.transforms, other.time);
+    }
+};
+
+const std::string& FastestLayout(const LayoutPlanStep& step)
+{
+    return std::min_element(step.layouts.begin(),
+                            step.layouts.end(),
+                            [](auto&& l, auto&& r) { return l.time < r.time; })
+        ->layout;
+}
+
+} // namespace
+
+LayoutPlan PlanLayouts(const std::vector<LayoutPlanStep>& steps,
+                       const std::string& input_layout,
+                       const std::string& output_layout)
+{
+    if(steps.empty())
+        MIOPEN_THROW(miopenStatusBadParm, "Cannot plan layouts of an empty chain.");
+
+    // costs[i][j] is the cheapest way to run steps 0..i with step i in its layout j, reached from
+    // the layout previous[i][j] of step i - 1.
+    auto costs    = std::vector<std::vector<PlanCost>>(steps.size());
+    auto previous = std::vector<std::vector<std::size_t>>(steps.size());
+
+    for(std::size_t i = 0; i < steps.size(); ++i)
+    {
+        const auto& step = steps[i];
+        if(step.layouts.empty())
+            MIOPEN_THROW(miopenStatusBadParm,
+                         "Step " + std::to_string(i) + " cannot run in any layout.");
+
+        for(const auto& choice : step.layouts)
+        {
+            if(i == 0)
+            {
+                costs[i].push_back(
+                    PlanCost{}.Add(choice.layout != input_layout, step.input_bytes, choice.time));
+                previous[i].push_back(0);
+                continue;
+            }
+
+            const auto& prev_layouts = steps[i - 1].layouts;
+            auto best                = PlanCost{};
+            auto best_prev           = std::size_t{0};
+            for(std::size_t k = 0; k < prev_layouts.size(); ++k)
+            {
+                const auto cost = costs[i - 1][k].Add(
+                    prev_layouts[k].layout != choice.layout, step.input_bytes, choice.time);
+                if(k == 0 || cost < best)
+                {
+                    best      = cost;
+                    best_prev = k;
+                }
+            }
+            costs[i].push_back(best);
+            previous[i].push_back(best_prev);
+        }
+    }
+
+    const auto& last = steps.back();
+    auto best        = PlanCost{};
+    auto best_last   = std::size_t{0};
+    for(std::size_t j = 0; j < last.layouts.size(); ++j)
+    {
+        const auto cost =
+            costs.back()[j].Add(last.layouts[j].layout != output_layout, last.output_bytes, 0);
+        if(j == 0 || cost < best)
+        {
+            best      = cost;
+            best_last = j;
+        }
+    }
+
+    auto plan = LayoutPlan{};
+    plan.layouts.resize(steps.size());
+    for(auto i = steps.size(), j = best_last; i-- > 0;)
+    {
+        plan.layouts[i] = steps[i].layouts[j].layout;
+        j               = previous[i][j];
+    }
+
+    auto current = input_layout;
+    for(std::size_t i = 0; i < steps.size(); ++i)
+    {
+        if(plan.layouts[i] != current)
+            plan.transforms.push_back({i, current, plan.layouts[i], 2 * steps[i].input_bytes});
+        current = plan.layouts[i];
+    }
+    if(current != output_layout)
+        plan.transforms.push_back({steps.size(), current, output_layout, 2 * last.output_bytes});
+    plan.bytes_moved = best.bytes;
+
+    // Without planning the tensors between the steps stay in the input layout and every step
+    // running in another one transposes both its input and its output.
+    for(const auto& step : steps)
+    {
+        if(FastestLayout(step) != input_layout)
+            plan.unplanned_bytes_moved += 2 * (step.input_bytes + step.output_bytes);
+    }
+    if(input_layout != output_layout)
+        plan.unplanned_bytes_moved += 2 * last.output_bytes;
+
+    return plan;
+}
+
+LayoutPlan PlanLayouts(Handle& handle,
+                       const std::vector<Problem>& problems,
+                       const std::vector<std::string>& candidates,
+                       const std::string& input_layout,
+                       const std::string& output_layout)
+{
+    auto steps = std::vector<LayoutPlanStep>{};
+    steps.reserve(problems.size());
+    for(const auto& problem : problems)
+        steps.push_back(problem.MakeLayoutPlanStep(handle, candidates));
+    return PlanLayouts(steps, input_layout, output_layout);
+}
+
+std::ostream& operator<<(std::ostream& stream, const LayoutPlan& plan)
+{
+    for(std::size_t i = 0; i < plan.layouts.size(); ++i)
+        stream << (i == 0 ? "" : " ") << plan.layouts[i];
+    stream << ", " << plan.transforms.size() << " transforms";
+    for(const auto& transform : plan.transforms)
+        stream << " (" << transform.from << "-" << transform.to << " at " << transform.position
+               << ")";
+    stream << ", " << plan.bytes_moved << " bytes moved (" << plan.unplanned_bytes_moved
+           << " without planning)";
+    return stream;
+}
+
+} // namespace miopen
@@ -76,6 +76,7 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
             fs::permissions(path, fs::all_all);
         }
         flock = path;
+        MapGeneration();
     }
     catch(const fs::filesystem_error& ex)
     {
@@ -89,6 +90,31 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
     }
 }
 
+void LockFile::MapGeneration()
+{
+    namespace ipc = boost::interprocess;
+
+    try
+    {
+        // Growing an empty lock file to the counter size is harmless if processes race on it,
+        // and never touches a counter already written.
+        if(fs::file_size(path) < sizeof(std::uint64_t))
+            fs::resize_file(path, sizeof(std::uint64_t));
+
+        const auto mapping = ipc::file_mapping{path, ipc::read_write};
+        generation_region  = ipc::mapped_region{mapping, ipc::read_write, 0, sizeof(std::uint64_t)};
+        generation = static_cast<std::atomic<std::uint64_t>*>(generation_region.get_address());
+    }
+    catch(const fs::filesystem_error& ex)
+    {
+        MIOPEN_LOG_W("Cannot map generation counter of <" << path << ">: " << ex.what());
+    }
+    catch(const boost::interprocess::interprocess_exception& ex)
+    {
+        MIOPEN_LOG_W("Cannot map generation counter of <" << path << ">: " << ex.what());
+    }
+}
+
 LockFile& LockFile::Get(const char* path)
 {
     // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
@@ -40,6 +40,7 @@
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
 #include <miopen/tensor.hpp>
+#include <miopen/tensor_dump.hpp>
 #include <miopen/util.hpp>
 #include <miopen/visit_float.hpp>
 #include <miopen/datatype.hpp>
@@ -332,49 +333,8 @@ void DumpTensorToFileFromDevice(const miopen::Handle& handle,
                                 ConstData_t dData,
                                 const std::string& filename)
 {
-    if(dData == nullptr)
-    {
-        MIOPEN_LOG_E("Dereferencing nullptr when trying to dump tensor from gpu");
-        return;
-    }
-    namespace fs = boost::filesystem;
-
-    fs::path file_name_with_path(filename);
-    fs::path path = file_name_with_path.parent_path();
-
-    // dump to current folder if full path not provided.
-    if(path.empty())
-    {
-        path                = fs::current_path();
-        file_name_with_path = path / file_name_with_path; // append paths
-    }
-    if(!fs::exists(path))
-    {
-        MIOPEN_LOG_E("Directory does not exists : " << path);
-        return;
-    }
-    std::string file_name_with_path_str = file_name_with_path.string();
-
-    std::ofstream file_stream;
-    file_stream.open(file_name_with_path_str);
-
-    if(!file_stream.is_open())
-    {
-        MIOPEN_LOG_E("Cannot write to file : " << file_name_with_path_str);
-        return;
-    }
-
-    // read tensor data from gpu
-    size_t num_bytes = tDesc.GetNumBytes();
-    MIOPEN_LOG_I2("Start bringing tensor from device to host");
-    std::vector<char> hdata(num_bytes);
-    handle.ReadTo(hdata.data(), dData, num_bytes);
-    MIOPEN_LOG_I2("Done bringing tensor from device to host");
-    // write tensor data to file
-    const char* pointer = reinterpret_cast<const char*>(&hdata[0]);
-    file_stream.write(pointer, num_bytes);
-    file_stream.close();
-    MIOPEN_LOG_I("Dumping tensor to file : " << file_name_with_path_str);
+    DumpTensorToFileAsync(handle, tDesc, dData, filename);
+    FlushTensorDumps();
 }
 
 static void ConvForwardCheckNumerics(const Handle& handle,
@@ -387,22 +347,24 @@ static void ConvForwardCheckNumerics(const Handle& handle,
         return;
     }
 
-    bool flag = false;
+    CheckNumericsBatch checks(handle);
 
-    flag |= miopen::checkNumericsInput(handle, tensors.xDesc, tensors.x);
-    flag |= miopen::checkNumericsInput(handle, tensors.wDesc, tensors.w);
+    checks.Input(tensors.xDesc, tensors.x);
+    checks.Input(tensors.wDesc, tensors.w);
 
     worker();
 
-    flag |= miopen::checkNumericsOutput(handle, tensors.yDesc, tensors.y);
+    checks.Output(tensors.yDesc, tensors.y);
+
+    const bool flag = checks.Collect();
 
     const char* file_name = miopen::GetStringEnv(MIOPEN_DUMP_TENSOR_PATH{});
-    if(flag && static_cast<bool>(file_name))
+    if(flag && static_cast<bool>(file_name) && TensorDumpSelected())
     {
         std::string file_name_str = file_name;
-        DumpTensorToFileFromDevice(handle, tensors.xDesc, tensors.x, file_name_str + "_x.bin");
-        DumpTensorToFileFromDevice(handle, tensors.wDesc, tensors.w, file_name_str + "_w.bin");
-        DumpTensorToFileFromDevice(handle, tensors.yDesc, tensors.y, file_name_str + "_y.bin");
+        DumpTensorToFileAsync(handle, tensors.xDesc, tensors.x, file_name_str + "_x.bin");
+        DumpTensorToFileAsync(handle, tensors.wDesc, tensors.w, file_name_str + "_w.bin");
+        DumpTensorToFileAsync(handle, tensors.yDesc, tensors.y, file_name_str + "_y.bin");
     }
 }
 
@@ -846,24 +808,26 @@ static void ConvBwdCheckNumerics(const Handle& handle,
         return;
     }
 
-    bool flag = false;
+    CheckNumericsBatch checks(handle);
 
-    flag |= miopen::checkNumericsInput(handle, tensors.dyDesc, tensors.dy);
-    flag |= miopen::checkNumericsInput(handle, tensors.wDesc, tensors.w);
+    checks.Input(tensors.dyDesc, tensors.dy);
+    checks.Input(tensors.wDesc, tensors.w);
     if(!float_equal(*(static_cast<const float*>(beta)), 0))
-        flag |= miopen::checkNumericsInput(handle, tensors.dxDesc, tensors.dx);
+        checks.Input(tensors.dxDesc, tensors.dx);
 
     worker();
 
-    flag |= miopen::checkNumericsOutput(handle, tensors.dxDesc, tensors.dx);
+    checks.Output(tensors.dxDesc, tensors.dx);
+
+    const bool flag = checks.Collect();
 
     const char* file_name = miopen::GetStringEnv(MIOPEN_DUMP_TENSOR_PATH{});
-    if(flag && static_cast<bool>(file_name))
+    if(flag && static_cast<bool>(file_name) && TensorDumpSelected())
     {
         std::string file_name_str = file_name;
-        DumpTensorToFileFromDevice(handle, tensors.dyDesc, tensors.dy, file_name_str + "_dy.bin");
-        DumpTensorToFileFromDevice(handle, tensors.wDesc, tensors.w, file_name_str + "_w.bin");
-        DumpTensorToFileFromDevice(handle, tensors.dxDesc, tensors.dx, file_name_str + "_dx.bin");
+        DumpTensorToFileAsync(handle, tensors.dyDesc, tensors.dy, file_name_str + "_dy.bin");
+        DumpTensorToFileAsync(handle, tensors.wDesc, tensors.w, file_name_str + "_w.bin");
+        DumpTensorToFileAsync(handle, tensors.dxDesc, tensors.dx, file_name_str + "_dx.bin");
     }
 }
 
@@ -1055,24 +1019,26 @@ static void ConvWrwCheckNumerics(const Handle& handle,
         return;
     }
 
-    bool flag = false;
+    CheckNumericsBatch checks(handle);
 
-    flag |= miopen::checkNumericsInput(handle, tensors.dyDesc, tensors.dy);
-    flag |= miopen::checkNumericsInput(handle, tensors.xDesc, tensors.x);
+    checks.Input(tensors.dyDesc, tensors.dy);
+    checks.Input(tensors.xDesc, tensors.x);
     if(!float_equal(*(static_cast<const float*>(beta)), 0))
-        flag |= miopen::checkNumericsInput(handle, tensors.dwDesc, tensors.dw);
+        checks.Input(tensors.dwDesc, tensors.dw);
 
     worker();
 
-    flag |= miopen::checkNumericsOutput(handle, tensors.dwDesc, tensors.dw);
+    checks.Output(tensors.dwDesc, tensors.dw);
+
+    const bool flag = checks.Collect();
 
     const char* file_name = miopen::GetStringEnv(MIOPEN_DUMP_TENSOR_PATH{});
-    if(flag && static_cast<bool>(file_name))
+    if(flag && static_cast<bool>(file_name) && TensorDumpSelected())
     {
         std::string file_name_str = file_name;
-        DumpTensorToFileFromDevice(handle, tensors.dyDesc, tensors.dy, file_name_str + "_dy.bin");
-        DumpTensorToFileFromDevice(handle, tensors.xDesc, tensors.x, file_name_str + "_x.bin");
-        DumpTensorToFileFromDevice(handle, tensors.dwDesc, tensors.dw, file_name_str + "_dw.bin");
+        DumpTensorToFileAsync(handle, tensors.dyDesc, tensors.dy, file_name_str + "_dy.bin");
+        DumpTensorToFileAsync(handle, tensors.xDesc, tensors.x, file_name_str + "_x.bin");
+        DumpTensorToFileAsync(handle, tensors.dwDesc, tensors.dw, file_name_str + "_dw.bin");
     }
 }
 
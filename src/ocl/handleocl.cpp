@@ -27,6 +27,7 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/check_numerics.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -271,7 +272,19 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+
+Handle::~Handle()
+{
+    // Deferred numerics checks are reported here at the latest. Nothing may escape a destructor.
+    try
+    {
+        FlushCheckNumerics(*this);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_E(ex.what());
+    }
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -460,7 +473,11 @@ void Handle::AddProgram(Program prog,
     this->impl->cache.AddProgram(prog, program_name, params);
 }
 
-void Handle::Finish() const { clFinish(this->GetStream()); }
+void Handle::Finish() const
+{
+    clFinish(this->GetStream());
+    FlushCheckNumerics(*this);
+}
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
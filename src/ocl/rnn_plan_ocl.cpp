@@ -0,0 +1,384 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/rnn.hpp>
+#include <miopen/rnn_plan.hpp>
+#include <miopen/rnn_util.hpp>
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <algorithm>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_GEMM_BATCHING)
+
+namespace miopen {
+
+RNNPlanRecorder::RNNPlanRecorder(Handle& handle_, const RNNPlanBindings& bindings_, bool record)
+    : handle(handle_), bindings(bindings_), plan(record ? std::make_shared<RNNPlan>() : nullptr)
+{
+}
+
+bool RNNPlanRecorder::Resolve(ConstData_t ptr, RNNPlanBuffer& buffer)
+{
+    if(plan == nullptr)
+        return false;
+    if(bindings.Find(ptr, buffer))
+        return true;
+    MIOPEN_LOG_I2("Buffer is not uniquely bound, RNN plan recording abandoned");
+    plan = nullptr;
+    return false;
+}
+
+std::shared_ptr<const RNNPlan> RNNPlanRecorder::Finish()
+{
+    if(!queued_gemms.empty())
+        MIOPEN_THROW("RNN plan finished with queued GEMMs");
+    auto result = std::move(plan);
+    plan        = nullptr;
+    return result;
+}
+
+#if MIOPEN_USE_GEMM
+miopenStatus_t RNNPlanRecorder::CallGemm(const GemmDescriptor& gemm_desc,
+                                         ConstData_t A,
+                                         int a_offset,
+                                         ConstData_t B,
+                                         int b_offset,
+                                         Data_t C,
+                                         int c_offset,
+                                         GemmBackend_t gemm_backend)
+{
+    const auto status =
+        miopen::CallGemm(handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, gemm_backend);
+
+    // A failed launch must not be baked into a plan.
+    if(status != miopenStatusSuccess)
+        plan = nullptr;
+
+    RNNPlanBuffer a, b, c;
+    if(Resolve(A, a) && Resolve(B, b) && Resolve(C, c))
+    {
+        plan->Add(RNNPlanOp::Gemm, [=](Handle& h, const RNNPlanBindings& bind) {
+            const auto replay_status = miopen::CallGemm(h,
+                                                        gemm_desc,
+                                                        bind.Get(a),
+                                                        a_offset,
+                                                        bind.Get(b),
+                                                        b_offset,
+                                                        bind.Get(c),
+                                                        c_offset,
+                                                        gemm_backend);
+            if(replay_status != miopenStatusSuccess)
+                MIOPEN_LOG_E("GEMM failed");
+        });
+    }
+    return status;
+}
+
+miopenStatus_t RNNPlanRecorder::CallGemmStridedBatched(const GemmDescriptor& gemm_desc,
+                                                       ConstData_t A,
+                                                       int a_offset,
+                                                       ConstData_t B,
+                                                       int b_offset,
+                                                       Data_t C,
+                                                       int c_offset,
+                                                       GemmBackend_t gemm_backend)
+{
+    const auto status = miopen::CallGemmStridedBatched(
+        handle, gemm_desc, A, a_offset, B, b_offset, C, c_offset, gemm_backend);
+
+    if(status != miopenStatusSuccess)
+        plan = nullptr;
+
+    RNNPlanBuffer a, b, c;
+    if(Resolve(A, a) && Resolve(B, b) && Resolve(C, c))
+    {
+        plan->Add(
+            RNNPlanOp::GemmStridedBatched,
+            [=](Handle& h, const RNNPlanBindings& bind) {
+                const auto replay_status = miopen::CallGemmStridedBatched(h,
+                                                                          gemm_desc,
+                                                                          bind.Get(a),
+                                                                          a_offset,
+                                                                          bind.Get(b),
+                                                                          b_offset,
+                                                                          bind.Get(c),
+                                                                          c_offset,
+                                                                          gemm_backend);
+                if(replay_status != miopenStatusSuccess)
+                    MIOPEN_LOG_E("GEMM failed");
+            },
+            gemm_desc.batch_count);
+    }
+    return status;
+}
+
+void RNNPlanRecorder::QueueGemm(const GemmDescriptor& gemm_desc,
+                                ConstData_t A,
+                                int a_offset,
+                                ConstData_t B,
+                                int b_offset,
+                                Data_t C,
+                                int c_offset,
+                                GemmBackend_t gemm_backend)
+{
+    queued_gemms.push_back({gemm_desc, A, a_offset, B, b_offset, C, c_offset, gemm_backend});
+}
+
+miopenStatus_t RNNPlanRecorder::FlushGemms(float& ctime)
+{
+    // Only backends with a native strided batched GEMM save launches by batching.
+    const auto batch =
+        !miopen::IsDisabled(MIOPEN_DEBUG_RNN_GEMM_BATCHING{}) &&
+        std::all_of(queued_gemms.begin(), queued_gemms.end(), [](const auto& call) {
+            return IsGemmStridedBatchedNative(call.desc.dataType, call.backend);
+        });
+    const auto calls = batch ? BatchIndependentGemms(queued_gemms) : std::move(queued_gemms);
+    queued_gemms.clear();
+
+    auto result = miopenStatusSuccess;
+    for(const auto& call : calls)
+    {
+        const auto status =
+            call.desc.batch_count == 1
+                ? CallGemm(call.desc,
+                           call.A,
+                           call.a_offset,
+                           call.B,
+                           call.b_offset,
+                           call.C,
+                           call.c_offset,
+                           call.backend)
+                : CallGemmStridedBatched(call.desc,
+                                         call.A,
+                                         call.a_offset,
+                                         call.B,
+                                         call.b_offset,
+                                         call.C,
+                                         call.c_offset,
+                                         call.backend);
+        profileRNNkernels(handle, 1, ctime);
+        if(result == miopenStatusSuccess)
+            result = status;
+    }
+    return result;
+}
+#endif
+
+void RNNPlanRecorder::OpTensor(miopenTensorOp_t tensorOp,
+                               float alpha0,
+                               const TensorDescriptor& aDesc,
+                               ConstData_t A,
+                               float alpha1,
+                               const TensorDescriptor& bDesc,
+                               ConstData_t B,
+                               float beta,
+                               const TensorDescriptor& cDesc,
+                               Data_t C,
+                               std::size_t Aoffset,
+                               std::size_t Boffset,
+                               std::size_t Coffset)
+{
+    miopen::OpTensor(handle,
+                     tensorOp,
+                     &alpha0,
+                     aDesc,
+                     A,
+                     &alpha1,
+                     bDesc,
+                     B,
+                     &beta,
+                     cDesc,
+                     C,
+                     Aoffset,
+                     Boffset,
+                     Coffset);
+
+    RNNPlanBuffer a, b, c;
+    if(Resolve(A, a) && Resolve(B, b) && Resolve(C, c))
+    {
+        plan->Add(RNNPlanOp::OpTensor, [=](Handle& h, const RNNPlanBindings& bind) {
+            miopen::OpTensor(h,
+                             tensorOp,
+                             &alpha0,
+                             aDesc,
+                             bind.Get(a),
+                             &alpha1,
+                             bDesc,
+                             bind.Get(b),
+                             &beta,
+                             cDesc,
+                             bind.Get(c),
+                             Aoffset,
+                             Boffset,
+                             Coffset);
+        });
+    }
+}
+
+void RNNPlanRecorder::CopyTensor(const TensorDescriptor& srcDesc,
+                                 ConstData_t src,
+                                 const TensorDescriptor& dstDesc,
+                                 Data_t dst,
+                                 int srcOffset,
+                                 int dstOffset)
+{
+    miopen::CopyTensor(handle, srcDesc, src, dstDesc, dst, srcOffset, dstOffset);
+
+    RNNPlanBuffer s, d;
+    if(Resolve(src, s) && Resolve(dst, d))
+    {
+        plan->Add(RNNPlanOp::CopyTensor, [=](Handle& h, const RNNPlanBindings& bind) {
+            miopen::CopyTensor(h, srcDesc, bind.Get(s), dstDesc, bind.Get(d), srcOffset, dstOffset);
+        });
+    }
+}
+
+void RNNPlanRecorder::SetTensor(const TensorDescriptor& yDesc, Data_t y, float value, int offset)
+{
+    miopen::SetTensor(handle, yDesc, y, &value, offset);
+
+    RNNPlanBuffer dst;
+    if(Resolve(y, dst))
+    {
+        plan->Add(RNNPlanOp::SetTensor, [=](Handle& h, const RNNPlanBindings& bind) {
+            miopen::SetTensor(h, yDesc, bind.Get(dst), &value, offset);
+        });
+    }
+}
+
+void RNNPlanRecorder::ActivationForward(const ActivationDescriptor& activDesc,
+                                        float alpha,
+                                        const TensorDescriptor& xDesc,
+                                        ConstData_t x,
+                                        float beta,
+                                        const TensorDescriptor& yDesc,
+                                        Data_t y,
+                                        std::size_t xOffset,
+                                        std::size_t yOffset)
+{
+    auto desc = activDesc;
+    desc.Forward(handle, &alpha, xDesc, x, &beta, yDesc, y, xOffset, yOffset);
+
+    RNNPlanBuffer src, dst;
+    if(Resolve(x, src) && Resolve(y, dst))
+    {
+        plan->Add(RNNPlanOp::Activation, [=](Handle& h, const RNNPlanBindings& bind) {
+            // Forward() is not const-qualified, so launch from a local copy.
+            auto replay_desc = desc;
+            replay_desc.Forward(
+                h, &alpha, xDesc, bind.Get(src), &beta, yDesc, bind.Get(dst), xOffset, yOffset);
+        });
+    }
+}
+
+void RNNPlanRecorder::LSTMForwardHiddenStateUpdate(miopenDataType_t rnn_data_type,
+                                                   bool is_inference,
+                                                   bool is_seq_begin,
+                                                   int direction,
+                                                   int max_batch,
+                                                   int cur_batch,
+                                                   int use_batch,
+                                                   int hy_h,
+                                                   int hy_stride,
+                                                   int wei_len,
+                                                   int wei_stride,
+                                                   ConstData_t cx,
+                                                   std::size_t cx_offset,
+                                                   Data_t reserve_space,
+                                                   std::size_t i_offset,
+                                                   std::size_t f_offset,
+                                                   std::size_t o_offset,
+                                                   std::size_t c_offset,
+                                                   std::size_t cell_offset,
+                                                   std::size_t cell_offset_pre,
+                                                   std::size_t activ_cell_offset,
+                                                   std::size_t hidden_offset)
+{
+    miopen::LSTMForwardHiddenStateUpdate(handle,
+                                         rnn_data_type,
+                                         is_inference,
+                                         is_seq_begin,
+                                         direction,
+                                         max_batch,
+                                         cur_batch,
+                                         use_batch,
+                                         hy_h,
+                                         hy_stride,
+                                         wei_len,
+                                         wei_stride,
+                                         cx,
+                                         cx_offset,
+                                         reserve_space,
+                                         i_offset,
+                                         f_offset,
+                                         o_offset,
+                                         c_offset,
+                                         cell_offset,
+                                         cell_offset_pre,
+                                         activ_cell_offset,
+                                         hidden_offset);
+
+    // cx is optional and only read at the beginning of the sequence.
+    const auto has_cx       = cx != nullptr;
+    RNNPlanBuffer cx_buffer = RNNPlanBuffer::Cx, rsv;
+    if((!has_cx || Resolve(cx, cx_buffer)) && Resolve(reserve_space, rsv))
+    {
+        plan->Add(RNNPlanOp::LSTMHiddenStateUpdate,
+                  [=](Handle& h, const RNNPlanBindings& bind) {
+                      miopen::LSTMForwardHiddenStateUpdate(h,
+                                                           rnn_data_type,
+                                                           is_inference,
+                                                           is_seq_begin,
+                                                           direction,
+                                                           max_batch,
+                                                           cur_batch,
+                                                           use_batch,
+                                                           hy_h,
+                                                           hy_stride,
+                                                           wei_len,
+                                                           wei_stride,
+                                                           has_cx ? bind.Get(cx_buffer) : nullptr,
+                                                           cx_offset,
+                                                           bind.Get(rsv),
+                                                           i_offset,
+                                                           f_offset,
+                                                           o_offset,
+                                                           c_offset,
+                                                           cell_offset,
+                                                           cell_offset_pre,
+                                                           activ_cell_offset,
+                                                           hidden_offset);
+                  });
+    }
+}
+
+} // namespace miopen
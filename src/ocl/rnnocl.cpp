@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include <miopen/rnn.hpp>
+#include <miopen/rnn_plan.hpp>
 #include <miopen/rnn_util.hpp>
 
 #include <miopen/activ.hpp>
@@ -37,6 +38,7 @@
 #include <algorithm>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_RNNFWD_exp)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RNN_PLANS)
 
 namespace miopen {
 
@@ -924,6 +926,43 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     }
     // input check end
 
+    RNNPlanBindings plan_bindings;
+    plan_bindings.Set(RNNPlanBuffer::X, x);
+    plan_bindings.Set(RNNPlanBuffer::W, w);
+    plan_bindings.Set(RNNPlanBuffer::Y, y);
+    plan_bindings.Set(RNNPlanBuffer::Hx, hx);
+    plan_bindings.Set(RNNPlanBuffer::Cx, cx);
+    plan_bindings.Set(RNNPlanBuffer::Hy, hy);
+    plan_bindings.Set(RNNPlanBuffer::Cy, cy);
+    plan_bindings.Set(RNNPlanBuffer::Workspace, workSpace);
+
+    RNNPlanKey plan_key;
+    plan_key.data_type       = wDesc.GetType();
+    plan_key.in_h            = in_h;
+    plan_key.hy_d            = hy_d;
+    plan_key.hy_n            = hy_n;
+    plan_key.hy_h            = hy_h;
+    plan_key.out_h           = out_h;
+    plan_key.batches         = in_n;
+    plan_key.workspace_size  = workSpaceSize;
+    plan_key.present_buffers = (hx != nullptr ? 1u : 0u) | (cx != nullptr ? 2u : 0u) |
+                               (hy != nullptr ? 4u : 0u) | (cy != nullptr ? 8u : 0u);
+
+    // Shapes repeat from call to call in serving, so the launch sequence is recorded once
+    // and replayed afterwards. Profiling needs the per-kernel timing calls, so it always
+    // takes the direct path.
+    const auto use_plans =
+        !handle.IsProfilingEnabled() && !miopen::IsDisabled(MIOPEN_DEBUG_RNN_PLANS{});
+    if(use_plans)
+    {
+        if(const auto plan = plans->Find(plan_key))
+        {
+            plan->Run(handle, plan_bindings);
+            return;
+        }
+    }
+    RNNPlanRecorder plan_rec(handle, plan_bindings, use_plans);
+
     int in_stride  = xDesc[0].GetLengths()[1];
     int hy_stride  = hy_h * bi * static_cast<int>(workspaceScale);
     int out_stride = out_h;
@@ -944,7 +983,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     sp_stride[0] = sp_size[2];
     sp_stride[1] = sp_size[2];
     sp_desc      = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
-    SetTensor(handle, sp_desc, workSpace, &beta);
+    plan_rec.SetTensor(sp_desc, workSpace, beta);
     // Update time
     profileRNNkernels(handle, 1, ctime);
     sp_stride[0] = batch_n * hy_stride;
@@ -964,13 +1003,13 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         hx_desc      = miopen::TensorDescriptor(wDesc.GetType(), hx_size, hx_stride);
         if(hy != nullptr)
         {
-            SetTensor(handle, hx_desc, hy, &beta);
+            plan_rec.SetTensor(hx_desc, hy, beta);
             // Update time
             profileRNNkernels(handle, 1, ctime);
         }
         if(rnnMode == miopenLSTM && cy != nullptr)
         {
-            SetTensor(handle, hx_desc, cy, &beta);
+            plan_rec.SetTensor(hx_desc, cy, beta);
             // Update time
             profileRNNkernels(handle, 1, ctime);
         }
@@ -1034,7 +1073,7 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                 for(int gi = 0; gi < nHiddenTensorsPerLayer * bi; gi++)
                 {
-                    CopyTensor(handle, x_desc, x, sp_desc, workSpace, 0, gi * hy_h);
+                    plan_rec.CopyTensor(x_desc, x, sp_desc, workSpace, 0, gi * hy_h);
                     // Update time
                     profileRNNkernels(handle, 1, ctime);
                 }
@@ -1060,8 +1099,8 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                    xDesc[0].GetType(),
                                    false}; // RNN does not support determinism
 
-                miopenStatus_t gemm_status = CallGemm(
-                    handle, gemm_desc, x, 0, w, 0, workSpace, hid_shift, GemmBackend_t::miopengemm);
+                miopenStatus_t gemm_status = plan_rec.CallGemm(
+                    gemm_desc, x, 0, w, 0, workSpace, hid_shift, GemmBackend_t::miopengemm);
 
                 if(gemm_status != miopenStatusSuccess)
                 {
@@ -1100,15 +1139,14 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                                               1, // beta
                                                               xDesc[0].GetType(),
                                                               false};
-            miopenStatus_t gemm_status       = CallGemm(handle,
-                                                  gemm_desc,
-                                                  workSpace,
-                                                  prelayer_shift,
-                                                  w,
-                                                  wei_shift,
-                                                  workSpace,
-                                                  hid_shift,
-                                                  GemmBackend_t::miopengemm);
+            miopenStatus_t gemm_status       = plan_rec.CallGemm(gemm_desc,
+                                                                 workSpace,
+                                                                 prelayer_shift,
+                                                                 w,
+                                                                 wei_shift,
+                                                                 workSpace,
+                                                                 hid_shift,
+                                                                 GemmBackend_t::miopengemm);
 
             if(gemm_status != miopenStatusSuccess)
             {
@@ -1138,20 +1176,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             w_desc     = miopen::TensorDescriptor(wDesc.GetType(), w_size, w_stride);
             sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-            OpTensor(handle,
-                     miopenTensorOpAdd,
-                     &alpha0,
-                     sp_desc,
-                     workSpace,
-                     &alpha1,
-                     w_desc,
-                     w,
-                     &beta_t,
-                     sp_desc,
-                     workSpace,
-                     hid_shift,
-                     wei_shift_bias_temp,
-                     hid_shift);
+            plan_rec.OpTensor(miopenTensorOpAdd,
+                              alpha0,
+                              sp_desc,
+                              workSpace,
+                              alpha1,
+                              w_desc,
+                              w,
+                              beta_t,
+                              sp_desc,
+                              workSpace,
+                              hid_shift,
+                              wei_shift_bias_temp,
+                              hid_shift);
             // Update time
             profileRNNkernels(handle, 1, ctime);
         }
@@ -1167,30 +1204,28 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
             beta_t = 0;
             for(int bs = 0; bs < bi; bs++)
             {
-                CopyTensor(handle,
-                           sp_desc,
-                           workSpace,
-                           sp_desc,
-                           workSpace,
-                           hid_shift + bs * wei_len + 2 * hy_h,
-                           hid_shift + hid_off + bs * hy_h);
+                plan_rec.CopyTensor(sp_desc,
+                                    workSpace,
+                                    sp_desc,
+                                    workSpace,
+                                    hid_shift + bs * wei_len + 2 * hy_h,
+                                    hid_shift + hid_off + bs * hy_h);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
 
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         sp_desc,
-                         workSpace,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift + bs * wei_len + 2 * hy_h,
-                         hid_shift + bs * wei_len + 2 * hy_h,
-                         hid_shift + bs * wei_len + 2 * hy_h);
+                plan_rec.OpTensor(miopenTensorOpAdd,
+                                  alpha0,
+                                  sp_desc,
+                                  workSpace,
+                                  alpha1,
+                                  sp_desc,
+                                  workSpace,
+                                  beta_t,
+                                  sp_desc,
+                                  workSpace,
+                                  hid_shift + bs * wei_len + 2 * hy_h,
+                                  hid_shift + bs * wei_len + 2 * hy_h,
+                                  hid_shift + bs * wei_len + 2 * hy_h);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
             }
@@ -1210,20 +1245,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                 sp_size[2] = wei_stride;
                 sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         w_desc,
-                         w,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift,
-                         wei_shift_bias_temp,
-                         hid_shift);
+                plan_rec.OpTensor(miopenTensorOpAdd,
+                                  alpha0,
+                                  sp_desc,
+                                  workSpace,
+                                  alpha1,
+                                  w_desc,
+                                  w,
+                                  beta_t,
+                                  sp_desc,
+                                  workSpace,
+                                  hid_shift,
+                                  wei_shift_bias_temp,
+                                  hid_shift);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
             }
@@ -1236,20 +1270,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                 w_size[2]  = wei_len;
                 w_desc     = miopen::TensorDescriptor(wDesc.GetType(), w_size, w_stride);
 
-                OpTensor(handle,
-                         miopenTensorOpAdd,
-                         &alpha0,
-                         sp_desc,
-                         workSpace,
-                         &alpha1,
-                         w_desc,
-                         w,
-                         &beta_t,
-                         sp_desc,
-                         workSpace,
-                         hid_shift + in_n.at(0) * hy_stride,
-                         wei_shift_bias_temp,
-                         hid_shift + in_n.at(0) * hy_stride);
+                plan_rec.OpTensor(miopenTensorOpAdd,
+                                  alpha0,
+                                  sp_desc,
+                                  workSpace,
+                                  alpha1,
+                                  w_desc,
+                                  w,
+                                  beta_t,
+                                  sp_desc,
+                                  workSpace,
+                                  hid_shift + in_n.at(0) * hy_stride,
+                                  wei_shift_bias_temp,
+                                  hid_shift + in_n.at(0) * hy_stride);
                 // Update time
                 profileRNNkernels(handle, 1, ctime);
 
@@ -1257,20 +1290,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                 {
                     if(in_n.at(0) == in_n.at(seqLen - 1))
                     {
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 w_desc,
-                                 w,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 hid_shift + wei_len,
-                                 wei_shift_bias_temp + wei_len,
-                                 hid_shift + wei_len);
+                        plan_rec.OpTensor(miopenTensorOpAdd,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          w_desc,
+                                          w,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          hid_shift + wei_len,
+                                          wei_shift_bias_temp + wei_len,
+                                          hid_shift + wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
                     }
@@ -1288,20 +1320,19 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 sp_desc =
                                     miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                                OpTensor(handle,
-                                         miopenTensorOpAdd,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         w_desc,
-                                         w,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + wei_len,
-                                         wei_shift_bias_temp + wei_len,
-                                         offset + wei_len);
+                                plan_rec.OpTensor(miopenTensorOpAdd,
+                                                  alpha0,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  alpha1,
+                                                  w_desc,
+                                                  w,
+                                                  beta_t,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  offset + wei_len,
+                                                  wei_shift_bias_temp + wei_len,
+                                                  offset + wei_len);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
@@ -1313,244 +1344,132 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
         }
 
         // from hidden state
+        const auto hidden_gemms = RNNHiddenGemmLayer{xDesc[0].GetType(),
+                                                     bi,
+                                                     hy_h,
+                                                     hy_n,
+                                                     wei_len,
+                                                     hid_off,
+                                                     hy_stride,
+                                                     uni_stride,
+                                                     hid_shift,
+                                                     hx_shift,
+                                                     in_h * wei_stride +
+                                                         li * (bi * hy_h + hy_h) * wei_stride,
+                                                     hx,
+                                                     w,
+                                                     workSpace};
         int bacc   = 0;
         int baccbi = batch_n;
         for(int ti = 0; ti < seqLen; ti++)
         {
             baccbi -= in_n.at(seqLen - 1 - ti);
-            wei_shift         = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
-            int pretime_shift = 0;
-            int use_time      = 0;
 
-            for(int ri = 0; ri < bi; ri++)
+            // The GEMMs of both directions only read the previous time step, so they are
+            // queued and issued together ahead of the hidden state updates.
+            for(const auto& call : RNNHiddenGemms(hidden_gemms, in_n, bacc, baccbi, ti))
+                plan_rec.QueueGemm(call.desc,
+                                   call.A,
+                                   call.a_offset,
+                                   call.B,
+                                   call.b_offset,
+                                   call.C,
+                                   call.c_offset,
+                                   call.backend);
+
+            const auto gemm_status = plan_rec.FlushGemms(ctime);
+            if(gemm_status != miopenStatusSuccess)
             {
-                int cur_time  = ri == 0 ? ti : seqLen - 1 - ti;
-                int cur_batch = ri == 0 ? bacc : baccbi;
-                offset        = hid_shift + cur_batch * hy_stride;
-                if(ti > 0)
+                if(gemm_status == miopenStatusNotImplemented)
                 {
-                    pretime_shift =
-                        ri == 0 ? hid_shift + (bacc - in_n.at(ti - 1)) * hy_stride
-                                : hid_shift + (baccbi + in_n.at(seqLen - 1 - ti)) * hy_stride;
-                    use_time = ri == 0 ? ti : seqLen - ti;
+                    MIOPEN_LOG_E("GEMM not implemented");
+                }
+                else
+                {
+                    MIOPEN_LOG_E("GEMM failed");
                 }
+            }
+
+            for(int ri = 0; ri < bi; ri++)
+            {
+                const auto step = RNNTimeStep{in_n, hid_shift, hy_stride, bacc, baccbi, ti, ri};
+
+                const auto cur_time      = step.cur_time;
+                const auto use_time      = step.use_time;
+                const auto pretime_shift = step.pretime_shift;
+                offset                   = step.offset;
 
                 if(in_n.at(cur_time) > 0)
                 {
-                    if(ti == 0)
+                    // update hidden status
+                    sp_size[1] = in_n.at(cur_time);
+                    if(rnnMode == miopenRNNRELU || rnnMode == miopenRNNTANH)
                     {
-                        if(hx != nullptr)
-                        {
-                            miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
-                                                                              false,
-                                                                              true,
-                                                                              in_n.at(cur_time),
-                                                                              wei_len,
-                                                                              hy_h,
-                                                                              uni_stride,
-                                                                              uni_stride,
-                                                                              hy_stride,
-                                                                              1, // batch count
-                                                                              0, // Stride A
-                                                                              0, // Stride B
-                                                                              0, // Stride C
-                                                                              1, // alpha
-                                                                              1, // beta
-                                                                              xDesc[0].GetType(),
-                                                                              false};
-
-                            miopenStatus_t gemm_status =
-                                CallGemm(handle,
-                                         gemm_desc,
-                                         hx,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         w,
-                                         wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
-                                         static_cast<int>(offset) + ri * wei_len,
-                                         GemmBackend_t::miopengemm);
+                        sp_size[2] = hy_h;
+                        sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                            if(gemm_status != miopenStatusSuccess)
-                            {
-                                if(gemm_status == miopenStatusNotImplemented)
-                                {
-                                    MIOPEN_LOG_E("GEMM not implemented");
-                                }
-                                else
-                                {
-                                    MIOPEN_LOG_E("GEMM failed");
-                                }
-                            }
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
+                        plan_rec.ActivationForward(activDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + static_cast<size_t>(ri) * wei_len,
+                                                   offset + static_cast<size_t>(ri) * wei_len);
+                        // Update time
+                        profileRNNkernels(handle, 1, ctime);
                     }
-                    else
+                    else if(rnnMode == miopenLSTM)
                     {
-                        if(ri == 1 && hx != nullptr && in_n.at(cur_time) > in_n.at(use_time))
+                        if(algoMode == miopenRNNdefault)
                         {
-                            miopen::GemmDescriptor gemm_desc =
-                                GemmDescriptor{false,
-                                               false,
-                                               true,
-                                               (in_n.at(cur_time) - in_n.at(use_time)),
-                                               wei_len,
-                                               hy_h,
-                                               uni_stride,
-                                               uni_stride,
-                                               hy_stride,
-                                               1, // batch count
-                                               0, // Stride A
-                                               0, // Stride B
-                                               0, // Stride C
-                                               1, // alpha
-                                               1, // beta
-                                               xDesc[0].GetType(),
-                                               false};
-                            miopenStatus_t gemm_status =
-                                CallGemm(handle,
-                                         gemm_desc,
-                                         hx,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         w,
-                                         wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
-                                         static_cast<int>(offset) + ri * wei_len +
-                                             in_n.at(use_time) * hy_stride,
-                                         GemmBackend_t::miopengemm);
+                            plan_rec.LSTMForwardHiddenStateUpdate(
+                                wDesc.GetType(),
+                                true,
+                                ti == 0,
+                                ri,
+                                in_n.at(0),
+                                in_n.at(cur_time),
+                                in_n.at(use_time),
+                                hy_h,
+                                hy_stride,
+                                wei_len,
+                                wei_stride,
+                                cx,
+                                hx_shift + ri * hy_n * hy_h,
+                                workSpace,
+                                offset + static_cast<size_t>(ri) * wei_len,
+                                offset + hy_h + static_cast<size_t>(ri) * wei_len,
+                                offset + 2 * static_cast<size_t>(hy_h) +
+                                    static_cast<size_t>(ri) * wei_len,
+                                offset + 3 * static_cast<size_t>(hy_h) +
+                                    static_cast<size_t>(ri) * wei_len,
+                                offset + static_cast<size_t>(bi) * wei_len +
+                                    static_cast<size_t>(ri) * hy_h,
+                                pretime_shift + static_cast<size_t>(bi) * wei_len +
+                                    static_cast<size_t>(ri) * hy_h,
+                                0,
+                                offset + hid_off + static_cast<size_t>(ri) * hy_h);
 
-                            if(gemm_status != miopenStatusSuccess)
-                            {
-                                if(gemm_status == miopenStatusNotImplemented)
-                                {
-                                    MIOPEN_LOG_E("GEMM not implemented");
-                                }
-                                else
-                                {
-                                    MIOPEN_LOG_E("GEMM failed");
-                                }
-                            }
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
-                        }
-
-                        if(in_n.at(use_time) > 0)
-                        {
-                            miopen::GemmDescriptor gemm_desc = GemmDescriptor{false,
-                                                                              false,
-                                                                              true,
-                                                                              in_n.at(use_time),
-                                                                              wei_len,
-                                                                              hy_h,
-                                                                              hy_stride,
-                                                                              uni_stride,
-                                                                              hy_stride,
-                                                                              1, // batch count
-                                                                              0, // Stride A
-                                                                              0, // Stride B
-                                                                              0, // Stride C
-                                                                              1, // alpha
-                                                                              1, // beta
-                                                                              xDesc[0].GetType(),
-                                                                              false};
-
-                            miopenStatus_t gemm_status =
-                                CallGemm(handle,
-                                         gemm_desc,
-                                         workSpace,
-                                         pretime_shift + hid_off + ri * hy_h,
-                                         w,
-                                         wei_shift + ri * wei_len * uni_stride,
-                                         workSpace,
-                                         static_cast<int>(offset) + ri * wei_len,
-                                         GemmBackend_t::miopengemm);
-
-                            if(gemm_status != miopenStatusSuccess)
-                            {
-                                if(gemm_status == miopenStatusNotImplemented)
-                                {
-                                    MIOPEN_LOG_E("GEMM not implemented");
-                                }
-                                else
-                                {
-                                    MIOPEN_LOG_E("GEMM failed");
-                                }
-                            }
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                        }
-                    }
-
-                    // update hidden status
-                    sp_size[1] = in_n.at(cur_time);
-                    if(rnnMode == miopenRNNRELU || rnnMode == miopenRNNTANH)
-                    {
-                        sp_size[2] = hy_h;
-                        sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
-
-                        activDesc.Forward(handle,
-                                          &alpha,
-                                          sp_desc,
-                                          workSpace,
-                                          &beta,
-                                          sp_desc,
-                                          workSpace,
-                                          offset + static_cast<size_t>(ri) * wei_len,
-                                          offset + static_cast<size_t>(ri) * wei_len);
-                        // Update time
-                        profileRNNkernels(handle, 1, ctime);
-                    }
-                    else if(rnnMode == miopenLSTM)
-                    {
-                        if(algoMode == miopenRNNdefault)
-                        {
-                            LSTMForwardHiddenStateUpdate(
-                                handle,
-                                wDesc.GetType(),
-                                true,
-                                ti == 0,
-                                ri,
-                                in_n.at(0),
-                                in_n.at(cur_time),
-                                in_n.at(use_time),
-                                hy_h,
-                                hy_stride,
-                                wei_len,
-                                wei_stride,
-                                cx,
-                                hx_shift + ri * hy_n * hy_h,
-                                workSpace,
-                                offset + static_cast<size_t>(ri) * wei_len,
-                                offset + hy_h + static_cast<size_t>(ri) * wei_len,
-                                offset + 2 * static_cast<size_t>(hy_h) +
-                                    static_cast<size_t>(ri) * wei_len,
-                                offset + 3 * static_cast<size_t>(hy_h) +
-                                    static_cast<size_t>(ri) * wei_len,
-                                offset + static_cast<size_t>(bi) * wei_len +
-                                    static_cast<size_t>(ri) * hy_h,
-                                pretime_shift + static_cast<size_t>(bi) * wei_len +
-                                    static_cast<size_t>(ri) * hy_h,
-                                0,
-                                offset + hid_off + static_cast<size_t>(ri) * hy_h);
-
-                            // Update time
-                            profileRNNkernels(handle, 1, ctime);
-                            continue;
+                            continue;
                         }
 
                         // active gate i, f, o
                         sp_size[2] = hy_h * 3;
                         sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                        sigDesc.Forward(handle,
-                                        &alpha,
-                                        sp_desc,
-                                        workSpace,
-                                        &beta,
-                                        sp_desc,
-                                        workSpace,
-                                        offset + static_cast<size_t>(ri) * wei_len,
-                                        offset + static_cast<size_t>(ri) * wei_len);
+                        plan_rec.ActivationForward(sigDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + static_cast<size_t>(ri) * wei_len,
+                                                   offset + static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1558,17 +1477,17 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         sp_size[2] = hy_h;
                         sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + 3 * static_cast<size_t>(hy_h) +
-                                             static_cast<size_t>(ri) * wei_len,
-                                         offset + 3 * static_cast<size_t>(hy_h) +
-                                             static_cast<size_t>(ri) * wei_len);
+                        plan_rec.ActivationForward(tanhDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + 3 * static_cast<size_t>(hy_h) +
+                                                       static_cast<size_t>(ri) * wei_len,
+                                                   offset + 3 * static_cast<size_t>(hy_h) +
+                                                       static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1577,22 +1496,21 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         alpha1 = 1;
                         beta_t = 1;
 
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + static_cast<size_t>(ri) * wei_len,
-                                 offset + 3 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + static_cast<size_t>(bi) * wei_len +
-                                     static_cast<size_t>(ri) * hy_h);
+                        plan_rec.OpTensor(miopenTensorOpMul,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + static_cast<size_t>(ri) * wei_len,
+                                          offset + 3 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + static_cast<size_t>(bi) * wei_len +
+                                              static_cast<size_t>(ri) * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1605,21 +1523,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 hx_desc =
                                     miopen::TensorDescriptor(wDesc.GetType(), hx_size, hx_stride);
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         cx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + static_cast<size_t>(ri) * wei_len,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         offset + static_cast<size_t>(bi) * wei_len +
-                                             static_cast<size_t>(ri) * hy_h);
+                                plan_rec.OpTensor(miopenTensorOpMul,
+                                                  alpha0,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  alpha1,
+                                                  hx_desc,
+                                                  cx,
+                                                  beta_t,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  offset + hy_h + static_cast<size_t>(ri) * wei_len,
+                                                  hx_shift + ri * hy_n * hy_h,
+                                                  offset + static_cast<size_t>(bi) * wei_len +
+                                                      static_cast<size_t>(ri) * hy_h);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
@@ -1637,23 +1554,23 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 sp_desc =
                                     miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         cx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + static_cast<size_t>(ri) * wei_len +
-                                             static_cast<size_t>(in_n.at(use_time)) * hy_stride,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         offset + static_cast<size_t>(bi) * wei_len +
-                                             static_cast<size_t>(ri) * hy_h +
-                                             static_cast<size_t>(in_n.at(use_time)) * hy_stride);
+                                plan_rec.OpTensor(
+                                    miopenTensorOpMul,
+                                    alpha0,
+                                    sp_desc,
+                                    workSpace,
+                                    alpha1,
+                                    hx_desc,
+                                    cx,
+                                    beta_t,
+                                    sp_desc,
+                                    workSpace,
+                                    offset + hy_h + static_cast<size_t>(ri) * wei_len +
+                                        static_cast<size_t>(in_n.at(use_time)) * hy_stride,
+                                    hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
+                                    offset + static_cast<size_t>(bi) * wei_len +
+                                        static_cast<size_t>(ri) * hy_h +
+                                        static_cast<size_t>(in_n.at(use_time)) * hy_stride);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
 
@@ -1671,22 +1588,22 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         wDesc.GetType(), sp_size, sp_stride);
                                 }
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + hy_h + static_cast<size_t>(ri) * wei_len,
-                                         pretime_shift + static_cast<size_t>(bi) * wei_len +
-                                             static_cast<size_t>(ri) * hy_h,
-                                         offset + static_cast<size_t>(bi) * wei_len +
-                                             static_cast<size_t>(ri) * hy_h);
+                                plan_rec.OpTensor(miopenTensorOpMul,
+                                                  alpha0,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  alpha1,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  beta_t,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  offset + hy_h + static_cast<size_t>(ri) * wei_len,
+                                                  pretime_shift +
+                                                      static_cast<size_t>(bi) * wei_len +
+                                                      static_cast<size_t>(ri) * hy_h,
+                                                  offset + static_cast<size_t>(bi) * wei_len +
+                                                      static_cast<size_t>(ri) * hy_h);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
 
@@ -1700,36 +1617,36 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         }
 
                         // active cell state
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + static_cast<size_t>(bi) * wei_len +
-                                             static_cast<size_t>(ri) * hy_h,
-                                         offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                        plan_rec.ActivationForward(tanhDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + static_cast<size_t>(bi) * wei_len +
+                                                       static_cast<size_t>(ri) * hy_h,
+                                                   offset + hid_off +
+                                                       static_cast<size_t>(ri) * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
                         // update hidden state
                         beta_t = 0;
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                        plan_rec.OpTensor(miopenTensorOpMul,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
                     }
@@ -1739,15 +1656,15 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         sp_size[2] = 2 * hy_h;
                         sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                        sigDesc.Forward(handle,
-                                        &alpha,
-                                        sp_desc,
-                                        workSpace,
-                                        &beta,
-                                        sp_desc,
-                                        workSpace,
-                                        offset + static_cast<size_t>(ri) * wei_len,
-                                        offset + static_cast<size_t>(ri) * wei_len);
+                        plan_rec.ActivationForward(sigDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + static_cast<size_t>(ri) * wei_len,
+                                                   offset + static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1759,56 +1676,54 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         alpha1 = 1;
                         beta_t = 0;
 
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + hy_h + static_cast<size_t>(ri) * wei_len,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len);
+                        plan_rec.OpTensor(miopenTensorOpMul,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + hy_h + static_cast<size_t>(ri) * wei_len,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len);
+                        plan_rec.OpTensor(miopenTensorOpAdd,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
                         // active c gate
-                        tanhDesc.Forward(handle,
-                                         &alpha,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + 2 * static_cast<size_t>(hy_h) +
-                                             static_cast<size_t>(ri) * wei_len,
-                                         offset + 2 * static_cast<size_t>(hy_h) +
-                                             static_cast<size_t>(ri) * wei_len);
+                        plan_rec.ActivationForward(tanhDesc,
+                                                   alpha,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   beta,
+                                                   sp_desc,
+                                                   workSpace,
+                                                   offset + 2 * static_cast<size_t>(hy_h) +
+                                                       static_cast<size_t>(ri) * wei_len,
+                                                   offset + 2 * static_cast<size_t>(hy_h) +
+                                                       static_cast<size_t>(ri) * wei_len);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1816,21 +1731,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         alpha0 = -1;
                         alpha1 = 1;
                         beta_t = 0;
-                        OpTensor(handle,
-                                 miopenTensorOpMul,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + static_cast<size_t>(ri) * wei_len,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                        plan_rec.OpTensor(miopenTensorOpMul,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + static_cast<size_t>(ri) * wei_len,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1838,21 +1752,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                         alpha1 = 1;
                         beta_t = 0;
 
-                        OpTensor(handle,
-                                 miopenTensorOpAdd,
-                                 &alpha0,
-                                 sp_desc,
-                                 workSpace,
-                                 &alpha1,
-                                 sp_desc,
-                                 workSpace,
-                                 &beta_t,
-                                 sp_desc,
-                                 workSpace,
-                                 offset + 2 * static_cast<size_t>(hy_h) +
-                                     static_cast<size_t>(ri) * wei_len,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h,
-                                 offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                        plan_rec.OpTensor(miopenTensorOpAdd,
+                                          alpha0,
+                                          sp_desc,
+                                          workSpace,
+                                          alpha1,
+                                          sp_desc,
+                                          workSpace,
+                                          beta_t,
+                                          sp_desc,
+                                          workSpace,
+                                          offset + 2 * static_cast<size_t>(hy_h) +
+                                              static_cast<size_t>(ri) * wei_len,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h,
+                                          offset + hid_off + static_cast<size_t>(ri) * hy_h);
                         // Update time
                         profileRNNkernels(handle, 1, ctime);
 
@@ -1868,20 +1781,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 hx_desc =
                                     miopen::TensorDescriptor(wDesc.GetType(), hx_size, hx_stride);
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         hx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + static_cast<size_t>(ri) * wei_len,
-                                         hx_shift + ri * hy_n * hy_h,
-                                         offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                                plan_rec.OpTensor(miopenTensorOpMul,
+                                                  alpha0,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  alpha1,
+                                                  hx_desc,
+                                                  hx,
+                                                  beta_t,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  offset + static_cast<size_t>(ri) * wei_len,
+                                                  hx_shift + ri * hy_n * hy_h,
+                                                  offset + hid_off +
+                                                      static_cast<size_t>(ri) * hy_h);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
@@ -1899,22 +1812,22 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                 sp_desc =
                                     miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         hx_desc,
-                                         hx,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + static_cast<size_t>(ri) * wei_len +
-                                             static_cast<size_t>(in_n.at(use_time)) * hy_stride,
-                                         hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
-                                         offset + hid_off + static_cast<size_t>(ri) * hy_h +
-                                             static_cast<size_t>(in_n.at(use_time)) * hy_stride);
+                                plan_rec.OpTensor(
+                                    miopenTensorOpMul,
+                                    alpha0,
+                                    sp_desc,
+                                    workSpace,
+                                    alpha1,
+                                    hx_desc,
+                                    hx,
+                                    beta_t,
+                                    sp_desc,
+                                    workSpace,
+                                    offset + static_cast<size_t>(ri) * wei_len +
+                                        static_cast<size_t>(in_n.at(use_time)) * hy_stride,
+                                    hx_shift + ri * hy_n * hy_h + in_n.at(use_time) * hy_h,
+                                    offset + hid_off + static_cast<size_t>(ri) * hy_h +
+                                        static_cast<size_t>(in_n.at(use_time)) * hy_stride);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
 
@@ -1932,20 +1845,20 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
                                         wDesc.GetType(), sp_size, sp_stride);
                                 }
 
-                                OpTensor(handle,
-                                         miopenTensorOpMul,
-                                         &alpha0,
-                                         sp_desc,
-                                         workSpace,
-                                         &alpha1,
-                                         sp_desc,
-                                         workSpace,
-                                         &beta_t,
-                                         sp_desc,
-                                         workSpace,
-                                         offset + static_cast<size_t>(ri) * wei_len,
-                                         pretime_shift + hid_off + ri * hy_h,
-                                         offset + hid_off + static_cast<size_t>(ri) * hy_h);
+                                plan_rec.OpTensor(miopenTensorOpMul,
+                                                  alpha0,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  alpha1,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  beta_t,
+                                                  sp_desc,
+                                                  workSpace,
+                                                  offset + static_cast<size_t>(ri) * wei_len,
+                                                  pretime_shift + hid_off + ri * hy_h,
+                                                  offset + hid_off +
+                                                      static_cast<size_t>(ri) * hy_h);
                                 // Update time
                                 profileRNNkernels(handle, 1, ctime);
                             }
@@ -1992,28 +1905,26 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
 
                         if(hy != nullptr)
                         {
-                            CopyTensor(handle,
-                                       sp_desc,
-                                       workSpace,
-                                       hx_desc,
-                                       hy,
-                                       static_cast<int>(offset) + hid_off + ri * hy_h +
-                                           use_batch * hy_stride,
-                                       hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
+                            plan_rec.CopyTensor(sp_desc,
+                                                workSpace,
+                                                hx_desc,
+                                                hy,
+                                                static_cast<int>(offset) + hid_off + ri * hy_h +
+                                                    use_batch * hy_stride,
+                                                hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
                         }
 
                         if(rnnMode == miopenLSTM && cy != nullptr)
                         {
-                            CopyTensor(handle,
-                                       sp_desc,
-                                       workSpace,
-                                       hx_desc,
-                                       cy,
-                                       static_cast<int>(offset) + bi * wei_len + ri * hy_h +
-                                           use_batch * hy_stride,
-                                       hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
+                            plan_rec.CopyTensor(sp_desc,
+                                                workSpace,
+                                                hx_desc,
+                                                cy,
+                                                static_cast<int>(offset) + bi * wei_len +
+                                                    ri * hy_h + use_batch * hy_stride,
+                                                hx_shift + ri * hy_n * hy_h + use_batch * hy_h);
                             // Update time
                             profileRNNkernels(handle, 1, ctime);
                         }
@@ -2034,10 +1945,16 @@ void RNNDescriptor::RNNForwardInference(Handle& handle,
     y_desc     = miopen::TensorDescriptor(wDesc.GetType(), y_size, y_stride);
     sp_desc    = miopen::TensorDescriptor(wDesc.GetType(), sp_size, sp_stride);
 
-    CopyTensor(handle, sp_desc, workSpace, y_desc, y, prelayer_shift, 0);
+    plan_rec.CopyTensor(sp_desc, workSpace, y_desc, y, prelayer_shift, 0);
     // Update time
     profileRNNkernels(handle, 2, ctime);
 
+    if(const auto plan = plan_rec.Finish())
+    {
+        MIOPEN_LOG_I2("RNN inference plan recorded, " << *plan);
+        plans->Insert(plan_key, plan);
+    }
+
 #else
     (void)hx;
     (void)cx;
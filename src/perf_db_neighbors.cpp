@@ -0,0 +1,363 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/perf_db_neighbors.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_PERFDB_NEIGHBORS)
+
+namespace miopen {
+
+PerfDbNeighborIndex::PerfDbNeighborIndex(const DbContents& contents)
+{
+    for(const auto& record : contents)
+    {
+        auto problem = conv::ProblemDescription{};
+        if(!ParsePerfDbKey(record.first, problem))
+            continue;
+
+        const auto features = GetFeatures(problem);
+        for(const auto& pair : record.second)
+        {
+            trees[GetGroup(problem, pair.first)].points.push_back({features, records.size()});
+            records.emplace_back(record.first, pair.second);
+        }
+    }
+
+    for(auto& tree : trees)
+    {
+        tree.second.split.resize(tree.second.points.size());
+        Build(tree.second, 0, tree.second.points.size());
+    }
+}
+
+PerfDbNeighborIndex::Features
+PerfDbNeighborIndex::GetFeatures(const conv::ProblemDescription& problem)
+{
+    const auto log2 = [](double value) {
+        return static_cast<float>(std::log2(std::max(value, 1.0)));
+    };
+    // Whether a config is valid and fast depends much more on the filter than on the sizes of the
+    // tensors, so that a neighbor with the same filter and another batch size is taken first.
+    const auto filter = [&](double value) { return 4 * log2(value); };
+
+    return {log2(problem.GetInBatchSize()),
+            log2(problem.GetInChannels()),
+            log2(problem.GetOutChannels()),
+            log2(problem.GetInDepth()),
+            log2(problem.GetInHeight()),
+            log2(problem.GetInWidth()),
+            filter(problem.GetWeightsDepth()),
+            filter(problem.GetWeightsHeight()),
+            filter(problem.GetWeightsWidth()),
+            filter(problem.GetKernelStrideD()),
+            filter(problem.GetKernelStrideH()),
+            filter(problem.GetKernelStrideW()),
+            filter(problem.GetDilationD()),
+            filter(problem.GetDilationH()),
+            filter(problem.GetDilationW()),
+            filter(1 + problem.GetPadD()),
+            filter(1 + problem.GetPadH()),
+            filter(1 + problem.GetPadW()),
+            filter(problem.GetGroupCount())};
+}
+
+std::string PerfDbNeighborIndex::GetGroup(const conv::ProblemDescription& problem,
+                                          const std::string& solver)
+{
+    auto ss = std::ostringstream{};
+    ss << solver << ':' << problem.GetSpatialDims() << ':'
+       << static_cast<int>(problem.GetDirection()) << ':' << problem.GetInLayout() << ':'
+       << problem.GetWeightsLayout() << ':' << problem.GetOutLayout() << ':'
+       << EncodeDataTypesForKey(
+              problem.GetInDataType(), problem.GetWeightsDataType(), problem.GetOutDataType());
+    return ss.str();
+}
+
+void PerfDbNeighborIndex::Build(Tree& tree, std::size_t begin, std::size_t end)
+{
+    if(end - begin < 2)
+        return;
+
+    // Split along the feature with the widest spread.
+    auto low  = tree.points[begin].features;
+    auto high = low;
+    for(auto i = begin + 1; i < end; ++i)
+    {
+        for(std::size_t f = 0; f < low.size(); ++f)
+        {
+            low[f]  = std::min(low[f], tree.points[i].features[f]);
+            high[f] = std::max(high[f], tree.points[i].features[f]);
+        }
+    }
+
+    auto split = std::size_t{0};
+    for(std::size_t f = 1; f < low.size(); ++f)
+        if(high[f] - low[f] > high[split] - low[split])
+            split = f;
+
+    const auto middle = begin + (end - begin) / 2;
+    std::nth_element(tree.points.begin() + begin,
+                     tree.points.begin() + middle,
+                     tree.points.begin() + end,
+                     [&](const Point& lhs, const Point& rhs) {
+                         return lhs.features[split] < rhs.features[split];
+                     });
+    tree.split[middle] = static_cast<std::uint8_t>(split);
+
+    Build(tree, begin, middle);
+    Build(tree, middle + 1, end);
+}
+
+void PerfDbNeighborIndex::Search(const Tree& tree,
+                                 const Features& features,
+                                 const std::string& skip_key,
+                                 std::size_t count,
+                                 std::size_t begin,
+                                 std::size_t end,
+                                 Heap& heap) const
+{
+    if(begin >= end)
+        return;
+
+    const auto middle = begin + (end - begin) / 2;
+    const auto& point = tree.points[middle];
+
+    auto distance = 0.f;
+    for(std::size_t f = 0; f < features.size(); ++f)
+        distance += (features[f] - point.features[f]) * (features[f] - point.features[f]);
+
+    // Only the problem itself can be at distance 0 and have the same key.
+    if(distance != 0 || records[point.record].first != skip_key)
+    {
+        if(heap.size() < count)
+            heap.emplace(distance, point.record);
+        else if(distance < heap.top().first)
+        {
+            heap.pop();
+            heap.emplace(distance, point.record);
+        }
+    }
+
+    if(end - begin == 1)
+        return;
+
+    const auto split      = tree.split[middle];
+    const auto offset     = features[split] - point.features[split];
+    const auto near_first = offset < 0;
+
+    Search(tree,
+           features,
+           skip_key,
+           count,
+           near_first ? begin : middle + 1,
+           near_first ? middle : end,
+           heap);
+    if(heap.size() < count || offset * offset < heap.top().first)
+        Search(tree,
+               features,
+               skip_key,
+               count,
+               near_first ? middle + 1 : begin,
+               near_first ? end : middle,
+               heap);
+}
+
+std::vector<PerfDbNeighbor> PerfDbNeighborIndex::Find(const conv::ProblemDescription& problem,
+                                                      const std::string& solver,
+                                                      std::size_t count) const
+{
+    const auto tree = trees.find(GetGroup(problem, solver));
+    if(tree == trees.end() || count == 0)
+        return {};
+
+    auto ss = std::ostringstream{};
+    problem.Serialize(ss);
+
+    auto heap = Heap{};
+    Search(tree->second,
+           GetFeatures(problem),
+           ss.str(),
+           count,
+           0,
+           tree->second.points.size(),
+           heap);
+
+    auto neighbors = std::vector<PerfDbNeighbor>(heap.size());
+    for(auto i = neighbors.size(); i > 0; --i, heap.pop())
+    {
+        const auto& record = records[heap.top().second];
+        neighbors[i - 1]   = {record.first, record.second, std::sqrt(heap.top().first)};
+    }
+    return neighbors;
+}
+
+const PerfDbNeighborIndex& PerfDbNeighborIndex::GetCached(const ExecutionContext& ctx)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto instances = std::map<std::string, std::unique_ptr<PerfDbNeighborIndex>>{};
+
+    const std::string paths[] = {ctx.GetPerfDbPath(), ctx.GetUserPerfDbPath()};
+    const auto cache_key      = paths[0] + ';' + paths[1];
+    const auto it             = instances.find(cache_key);
+    if(it != instances.end())
+        return *it->second;
+
+    auto contents = DbContents{};
+    auto stats    = DbCompactionStats{};
+    for(const auto& path : paths)
+    {
+        if(path.empty() || !boost::filesystem::exists(path))
+            continue;
+        try
+        {
+            ReadDb(path, DbKind::Perf, contents, stats);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Perf Db neighbors: cannot read " << path << ": " << ex.what());
+        }
+    }
+
+    auto index = std::make_unique<PerfDbNeighborIndex>(contents);
+    MIOPEN_LOG_I("Perf Db neighbors: " << index->Size() << " entries of " << contents.size()
+                                       << " records indexed from " << cache_key);
+    return *instances.emplace(cache_key, std::move(index)).first->second;
+}
+
+std::size_t GetPerfDbNeighborCount()
+{
+    return Value(MIOPEN_DEBUG_PERFDB_NEIGHBORS{}, 0);
+}
+
+std::ostream& operator<<(std::ostream& stream, const PerfDbReplayStats& stats)
+{
+    const auto percent = [&](std::size_t value) {
+        return stats.entries == 0 ? 0. : 100. * value / stats.entries;
+    };
+
+    stream << "entries: " << stats.entries << std::endl;
+    stream << "with neighbors: " << percent(stats.found) << '%' << std::endl;
+    stream << "nearest neighbor is the tuned config: " << percent(stats.nearest_match) << '%'
+           << std::endl;
+    stream << "a neighbor is the tuned config: " << percent(stats.any_match) << '%' << std::endl;
+    stream << "default is the tuned config: " << percent(stats.default_match) << '%' << std::endl;
+    stream << "a neighbor is valid: " << percent(stats.valid) << '%' << std::endl;
+    stream << "unchecked: " << stats.unchecked << std::endl;
+    stream << "mean distance to the nearest neighbor: " << stats.distance << std::endl;
+    return stream;
+}
+
+PerfDbReplayStats
+ReplayPerfDbNeighbors(const DbContents& contents, std::size_t count, Handle* handle)
+{
+    const auto index = PerfDbNeighborIndex{contents};
+    auto stats       = PerfDbReplayStats{};
+
+    auto base_ctx = ExecutionContext{handle};
+    if(handle != nullptr)
+        base_ctx.DetectRocm();
+
+    for(const auto& record : contents)
+    {
+        auto problem = conv::ProblemDescription{};
+        if(!ParsePerfDbKey(record.first, problem))
+            continue;
+
+        auto ctx = ConvolutionContext{base_ctx};
+        if(handle != nullptr)
+            problem.SetupFloats(ctx);
+        const auto legacy_problem = ProblemDescription{problem};
+
+        for(const auto& pair : record.second)
+        {
+            const auto neighbors = index.Find(problem, pair.first, count);
+            const auto is_tuned  = [&](const PerfDbNeighbor& n) { return n.values == pair.second; };
+
+            ++stats.entries;
+            if(!neighbors.empty())
+            {
+                ++stats.found;
+                stats.distance += neighbors.front().distance;
+                if(is_tuned(neighbors.front()))
+                    ++stats.nearest_match;
+                if(std::any_of(neighbors.begin(), neighbors.end(), is_tuned))
+                    ++stats.any_match;
+            }
+
+            if(handle == nullptr)
+                continue;
+
+            const auto id = solver::Id{pair.first};
+            const auto solver =
+                id.IsValid() && id.GetPrimitive() == solver::Primitive::Convolution
+                    ? id.GetSolver()
+                    : solver::AnySolver{};
+            if(solver.IsEmpty() || !solver.IsApplicable(ctx, legacy_problem))
+            {
+                ++stats.unchecked;
+                continue;
+            }
+
+            auto no_db = PerformanceDb{"", ""};
+            if(solver.GetPerfCfgParams(ctx, legacy_problem, no_db) == pair.second)
+                ++stats.default_match;
+            if(std::any_of(neighbors.begin(), neighbors.end(), [&](const PerfDbNeighbor& n) {
+                   return solver.TestPerfCfgParams(ctx, legacy_problem, n.values);
+               }))
+                ++stats.valid;
+        }
+    }
+
+    if(stats.found != 0)
+        stats.distance /= stats.found;
+    return stats;
+}
+
+} // namespace miopen
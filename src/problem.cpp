@@ -35,7 +35,9 @@
 #include <miopen/any_solver.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/solution.hpp>
+#include <miopen/solver_id.hpp>
 #include <miopen/search_options.hpp>
+#include <miopen/tensor_layout.hpp>
 #include <miopen/tensor_ops.hpp>
 
 #include <nlohmann/json.hpp>
@@ -43,6 +45,10 @@
 #include <boost/variant/apply_visitor.hpp>
 #include <boost/hof/match.hpp>
 
+#include <algorithm>
+#include <array>
+#include <limits>
+
 namespace miopen {
 
 namespace detail {
@@ -193,6 +199,105 @@ void Problem::TransposeImpl(const ConvolutionDescriptor& /*conv_desc*/)
               tensor_descriptors.at(miopenTensorConvolutionY));
 }
 
+namespace {
+
+// These solvers run NHWC kernels and transpose NCHW tensors into and out of their workspace,
+// so their NCHW solutions pay for the transposes a layout plan is meant to avoid.
+bool TransposesInternally(const solver::Id& solver_id, const conv::ProblemDescription& problem)
+{
+    static const auto nhwc_solvers =
+        std::array<solver::Id, 3>{solver::Id{"ConvAsmImplicitGemmGTCDynamicFwdXdlopsNHWC"},
+                                  solver::Id{"ConvAsmImplicitGemmGTCDynamicBwdXdlopsNHWC"},
+                                  solver::Id{"ConvAsmImplicitGemmGTCDynamicWrwXdlopsNHWC"}};
+
+    return problem.IsLayoutDefault() &&
+           std::find(nhwc_solvers.begin(), nhwc_solvers.end(), solver_id) != nhwc_solvers.end();
+}
+
+} // namespace
+
+LayoutPlanStep Problem::MakeLayoutPlanStep(Handle& handle,
+                                           const std::vector<std::string>& candidates) const
+{
+    const auto make_step = boost::hof::match([&](const ConvolutionDescriptor& op_desc) {
+        return MakeLayoutPlanStepImpl(handle, candidates, op_desc);
+    });
+
+    return boost::apply_visitor(make_step, operator_descriptor);
+}
+
+LayoutPlanStep Problem::MakeLayoutPlanStepImpl(Handle& handle,
+                                               const std::vector<std::string>& candidates,
+                                               const ConvolutionDescriptor& conv_desc) const
+{
+    const auto& x_desc =
+        GetTensorDescriptorChecked(miopenTensorConvolutionX, "miopenTensorConvolutionX");
+    const auto& y_desc =
+        GetTensorDescriptorChecked(miopenTensorConvolutionY, "miopenTensorConvolutionY");
+
+    const auto bytes = [](const TensorDescriptor& desc) {
+        return desc.GetElementSpace() * get_data_size(desc.GetType());
+    };
+
+    auto step = LayoutPlanStep{};
+
+    switch(direction)
+    {
+    case miopenProblemDirectionForward:
+        step.input_bytes  = bytes(x_desc);
+        step.output_bytes = bytes(y_desc);
+        break;
+    case miopenProblemDirectionBackward:
+        step.input_bytes  = bytes(y_desc);
+        step.output_bytes = bytes(x_desc);
+        break;
+    case miopenProblemDirectionBackwardWeights:
+    default:
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     "Only forward and backward data problems can be chained.");
+    }
+
+    auto ctx = ExecutionContext{&handle};
+    ctx.DetectRocm();
+
+    const auto labels = tensor_layout_get_default(x_desc.GetSize());
+
+    for(const auto& layout : candidates)
+    {
+        if(layout.size() != labels.size())
+            continue;
+
+        auto relaid = *this;
+        for(auto& pair : relaid.tensor_descriptors)
+        {
+            const auto& desc = pair.second;
+            auto strides     = std::vector<std::size_t>{};
+            tensor_layout_to_strides(desc.GetLengths(), labels, layout, strides);
+            pair.second = {desc.GetType(), desc.GetLengths(), strides};
+        }
+
+        auto conv_problem = conv_desc.mode == miopenTranspose
+                                ? relaid.MakeTransposed().AsConvolution()
+                                : relaid.AsConvolution();
+        conv_problem.SetupFloats(ctx);
+
+        // Solutions come sorted by time, so the first native one is the best.
+        const auto solutions = conv_desc.GetSolutions(
+            ctx, conv_problem, std::numeric_limits<std::size_t>::max(), nullptr);
+        const auto native = std::find_if(solutions.begin(), solutions.end(), [&](auto&& sln) {
+            return !TransposesInternally(solver::Id{sln.solution_id}, conv_problem);
+        });
+        if(native == solutions.end())
+            continue;
+
+        MIOPEN_LOG_I2(layout << ": " << solver::Id{native->solution_id}.ToString() << ", "
+                             << native->time << " ms");
+        step.layouts.push_back({layout, native->time});
+    }
+
+    return step;
+}
+
 conv::ProblemDescription Problem::AsConvolution() const
 {
     const auto& conv_desc = boost::get<ConvolutionDescriptor>(operator_descriptor);
@@ -26,6 +26,7 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -44,6 +45,8 @@
 
 namespace miopen {
 
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RAMDB_LEASE_MS)
+
 std::string RamDb::GetTimeFilePath(const std::string& path) { return path + ".time"; }
 
 static ramdb_clock::time_point GetDbModificationTime(const std::string& path)
@@ -88,6 +91,25 @@ static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60};
 
 using exclusive_lock = std::unique_lock<LockFile>;
 
+// Lockable view of the in-process part of a LockFile.
+struct LocalLockFile
+{
+    LockFile& file;
+
+    void lock_shared() { file.lock_shared_local(); }
+    void unlock_shared() { file.unlock_shared_local(); }
+};
+
+// How long a validated cache is trusted without touching the file system, as long as the
+// generation of the lock file is unchanged. Bounds the staleness when the db is written by a
+// build which does not maintain the generation counter.
+static std::chrono::milliseconds GetLeaseTime()
+{
+    static const auto lease =
+        std::chrono::milliseconds{Value(MIOPEN_DEBUG_RAMDB_LEASE_MS{}, 1000)};
+    return lease;
+}
+
 RamDb::RamDb(std::string path, bool is_system) : PlainTextDb(path, is_system) {}
 
 RamDb& RamDb::GetCached(const std::string& path, bool is_system)
@@ -123,6 +145,14 @@ RamDb& RamDb::GetCached(const std::string& path, bool is_system)
 
 boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
 {
+    {
+        auto local_lock_file  = LocalLockFile{GetLockFile()};
+        const auto local_lock = std::shared_lock<LocalLockFile>(local_lock_file);
+
+        if(HasLeaseUnsafe())
+            return FindRecordUnsafe(problem);
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
@@ -132,6 +162,7 @@ boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
         Prefetch();
     }
 
+    RenewLeaseUnsafe();
     return FindRecordUnsafe(problem);
 }
 
@@ -306,6 +337,22 @@ bool RamDb::ValidateUnsafe()
     return validation_result;
 }
 
+bool RamDb::HasLeaseUnsafe()
+{
+    return lease_generation && ramdb_clock::now() < lease_expiry &&
+           GetLockFile().GetGeneration() == lease_generation;
+}
+
+void RamDb::RenewLeaseUnsafe()
+{
+    // Without file IO there is nobody to race with and validation is already free.
+    if(DisableUserDbFileIO || GetLeaseTime().count() <= 0)
+        return;
+
+    lease_generation = GetLockFile().GetGeneration();
+    lease_expiry     = ramdb_clock::now() + GetLeaseTime();
+}
+
 void RamDb::Prefetch()
 {
     if(DisableUserDbFileIO)
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/reduce/problem_description.hpp>
+
+#include <miopen/errors.hpp>
+#include <miopen/names.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace miopen {
+
+namespace reduce {
+
+namespace {
+
+template <typename T>
+std::string get_vect_config(const std::vector<T>& v)
+{
+    std::string str;
+    for(auto itr = v.begin(); itr < v.end(); itr++)
+    {
+        str += (std::to_string(*itr) + (itr == v.end() - 1 ? "" : "x"));
+    }
+    return str;
+}
+
+struct FoldedDim
+{
+    std::size_t length;
+    std::size_t inStride;
+    std::size_t outStride;
+    bool reduced;
+};
+
+} // namespace
+
+ProblemDescription::ProblemDescription(const ReduceTensorDescriptor& reduce_,
+                                       const TensorDescriptor& xDesc_,
+                                       const TensorDescriptor& yDesc_)
+    : reduce(reduce_)
+{
+    const auto& inLengths  = xDesc_.GetLengths();
+    const auto& inStrides  = xDesc_.GetStrides();
+    const auto& outLengths = yDesc_.GetLengths();
+    const auto& outStrides = yDesc_.GetStrides();
+
+    if(inLengths.size() != outLengths.size())
+        MIOPEN_THROW("The number of dimensions of the input and output tensor should match.");
+
+    for(std::size_t i = 0; i < inLengths.size(); i++)
+    {
+        if(outLengths[i] != 1 && outLengths[i] != inLengths[i])
+            MIOPEN_THROW("The length of the output tensor dimension should either be 1 or be equal "
+                         "to the length of the corresponding dimension of the input tensor.");
+    };
+
+    if(std::none_of(outLengths.begin(), outLengths.end(), [](auto len) { return len == 1; }))
+        MIOPEN_THROW("Invalid TensorDescriptor, at least one dimension of the input tensor should "
+                     "be reduced.");
+
+    std::vector<FoldedDim> dims;
+
+    for(std::size_t i = 0; i < inLengths.size(); i++)
+    {
+        // unit-length dimensions do not take part in addressing
+        if(inLengths[i] == 1)
+            continue;
+
+        const bool reduced = (outLengths[i] == 1);
+
+        if(!dims.empty())
+        {
+            auto& prev = dims.back();
+
+            if(prev.reduced == reduced && prev.inStride == inStrides[i] * inLengths[i] &&
+               (reduced || prev.outStride == outStrides[i] * outLengths[i]))
+            {
+                prev.length    = prev.length * inLengths[i];
+                prev.inStride  = inStrides[i];
+                prev.outStride = outStrides[i];
+                continue;
+            }
+        }
+
+        dims.push_back({inLengths[i], inStrides[i], outStrides[i], reduced});
+    };
+
+    // the reduced dimensions could all be unit-length ones, keep one of them
+    if(std::none_of(dims.begin(), dims.end(), [](const auto& dim) { return dim.reduced; }))
+        dims.push_back({1, 1, 1, true});
+
+    std::vector<std::size_t> foldedInLengths;
+    std::vector<std::size_t> foldedInStrides;
+    std::vector<std::size_t> foldedOutLengths;
+    std::vector<std::size_t> foldedOutStrides;
+
+    for(const auto& dim : dims)
+    {
+        if(dim.reduced)
+            toReduceDims.push_back(static_cast<int>(foldedInLengths.size()));
+        else
+            invariantDims.push_back(static_cast<int>(foldedInLengths.size()));
+
+        foldedInLengths.push_back(dim.length);
+        foldedInStrides.push_back(dim.inStride);
+        foldedOutLengths.push_back(dim.reduced ? 1 : dim.length);
+        foldedOutStrides.push_back(dim.outStride);
+    };
+
+    xDesc = TensorDescriptor{xDesc_.GetType(), foldedInLengths, foldedInStrides};
+    yDesc = TensorDescriptor{yDesc_.GetType(), foldedOutLengths, foldedOutStrides};
+}
+
+bool ProblemDescription::NeedIndices() const
+{
+    const auto reduceOp = reduce.reduceTensorOp_;
+
+    return (reduce.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES) &&
+           (reduceOp == MIOPEN_REDUCE_TENSOR_MIN || reduceOp == MIOPEN_REDUCE_TENSOR_MAX ||
+            reduceOp == MIOPEN_REDUCE_TENSOR_AMAX);
+}
+
+NetworkConfig ProblemDescription::MakeNetworkConfig() const
+{
+    std::ostringstream ss;
+    Serialize(ss);
+    return NetworkConfig{ss.str()};
+}
+
+void ProblemDescription::Serialize(std::ostream& stream) const
+{
+    stream << "reduce";
+    stream << "_t" << xDesc.GetType() << reduce.reduceTensorCompType_ << yDesc.GetType();
+    stream << "_op" << reduce.reduceTensorOp_;
+    stream << "_o" << ((reduce.reduceTensorNanOpt_ == MIOPEN_PROPAGATE_NAN) ? 1 : 0)
+           << ((reduce.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES) ? 1 : 0);
+    stream << "_in" << get_vect_config(xDesc.GetLengths());
+    stream << "_ins" << get_vect_config(xDesc.GetStrides());
+    stream << "_out" << get_vect_config(yDesc.GetLengths());
+    stream << "_outs" << get_vect_config(yDesc.GetStrides());
+}
+
+} // namespace reduce
+
+} // namespace miopen
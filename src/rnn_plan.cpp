@@ -0,0 +1,333 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/rnn.hpp>
+#include <miopen/rnn_plan.hpp>
+
+#include <ostream>
+#include <tuple>
+
+namespace miopen {
+
+void RNNPlanBindings::Set(RNNPlanBuffer buffer, ConstData_t ptr)
+{
+    // Const doesn't apply to the plan bindings; the steps know which buffers they write.
+    // NOLINTNEXTLINE (cppcoreguidelines-pro-type-const-cast)
+    ptrs[static_cast<std::size_t>(buffer)] = const_cast<Data_t>(ptr);
+}
+
+bool RNNPlanBindings::Find(ConstData_t ptr, RNNPlanBuffer& buffer) const
+{
+    if(ptr == nullptr)
+        return false;
+
+    auto found = false;
+    for(std::size_t i = 0; i < ptrs.size(); ++i)
+    {
+        if(ptrs[i] != ptr)
+            continue;
+        if(found)
+            return false;
+        found  = true;
+        buffer = static_cast<RNNPlanBuffer>(i);
+    }
+    return found;
+}
+
+bool operator<(const RNNPlanKey& l, const RNNPlanKey& r)
+{
+    return std::tie(l.is_inference,
+                    l.data_type,
+                    l.in_h,
+                    l.hy_d,
+                    l.hy_n,
+                    l.hy_h,
+                    l.out_h,
+                    l.workspace_size,
+                    l.reserve_size,
+                    l.present_buffers,
+                    l.batches) < std::tie(r.is_inference,
+                                          r.data_type,
+                                          r.in_h,
+                                          r.hy_d,
+                                          r.hy_n,
+                                          r.hy_h,
+                                          r.out_h,
+                                          r.workspace_size,
+                                          r.reserve_size,
+                                          r.present_buffers,
+                                          r.batches);
+}
+
+void RNNPlan::Add(RNNPlanOp op, Step step, std::size_t merged_gemms)
+{
+    steps.push_back(std::move(step));
+    ++launch_counts[static_cast<std::size_t>(op)];
+    merged_gemm_count += merged_gemms;
+}
+
+void RNNPlan::Run(Handle& handle, const RNNPlanBindings& bindings) const
+{
+    for(const auto& step : steps)
+        step(handle, bindings);
+}
+
+std::ostream& operator<<(std::ostream& os, const RNNPlan& plan)
+{
+    return os << "launches: " << plan.GetLaunchCount()
+              << " (gemm: " << plan.GetLaunchCount(RNNPlanOp::Gemm)
+              << ", gemm_strided_batched: " << plan.GetLaunchCount(RNNPlanOp::GemmStridedBatched)
+              << " merging " << plan.GetMergedGemmCount() << " gemms"
+              << ", op_tensor: " << plan.GetLaunchCount(RNNPlanOp::OpTensor)
+              << ", copy: " << plan.GetLaunchCount(RNNPlanOp::CopyTensor)
+              << ", set: " << plan.GetLaunchCount(RNNPlanOp::SetTensor)
+              << ", activation: " << plan.GetLaunchCount(RNNPlanOp::Activation)
+              << ", lstm_update: " << plan.GetLaunchCount(RNNPlanOp::LSTMHiddenStateUpdate)
+              << ")";
+}
+
+namespace {
+
+bool SameGemmShape(const GemmDescriptor& l, const GemmDescriptor& r)
+{
+    return std::tie(l.isColMajor,
+                    l.transA,
+                    l.transB,
+                    l.m,
+                    l.n,
+                    l.k,
+                    l.lda,
+                    l.ldb,
+                    l.ldc,
+                    l.alpha,
+                    l.beta,
+                    l.dataType,
+                    l.deterministic) == std::tie(r.isColMajor,
+                                                 r.transA,
+                                                 r.transB,
+                                                 r.m,
+                                                 r.n,
+                                                 r.k,
+                                                 r.lda,
+                                                 r.ldb,
+                                                 r.ldc,
+                                                 r.alpha,
+                                                 r.beta,
+                                                 r.dataType,
+                                                 r.deterministic);
+}
+
+bool CanAppend(const RNNGemmCall& run, const RNNGemmCall& last, const RNNGemmCall& call)
+{
+    if(last.desc.batch_count != 1 || call.desc.batch_count != 1 ||
+       !SameGemmShape(run.desc, call.desc) || call.A != run.A || call.B != run.B ||
+       call.C != run.C || call.backend != run.backend)
+        return false;
+
+    const long long stride_a = call.a_offset - last.a_offset;
+    const long long stride_b = call.b_offset - last.b_offset;
+    const long long stride_c = call.c_offset - last.c_offset;
+
+    if(run.desc.batch_count == 1)
+        return stride_a >= 0 && stride_b >= 0 && stride_c > 0;
+
+    return stride_a == run.desc.strideA && stride_b == run.desc.strideB &&
+           stride_c == run.desc.strideC;
+}
+
+} // namespace
+
+std::vector<RNNGemmCall> BatchIndependentGemms(const std::vector<RNNGemmCall>& calls)
+{
+    std::vector<RNNGemmCall> batched;
+    std::vector<const RNNGemmCall*> last_of_run;
+
+    for(const auto& call : calls)
+    {
+        auto run = std::size_t{0};
+        while(run < batched.size() && !CanAppend(batched[run], *last_of_run[run], call))
+            ++run;
+
+        if(run == batched.size())
+        {
+            batched.push_back(call);
+            last_of_run.push_back(&call);
+            continue;
+        }
+
+        auto& desc = batched[run].desc;
+        if(desc.batch_count == 1)
+        {
+            desc.strideA = call.a_offset - last_of_run[run]->a_offset;
+            desc.strideB = call.b_offset - last_of_run[run]->b_offset;
+            desc.strideC = call.c_offset - last_of_run[run]->c_offset;
+        }
+        ++desc.batch_count;
+        last_of_run[run] = &call;
+    }
+
+    return batched;
+}
+
+RNNTimeStep::RNNTimeStep(const std::vector<int>& in_n,
+                         int hid_shift,
+                         int hy_stride,
+                         int bacc,
+                         int baccbi,
+                         int ti,
+                         int ri)
+{
+    const auto seq_len = static_cast<int>(in_n.size());
+    cur_time           = ri == 0 ? ti : seq_len - 1 - ti;
+    offset             = hid_shift + (ri == 0 ? bacc : baccbi) * hy_stride;
+    if(ti > 0)
+    {
+        pretime_shift = ri == 0 ? hid_shift + (bacc - in_n.at(ti - 1)) * hy_stride
+                                : hid_shift + (baccbi + in_n.at(seq_len - 1 - ti)) * hy_stride;
+        use_time      = ri == 0 ? ti : seq_len - ti;
+    }
+}
+
+std::vector<RNNGemmCall> RNNHiddenGemms(const RNNHiddenGemmLayer& layer,
+                                        const std::vector<int>& in_n,
+                                        int bacc,
+                                        int baccbi,
+                                        int ti)
+{
+    const auto gemm = [&](int m, int lda) {
+        return GemmDescriptor{false,
+                              false,
+                              true,
+                              m,
+                              layer.wei_len,
+                              layer.hy_h,
+                              lda,
+                              layer.uni_stride,
+                              layer.hy_stride,
+                              1, // batch count
+                              0, // Stride A
+                              0, // Stride B
+                              0, // Stride C
+                              1, // alpha
+                              1, // beta
+                              layer.data_type,
+                              false};
+    };
+
+    std::vector<RNNGemmCall> calls;
+    for(int ri = 0; ri < layer.bi; ri++)
+    {
+        const auto step = RNNTimeStep{in_n, layer.hid_shift, layer.hy_stride, bacc, baccbi, ti, ri};
+
+        const auto hx_offset = layer.hx_shift + ri * layer.hy_n * layer.hy_h;
+        const auto w_offset  = layer.wei_shift + ri * layer.wei_len * layer.uni_stride;
+        const auto c_offset  = step.offset + ri * layer.wei_len;
+        const auto cur_n     = in_n.at(step.cur_time);
+        const auto use_n     = in_n.at(step.use_time);
+
+        if(cur_n == 0)
+            continue;
+
+        if(ti == 0)
+        {
+            if(layer.hx != nullptr)
+                calls.push_back({gemm(cur_n, layer.uni_stride),
+                                 layer.hx,
+                                 hx_offset,
+                                 layer.w,
+                                 w_offset,
+                                 layer.workspace,
+                                 c_offset,
+                                 GemmBackend_t::miopengemm});
+            continue;
+        }
+
+        // Rows of the reverse direction that start at this step take their state from hx.
+        if(ri == 1 && layer.hx != nullptr && cur_n > use_n)
+            calls.push_back({gemm(cur_n - use_n, layer.uni_stride),
+                             layer.hx,
+                             hx_offset + use_n * layer.hy_h,
+                             layer.w,
+                             w_offset,
+                             layer.workspace,
+                             c_offset + use_n * layer.hy_stride,
+                             GemmBackend_t::miopengemm});
+
+        if(use_n > 0)
+            calls.push_back({gemm(use_n, layer.hy_stride),
+                             layer.workspace,
+                             step.pretime_shift + layer.hid_off + ri * layer.hy_h,
+                             layer.w,
+                             w_offset,
+                             layer.workspace,
+                             c_offset,
+                             GemmBackend_t::miopengemm});
+    }
+    return calls;
+}
+
+std::shared_ptr<const RNNPlan> RNNPlanCache::Find(const RNNPlanKey& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = index.find(key);
+    if(it == index.end())
+        return nullptr;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->second;
+}
+
+void RNNPlanCache::Insert(const RNNPlanKey& key, std::shared_ptr<const RNNPlan> plan)
+{
+    if(capacity == 0 || plan == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = index.find(key);
+    if(it != index.end())
+    {
+        it->second->second = std::move(plan);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    if(entries.size() >= capacity)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, std::move(plan));
+    index.emplace(key, entries.begin());
+}
+
+std::size_t RNNPlanCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::shared_ptr<RNNPlanCache> MakeRNNPlanCache() { return std::make_shared<RNNPlanCache>(); }
+
+} // namespace miopen
@@ -0,0 +1,267 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_cost_model.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <random>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_RECORD)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+constexpr std::size_t wave_size    = 64;
+constexpr std::size_t waves_per_cu = 40;
+constexpr float launch_ms          = 0.005f;
+
+const char* GetRecordPath()
+{
+    const auto* const path = GetStringEnv(MIOPEN_DEBUG_TUNING_RECORD{});
+    return path != nullptr && *path != '\0' ? path : nullptr;
+}
+
+} // namespace
+
+AnalyticCostModel::AnalyticCostModel(std::size_t cu_count_,
+                                     float work_ms_,
+                                     float roughness_,
+                                     float noise_)
+    : cu_count(std::max<std::size_t>(cu_count_, 1)),
+      work_ms(work_ms_),
+      roughness(roughness_),
+      noise(noise_)
+{
+}
+
+float AnalyticCostModel::Measure(const SearchCandidate& candidate)
+{
+    if(candidate.solution == nullptr || candidate.solution->construction_params.empty())
+        MIOPEN_THROW("No kernels to measure: " + candidate.solver + ": " + candidate.config);
+
+    const auto& kernels = candidate.solution->construction_params;
+    auto time           = 0.0f;
+
+    for(const auto& kernel : kernels)
+    {
+        auto threads = std::size_t{1};
+        auto groups  = std::size_t{1};
+        for(auto i = std::size_t{0}; i < kernel.g_wk.size(); ++i)
+        {
+            const auto local = i < kernel.l_wk.size() && kernel.l_wk[i] > 0 ? kernel.l_wk[i] : 1;
+            threads *= local;
+            groups *= (kernel.g_wk[i] + local - 1) / local;
+        }
+        groups = std::max<std::size_t>(groups, 1);
+
+        const auto waves  = (threads + wave_size - 1) / wave_size;
+        const auto lanes  = static_cast<float>(threads) / (waves * wave_size);
+        const auto slots  = cu_count * std::max<std::size_t>(waves_per_cu / waves, 1);
+        const auto rounds = (groups + slots - 1) / slots;
+        const auto tail   = static_cast<float>(groups) / (rounds * slots);
+        time += launch_ms + work_ms / kernels.size() / (lanes * tail);
+    }
+
+    const auto hash = std::hash<std::string>{}(candidate.solver + ':' + candidate.problem + ':' +
+                                               candidate.config);
+    time *= 1.0f + roughness * static_cast<float>(hash % 1024) / 1024;
+
+    if(noise > 0.0f)
+    {
+        auto rng = std::minstd_rand{static_cast<std::minstd_rand::result_type>(hash ^ ++runs)};
+        time *= 1.0f + std::uniform_real_distribution<float>{-noise, noise}(rng);
+    }
+
+    return time;
+}
+
+RecordedCostModel::RecordedCostModel(const std::string& path)
+{
+    auto file = std::ifstream{path};
+    if(!file)
+        MIOPEN_THROW("Cannot open the recorded tuning times: " + path);
+
+    auto counts = std::map<std::tuple<std::string, std::string, std::string>, int>{};
+    auto line   = std::string{};
+    while(std::getline(file, line))
+    {
+        auto ss      = std::istringstream{line};
+        auto problem = std::string{};
+        auto solver  = std::string{};
+        auto config  = std::string{};
+        auto time    = 0.0f;
+        if(!(ss >> problem >> solver >> config >> time))
+        {
+            MIOPEN_LOG_W("Ill-formed recorded tuning time: " << line);
+            continue;
+        }
+        const auto key = std::make_tuple(problem, solver, config);
+        times[key] += time;
+        counts[key]++;
+    }
+
+    for(auto& entry : times)
+        entry.second /= counts[entry.first];
+}
+
+float RecordedCostModel::Measure(const SearchCandidate& candidate)
+{
+    const auto it =
+        times.find(std::make_tuple(candidate.problem, candidate.solver, candidate.config));
+    if(it == times.end())
+        MIOPEN_THROW("No recorded time for " + candidate.solver + ": " + candidate.config);
+    return it->second;
+}
+
+bool IsSearchRecordEnabled() { return GetRecordPath() != nullptr; }
+
+void RecordSearchTime(const SearchCandidate& candidate, float time)
+{
+    const auto* const path = GetRecordPath();
+    if(path == nullptr)
+        return;
+
+    static std::mutex mutex;
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto file = std::ofstream{path, std::ios::app};
+    file << candidate.problem << ' ' << candidate.solver << ' ' << candidate.config << ' ' << time
+         << '\n';
+    if(!file)
+        MIOPEN_LOG_W("Cannot record the tuning time to " << path);
+}
+
+float SearchTrace::Measure(const SearchCandidate& candidate)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if(!started)
+    {
+        begin   = now;
+        started = true;
+    }
+
+    if(!candidate.is_default && (candidate.repeat == 0 || evaluations.empty()))
+        evaluations.push_back({now - begin});
+
+    try
+    {
+        const auto time = model.Measure(candidate);
+        if(candidate.is_default)
+        {
+            default_time = time;
+        }
+        else
+        {
+            evaluations.back().total += time;
+            evaluations.back().runs++;
+        }
+        end = std::chrono::steady_clock::now() - begin;
+        return time;
+    }
+    catch(...)
+    {
+        if(!candidate.is_default)
+            evaluations.back().failed = true;
+        end = std::chrono::steady_clock::now() - begin;
+        throw;
+    }
+}
+
+void SearchTrace::Clear()
+{
+    evaluations.clear();
+    default_time = 0.0f;
+    started      = false;
+    end          = {};
+}
+
+float SearchTrace::BestAfter(std::size_t count) const
+{
+    auto best = std::numeric_limits<float>::max();
+    for(auto i = std::size_t{0}; i < std::min(count, evaluations.size()); ++i)
+    {
+        if(!evaluations[i].failed && evaluations[i].runs > 0)
+            best = std::min(best, evaluations[i].Average());
+    }
+    return best == std::numeric_limits<float>::max() ? 0.0f : best;
+}
+
+std::size_t SearchTrace::EvaluationsTo(float time) const
+{
+    for(auto i = std::size_t{0}; i < evaluations.size(); ++i)
+    {
+        if(!evaluations[i].failed && evaluations[i].runs > 0 && evaluations[i].Average() <= time)
+            return i + 1;
+    }
+    return 0;
+}
+
+SearchTraceStats SearchTrace::GetStats() const
+{
+    auto stats         = SearchTraceStats{};
+    stats.evaluated    = evaluations.size();
+    stats.seconds      = std::chrono::duration<double>(end).count();
+    stats.default_time = default_time;
+
+    for(auto i = std::size_t{0}; i < evaluations.size(); ++i)
+    {
+        const auto& evaluation = evaluations[i];
+        if(evaluation.failed || evaluation.runs == 0)
+        {
+            stats.failed++;
+            continue;
+        }
+        if(stats.evaluations_best == 0 || evaluation.Average() < stats.best)
+        {
+            stats.best             = evaluation.Average();
+            stats.evaluations_best = i + 1;
+            stats.seconds_best     = std::chrono::duration<double>(evaluation.start).count();
+        }
+    }
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& stream, const SearchTraceStats& stats)
+{
+    stream << "evaluated: " << stats.evaluated << ", failed: " << stats.failed
+           << ", configs/s: " << stats.EvaluationsPerSecond() << ", best: " << stats.best
+           << " ms after " << stats.evaluations_best << " configs (" << stats.seconds_best
+           << " s), default: " << stats.default_time << " ms";
+    return stream;
+}
+
+} // namespace solver
+} // namespace miopen
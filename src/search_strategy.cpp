@@ -0,0 +1,412 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/search_strategy.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <utility>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_TUNING_STRATEGY)
+
+namespace miopen {
+namespace solver {
+
+namespace {
+
+std::vector<std::string> SplitFields(const std::string& key)
+{
+    auto result = std::vector<std::string>{};
+    auto field  = std::string{};
+    for(const auto c : key)
+    {
+        if(c == ',' || c == ':' || c == ';')
+        {
+            result.push_back(field);
+            field.clear();
+        }
+        else
+        {
+            field.push_back(c);
+        }
+    }
+    result.push_back(field);
+    return result;
+}
+
+} // namespace
+
+SearchStrategy::SearchStrategy(const std::vector<std::string>& keys, unsigned seed)
+    : proposed(keys.size()),
+      failed(keys.size()),
+      times(keys.size(), std::numeric_limits<float>::infinity()),
+      rng(seed),
+      random_order(keys.size())
+{
+    auto values = std::vector<std::map<std::string, int>>{};
+    fields.reserve(keys.size());
+    for(const auto& key : keys)
+    {
+        const auto split = SplitFields(key);
+        if(values.size() < split.size())
+            values.resize(split.size());
+
+        auto coded = std::vector<int>{};
+        coded.reserve(split.size());
+        for(auto i = std::size_t{0}; i < split.size(); ++i)
+        {
+            const auto inserted =
+                values[i].emplace(split[i], static_cast<int>(values[i].size())).first;
+            coded.push_back(inserted->second);
+        }
+        fields.push_back(std::move(coded));
+    }
+
+    std::iota(random_order.begin(), random_order.end(), 0);
+    std::shuffle(random_order.begin(), random_order.end(), rng);
+}
+
+void SearchStrategy::Report(std::size_t index, float time, bool failed_)
+{
+    times.at(index)  = time;
+    failed.at(index) = failed_;
+}
+
+std::size_t SearchStrategy::Distance(std::size_t a, std::size_t b) const
+{
+    return Distance(fields[a], b);
+}
+
+std::size_t SearchStrategy::Distance(const std::vector<int>& a, std::size_t b) const
+{
+    const auto& other = fields[b];
+    const auto common = std::min(a.size(), other.size());
+    auto distance     = std::max(a.size(), other.size()) - common;
+    for(auto i = std::size_t{0}; i < common; ++i)
+    {
+        if(a[i] != other[i])
+            ++distance;
+    }
+    return distance;
+}
+
+void SearchStrategy::MarkProposed(std::size_t index)
+{
+    if(!proposed.at(index))
+    {
+        proposed[index] = true;
+        ++proposed_count;
+    }
+}
+
+std::size_t SearchStrategy::ProposeRandom()
+{
+    while(!random_order.empty())
+    {
+        const auto index = random_order.back();
+        random_order.pop_back();
+        if(!proposed[index])
+        {
+            MarkProposed(index);
+            return index;
+        }
+    }
+    return none;
+}
+
+std::size_t SearchStrategy::ProposeNearest(const std::vector<int>& target)
+{
+    auto nearest       = none;
+    auto best_distance = std::numeric_limits<std::size_t>::max();
+    auto ties          = std::size_t{0};
+
+    for(auto i = std::size_t{0}; i < Size(); ++i)
+    {
+        if(proposed[i])
+            continue;
+        const auto distance = Distance(target, i);
+        if(distance < best_distance)
+        {
+            nearest       = i;
+            best_distance = distance;
+            ties          = 1;
+        }
+        else if(distance == best_distance &&
+                std::uniform_int_distribution<std::size_t>{0, ties++}(rng) == 0)
+        {
+            nearest = i;
+        }
+    }
+
+    if(nearest != none)
+        MarkProposed(nearest);
+    return nearest;
+}
+
+std::vector<std::size_t> RandomSearchStrategy::Propose(std::size_t count)
+{
+    auto result = std::vector<std::size_t>{};
+    while(result.size() < count)
+    {
+        const auto index = ProposeRandom();
+        if(index == none)
+            break;
+        result.push_back(index);
+    }
+    return result;
+}
+
+std::vector<std::size_t> LocalSearchStrategy::Propose(std::size_t count)
+{
+    auto result = std::vector<std::size_t>{};
+    if(current != none)
+    {
+        for(auto radius = std::size_t{1}; radius <= 2 && result.empty(); ++radius)
+        {
+            for(auto i = std::size_t{0}; i < Size(); ++i)
+            {
+                if(!proposed[i] && Distance(current, i) == radius)
+                    result.push_back(i);
+            }
+        }
+
+        std::shuffle(result.begin(), result.end(), rng);
+        result.resize(std::min(result.size(), count));
+        for(const auto index : result)
+            MarkProposed(index);
+    }
+
+    if(result.empty() && count > 0)
+    {
+        // A local optimum: restart the climb.
+        current          = none;
+        const auto start = ProposeRandom();
+        if(start != none)
+            result.push_back(start);
+    }
+    return result;
+}
+
+void LocalSearchStrategy::Report(std::size_t index, float time, bool failed_)
+{
+    SearchStrategy::Report(index, time, failed_);
+    if(!failed_ && (current == none || time < times[current]))
+        current = index;
+}
+
+std::size_t EvolutionSearchStrategy::Tournament()
+{
+    auto pick    = std::uniform_int_distribution<std::size_t>{0, population.size() - 1};
+    const auto a = population[pick(rng)];
+    const auto b = population[pick(rng)];
+    return times[a] <= times[b] ? a : b;
+}
+
+std::vector<std::size_t> EvolutionSearchStrategy::Propose(std::size_t count)
+{
+    auto result = std::vector<std::size_t>{};
+    while(result.size() < count)
+    {
+        auto index = none;
+        if(proposed_count < population_size || population.size() < 2)
+        {
+            index = ProposeRandom();
+        }
+        else
+        {
+            const auto& a = fields[Tournament()];
+            const auto& b = fields[Tournament()];
+
+            auto child = a;
+            auto cross = std::bernoulli_distribution{0.5};
+            for(auto i = std::size_t{0}; i < std::min(child.size(), b.size()); ++i)
+            {
+                if(cross(rng))
+                    child[i] = b[i];
+            }
+
+            auto mutate = std::bernoulli_distribution{1.0 / std::max<std::size_t>(child.size(), 1)};
+            auto donor  = std::uniform_int_distribution<std::size_t>{0, Size() - 1};
+            for(auto i = std::size_t{0}; i < child.size(); ++i)
+            {
+                if(!mutate(rng))
+                    continue;
+                const auto& other = fields[donor(rng)];
+                if(i < other.size())
+                    child[i] = other[i];
+            }
+
+            index = ProposeNearest(child);
+        }
+
+        if(index == none)
+            break;
+        result.push_back(index);
+    }
+    return result;
+}
+
+void EvolutionSearchStrategy::Report(std::size_t index, float time, bool failed_)
+{
+    SearchStrategy::Report(index, time, failed_);
+    if(failed_)
+        return;
+
+    if(population.size() < population_size)
+    {
+        population.push_back(index);
+        return;
+    }
+
+    const auto slowest = std::max_element(
+        population.begin(), population.end(), [&](auto a, auto b) { return times[a] < times[b]; });
+    if(time < times[*slowest])
+        *slowest = index;
+}
+
+std::vector<std::size_t> SurrogateSearchStrategy::Propose(std::size_t count)
+{
+    auto evaluated = std::vector<std::size_t>{};
+    auto passed    = std::size_t{0};
+    auto slowest   = 0.0f;
+    for(auto i = std::size_t{0}; i < Size(); ++i)
+    {
+        if(failed[i])
+        {
+            evaluated.push_back(i);
+        }
+        else if(times[i] < std::numeric_limits<float>::infinity())
+        {
+            evaluated.push_back(i);
+            slowest = std::max(slowest, std::log(std::max(times[i], 1e-6f)));
+            ++passed;
+        }
+    }
+
+    auto result = std::vector<std::size_t>{};
+    if(passed < initial)
+    {
+        while(result.size() < count)
+        {
+            const auto index = ProposeRandom();
+            if(index == none)
+                break;
+            result.push_back(index);
+        }
+        return result;
+    }
+
+    // Scores a random sample of the configs not proposed yet.
+    auto pool = std::vector<std::size_t>{};
+    auto seen = std::size_t{0};
+    for(auto i = std::size_t{0}; i < Size(); ++i)
+    {
+        if(proposed[i])
+            continue;
+        if(pool.size() < candidates)
+        {
+            pool.push_back(i);
+        }
+        else
+        {
+            const auto slot = std::uniform_int_distribution<std::size_t>{0, seen}(rng);
+            if(slot < candidates)
+                pool[slot] = i;
+        }
+        ++seen;
+    }
+    std::shuffle(pool.begin(), pool.end(), rng);
+
+    auto scores  = std::vector<std::pair<float, std::size_t>>{};
+    auto nearest = std::vector<std::pair<std::size_t, float>>{};
+    for(const auto candidate : pool)
+    {
+        nearest.clear();
+        for(const auto index : evaluated)
+        {
+            const auto value = failed[index] ? slowest + 1.0f
+                                             : std::log(std::max(times[index], 1e-6f));
+            nearest.emplace_back(Distance(candidate, index), value);
+        }
+        const auto k = std::min(neighbors, nearest.size());
+        std::partial_sort(nearest.begin(),
+                          nearest.begin() + k,
+                          nearest.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        auto mean = 0.0f;
+        for(auto i = std::size_t{0}; i < k; ++i)
+            mean += nearest[i].second / k;
+        auto variance = 0.0f;
+        for(auto i = std::size_t{0}; i < k; ++i)
+            variance += (nearest[i].second - mean) * (nearest[i].second - mean) / k;
+        scores.emplace_back(mean - std::sqrt(variance), candidate);
+    }
+
+    const auto n = std::min(count, scores.size());
+    std::partial_sort(scores.begin(),
+                      scores.begin() + n,
+                      scores.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+    for(auto i = std::size_t{0}; i < n; ++i)
+    {
+        MarkProposed(scores[i].second);
+        result.push_back(scores[i].second);
+    }
+    return result;
+}
+
+std::string GetSearchStrategyName(const ExecutionContext& context)
+{
+    if(!context.search_strategy.empty())
+        return context.search_strategy;
+    const auto* const name = GetStringEnv(MIOPEN_DEBUG_TUNING_STRATEGY{});
+    return name != nullptr && *name != '\0' ? name : "random";
+}
+
+std::unique_ptr<SearchStrategy>
+MakeSearchStrategy(const std::string& name, const std::vector<std::string>& keys, unsigned seed)
+{
+    if(name == "random")
+        return std::make_unique<RandomSearchStrategy>(keys, seed);
+    if(name == "local")
+        return std::make_unique<LocalSearchStrategy>(keys, seed);
+    if(name == "evolution")
+        return std::make_unique<EvolutionSearchStrategy>(keys, seed);
+    if(name == "surrogate")
+        return std::make_unique<SurrogateSearchStrategy>(keys, seed);
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown tuning strategy: " + name);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,115 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/shared_program_cache.hpp>
+
+#include <chrono>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SHARED_PROGRAM_CACHE)
+
+SharedProgramCache& SharedProgramCache::Instance()
+{
+    // Never destroyed, as handles with static storage may release programs at exit.
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static auto* const instance = new SharedProgramCache{};
+    return *instance;
+}
+
+bool SharedProgramCache::IsEnabled() { return miopen::IsEnabled(MIOPEN_SHARED_PROGRAM_CACHE{}); }
+
+Program SharedProgramCache::Acquire(const Key& key, const std::function<Program()>& load)
+{
+    auto promise = std::promise<Program>{};
+    auto program = std::shared_future<Program>{};
+    auto builder = false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = entries[key];
+        if(!entry.program.valid())
+        {
+            entry.program = promise.get_future().share();
+            builder       = true;
+        }
+        program = entry.program;
+        ++entry.references;
+    }
+
+    if(builder)
+    {
+        MIOPEN_LOG_I2("Building shared program: " << std::get<1>(key) << " \""
+                                                  << std::get<2>(key) << '\"');
+        try
+        {
+            promise.set_value(load());
+        }
+        catch(...)
+        {
+            // Waiters get the same error, and a later call retries the build.
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(mutex);
+            entries.erase(key);
+            throw;
+        }
+    }
+
+    return program.get();
+}
+
+void SharedProgramCache::Release(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    if(it == entries.end() || it->second.references == 0)
+        return;
+    if(--it->second.references == 0)
+    {
+        MIOPEN_LOG_I2("Dropping shared program: " << std::get<1>(key) << " \"" << std::get<2>(key)
+                                                  << '\"');
+        entries.erase(it);
+    }
+}
+
+bool SharedProgramCache::Contains(const Key& key) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    return it != entries.end() &&
+           it->second.program.wait_for(std::chrono::seconds{0}) == std::future_status::ready;
+}
+
+std::size_t SharedProgramCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+} // namespace miopen
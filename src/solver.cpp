@@ -29,6 +29,7 @@
 #include <miopen/activ/solvers.hpp>
 #include <miopen/batchnorm/solvers.hpp>
 #include <miopen/pooling/solvers.hpp>
+#include <miopen/reduce/solvers.hpp>
 #include <miopen/fusion/solvers.hpp>
 
 #include <miopen/conv_algo_name.hpp>
@@ -41,6 +42,7 @@
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
+#include <map>
 #include <ostream>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_DEPRECATED_SOLVERS)
@@ -64,16 +66,35 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
     CompileTimer ct;
     std::vector<Program> programs(kernels.size());
 
+    // Different solutions often share programs, each unique one is built only once.
+    std::vector<std::size_t> unique;
+    std::vector<std::size_t> source_of(kernels.size());
+    {
+        std::map<std::pair<std::string, std::string>, std::size_t> seen;
+        for(std::size_t i = 0; i < kernels.size(); ++i)
+        {
+            const auto key      = std::make_pair(kernels[i].kernel_file, kernels[i].comp_options);
+            const auto inserted = seen.emplace(key, i);
+            if(inserted.second)
+                unique.push_back(i);
+            source_of[i] = inserted.first->second;
+        }
+    }
+
     // clang-format off
-    par_for_strided(kernels.size(),
-                    // max_threads{Value(MIOPEN_COMPILE_PARALLEL_LEVEL{}, 20)},
+    par_for_strided(unique.size(),
                     max_threads{GetTuningThreadsMax()},
                     [&](auto i) {
-                        const KernelInfo& k = kernels[i];
-                        programs[i]         = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
+                        const KernelInfo& k = kernels[unique[i]];
+                        programs[unique[i]] = h.LoadProgram(k.kernel_file, k.comp_options, false, "");
                     });
     // clang-format on
-    ct.Log("PrecompileKernels");
+
+    for(std::size_t i = 0; i < kernels.size(); ++i)
+        if(source_of[i] != i)
+            programs[i] = programs[source_of[i]];
+
+    ct.Log("PrecompileKernels", std::to_string(unique.size()) + "/" + std::to_string(kernels.size()));
     return programs;
 }
 
@@ -558,6 +579,9 @@ inline SolverRegistrar::SolverRegistrar(IdRegistryData& registry)
              Primitive::Fusion,
              solver::fusion::ConvCKIgemmFwdBiasActivFused{}.SolverDbId(),
              miopenConvolutionAlgoImplicitGEMM);
+
+    Register(registry, ++id, Primitive::Reduce, reduce::GenericReductionStatic{}.SolverDbId());
+    Register(registry, ++id, Primitive::Reduce, reduce::GenericReductionDynamic{}.SolverDbId());
     // IMPORTANT: New solvers should be added to the end of the function!
 }
 
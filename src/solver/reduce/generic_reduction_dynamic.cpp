@@ -0,0 +1,624 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/reduce/solvers.hpp>
+
+#include <miopen/db.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/env.hpp>
+#include <miopen/find_controls.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/reduce/invoke_params.hpp>
+#include <miopen/reduce/kernel_utils.hpp>
+#include <miopen/sequences.hpp>
+#include <miopen/solver/ck_utility_common.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <array>
+#include <limits>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DYNAMIC_REDUCTION)
+
+namespace miopen {
+
+namespace solver {
+
+namespace reduce {
+
+namespace {
+
+constexpr int search_runs = 5;
+
+using BlockSizes = seq::TwoPowersSpan<int, 128, 512>;
+
+// clang-format off
+auto PerfFieldRules()
+{
+    using Config = PerformanceConfigGenericReduction;
+
+    return seq::MakeRuleSet(
+        std::make_tuple(BlockSizes{}, &Config::block_size),
+        std::make_tuple(seq::TwoPowersSpan<int, 4, 16>{}, &Config::thread_buffer_length),
+        std::make_tuple(seq::TwoPowersSpan<int, 1, 4>{}, &Config::accesses_per_thread_inblock),
+        std::make_tuple(seq::TwoPowersSpan<int, 1, 4>{}, &Config::accesses_per_thread_inwarp)
+    );
+}
+// clang-format on
+
+// Tuned values are per device, like the convolution ones, but the problem keys have nothing in
+// common with the convolution perf-db, so the reductions have their own files.
+using ReducePerfDb = MultiFileDb<ReadonlyRamDb, RamDb, true>;
+
+ReducePerfDb GetReducePerfDb(const ExecutionContext& ctx)
+{
+    const auto basename = ctx.GetStream().GetDbBasename();
+
+    const auto system_path = boost::filesystem::path(GetSystemDbPath()) /
+                             (basename + ".reduce.pdb.txt");
+    const auto& user_dir = GetUserDbPath();
+
+    return {boost::filesystem::exists(system_path) ? system_path.string() : "",
+            user_dir.empty() ? ""
+                             : (boost::filesystem::path(user_dir) /
+                                (basename + "." + GetUserDbSuffix() + ".reduce.updb.txt"))
+                                   .string()};
+}
+
+struct ReductionMethods
+{
+    miopen::reduce::ReductionMethod_t first;
+    // Only set when the first call leaves partial results in the workspace
+    miopen::reduce::ReductionMethod_t second;
+    int gridSize;
+    int blkGroupSize;
+};
+
+ReductionMethods
+GetReductionMethods(const miopen::reduce::detail::ReductionKernelConfigurator& configurator,
+                    const miopen::reduce::ProblemDescription& problem)
+{
+    using namespace miopen::reduce;
+
+    const auto invariantLength = problem.GetInvariantLength();
+    const auto toReduceLength  = problem.GetToReduceLength();
+
+    auto methods     = ReductionMethods{};
+    methods.first    = configurator.getReductionMethod(invariantLength, toReduceLength);
+    methods.gridSize = configurator.getGridSize(invariantLength, toReduceLength);
+    methods.second   = methods.first;
+
+    if(methods.first == Reduce_MultiBlock)
+    {
+        methods.blkGroupSize = static_cast<int>(methods.gridSize / invariantLength);
+        methods.second       = configurator.GetReductionMethod_2(methods.blkGroupSize);
+    }
+    else
+        methods.blkGroupSize = 0;
+
+    return methods;
+}
+
+} // namespace
+
+PerformanceConfigGenericReduction::PerformanceConfigGenericReduction(int bs,
+                                                                     int tbl,
+                                                                     int apt_block,
+                                                                     int apt_warp)
+    : block_size(bs),
+      thread_buffer_length(tbl),
+      accesses_per_thread_inblock(apt_block),
+      accesses_per_thread_inwarp(apt_warp)
+{
+}
+
+tunable_generic_reduction PerformanceConfigGenericReduction::GetTunable() const
+{
+    return {block_size,
+            thread_buffer_length,
+            accesses_per_thread_inblock,
+            accesses_per_thread_inwarp};
+}
+
+void PerformanceConfigGenericReduction::HeuristicInit(const ExecutionContext&,
+                                                      const miopen::reduce::ProblemDescription&)
+{
+    const auto& tunable = default_tunable_generic_reduction;
+
+    block_size                  = tunable.BlockSize;
+    thread_buffer_length        = tunable.GredThreadBufferLength;
+    accesses_per_thread_inblock = tunable.GredAccessesPerThreadInBlock;
+    accesses_per_thread_inwarp  = tunable.GredAccessesPerThreadInWarp;
+}
+
+bool PerformanceConfigGenericReduction::IsValidValue() const
+{
+    return PerfFieldRules().IsIn(*this);
+}
+
+bool PerformanceConfigGenericReduction::SetNextValue(const miopen::reduce::ProblemDescription&)
+{
+    return !PerfFieldRules().Next(*this);
+}
+
+bool PerformanceConfigGenericReduction::IsValid(
+    const ExecutionContext& ctx, const miopen::reduce::ProblemDescription& problem) const
+{
+    using namespace miopen::reduce;
+
+    if(!IsValidValue())
+        return false;
+
+    const auto warpSize = static_cast<int>(ctx.GetStream().GetWavefrontWidth());
+
+    if(block_size < warpSize)
+        return false;
+
+    const auto methods = GetReductionMethods(
+        miopen::reduce::detail::ReductionKernelConfigurator(block_size, warpSize), problem);
+    const auto uses = [&](ReductionMethod_t method) {
+        return methods.first == method || methods.second == method;
+    };
+
+    // Parameters of the methods which are not used are kept at their default values, so that
+    // the search does not build and measure the same kernels several times.
+    const auto& tunable = default_tunable_generic_reduction;
+
+    if(!uses(Reduce_DirectThreadWise) && thread_buffer_length != tunable.GredThreadBufferLength)
+        return false;
+    if(!uses(Reduce_DirectWarpWise) &&
+       accesses_per_thread_inwarp != tunable.GredAccessesPerThreadInWarp)
+        return false;
+    if(!uses(Reduce_BlockWise) && !uses(Reduce_MultiBlock) &&
+       accesses_per_thread_inblock != tunable.GredAccessesPerThreadInBlock)
+        return false;
+
+    return true;
+}
+
+bool PerformanceConfigGenericReduction::operator==(
+    const PerformanceConfigGenericReduction& other) const
+{
+    return PerfFieldRules().Compare(*this, other);
+}
+
+bool GenericReductionDynamic::IsApplicable(const ExecutionContext&,
+                                           const miopen::reduce::ProblemDescription& problem) const
+{
+    return !miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}) &&
+           problem.GetXDesc().GetLengths().size() <= 6;
+}
+
+std::size_t
+GenericReductionDynamic::GetWorkspaceSize(const ExecutionContext& context,
+                                          const miopen::reduce::ProblemDescription& problem) const
+{
+    std::size_t workspace_size = 0;
+
+    for(const auto block_size : BlockSizes{})
+    {
+        const auto configurator = miopen::reduce::detail::ReductionKernelConfigurator(
+            block_size, context.GetStream().GetWavefrontWidth());
+
+        workspace_size =
+            std::max(workspace_size,
+                     configurator.getWorkspaceSize(problem.GetInvariantLength(),
+                                                   problem.GetToReduceLength()));
+    }
+
+    // dynamic reduction use one additional page for storing tensor descriptors
+    return miopen::reduce::detail::GetWorkspaceSizeInBytes(
+               workspace_size, problem.GetXDesc().GetType(), problem.NeedIndices()) +
+           4096;
+}
+
+PerformanceConfigGenericReduction GenericReductionDynamic::GetDefaultPerformanceConfig(
+    const ExecutionContext& context, const miopen::reduce::ProblemDescription& problem) const
+{
+    auto config = PerformanceConfigGenericReduction{};
+    config.HeuristicInit(context, problem);
+    return config;
+}
+
+bool GenericReductionDynamic::IsValidPerformanceConfig(
+    const ExecutionContext& context,
+    const miopen::reduce::ProblemDescription& problem,
+    const PerformanceConfigGenericReduction& config) const
+{
+    return config.IsValid(context, problem);
+}
+
+ConvSolution
+GenericReductionDynamic::GetSolution(const ExecutionContext& context,
+                                     const miopen::reduce::ProblemDescription& problem) const
+{
+    auto config = GetDefaultPerformanceConfig(context, problem);
+
+    if(!context.disable_perfdb_access)
+    {
+        auto db     = GetReducePerfDb(context);
+        auto loaded = PerformanceConfigGenericReduction{};
+
+        if(db.Load(problem, SolverDbId(), loaded))
+        {
+            if(IsValidPerformanceConfig(context, problem, loaded))
+            {
+                MIOPEN_LOG_I2("Perf-db record loaded: " << loaded);
+                config = loaded;
+            }
+            else
+                MIOPEN_LOG_W("Invalid perf-db record ignored: " << loaded);
+        }
+    }
+
+    return GetSolution(context, problem, config);
+}
+
+ConvSolution
+GenericReductionDynamic::GetSolution(const ExecutionContext& context,
+                                     const miopen::reduce::ProblemDescription& problem,
+                                     const PerformanceConfigGenericReduction& config) const
+{
+    using namespace miopen::reduce;
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto& handle       = context.GetStream();
+    const auto& reduceDesc   = problem.GetReduceDesc();
+    const auto& inLengths    = problem.GetXDesc().GetLengths();
+    const auto& inStrides    = problem.GetXDesc().GetStrides();
+    const auto& outLengths   = problem.GetYDesc().GetLengths();
+    const auto& outStrides   = problem.GetYDesc().GetStrides();
+    const auto reduceAllDims = problem.IsAllDimsReduced();
+    const auto tunable       = config.GetTunable();
+    const auto warpSize      = static_cast<int>(handle.GetWavefrontWidth());
+
+    const auto invariantLength = problem.GetInvariantLength();
+    const auto toReduceLength  = problem.GetToReduceLength();
+
+    const auto configurator =
+        miopen::reduce::detail::ReductionKernelConfigurator(tunable.BlockSize, warpSize);
+    const auto methods     = GetReductionMethods(configurator, problem);
+    const auto useTwoCalls = (methods.first == Reduce_MultiBlock);
+
+    std::array<int, 6> p_inLengths  = {0};
+    std::array<int, 6> p_inStrides  = {0};
+    std::array<int, 6> p_outLengths = {0};
+    std::array<int, 6> p_outStrides = {0};
+
+    int pos = 0;
+    for(const auto dim : problem.GetInvariantDims())
+    {
+        p_outLengths[pos] = static_cast<int>(outLengths[dim]);
+        p_outStrides[pos] = static_cast<int>(outStrides[dim]);
+        p_inLengths[pos]  = static_cast<int>(inLengths[dim]);
+        p_inStrides[pos]  = static_cast<int>(inStrides[dim]);
+        pos++;
+    }
+
+    for(const auto dim : problem.GetToReduceDims())
+    {
+        p_inLengths[pos] = static_cast<int>(inLengths[dim]);
+        p_inStrides[pos] = static_cast<int>(inStrides[dim]);
+        pos++;
+    }
+
+    if(reduceAllDims)
+    {
+        p_outLengths[0] = 1;
+        p_outStrides[0] = 1;
+    }
+
+    std::string param = solver::ck_utility::get_ck_common_compiler_flag(handle);
+
+    param += detailDynamic::get_definition_string_from_type_enums(problem.GetXDesc().GetType(),
+                                                                  reduceDesc.reduceTensorCompType_,
+                                                                  problem.GetYDesc().GetType()) +
+             " " + detailDynamic::get_definition_string_from_tunable(&tunable);
+
+    if(!reduceAllDims)
+        param +=
+            " -DCK_PARAM_NUM_TOREDUCE_DIMS=" + std::to_string(problem.GetToReduceDims().size());
+
+    param += " -DCK_PARAM_REDUCE_OP=" +
+             std::to_string(
+                 static_cast<int>(detailDynamic::mapReduceOpId(reduceDesc.reduceTensorOp_)));
+
+    param += detailDynamic::get_definition_string_from_options(reduceDesc.reduceTensorNanOpt_,
+                                                               reduceDesc.reduceTensorIndices_);
+
+    param += " -DCK_PARAM_IN_DIMS=" + std::to_string(inLengths.size());
+    param += " -DCK_PARAM_OUT_DIMS=";
+    param += reduceAllDims ? "1" : std::to_string(problem.GetInvariantDims().size());
+
+    const auto add_kernels = [&](bool isFirstCall,
+                                 ReductionMethod_t reduceImpl,
+                                 std::size_t reduceLength,
+                                 int gridSize,
+                                 int blkGroupSize) {
+        const auto use_padding = detailDynamic::get_padding_need(reduceImpl,
+                                                                 invariantLength,
+                                                                 reduceLength,
+                                                                 gridSize,
+                                                                 tunable.BlockSize,
+                                                                 warpSize,
+                                                                 blkGroupSize,
+                                                                 &tunable);
+
+        auto kernel_info = KernelInfo{};
+        kernel_info.comp_options =
+            param +
+            " -DCK_PARAM_SRC2D_PADDING=" + std::to_string(static_cast<int>(use_padding.first)) +
+            " -DCK_PARAM_DST1D_PADDING=" + std::to_string(static_cast<int>(use_padding.second));
+        kernel_info.l_wk = {static_cast<std::size_t>(tunable.BlockSize), 1, 1};
+        kernel_info.kernel_file =
+            detailDynamic::get_kernel_file_name(isFirstCall, reduceImpl, reduceAllDims);
+
+        const auto kernel_name =
+            std::string{isFirstCall ? "gridwise_generic_reduce_1" : "gridwise_generic_reduce_2"};
+
+        // the prepare kernel only fills the tensor descriptors in, one workgroup is enough
+        kernel_info.g_wk        = {static_cast<std::size_t>(tunable.BlockSize), 1, 1};
+        kernel_info.kernel_name = kernel_name + "_prepare";
+        result.construction_params.push_back(kernel_info);
+
+        kernel_info.g_wk = {static_cast<std::size_t>(gridSize) * tunable.BlockSize, 1, 1};
+        kernel_info.kernel_name = kernel_name;
+        result.construction_params.push_back(kernel_info);
+    };
+
+    add_kernels(true, methods.first, toReduceLength, methods.gridSize, methods.blkGroupSize);
+
+    const int gridSize_2 =
+        useTwoCalls
+            ? static_cast<int>(configurator.getGridSize_2(invariantLength, methods.blkGroupSize))
+            : 0;
+
+    if(useTwoCalls)
+        add_kernels(false, methods.second, methods.blkGroupSize, gridSize_2, 1);
+
+    const auto gridSize       = methods.gridSize;
+    const auto blkGroupSize   = methods.blkGroupSize;
+    const auto origReduceLen  = static_cast<int>(toReduceLength);
+    const auto workspace_size = configurator.getWorkspaceSize(invariantLength, toReduceLength);
+    const auto need_indices   = problem.NeedIndices();
+    const auto srcType        = problem.GetXDesc().GetType();
+    const auto aTypeSize      = miopen::reduce::detail::GetDataTypeSize(srcType);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::reduce::InvokeParams>();
+
+            const long ws_buf2_bytes_offset =
+                (need_indices && params.workspace != nullptr)
+                    ? ((workspace_size * aTypeSize + 63) / 64) * 64
+                    : 0;
+
+            float time_reduce = 0.0f;
+
+            const auto accum_time = [&]() {
+                if(handle_.IsProfilingEnabled())
+                    time_reduce += handle_.GetKernelTime();
+            };
+
+            if(!reduceAllDims)
+                handle_.Run(kernels[0])(gridSize,
+                                        blkGroupSize,
+                                        p_inLengths[0],
+                                        p_inLengths[1],
+                                        p_inLengths[2],
+                                        p_inLengths[3],
+                                        p_inLengths[4],
+                                        p_inLengths[5],
+                                        p_inStrides[0],
+                                        p_inStrides[1],
+                                        p_inStrides[2],
+                                        p_inStrides[3],
+                                        p_inStrides[4],
+                                        p_inStrides[5],
+                                        p_outStrides[0],
+                                        p_outStrides[1],
+                                        p_outStrides[2],
+                                        p_outStrides[3],
+                                        p_outStrides[4],
+                                        p_outStrides[5],
+                                        params.workspace);
+            else
+                handle_.Run(kernels[0])(gridSize,
+                                        blkGroupSize,
+                                        p_inLengths[0],
+                                        p_inLengths[1],
+                                        p_inLengths[2],
+                                        p_inLengths[3],
+                                        p_inLengths[4],
+                                        p_inLengths[5],
+                                        p_inStrides[0],
+                                        p_inStrides[1],
+                                        p_inStrides[2],
+                                        p_inStrides[3],
+                                        p_inStrides[4],
+                                        p_inStrides[5],
+                                        params.workspace);
+            accum_time();
+
+            handle_.Run(kernels[1])(origReduceLen,
+                                    blkGroupSize,
+                                    params.alpha,
+                                    params.x,
+                                    params.beta,
+                                    params.y,
+                                    params.workspace,
+                                    ws_buf2_bytes_offset,
+                                    params.indices);
+            accum_time();
+
+            if(kernels.size() > 2)
+            {
+                if(!reduceAllDims)
+                    handle_.Run(kernels[2])(gridSize_2,
+                                            blkGroupSize,
+                                            p_outLengths[0],
+                                            p_outLengths[1],
+                                            p_outLengths[2],
+                                            p_outLengths[3],
+                                            p_outLengths[4],
+                                            p_outLengths[5],
+                                            p_outStrides[0],
+                                            p_outStrides[1],
+                                            p_outStrides[2],
+                                            p_outStrides[3],
+                                            p_outStrides[4],
+                                            p_outStrides[5],
+                                            params.workspace);
+                else
+                    handle_.Run(kernels[2])(gridSize_2, blkGroupSize, params.workspace);
+                accum_time();
+
+                handle_.Run(kernels[3])(origReduceLen,
+                                        params.alpha,
+                                        params.x,
+                                        params.beta,
+                                        params.y,
+                                        params.workspace,
+                                        ws_buf2_bytes_offset,
+                                        params.indices);
+                accum_time();
+            }
+
+            if(handle_.IsProfilingEnabled())
+            {
+                handle_.ResetKernelTime();
+                handle_.AccumKernelTime(time_reduce);
+            }
+        };
+    };
+
+    return result;
+}
+
+PerformanceConfigGenericReduction
+GenericReductionDynamic::Search(const ExecutionContext& context,
+                                const miopen::reduce::ProblemDescription& problem,
+                                const AnyInvokeParams& invoke_ctx) const
+{
+    auto& handle = context.GetStream();
+    auto params  = invoke_ctx.CastTo<miopen::reduce::InvokeParams>();
+
+    // The candidates write into scratch buffers: the user's output may be accumulated into
+    // (beta != 0) and has to stay intact until the real run.
+    const auto y_buf = handle.Create(problem.GetYDesc().GetNumBytes());
+    params.y         = y_buf.get();
+
+    auto indices_buf = decltype(handle.Create(0)){};
+    if(params.indices != nullptr && params.indices_size > 0)
+    {
+        indices_buf    = handle.Create(params.indices_size);
+        params.indices = indices_buf.get();
+    }
+
+    const AutoEnableProfiling enable_profiling{handle};
+
+    auto best      = GetDefaultPerformanceConfig(context, problem);
+    auto best_time = std::numeric_limits<float>::max();
+    auto config    = PerformanceConfigGenericReduction{true};
+
+    do
+    {
+        if(!IsValidPerformanceConfig(context, problem, config))
+            continue;
+
+        try
+        {
+            const auto solution = GetSolution(context, problem, config);
+            const auto invoker =
+                handle.PrepareInvoker(*solution.invoker_factory, solution.construction_params);
+
+            // warm-up
+            invoker(handle, params);
+
+            auto time = 0.0f;
+            for(int i = 0; i < search_runs; ++i)
+            {
+                invoker(handle, params);
+                time += handle.GetKernelTime();
+            }
+            time /= search_runs;
+
+            MIOPEN_LOG_I2(config << ": " << time << " ms");
+
+            if(time < best_time)
+            {
+                best      = config;
+                best_time = time;
+            }
+        }
+        catch(const miopen::Exception& ex)
+        {
+            MIOPEN_LOG_W(config << ": " << ex.what());
+        }
+    } while(config.SetNextValue(problem));
+
+    MIOPEN_LOG_I("Best reduction config: " << best << ", " << best_time << " ms");
+    return best;
+}
+
+void GenericReductionDynamic::ApplyFindEnforce(const ExecutionContext& context,
+                                               const miopen::reduce::ProblemDescription& problem,
+                                               const AnyInvokeParams& invoke_ctx) const
+{
+    const auto enforce = FindEnforce{};
+
+    if(!IsApplicable(context, problem) || context.disable_perfdb_access)
+        return;
+
+    auto db = GetReducePerfDb(context);
+
+    if(enforce.IsDbClean(context))
+    {
+        if(db.Remove(problem, SolverDbId()))
+            MIOPEN_LOG_W("Perf-db record removed: " << problem.MakeNetworkConfig().ToString());
+        return;
+    }
+
+    if(!enforce.IsSearch(context))
+        return;
+
+    auto config = PerformanceConfigGenericReduction{};
+    if(!enforce.IsDbUpdate(context) && db.Load(problem, SolverDbId(), config))
+        return;
+
+    config = Search(context, problem, invoke_ctx);
+    db.Update(problem, SolverDbId(), config);
+}
+
+} // namespace reduce
+
+} // namespace solver
+
+} // namespace miopen
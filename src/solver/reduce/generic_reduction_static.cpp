@@ -0,0 +1,263 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/reduce/solvers.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/reduce/invoke_params.hpp>
+#include <miopen/reduce/kernel_utils.hpp>
+#include <miopen/stringutils.hpp>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_DYNAMIC_REDUCTION)
+
+#define WORKAROUND_MIOPEN_ISSUE_557 1
+
+namespace miopen {
+
+namespace solver {
+
+namespace reduce {
+
+namespace {
+
+constexpr int static_block_size = 256;
+
+template <typename T>
+std::string join_values(const std::vector<T>& values)
+{
+    std::string str;
+    for(std::size_t i = 0; i < values.size(); i++)
+    {
+        str += std::to_string(values[i]);
+        if(i < values.size() - 1)
+            str += ",";
+    }
+    return str;
+}
+
+} // namespace
+
+bool GenericReductionStatic::IsApplicable(const ExecutionContext&,
+                                          const miopen::reduce::ProblemDescription& problem) const
+{
+    return miopen::IsDisabled(MIOPEN_DEBUG_DYNAMIC_REDUCTION{}) &&
+           problem.GetXDesc().GetLengths().size() <= 6;
+}
+
+std::size_t
+GenericReductionStatic::GetWorkspaceSize(const ExecutionContext& context,
+                                         const miopen::reduce::ProblemDescription& problem) const
+{
+    const auto configurator = miopen::reduce::detail::ReductionKernelConfigurator(
+        static_block_size, context.GetStream().GetWavefrontWidth());
+
+    return miopen::reduce::detail::GetWorkspaceSizeInBytes(
+        configurator.getWorkspaceSize(problem.GetInvariantLength(), problem.GetToReduceLength()),
+        problem.GetXDesc().GetType(),
+        problem.NeedIndices());
+}
+
+ConvSolution
+GenericReductionStatic::GetSolution(const ExecutionContext& context,
+                                    const miopen::reduce::ProblemDescription& problem) const
+{
+    using namespace miopen::reduce;
+
+    auto result = ConvSolution{miopenStatusSuccess};
+
+    const auto& handle       = context.GetStream();
+    const auto& reduceDesc   = problem.GetReduceDesc();
+    const auto srcDataType   = problem.GetXDesc().GetType();
+    const auto dstDataType   = problem.GetYDesc().GetType();
+    const auto& inLengths    = problem.GetXDesc().GetLengths();
+    const auto& inStrides    = problem.GetXDesc().GetStrides();
+    const auto& outLengths   = problem.GetYDesc().GetLengths();
+    const auto& outStrides   = problem.GetYDesc().GetStrides();
+    const auto reduceAllDims = problem.IsAllDimsReduced();
+    const bool nanPropagate  = (reduceDesc.reduceTensorNanOpt_ == MIOPEN_PROPAGATE_NAN);
+    const bool reduceIndices =
+        (reduceDesc.reduceTensorIndices_ == MIOPEN_REDUCE_TENSOR_FLATTENED_INDICES);
+
+    const auto invariantLength = problem.GetInvariantLength();
+    const auto toReduceLength  = problem.GetToReduceLength();
+
+    const auto configurator = miopen::reduce::detail::ReductionKernelConfigurator(
+        static_block_size, handle.GetWavefrontWidth());
+
+    const ReductionMethod_t reduceImpl =
+        configurator.getReductionMethod(invariantLength, toReduceLength);
+    const int gridSize = configurator.getGridSize(invariantLength, toReduceLength);
+    const int blkGroupSize =
+        (reduceImpl == Reduce_MultiBlock) ? static_cast<int>(gridSize / invariantLength) : 0;
+
+    const bool useTwoCalls = (reduceImpl == Reduce_MultiBlock);
+
+    std::vector<std::size_t> invariantLengths;
+    std::vector<std::size_t> invariantStrides;
+
+    for(const auto dim : problem.GetInvariantDims())
+    {
+        invariantLengths.push_back(outLengths[dim]);
+        invariantStrides.push_back(outStrides[dim]);
+    }
+
+    const auto get_constants = detailStatic::get_tunable_reduction_kernel_constants(reduceImpl);
+
+    std::string param;
+
+    param = std::string(" -std=c++14 ");
+    param += " -DCK_PARAM_BLOCKSIZE=" + std::to_string(static_block_size);
+    param += " -DCK_PARAM_BLKGROUPSIZE=" + std::to_string(blkGroupSize);
+    param += " -DCK_PARAM_SRC_DATATYPE=" + std::to_string(detailStatic::GetDataTypeId(srcDataType));
+    param += " -DCK_PARAM_DST_DATATYPE=" + std::to_string(detailStatic::GetDataTypeId(dstDataType));
+    param += " -DCK_PARAM_REDUCE_COMPTYPE=" +
+             std::to_string(detailStatic::GetDataTypeId(reduceDesc.reduceTensorCompType_));
+
+    param += " -DCK_PARAM_SRC_DESC_LENGTHS=" + join_values(inLengths);
+    param += " -DCK_PARAM_SRC_DESC_STRIDES=" + join_values(inStrides);
+
+    if(!reduceAllDims)
+    {
+        param += " -DCK_PARAM_DST_DESC_LENGTHS=" + join_values(invariantLengths);
+        param += " -DCK_PARAM_DST_DESC_STRIDES=" + join_values(invariantStrides);
+    }
+    else
+    {
+        param += " -DCK_PARAM_DST_DESC_LENGTHS=1";
+        param += " -DCK_PARAM_DST_DESC_STRIDES=1";
+    };
+
+    param += " -DCK_PARAM_TOREDUCE_DIMS=" + join_values(problem.GetToReduceDims());
+    param += " -DCK_PARAM_INVARIANT_DIMS=" + join_values(problem.GetInvariantDims());
+
+    param += " -DCK_PARAM_REDUCE_OP=" +
+             std::to_string(detailStatic::GetReduceTensorOpId(reduceDesc.reduceTensorOp_));
+    param += " -DCK_PARAM_NAN_PROPAGATE=" + std::to_string(nanPropagate ? 1 : 0);
+    param += " -DCK_PARAM_REDUCE_INDICES=" + std::to_string(reduceIndices ? 1 : 0);
+
+    param += " -DCK_PARAM_THREAD_BUFFER_LENGTH=" +
+             std::to_string(get_constants.GredThreadBufferLength);
+    param += " -DCK_PARAM_ACCESSES_PER_THREAD_INBLOCK=" +
+             std::to_string(get_constants.GredAccessesPerThreadInBlock);
+    param += " -DCK_PARAM_ACCESSES_PER_THREAD_INWARP=" +
+             std::to_string(get_constants.GredAccessesPerThreadInWarp);
+
+    param += " -DCK_PARAM_REDUCE_IMPL=" + std::to_string(static_cast<int>(reduceImpl));
+
+    // to remove the warning from clang-tidy checking
+    param += " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=0 ";
+
+#if WORKAROUND_MIOPEN_ISSUE_557
+    if(StartsWith(handle.GetDeviceName(), "gfx10") || StartsWith(handle.GetDeviceName(), "gfx11"))
+        param += " -DCK_USE_AMD_BUFFER_ADDRESSING=0 ";
+    else
+    {
+        if(srcDataType == miopenDouble)
+            // TODO: support from composable kernel utility for using AMD Buffer Addressing for
+            // double
+            param += " -DCK_USE_AMD_BUFFER_ADDRESSING=0 ";
+    };
+#else
+    if(srcDataType == miopenDouble)
+        // TODO: support from composable kernel utility for using AMD Buffer Addressing for
+        // double
+        param += " -DCK_USE_AMD_BUFFER_ADDRESSING=0 ";
+#endif
+
+    {
+        const auto param1 = param + " -DCK_PARAM_GRIDSIZE=" + std::to_string(gridSize) + " ";
+
+        auto kernel_info         = KernelInfo{};
+        kernel_info.comp_options = param1;
+        kernel_info.l_wk         = {static_cast<std::size_t>(static_block_size), 1, 1};
+        kernel_info.g_wk         = {static_cast<std::size_t>(gridSize) * static_block_size, 1, 1};
+        kernel_info.kernel_file  = "static_kernel_gridwise_generic_reduction_first_call.cpp";
+        kernel_info.kernel_name  = "gridwise_generic_reduce_1";
+
+        result.construction_params.push_back(kernel_info);
+    }
+
+    if(useTwoCalls)
+    {
+        const int gridSize_2 = configurator.getGridSize_2(invariantLength, blkGroupSize);
+        const auto param2    = param + " -DCK_PARAM_GRIDSIZE=" + std::to_string(gridSize_2) + " ";
+
+        auto kernel_info         = KernelInfo{};
+        kernel_info.comp_options = param2;
+        kernel_info.l_wk         = {static_cast<std::size_t>(static_block_size), 1, 1};
+        kernel_info.g_wk         = {static_cast<std::size_t>(gridSize_2) * static_block_size, 1, 1};
+        kernel_info.kernel_file  = "static_kernel_gridwise_generic_reduction_second_call.cpp";
+        kernel_info.kernel_name  = "gridwise_generic_reduce_2";
+
+        result.construction_params.push_back(kernel_info);
+    }
+
+    const auto workspace_size = configurator.getWorkspaceSize(invariantLength, toReduceLength);
+    const auto need_indices   = problem.NeedIndices();
+    const auto aTypeSize      = miopen::reduce::detail::GetDataTypeSize(srcDataType);
+
+    result.invoker_factory = [=](const std::vector<Kernel>& kernels) {
+        return [=](const Handle& handle_, const AnyInvokeParams& raw_params) {
+            decltype(auto) params = raw_params.CastTo<miopen::reduce::InvokeParams>();
+
+            const long ws_buf2_bytes_offset =
+                (need_indices && params.workspace != nullptr)
+                    ? ((workspace_size * aTypeSize + 63) / 64) * 64
+                    : 0;
+
+            float time_reduce = 0.0f;
+
+            for(const auto& k : kernels)
+            {
+                handle_.Run(k)(params.alpha,
+                               params.x,
+                               params.beta,
+                               params.y,
+                               params.workspace,
+                               ws_buf2_bytes_offset,
+                               params.indices);
+
+                if(handle_.IsProfilingEnabled())
+                    time_reduce += handle_.GetKernelTime();
+            }
+
+            if(handle_.IsProfilingEnabled())
+            {
+                handle_.ResetKernelTime();
+                handle_.AccumKernelTime(time_reduce);
+            }
+        };
+    };
+
+    return result;
+}
+
+} // namespace reduce
+
+} // namespace solver
+
+} // namespace miopen
@@ -106,9 +106,31 @@ void ReorderVector(std::vector<size_t>& lens, const std::initializer_list<size_t
 
 } // namespace
 
-TensorDescriptor::TensorDescriptor() : packed(true) {}
+const std::shared_ptr<const TensorDescriptor::Geometry>& TensorDescriptor::EmptyGeometry()
+{
+    // Sizes of a descriptor without lengths are those of its single vector, as they always were.
+    static const std::shared_ptr<const Geometry> empty = [] {
+        auto g = std::make_shared<Geometry>();
+        g->CalculateDerived(1);
+        return std::shared_ptr<const Geometry>{std::move(g)};
+    }();
+    return empty;
+}
 
-TensorDescriptor::TensorDescriptor(miopenDataType_t t) : packed(true), type(t) {}
+void TensorDescriptor::Geometry::CalculateDerived(std::size_t vector_length)
+{
+    assert(lens.size() == strides.size());
+    element_size =
+        std::accumulate(lens.begin(), lens.end(), vector_length, std::multiplies<std::size_t>());
+
+    element_space = vector_length;
+    for(std::size_t i = 0; i < lens.size(); ++i)
+        element_space += (lens[i] - 1) * strides[i];
+}
+
+TensorDescriptor::TensorDescriptor() {}
+
+TensorDescriptor::TensorDescriptor(miopenDataType_t t) : type(t) {}
 
 // The delegation constructor should be placed above the target constructor in the
 // code for better dependency tracking
@@ -192,7 +214,7 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
                                    const std::vector<std::size_t>& lens_in,
                                    const std::vector<std::size_t>& strides_in,
                                    bool use_strides)
-    : lens(lens_in), type(t), tensorLayout(layout_in)
+    : type(t), tensorLayout(layout_in)
 {
     if(!IsDataTypeSupported(t))
         MIOPEN_THROW(miopenStatusBadParm, "Unsupported data type");
@@ -208,6 +230,9 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
 
     this->CalculateVectorLength();
 
+    auto g  = std::make_shared<Geometry>();
+    g->lens = lens_in;
+
     if(use_strides)
     {
         if(lens_in.size() != strides_in.size())
@@ -216,35 +241,40 @@ TensorDescriptor::TensorDescriptor(miopenDataType_t t,
         if(!CheckLengths(strides_in))
             MIOPEN_THROW(miopenStatusBadParm, "Strides must be > 0");
 
-        strides = strides_in;
-        packed  = (this->GetElementSize() == this->GetElementSpace());
+        g->strides = strides_in;
+        g->CalculateDerived(vector_length);
+        g->packed = (g->element_size == g->element_space);
     }
     else
     {
-        packed = true;
         // Since strides is not passed it is computed based on tensorLayout.
-        SetStrideNd(GetLayout_str());
+        SetStrideNd(*g, GetLayout_str());
+        g->CalculateDerived(vector_length);
+        g->packed = true;
     }
+
+    geometry = std::move(g);
 }
-void TensorDescriptor::SetStrideNd(const std::string& layout)
+
+void TensorDescriptor::SetStrideNd(Geometry& g, const std::string& layout) const
 {
     std::string default_layout = miopen::tensor_layout_get_default(layout.size());
     if(layout == default_layout)
     {
-        CalculateStrides();
+        CalculateStrides(g);
     }
     else if(layout.find('c') != std::string::npos)
     {
-        LensReorder(layout);
-        CalculateStrides();
+        LensReorder(g, layout);
+        CalculateStrides(g);
     }
     else
     {
-        miopen::tensor_layout_to_strides(lens, default_layout, layout, strides);
+        miopen::tensor_layout_to_strides(g.lens, default_layout, layout, g.strides);
     }
 }
 
-void TensorDescriptor::LensReorder(const std::string& layout)
+void TensorDescriptor::LensReorder(Geometry& g, const std::string& layout) const
 {
     if(layout == "NCHWc")
     {
@@ -252,7 +282,7 @@ void TensorDescriptor::LensReorder(const std::string& layout)
     }
     else if(layout == "CHWNc")
     {
-        ReorderVector(lens, {1, 2, 3, 0});
+        ReorderVector(g.lens, {1, 2, 3, 0});
     }
     else
     {
@@ -287,8 +317,10 @@ TensorDescriptor TensorDescriptor::MakeDescriptor(miopenDataType_t t,
     return {t, std::vector<int>(plens, plens + size), std::vector<int>(pstrides, pstrides + size)};
 }
 
-void TensorDescriptor::CalculateStrides()
+void TensorDescriptor::CalculateStrides(Geometry& g) const
 {
+    auto& lens    = g.lens;
+    auto& strides = g.strides;
     if(lens.empty())
         MIOPEN_THROW(miopenStatusInternalError, "lens must be non-empty");
     strides.clear();
@@ -320,20 +352,20 @@ void TensorDescriptor::CalculateVectorLength()
 
 bool TensorDescriptor::IsVectorized() const { return vector_length > 1; }
 
-const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return lens; }
+const std::vector<std::size_t>& TensorDescriptor::GetLengths() const { return geometry->lens; }
 
-const std::vector<std::size_t>& TensorDescriptor::GetStrides() const { return strides; }
+const std::vector<std::size_t>& TensorDescriptor::GetStrides() const { return geometry->strides; }
 
 int TensorDescriptor::GetSize() const
 {
-    assert(lens.size() == strides.size());
-    return lens.size();
+    assert(geometry->lens.size() == geometry->strides.size());
+    return geometry->lens.size();
 }
 
 std::size_t TensorDescriptor::GetElementSize() const
 {
-    assert(lens.size() == strides.size());
-    return std::accumulate(lens.begin(), lens.end(), vector_length, std::multiplies<std::size_t>());
+    assert(geometry->lens.size() == geometry->strides.size());
+    return geometry->element_size;
 }
 
 miopenDataType_t TensorDescriptor::GetType() const { return this->type; }
@@ -361,16 +393,16 @@ std::size_t TensorDescriptor::GetVectorLength() const { return this->vector_leng
 
 std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
 {
+    const auto& strides = geometry->strides;
+    const auto idx      = l.begin();
+
     // l is in NCHW order (MIOpen implicit logic)
-    if(this->GetLayout_str() == "CHWNc")
+    if(tensorLayout == miopenTensorCHWNc4 || tensorLayout == miopenTensorCHWNc8)
     {
         assert(l.size() - 1 <= this->GetSize());
-        std::initializer_list<int> l_chwn{
-            *(l.begin()), *(l.begin() + 2), *(l.begin() + 3), *(l.begin() + 4), *(l.begin() + 1)};
-        return std::inner_product(l_chwn.begin() + 1,
-                                  l_chwn.end(),
-                                  strides.begin(),
-                                  static_cast<std::size_t>(*(l_chwn.begin())));
+        // The vector element goes first, then the indices are taken in CHWN order.
+        return static_cast<std::size_t>(idx[0]) + idx[2] * strides[0] + idx[3] * strides[1] +
+               idx[4] * strides[2] + idx[1] * strides[3];
     }
     else
     {
@@ -383,29 +415,18 @@ std::size_t TensorDescriptor::GetIndex(std::initializer_list<int> l) const
         {
             assert(l.size() - 1 <= this->GetSize());
             return std::inner_product(
-                l.begin() + 1, l.end(), strides.begin(), static_cast<std::size_t>(*(l.begin())));
+                l.begin() + 1, l.end(), strides.begin(), static_cast<std::size_t>(idx[0]));
         }
     }
 }
 
-std::size_t TensorDescriptor::GetElementSpace() const
-{
-    std::vector<std::size_t> maxIndices(lens.size());
-    std::transform(lens.begin(),
-                   lens.end(),
-                   std::vector<std::size_t>(lens.size(), 1).begin(),
-                   maxIndices.begin(),
-                   std::minus<std::size_t>());
-    return std::inner_product(
-               maxIndices.begin(), maxIndices.end(), strides.begin(), std::size_t{0}) +
-           vector_length;
-}
+std::size_t TensorDescriptor::GetElementSpace() const { return geometry->element_space; }
 
 bool TensorDescriptor::IsPossibleLayout(const std::string& labels, const std::string& layout) const
 {
     std::vector<size_t> derived_strides;
-    tensor_layout_to_strides(lens, labels, layout, derived_strides);
-    return derived_strides == strides;
+    tensor_layout_to_strides(geometry->lens, labels, layout, derived_strides);
+    return derived_strides == geometry->strides;
 }
 
 std::size_t TensorDescriptor::GetNumBytes() const
@@ -414,12 +435,18 @@ std::size_t TensorDescriptor::GetNumBytes() const
     return typesize * this->GetElementSpace();
 }
 
-bool TensorDescriptor::IsPacked() const { return this->packed; }
+bool TensorDescriptor::IsPacked() const { return geometry->packed; }
 
 bool TensorDescriptor::operator==(const TensorDescriptor& rhs) const
 {
-    assert(this->lens.size() == rhs.strides.size());
-    return this->type == rhs.type && this->lens == rhs.lens && this->strides == rhs.strides;
+    if(this->type != rhs.type)
+        return false;
+    // Copies share the geometry.
+    if(this->geometry == rhs.geometry)
+        return true;
+    assert(this->geometry->lens.size() == rhs.geometry->strides.size());
+    return this->geometry->lens == rhs.geometry->lens &&
+           this->geometry->strides == rhs.geometry->strides;
 }
 
 bool TensorDescriptor::operator!=(const TensorDescriptor& rhs) const { return !(*this == rhs); }
@@ -439,9 +466,9 @@ bool TensorDescriptor::operator>(const TensorDescriptor& rhs) const
 std::string TensorDescriptor::ToString() const
 {
     std::string result;
-    if(this->lens.empty())
+    if(this->geometry->lens.empty())
         return result;
-    for(auto i : this->lens)
+    for(auto i : this->geometry->lens)
     {
         result += std::to_string(i) + ", ";
     }
@@ -450,9 +477,9 @@ std::string TensorDescriptor::ToString() const
 
 std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t)
 {
-    LogRange(stream << "{", t.lens, ", ") << "}, ";
-    LogRange(stream << "{", t.strides, ", ") << "}, ";
-    if(t.packed)
+    LogRange(stream << "{", t.geometry->lens, ", ") << "}, ";
+    LogRange(stream << "{", t.geometry->strides, ", ") << "}, ";
+    if(t.geometry->packed)
         stream << "packed"
                << ", ";
 
@@ -462,19 +489,22 @@ std::ostream& operator<<(std::ostream& stream, const TensorDescriptor& t)
 void to_json(nlohmann::json& j, const TensorDescriptor& descriptor)
 {
     j = nlohmann::json{
-        {"lengths", descriptor.lens},
-        {"strides", descriptor.strides},
-        {"packed", descriptor.packed},
+        {"lengths", descriptor.geometry->lens},
+        {"strides", descriptor.geometry->strides},
+        {"packed", descriptor.geometry->packed},
         {"type", descriptor.type},
     };
 }
 
 void from_json(const nlohmann::json& j, TensorDescriptor& descriptor)
 {
-    j.at("lengths").get_to(descriptor.lens);
-    j.at("strides").get_to(descriptor.strides);
-    j.at("packed").get_to(descriptor.packed);
+    auto g = std::make_shared<TensorDescriptor::Geometry>();
+    j.at("lengths").get_to(g->lens);
+    j.at("strides").get_to(g->strides);
+    g->CalculateDerived(descriptor.vector_length);
+    j.at("packed").get_to(g->packed);
     j.at("type").get_to(descriptor.type);
+    descriptor.geometry = std::move(g);
 }
 
 } // namespace miopen
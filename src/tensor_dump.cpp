@@ -0,0 +1,301 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tensor_dump.hpp>
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/datatype.hpp>
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/bz2.hpp>
+#endif
+
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_EVERY_N)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_MAX_COUNT)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_QUEUE_MB)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DUMP_TENSOR_COMPRESS)
+
+namespace {
+
+struct TensorDump
+{
+    std::string filename;
+    std::string header;
+    std::vector<char> data;
+};
+
+// Writes queued dumps on its own thread. Staging buffers go back to a free list once
+// written, so steady-state dumping does not allocate.
+struct TensorDumpWriter
+{
+    static TensorDumpWriter& Instance()
+    {
+        static TensorDumpWriter writer;
+        return writer;
+    }
+
+    TensorDumpWriter(const TensorDumpWriter&) = delete;
+    TensorDumpWriter& operator=(const TensorDumpWriter&) = delete;
+
+    ~TensorDumpWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        changed.notify_all();
+        thread.join();
+    }
+
+    // Waits for room in the queue, then hands out a buffer of the given size.
+    std::vector<char> Stage(std::size_t size)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return pending_bytes == 0 || pending_bytes + size <= limit; });
+        pending_bytes += size;
+
+        std::vector<char> buffer;
+        if(!free_buffers.empty())
+        {
+            buffer = std::move(free_buffers.back());
+            free_buffers.pop_back();
+        }
+        buffer.resize(size);
+        return buffer;
+    }
+
+    // Returns a staged buffer that will not be written.
+    void Release(std::vector<char> buffer)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            Recycle(std::move(buffer));
+        }
+        changed.notify_all();
+    }
+
+    void Push(TensorDump dump)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(std::move(dump));
+        }
+        changed.notify_all();
+    }
+
+    void Flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return pending_bytes == 0; });
+    }
+
+private:
+    TensorDumpWriter()
+        : limit(std::max<std::size_t>(miopen::Value(MIOPEN_DUMP_TENSOR_QUEUE_MB{}, 256), 1)
+                << 20),
+          compress(miopen::IsEnabled(MIOPEN_DUMP_TENSOR_COMPRESS{})),
+          thread([this] { Run(); })
+    {
+    }
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while(true)
+        {
+            changed.wait(lock, [&] { return stop || !queue.empty(); });
+            if(queue.empty())
+                return;
+
+            auto dump = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            Write(dump);
+            lock.lock();
+
+            Recycle(std::move(dump.data));
+            changed.notify_all();
+        }
+    }
+
+    void Recycle(std::vector<char> buffer)
+    {
+        pending_bytes -= buffer.size();
+        if(free_buffers.size() < max_free_buffers)
+            free_buffers.push_back(std::move(buffer));
+    }
+
+    void Write(const TensorDump& dump) const
+    {
+        auto filename           = dump.filename;
+        const char* bytes       = dump.data.data();
+        auto size               = dump.data.size();
+        std::string compression = "none";
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+        std::string compressed;
+        if(compress)
+        {
+            bool is_compressed = false;
+            compressed = miopen::compress({dump.data.begin(), dump.data.end()}, &is_compressed);
+            if(is_compressed)
+            {
+                filename += ".bz2";
+                bytes       = compressed.data();
+                size        = compressed.size();
+                compression = "bz2";
+            }
+        }
+#endif
+
+        std::ofstream file_stream(filename, std::ios::binary);
+        if(!file_stream.is_open())
+        {
+            MIOPEN_LOG_E("Cannot write to file : " << filename);
+            return;
+        }
+        file_stream.write(bytes, size);
+
+        std::ofstream header_stream(dump.filename + ".txt");
+        header_stream << dump.header << "compression=" << compression << std::endl;
+
+        MIOPEN_LOG_I("Dumping tensor to file : " << filename);
+    }
+
+    static constexpr std::size_t max_free_buffers = 8;
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<TensorDump> queue;
+    std::vector<std::vector<char>> free_buffers;
+    std::size_t pending_bytes = 0;
+    const std::size_t limit;
+    const bool compress;
+    bool stop = false;
+    std::thread thread;
+};
+
+std::string MakeTensorDumpHeader(const TensorDescriptor& tDesc)
+{
+    const auto join = [](const std::vector<std::size_t>& values) {
+        std::ostringstream ss;
+        for(std::size_t i = 0; i < values.size(); ++i)
+            ss << (i == 0 ? "" : ",") << values[i];
+        return ss.str();
+    };
+
+    std::ostringstream ss;
+    ss << "type=" << GetDataType(tDesc.GetType()) << std::endl
+       << "lengths=" << join(tDesc.GetLengths()) << std::endl
+       << "strides=" << join(tDesc.GetStrides()) << std::endl
+       << "bytes=" << tDesc.GetNumBytes() << std::endl;
+    return ss.str();
+}
+
+} // namespace
+
+bool TensorDumpSelected()
+{
+    static std::atomic<std::size_t> triggers{0};
+    static std::atomic<std::size_t> selected{0};
+
+    const auto every_n = std::max<std::size_t>(miopen::Value(MIOPEN_DUMP_TENSOR_EVERY_N{}, 1), 1);
+    const std::size_t max_count = miopen::Value(MIOPEN_DUMP_TENSOR_MAX_COUNT{});
+
+    if(triggers++ % every_n != 0)
+        return false;
+    return max_count == 0 || selected++ < max_count;
+}
+
+void DumpTensorToFileAsync(const Handle& handle,
+                           const TensorDescriptor& tDesc,
+                           ConstData_t dData,
+                           const std::string& filename)
+{
+    if(dData == nullptr)
+    {
+        MIOPEN_LOG_E("Dereferencing nullptr when trying to dump tensor from gpu");
+        return;
+    }
+    namespace fs = boost::filesystem;
+
+    fs::path file_name_with_path(filename);
+    fs::path path = file_name_with_path.parent_path();
+
+    // dump to current folder if full path not provided.
+    if(path.empty())
+    {
+        path                = fs::current_path();
+        file_name_with_path = path / file_name_with_path; // append paths
+    }
+    if(!fs::exists(path))
+    {
+        MIOPEN_LOG_E("Directory does not exists : " << path);
+        return;
+    }
+
+    auto& writer = TensorDumpWriter::Instance();
+
+    // read tensor data from gpu
+    TensorDump dump;
+    dump.filename = file_name_with_path.string();
+    dump.header   = MakeTensorDumpHeader(tDesc);
+    dump.data     = writer.Stage(tDesc.GetNumBytes());
+    MIOPEN_LOG_I2("Start bringing tensor from device to host");
+    try
+    {
+        handle.ReadTo(dump.data.data(), dData, dump.data.size());
+    }
+    catch(...)
+    {
+        writer.Release(std::move(dump.data));
+        throw;
+    }
+    MIOPEN_LOG_I2("Done bringing tensor from device to host");
+
+    writer.Push(std::move(dump));
+}
+
+void FlushTensorDumps() { TensorDumpWriter::Instance().Flush(); }
+
+} // namespace miopen
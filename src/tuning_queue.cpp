@@ -0,0 +1,551 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/tuning_queue.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/context.hpp>
+#include <miopen/conv/data_invoke_params.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv/wrw_invoke_params.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/datatype.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/tensor_ops.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <tuple>
+
+namespace miopen {
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+using exclusive_lock = std::unique_lock<LockFile>;
+
+std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+
+LockFile& GetQueueLock(const fs::path& directory)
+{
+    return LockFile::Get(LockFilePath(directory / "queue").c_str());
+}
+
+std::vector<std::string> ReadLines(const fs::path& path)
+{
+    auto lines = std::vector<std::string>{};
+    std::ifstream file(path.string());
+    std::string line;
+    while(std::getline(file, line))
+    {
+        if(!line.empty())
+            lines.push_back(line);
+    }
+    return lines;
+}
+
+void AppendLine(const fs::path& path, const std::string& line)
+{
+    std::ofstream file(path.string(), std::ios::app);
+    file << line << std::endl;
+    if(!file)
+        MIOPEN_THROW("Cannot write to " + path.string());
+}
+
+std::string JobKey(const TuningJob& job)
+{
+    return job.solver + '\t' + std::to_string(job.slice) + '\t' + std::to_string(job.slices) +
+           '\t' + job.problem;
+}
+
+TuningJob ParseJob(const std::string& line)
+{
+    std::istringstream stream(line);
+    std::string id, slice, slices;
+
+    auto job = TuningJob{};
+    // The problem is the last field and takes the rest of the line.
+    if(!std::getline(stream, id, '\t') || !std::getline(stream, job.solver, '\t') ||
+       !std::getline(stream, slice, '\t') || !std::getline(stream, slices, '\t') ||
+       !std::getline(stream, job.problem))
+        MIOPEN_THROW("Invalid tuning job: " + line);
+
+    job.id     = std::stoull(id);
+    job.slice  = std::stoull(slice);
+    job.slices = std::stoull(slices);
+    return job;
+}
+
+struct SerializedConfig
+{
+    std::string value;
+    void Serialize(std::ostream& stream) const { stream << value; }
+};
+
+/// The context and the legacy problem with which solvers search and the perf-db stores configs.
+std::tuple<ExecutionContext, conv::ProblemDescription, ConvolutionDescriptor>
+MakeTuningProblem(Handle& handle, const std::string& serialized)
+{
+    const auto problem    = nlohmann::json::parse(serialized).get<Problem>();
+    const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+
+    auto ctx = ExecutionContext{&handle};
+    ctx.DetectRocm();
+
+    auto conv_problem = conv_desc.mode == miopenTranspose ? problem.MakeTransposed().AsConvolution()
+                                                          : problem.AsConvolution();
+    conv_problem.SetupFloats(ctx);
+    return {ctx, conv_problem, conv_desc};
+}
+
+Allocator::ManageDataPtr AllocateTensor(Handle& handle, const TensorDescriptor& descriptor)
+{
+    auto buffer = handle.Create(descriptor.GetElementSpace() * get_data_size(descriptor.GetType()));
+    visit_float(descriptor.GetType(), [&](auto as_float) {
+        const auto zero = as_float(0.f);
+        SetTensor(handle, descriptor, buffer.get(), &zero);
+    });
+    return buffer;
+}
+
+} // namespace
+
+std::ostream& operator<<(std::ostream& stream, const TuningJob& job)
+{
+    return stream << '#' << job.id << ' ' << job.solver << ' ' << job.slice + 1 << '/'
+                  << job.slices;
+}
+
+TuningCheckpoint::TuningCheckpoint(const fs::path& path_, std::size_t slice_, std::size_t slices_)
+    : path(path_), slice(slice_), slices(slices_)
+{
+    if(slices == 0 || slice >= slices)
+        MIOPEN_THROW(miopenStatusBadParm,
+                     "Invalid tuning slice " + std::to_string(slice) + " of " +
+                         std::to_string(slices));
+
+    // A line cut short by an interruption has no time and is dropped.
+    for(const auto& line : ReadLines(path))
+    {
+        const auto tab = line.rfind('\t');
+        if(tab == std::string::npos || tab + 1 == line.size())
+            continue;
+        try
+        {
+            times[line.substr(0, tab)] = std::stof(line.substr(tab + 1));
+        }
+        catch(const std::logic_error&)
+        {
+            MIOPEN_LOG_W("Invalid checkpoint line in " << path << ": " << line);
+        }
+    }
+}
+
+std::pair<std::size_t, std::size_t> TuningCheckpoint::GetRange(std::size_t total)
+{
+    const auto begin = total * slice / slices;
+    const auto end   = total * (slice + 1) / slices;
+    expected         = end - begin;
+    return {begin, end};
+}
+
+boost::optional<float> TuningCheckpoint::Find(const std::string& config) const
+{
+    const auto time = times.find(config);
+    if(time == times.end())
+        return boost::none;
+    return time->second;
+}
+
+void TuningCheckpoint::Record(const std::string& config, float time)
+{
+    times[config] = time;
+    std::ostringstream line;
+    line << config << '\t' << time;
+    AppendLine(path, line.str());
+}
+
+bool TuningCheckpoint::IsComplete() const { return expected && times.size() >= *expected; }
+
+boost::optional<std::pair<std::string, float>> TuningCheckpoint::GetBest() const
+{
+    auto best = boost::optional<std::pair<std::string, float>>{};
+    for(const auto& time : times)
+    {
+        if(time.second >= 0.0f && (!best || time.second < best->second))
+            best = time;
+    }
+    return best;
+}
+
+TuningQueue::TuningQueue(const fs::path& directory_, std::chrono::seconds lease_) : lease(lease_)
+{
+    fs::create_directories(directory_ / "checkpoints");
+    // The lock file is named after the path, which has to be the same for every worker.
+    directory = fs::canonical(directory_);
+}
+
+fs::path TuningQueue::CheckpointPath(std::size_t id) const
+{
+    return directory / "checkpoints" / std::to_string(id);
+}
+
+std::vector<TuningJobStatus> TuningQueue::ReadStatus(std::vector<std::time_t>& claimed) const
+{
+    auto status = std::vector<TuningJobStatus>{};
+    for(const auto& line : ReadLines(directory / "jobs"))
+    {
+        status.push_back({ParseJob(line)});
+        if(status.back().job.id != status.size() - 1)
+            MIOPEN_THROW("Tuning jobs out of order in " + (directory / "jobs").string());
+    }
+    claimed.assign(status.size(), 0);
+
+    for(const auto& line : ReadLines(directory / "log"))
+    {
+        const auto fields = SplitDelim(line, '\t');
+        if(fields.size() != 4)
+            MIOPEN_THROW("Invalid tuning log line: " + line);
+        const auto id = std::stoull(fields[1]);
+        if(id >= status.size())
+            MIOPEN_THROW("Tuning log line of an unknown job: " + line);
+
+        status[id].worker = fields[2];
+        if(fields[0] == "done")
+        {
+            status[id].state = TuningJobState::Done;
+        }
+        else if(status[id].state != TuningJobState::Done)
+        {
+            status[id].state = TuningJobState::Running;
+            claimed[id]      = static_cast<std::time_t>(std::stoll(fields[3]));
+        }
+    }
+    return status;
+}
+
+void TuningQueue::AppendEvent(const std::string& event, std::size_t id, const std::string& worker)
+{
+    if(worker.empty() || worker.find_first_of("\t\n") != std::string::npos)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid tuning worker name: " + worker);
+    AppendLine(directory / "log",
+               event + '\t' + std::to_string(id) + '\t' + worker + '\t' +
+                   std::to_string(std::time(nullptr)));
+}
+
+std::size_t TuningQueue::Enqueue(std::vector<TuningJob> jobs)
+{
+    auto& lock_file = GetQueueLock(directory);
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    if(!lock)
+        MIOPEN_THROW("Cannot lock the tuning queue " + directory.string());
+
+    auto claimed        = std::vector<std::time_t>{};
+    const auto existing = ReadStatus(claimed);
+    auto keys           = std::map<std::string, std::size_t>{};
+    for(const auto& status : existing)
+        keys.emplace(JobKey(status.job), status.job.id);
+
+    auto added = std::size_t{0};
+    for(auto& job : jobs)
+    {
+        if(job.problem.find_first_of("\t\n") != std::string::npos)
+            MIOPEN_THROW(miopenStatusBadParm, "The tuning job problem cannot contain tabs.");
+        if(!keys.emplace(JobKey(job), existing.size() + added).second)
+            continue;
+
+        job.id = existing.size() + added;
+        AppendLine(directory / "jobs",
+                   std::to_string(job.id) + '\t' + JobKey(job));
+        ++added;
+    }
+    return added;
+}
+
+boost::optional<TuningJob> TuningQueue::Claim(const std::string& worker)
+{
+    auto& lock_file = GetQueueLock(directory);
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    if(!lock)
+        MIOPEN_THROW("Cannot lock the tuning queue " + directory.string());
+
+    auto claimed      = std::vector<std::time_t>{};
+    const auto status = ReadStatus(claimed);
+    const auto now    = std::time(nullptr);
+
+    const auto is_expired = [&](std::size_t id) {
+        auto active           = claimed[id];
+        const auto checkpoint = CheckpointPath(id);
+        if(fs::exists(checkpoint))
+            active = std::max(active, fs::last_write_time(checkpoint));
+        return now - active >= lease.count();
+    };
+
+    auto chosen = boost::optional<std::size_t>{};
+    for(const auto& candidate : {TuningJobState::Pending, TuningJobState::Running})
+    {
+        for(const auto& job : status)
+        {
+            if(job.state != candidate)
+                continue;
+            if(candidate == TuningJobState::Running && job.worker != worker &&
+               !is_expired(job.job.id))
+                continue;
+            chosen = job.job.id;
+            break;
+        }
+        if(chosen)
+            break;
+    }
+    if(!chosen)
+        return boost::none;
+
+    if(status[*chosen].state == TuningJobState::Running)
+    {
+        MIOPEN_LOG_I("Taking over tuning job " << status[*chosen].job << " from "
+                                               << status[*chosen].worker);
+    }
+    AppendEvent("claim", *chosen, worker);
+    return status[*chosen].job;
+}
+
+void TuningQueue::Complete(const TuningJob& job, const std::string& worker)
+{
+    auto& lock_file = GetQueueLock(directory);
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    if(!lock)
+        MIOPEN_THROW("Cannot lock the tuning queue " + directory.string());
+    AppendEvent("done", job.id, worker);
+}
+
+std::vector<TuningJobStatus> TuningQueue::GetStatus() const
+{
+    auto claimed = std::vector<std::time_t>{};
+    auto status  = ReadStatus(claimed);
+    for(auto& job : status)
+        job.evaluated = OpenCheckpoint(job.job).Size();
+    return status;
+}
+
+std::vector<TuningResult> TuningQueue::GetResults() const
+{
+    // Keyed by solver and problem, in the order of the jobs.
+    auto results = std::vector<TuningResult>{};
+    auto indices = std::map<std::pair<std::string, std::string>, std::size_t>{};
+
+    for(const auto& status : GetStatus())
+    {
+        const auto key   = std::make_pair(status.job.solver, status.job.problem);
+        const auto index = indices.emplace(key, results.size());
+        if(index.second)
+            results.push_back({status.job.solver, status.job.problem});
+        auto& result = results[index.first->second];
+
+        if(status.state != TuningJobState::Done)
+            ++result.slices_left;
+
+        const auto best = OpenCheckpoint(status.job).GetBest();
+        if(best && (result.config.empty() || best->second < result.time))
+        {
+            result.config = best->first;
+            result.time   = best->second;
+        }
+    }
+
+    results.erase(std::remove_if(results.begin(),
+                                 results.end(),
+                                 [](const auto& result) { return result.config.empty(); }),
+                  results.end());
+    return results;
+}
+
+TuningCheckpoint TuningQueue::OpenCheckpoint(const TuningJob& job) const
+{
+    return {CheckpointPath(job.id), job.slice, job.slices};
+}
+
+bool SearchesInSlices(const std::string& solver)
+{
+    return solver != solver::ConvOclDirectFwd{}.SolverDbId() &&
+           solver != solver::ConvOclDirectFwd1x1{}.SolverDbId();
+}
+
+std::vector<TuningJob> MakeTuningJobs(Handle& handle, const Problem& problem, std::size_t slices)
+{
+    if(slices == 0)
+        MIOPEN_THROW(miopenStatusBadParm, "A tuning job needs at least one slice.");
+
+    const auto serialized = nlohmann::json(problem).dump();
+    const auto tuning     = MakeTuningProblem(handle, serialized);
+    const auto ctx        = ConvolutionContext{std::get<0>(tuning)};
+    const auto legacy     = ProblemDescription{std::get<1>(tuning)};
+
+    auto jobs = std::vector<TuningJob>{};
+    for(const auto& id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+    {
+        const auto solver = id.GetSolver();
+        if(solver.IsEmpty() || !solver.IsTunable() || !solver.IsApplicable(ctx, legacy))
+            continue;
+
+        const auto& db_id = solver.GetSolverDbId();
+        const auto count  = SearchesInSlices(db_id) ? slices : 1;
+        for(auto slice = std::size_t{0}; slice < count; ++slice)
+            jobs.push_back({0, db_id, serialized, slice, count});
+    }
+    return jobs;
+}
+
+bool RunTuningJob(Handle& handle, const TuningJob& job, TuningCheckpoint& checkpoint)
+{
+    // The first slice of such a solver runs the whole search.
+    if(job.slice != 0 && !SearchesInSlices(job.solver))
+    {
+        MIOPEN_LOG_I("Tuning job " << job << ": searched by the first slice, complete");
+        return true;
+    }
+
+    auto tuning                = MakeTuningProblem(handle, job.problem);
+    auto& exec_ctx             = std::get<0>(tuning);
+    const auto& problem        = std::get<1>(tuning);
+    const auto& conv_desc      = std::get<2>(tuning);
+    exec_ctx.do_search         = true;
+    exec_ctx.db_update         = true;
+    exec_ctx.search_checkpoint = &checkpoint;
+
+    const auto ctx    = ConvolutionContext{exec_ctx};
+    const auto legacy = ProblemDescription{problem};
+    const auto solver = solver::Id{job.solver}.GetSolver();
+    if(solver.IsEmpty() || !solver.IsApplicable(ctx, legacy))
+        MIOPEN_THROW(miopenStatusNotImplemented,
+                     job.solver + " is not applicable to the problem of tuning job " +
+                         std::to_string(job.id));
+
+    const auto in  = AllocateTensor(handle, problem.GetIn());
+    const auto w   = AllocateTensor(handle, problem.GetWeights());
+    const auto out = AllocateTensor(handle, problem.GetOut());
+
+    const auto workspace_size = conv_desc.GetWorkSpaceSize(exec_ctx, problem);
+    const auto workspace      = workspace_size != 0 ? handle.Create(workspace_size) : nullptr;
+
+    const auto invoke_ctx = [&]() -> AnyInvokeParams {
+        switch(problem.GetDirection())
+        {
+        case conv::Direction::Forward:
+        case conv::Direction::BackwardData: {
+            const auto fp16alt = problem.GetDirection() == conv::Direction::Forward
+                                     ? conv_desc.attribute.gfx90aFp16alt.GetFwd()
+                                     : conv_desc.attribute.gfx90aFp16alt.GetBwd();
+            return conv::DataInvokeParams{InvokeType::Evaluate,
+                                          {problem.GetIn(),
+                                           in.get(),
+                                           problem.GetWeights(),
+                                           w.get(),
+                                           problem.GetOut(),
+                                           out.get()},
+                                          workspace.get(),
+                                          workspace_size,
+                                          fp16alt};
+        }
+        case conv::Direction::BackwardWeights:
+            return conv::WrWInvokeParams{InvokeType::Evaluate,
+                                         {problem.GetIn(),
+                                          in.get(),
+                                          problem.GetOut(),
+                                          out.get(),
+                                          problem.GetWeights(),
+                                          w.get()},
+                                         workspace.get(),
+                                         workspace_size,
+                                         conv_desc.attribute.gfx90aFp16alt.GetWrW()};
+        }
+        MIOPEN_THROW(miopenStatusInternalError);
+    }();
+
+    // The best config of a slice is not the best of the problem, so it goes to a scratch perf-db.
+    const auto scratch = fs::temp_directory_path() / fs::unique_path("miopen-tuning-%%%%-%%%%");
+    fs::create_directories(scratch);
+    auto complete = false;
+    {
+        auto db     = PerformanceDb{"", (scratch / "slice.udb").string()};
+        std::ignore = solver.FindSolution(ctx, legacy, db, invoke_ctx);
+
+        // Solvers that search without GenericSearch ignore the slices. The first slice keeps the
+        // config they found, without a time.
+        complete = checkpoint.IsComplete() || !checkpoint.IsSliced();
+        if(!checkpoint.IsSliced() && job.slice == 0)
+            checkpoint.Record(solver.GetPerfCfgParams(ctx, legacy, db), 0.0f);
+    }
+    fs::remove_all(scratch);
+
+    MIOPEN_LOG_I("Tuning job " << job << ": " << checkpoint.Size() << " configs evaluated"
+                               << (complete ? ", complete" : ""));
+    return complete;
+}
+
+std::size_t StoreTuningResults(Handle& handle, const std::vector<TuningResult>& results)
+{
+    auto stored = std::size_t{0};
+    for(const auto& result : results)
+    {
+        const auto tuning = MakeTuningProblem(handle, result.problem);
+        const auto ctx    = ConvolutionContext{std::get<0>(tuning)};
+        const auto legacy = ProblemDescription{std::get<1>(tuning)};
+        const auto solver = solver::Id{result.solver}.GetSolver();
+
+        if(solver.IsEmpty() || !solver.TestPerfCfgParams(ctx, legacy, result.config))
+        {
+            MIOPEN_LOG_W("Tuning result not stored, invalid for this device: "
+                         << result.solver << ": " << result.config);
+            continue;
+        }
+
+        auto db = GetDb(std::get<0>(tuning));
+        if(db.Update(legacy, result.solver, SerializedConfig{result.config}))
+            ++stored;
+    }
+    return stored;
+}
+
+} // namespace miopen
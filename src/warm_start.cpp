@@ -0,0 +1,230 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/warm_start.hpp>
+
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/timer.hpp>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace miopen {
+
+namespace {
+
+struct WarmStartItem
+{
+    conv::ProblemDescription problem;
+    solver::ConvSolution solution;
+};
+
+boost::optional<WarmStartItem>
+Resolve(Handle& handle, const Problem& problem, WarmStartLayer& layer)
+{
+    const auto& conv_desc = boost::get<ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+
+    auto ctx = ExecutionContext{&handle};
+    ctx.DetectRocm();
+    ctx.do_search              = false;
+    ctx.disable_search_enforce = true;
+
+    auto conv_problem = conv_desc.mode == miopenTranspose ? problem.MakeTransposed().AsConvolution()
+                                                          : problem.AsConvolution();
+    conv_problem.SetupFloats(ctx);
+
+    auto fallback        = false;
+    const auto solutions = conv_desc.GetSolutions(ctx, conv_problem, 1, &fallback);
+    if(solutions.empty())
+        MIOPEN_THROW(miopenStatusNotImplemented, "No applicable solution.");
+
+    layer.solver      = solver::Id{solutions.front().solution_id};
+    layer.find_db_hit = !fallback;
+
+    if(handle.GetInvoker(conv_problem.BuildConfKey(), layer.solver))
+        return boost::none;
+
+    const auto legacy_ctx     = ConvolutionContext{ctx};
+    const auto legacy_problem = ProblemDescription{conv_problem};
+    auto db                   = GetDb(ctx);
+    auto solution = layer.solver.GetSolver().FindSolution(legacy_ctx, legacy_problem, db, {});
+    if(!solution.Succeeded() || !solution.invoker_factory)
+        MIOPEN_THROW(miopenStatusInternalError, "The solution has no invoker.");
+
+    return WarmStartItem{conv_problem, std::move(solution)};
+}
+
+void Fail(WarmStartLayer& layer, std::size_t index, const std::string& error)
+{
+    layer.error = error;
+    MIOPEN_LOG_W("Layer " << index << " cannot be warmed up: " << error);
+}
+
+/// Builds the programs of all the layers in parallel, each program shared by layers only once.
+/// A program that fails to build fails the layers using it, and only them.
+void Compile(const Handle& handle,
+             std::vector<boost::optional<WarmStartItem>>& items,
+             std::vector<WarmStartLayer>& layers)
+{
+    struct Build
+    {
+        const solver::KernelInfo* kernel;
+        std::vector<std::size_t> layers;
+        Program program;
+        std::string error;
+    };
+
+    auto builds = std::vector<Build>{};
+    auto seen   = std::map<std::pair<std::string, std::string>, std::size_t>{};
+    for(std::size_t i = 0; i < items.size(); ++i)
+    {
+        if(!items[i])
+            continue;
+        for(const auto& kernel : items[i]->solution.construction_params)
+        {
+            if(handle.HasProgram(kernel.kernel_file, kernel.comp_options))
+                continue;
+            const auto key      = std::make_pair(kernel.kernel_file, kernel.comp_options);
+            const auto inserted = seen.emplace(key, builds.size());
+            if(inserted.second)
+                builds.push_back({&kernel, {}, {}, {}});
+            builds[inserted.first->second].layers.push_back(i);
+        }
+    }
+
+    // Exceptions must not leave the worker threads.
+    par_for_strided(builds.size(), max_threads{solver::GetTuningThreadsMax()}, [&](auto i) {
+        auto& build        = builds[i];
+        const auto& kernel = *build.kernel;
+        try
+        {
+            build.program = handle.LoadProgram(kernel.kernel_file, kernel.comp_options, false, "");
+        }
+        catch(const std::exception& ex)
+        {
+            build.error = ex.what();
+        }
+    });
+
+    auto failed = std::vector<std::size_t>{};
+    for(const auto& build : builds)
+    {
+        if(build.error.empty())
+        {
+            handle.AddProgram(build.program, build.kernel->kernel_file, build.kernel->comp_options);
+            continue;
+        }
+        for(const auto i : build.layers)
+        {
+            if(layers[i].error.empty())
+                Fail(layers[i], i, build.error);
+            failed.push_back(i);
+        }
+    }
+    for(const auto i : failed)
+        items[i] = boost::none;
+}
+
+} // namespace
+
+WarmStartReport WarmStart(Handle& handle, const std::vector<Problem>& problems)
+{
+    auto report = WarmStartReport{};
+    report.layers.resize(problems.size());
+
+    Timer total;
+    total.start();
+
+    // Invokers can only be registered in the handle one at a time, so only the compilation, which
+    // dominates, runs in parallel across the layers.
+    auto items = std::vector<boost::optional<WarmStartItem>>(problems.size());
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        Timer timer;
+        timer.start();
+        try
+        {
+            items[i] = Resolve(handle, problems[i], report.layers[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            Fail(report.layers[i], i, ex.what());
+        }
+        report.layers[i].resolve_ms = timer.elapsed_ms();
+    }
+
+    {
+        Timer timer;
+        timer.start();
+        Compile(handle, items, report.layers);
+        report.compile_ms = timer.elapsed_ms();
+    }
+
+    // The solutions built by Resolve() are reused, their programs are in the handle by now.
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        if(!items[i])
+            continue;
+
+        Timer timer;
+        timer.start();
+        try
+        {
+            const auto& item   = *items[i];
+            const auto& solver = report.layers[i].solver;
+            const auto invoker = handle.PrepareInvoker(*item.solution.invoker_factory,
+                                                       item.solution.construction_params);
+            handle.RegisterInvoker(invoker,
+                                   item.problem.BuildConfKey(),
+                                   solver.ToString(),
+                                   AlgorithmName{solver.GetAlgo(item.problem.GetDirection())});
+        }
+        catch(const std::exception& ex)
+        {
+            Fail(report.layers[i], i, ex.what());
+        }
+        report.layers[i].prepare_ms = timer.elapsed_ms();
+    }
+
+    report.total_ms = total.elapsed_ms();
+    MIOPEN_LOG_I("Warmed up " << problems.size() << " layers in " << report.total_ms << " ms, "
+                              << report.compile_ms << " ms compiling");
+    return report;
+}
+
+} // namespace miopen
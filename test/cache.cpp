@@ -28,6 +28,7 @@
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
 
+#include <miopen/content_hash.hpp>
 #include <miopen/md5.hpp>
 #include "test.hpp"
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -150,10 +151,25 @@ void check_cache_str()
     CHECK(p.filename().string() == name + ".o");
 }
 
+void check_content_hash()
+{
+    CHECK(miopen::xxh64("", 0) == 0xef46db3751d8e999ULL);
+    CHECK(miopen::xxh64("abc", 3) == 0x44bc2cf5ad770999ULL);
+    CHECK(miopen::ContentHash("abc") == "xxh64_44bc2cf5ad770999");
+
+    const std::string blob(100000, 'x');
+    CHECK(miopen::VerifyContentHash(blob, miopen::ContentHash(blob)));
+    // kernel hashes written before the tag was introduced are plain md5
+    CHECK(miopen::VerifyContentHash(blob, miopen::md5(blob)));
+    CHECK(!miopen::VerifyContentHash(blob + "y", miopen::ContentHash(blob)));
+    CHECK(!miopen::VerifyContentHash(blob + "y", miopen::md5(blob)));
+}
+
 int main()
 {
     check_cache_file();
     check_cache_str();
+    check_content_hash();
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
     check_bz2_compress();
     check_bz2_decompress();
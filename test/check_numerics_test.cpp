@@ -72,6 +72,11 @@ struct check_numeric_normal : check_numerics_base<T>
                                          this->desc,
                                          this->buffer.get(),
                                          false));
+
+        miopen::CheckNumericsBatch checks(this->h, miopen::CheckNumerics::Throw);
+        checks.Input(this->desc, this->buffer.get());
+        checks.Output(this->desc, this->buffer.get());
+        CHECK(!checks.Collect());
     }
 };
 
@@ -125,6 +130,30 @@ struct check_numeric_abnormal : check_numerics_base<T>
                                       this->buffer.get(),
                                       false);
         }));
+
+        miopen::CheckNumericsBatch checks(this->h, miopen::CheckNumerics::Warn);
+        checks.Input(this->desc, this->buffer.get());
+        checks.Output(this->desc, this->buffer.get());
+        CHECK(checks.Collect());
+
+        // A deferred check only throws once a later readback on the handle reports it.
+        miopen::CheckNumericsBatch deferred(
+            this->h, miopen::CheckNumerics::Throw | miopen::CheckNumerics::Deferred);
+        deferred.Input(this->desc, this->buffer.get());
+        CHECK(!deferred.Collect());
+        CHECK(throws([&] {
+            miopen::checkNumericsImpl(
+                this->h, miopen::CheckNumerics::Warn, this->desc, this->buffer.get(), true);
+        }));
+
+        // Finishing the handle reports every pending check and leaves none behind.
+        miopen::CheckNumericsBatch finished(
+            this->h, miopen::CheckNumerics::Throw | miopen::CheckNumerics::Deferred);
+        finished.Input(this->desc, this->buffer.get());
+        finished.Output(this->desc, this->buffer.get());
+        CHECK(!finished.Collect());
+        CHECK(throws([&] { this->h.Finish(); }));
+        this->h.Finish();
     }
 };
 
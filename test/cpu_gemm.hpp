@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_GEMM_HPP
+#define GUARD_CPU_GEMM_HPP
+
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace cpu_gemm_detail {
+
+// Tile of C owned by one task. The depth block keeps the slice of B that the rows of a
+// tile walk over resident in cache.
+constexpr std::size_t row_block   = 16;
+constexpr std::size_t col_block   = 128;
+constexpr std::size_t depth_block = 128;
+
+// Below this many multiply-adds spawning threads costs more than it saves.
+constexpr std::size_t min_parallel_work = std::size_t{1} << 18;
+
+// Copies the transpose of a (cols x rows) matrix into a dense row-major (rows x cols) one.
+template <typename T>
+std::vector<T> transpose(const T* x, std::size_t ld, std::size_t rows, std::size_t cols)
+{
+    std::vector<T> result(rows * cols);
+    miopen::par_for(rows, [&](std::size_t r) {
+        for(std::size_t c = 0; c < cols; ++c)
+            result[r * cols + c] = x[c * ld + r];
+    });
+    return result;
+}
+
+} // namespace cpu_gemm_detail
+
+/// Host reference for C = beta * C + alpha * op(A) * op(B), where op(A) is m x k and op(B)
+/// is k x n. Transposed operands are repacked row-major once, then C is computed in
+/// independent tiles spread over the host threads.
+///
+/// Every element of C is accumulated in Acc, over k in ascending order, exactly like the
+/// naive triple loop, so results do not depend on the blocking or on the thread count.
+template <typename T, typename Acc = double>
+void cpu_gemm(std::size_t m,
+              std::size_t n,
+              std::size_t k,
+              const T* a,
+              std::size_t lda,
+              bool transpose_a,
+              const T* b,
+              std::size_t ldb,
+              bool transpose_b,
+              T* c,
+              std::size_t ldc,
+              double d_alpha,
+              double d_beta)
+{
+    using namespace cpu_gemm_detail;
+
+    if(m == 0 || n == 0)
+        return;
+
+    const auto alpha = T(d_alpha);
+    const auto beta  = T(d_beta);
+
+    std::vector<T> a_packed;
+    std::vector<T> b_packed;
+    if(transpose_a)
+    {
+        a_packed = transpose(a, lda, m, k);
+        a        = a_packed.data();
+        lda      = k;
+    }
+    if(transpose_b)
+    {
+        b_packed = transpose(b, ldb, k, n);
+        b        = b_packed.data();
+        ldb      = n;
+    }
+
+    const auto row_tiles = (m + row_block - 1) / row_block;
+    const auto col_tiles = (n + col_block - 1) / col_block;
+
+    const auto tile = [&](std::size_t t) {
+        const auto i0   = (t / col_tiles) * row_block;
+        const auto j0   = (t % col_tiles) * col_block;
+        const auto rows = std::min(row_block, m - i0);
+        const auto cols = std::min(col_block, n - j0);
+
+        std::vector<Acc> acc(rows * cols, Acc(0));
+        for(std::size_t p0 = 0; p0 < k; p0 += depth_block)
+        {
+            const auto p1 = std::min(k, p0 + depth_block);
+            for(std::size_t i = 0; i < rows; ++i)
+            {
+                Acc* acc_row   = &acc[i * cols];
+                const T* a_row = &a[(i0 + i) * lda];
+                for(std::size_t p = p0; p < p1; ++p)
+                {
+                    const T a_ip   = a_row[p];
+                    const T* b_row = &b[p * ldb + j0];
+                    for(std::size_t j = 0; j < cols; ++j)
+                        acc_row[j] += a_ip * b_row[j];
+                }
+            }
+        }
+
+        for(std::size_t i = 0; i < rows; ++i)
+        {
+            T* c_row = &c[(i0 + i) * ldc + j0];
+            for(std::size_t j = 0; j < cols; ++j)
+                c_row[j] = beta * c_row[j] + alpha * acc[i * cols + j];
+        }
+    };
+
+    if(m * n * k < min_parallel_work)
+    {
+        for(std::size_t t = 0; t < row_tiles * col_tiles; ++t)
+            tile(t);
+    }
+    else
+    {
+        miopen::par_for(row_tiles * col_tiles, miopen::min_grain{1}, tile);
+    }
+}
+
+#endif
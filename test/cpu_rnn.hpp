@@ -0,0 +1,4478 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_CPU_RNN_HPP
+#define GUARD_CPU_RNN_HPP
+
+#include "cpu_gemm.hpp"
+
+#include <miopen/dropout.hpp>
+#include <miopen/miopen.h>
+#include <miopen/par_for.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+// Host references for the vanilla RNN, LSTM and GRU cells. The tests and MIOpenDriver both
+// verify against these loops, so a fix to one reference is a fix to both.
+
+#define RNN_MM_TRANSPOSE 1
+
+inline int sumvc(const std::vector<int>& x) { return std::accumulate(x.begin(), x.end(), 0); }
+
+template <typename T>
+inline T activfunc(T x, int actvf)
+{
+    T alpha = static_cast<T>(1), beta0 = static_cast<T>(0), beta1 = static_cast<T>(1);
+    if(actvf == 0)
+    {
+        return (x > 0) ? x : x * beta0;
+    }
+    else if(actvf == 2)
+    {
+        return static_cast<T>(1 / (1 + std::exp(-x)));
+    }
+    return static_cast<T>(alpha * std::tanh(beta1 * x));
+}
+
+template <typename T>
+inline T dervactivfunc(T x, int actvf)
+{
+    if(actvf == 0)
+    {
+        return static_cast<T>(x > 0 ? 1 : 0);
+    }
+    else if(actvf == 2)
+    {
+        return static_cast<T>(std::exp(-x) / (1 + std::exp(-x)) / (1 + std::exp(-x)));
+    }
+
+    return static_cast<T>(1 / std::cosh(x) / std::cosh(x));
+}
+
+template <typename Dtype>
+void RNN_mm_cpu(const Dtype* a_ptr,
+                size_t a_cols,
+                size_t a_rows,
+                size_t a_stride,
+                int a_flags,
+                const Dtype* b_ptr,
+                size_t b_cols,
+                size_t b_rows,
+                size_t b_stride,
+                int b_flags,
+                Dtype* c_ptr,
+                size_t c_cols,
+                size_t c_rows,
+                size_t c_stride,
+                int /*c_flags*/,
+                double d_alpha,
+                double d_beta)
+{
+    if((!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE) &&
+        ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
+       ((a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE) &&
+        ((a_rows != b_cols) || (a_cols != c_rows) || (b_rows != c_cols))) ||
+       ((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE) &&
+        ((a_rows != b_rows) || (a_cols != c_rows) || (b_cols != c_cols))) ||
+       (!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE) &&
+        ((a_cols != b_cols) || (a_rows != c_rows) || (b_rows != c_cols))))
+    {
+        std::cout << "MM_CPU ERROR: " << a_cols << ", " << a_rows << "   " << b_cols << ", "
+                  << b_rows << "   " << c_cols << ", " << c_rows << std::endl;
+        return;
+    }
+
+    size_t inner_loop = (!(a_flags & RNN_MM_TRANSPOSE)) ? a_cols : a_rows;
+    cpu_gemm(c_rows,
+             c_cols,
+             inner_loop,
+             a_ptr,
+             a_stride,
+             (a_flags & RNN_MM_TRANSPOSE) != 0,
+             b_ptr,
+             b_stride,
+             (b_flags & RNN_MM_TRANSPOSE) != 0,
+             c_ptr,
+             c_stride,
+             d_alpha,
+             d_beta);
+}
+
+/// Dropout applied between the layers of the reference RNNs. The tests and the driver each
+/// emulate the dropout kernels on their own, so the cell loops only go through these hooks.
+template <typename T>
+struct cpu_rnn_dropout
+{
+    /// Initial PRNG states of the dropout descriptor.
+    std::function<std::vector<prngStates>()> init_states;
+    /// Applies dropout to x, storing the result in y and the kept mask in reserve.
+    std::function<void(miopenTensorDescriptor_t x_desc,
+                       const std::vector<T>& x,
+                       miopenTensorDescriptor_t y_desc,
+                       std::vector<T>& y,
+                       std::vector<unsigned char>& reserve,
+                       std::vector<prngStates>& states,
+                       std::size_t x_offset,
+                       std::size_t y_offset,
+                       std::size_t reserve_offset)>
+        forward;
+    /// Propagates dy back through the mask in reserve into dx.
+    std::function<void(miopenTensorDescriptor_t dy_desc,
+                       const std::vector<T>& dy,
+                       miopenTensorDescriptor_t dx_desc,
+                       std::vector<T>& dx,
+                       std::vector<unsigned char>& reserve,
+                       std::size_t dx_offset,
+                       std::size_t dy_offset,
+                       std::size_t reserve_offset)>
+        backward;
+};
+
+/// Forward training pass of a vanilla RNN, squash selecting tanh over relu. in_n holds the
+/// batch size of every time step, hy_d is the number of layers times the number of directions
+/// and out_h is hy_h times the number of directions. inputMode 1 is SKIP_INPUT. Fills out_host,
+/// the final hidden state hy_host and the activations that rsvspace keeps for the backward pass.
+template <typename T>
+void cpu_rnn_forward(bool use_dropout,
+                     const cpu_rnn_dropout<T>& dropout,
+                     const std::vector<T>& in,
+                     const std::vector<T>& wei,
+                     std::vector<T>& hy_host,
+                     const std::vector<T>& hx,
+                     std::vector<T>& out_host,
+                     const std::vector<int>& in_n,
+                     int in_h,
+                     int seqLength,
+                     bool bidirection,
+                     bool biased,
+                     int hy_d,
+                     int hy_n,
+                     int hy_h,
+                     int out_h,
+                     int squash,
+                     int inputMode,
+                     std::vector<T>& rsvspace,
+                     bool hx_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int hy_stride  = hy_h * bi;
+    int out_stride = out_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_shift_bias = ((in_h + hy_h) * bi + (bi * hy_h + hy_h) * bi * (numlayer - 1)) * hy_h;
+
+    // initial dropoput
+    std::vector<prngStates> dropout_states_host;
+    std::vector<unsigned char> dropout_reservespace_host;
+    std::vector<T> dropout_hid_state;
+    miopenTensorDescriptor_t dropout_inputTensor{}, dropout_outputTensor{};
+    if(use_dropout)
+    {
+        dropout_states_host = dropout.init_states();
+
+        std::array<int, 2> drop_in_len  = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str  = {{hy_stride, 1}};
+        std::array<int, 2> drop_out_str = {{hy_h * bi, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenCreateTensorDescriptor(&dropout_outputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+        miopenSetTensorDescriptor(
+            dropout_outputTensor, miopenFloat, 2, drop_in_len.data(), drop_out_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(1));
+
+        dropout_hid_state = std::vector<T>((numlayer - 1) * batch_n * hy_h * bi, static_cast<T>(0));
+    }
+
+    // forward emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        int hid_shift = li * batch_n * hy_h * bi;
+        int hx_shift  = li * bi * in_n.at(0) * hy_h;
+
+        // from input
+        if(li == 0)
+        {
+            if(inputMode == 1)
+            {
+                // for(int bs = 0; bs < batch_n; bs++)
+                miopen::par_for(batch_n, 4, [&](int bs) {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        rsvspace.at(hid_shift + bs * hy_stride + h) += in.at(bs * in_stride + h);
+                        if(bidirection)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + hy_h + h) +=
+                                in.at(bs * in_stride + h);
+                        }
+                    }
+                });
+
+                // from bias
+                if(biased)
+                {
+                    // for(int bs = 0; bs < batch_n; bs++)
+                    miopen::par_for(batch_n, 4, [&](int bs) {
+                        for(int h = 0; h < hy_stride; h++)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias + h);
+                        }
+                    });
+                }
+            }
+            else
+            {
+                RNN_mm_cpu<T>(in.data(),
+                              in_h,
+                              batch_n,
+                              in_stride,
+                              0,
+                              wei.data(),
+                              in_h,
+                              hy_h * bi,
+                              in_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[hid_shift],
+                              hy_h * bi,
+                              batch_n,
+                              hy_stride,
+                              0,
+                              1,
+                              1);
+
+                // from bias
+                if(biased)
+                {
+                    // for(int bs = 0; bs < batch_n; bs++)
+                    miopen::par_for(batch_n, 4, [&](int bs) {
+                        for(int h = 0; h < hy_stride; h++)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias + h);
+                        }
+                    });
+                }
+            }
+        }
+        else
+        {
+            int wei_shift = bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h;
+            int prelayer_shift = (li - 1) * batch_n * hy_h * bi + numlayer * batch_n * hy_h * bi;
+            if(use_dropout)
+            {
+                auto dropout_states_tmp = dropout_states_host;
+                size_t drop_out_offset  = (li - 1ULL) * batch_n * hy_h * bi;
+
+                dropout.forward(dropout_inputTensor,
+                                rsvspace,
+                                dropout_outputTensor,
+                                dropout_hid_state,
+                                dropout_reservespace_host,
+                                dropout_states_tmp,
+                                prelayer_shift,
+                                drop_out_offset,
+                                drop_out_offset);
+
+                prelayer_shift = drop_out_offset;
+            }
+
+            RNN_mm_cpu<T>(use_dropout ? &dropout_hid_state[prelayer_shift]
+                                      : &rsvspace[prelayer_shift],
+                          hy_h * bi,
+                          batch_n,
+                          use_dropout ? hy_h * bi : hy_stride,
+                          0,
+                          &wei[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi,
+                          bi_stride,
+                          RNN_MM_TRANSPOSE,
+                          &rsvspace[hid_shift],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          1,
+                          1);
+
+            // from bias
+            if(biased)
+            {
+                int wei_shift_bias_temp = wei_shift_bias + bi * li * 2 * hy_h;
+
+                // for(int bs = 0; bs < batch_n; bs++)
+                miopen::par_for(batch_n, 4, [&](int bs) {
+                    for(int h = 0; h < hy_stride; h++)
+                    {
+                        rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                            wei.at(wei_shift_bias_temp + h);
+                    }
+                });
+            }
+        }
+
+        // from hidden state
+        int bacc   = 0;
+        int baccbi = batch_n;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            baccbi -= in_n.at(seqLength - 1 - ti);
+
+            int wei_shift =
+                li == 0 ? (in_h * hy_h * bi)
+                        : (bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h +
+                           bi * hy_h * hy_stride);
+
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu<T>(&hx[hx_shift],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  uni_stride,
+                                  0,
+                                  &wei[wei_shift],
+                                  hy_h,
+                                  hy_h,
+                                  uni_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[hid_shift + bacc * hy_stride],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  hy_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    // from bias
+                    if(biased)
+                    {
+                        int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
+
+                        miopen::par_for(in_n.at(ti), 4, [&](int bs) {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                    wei.at(wei_shift_bias_temp + h);
+                            }
+                        });
+                    }
+
+                    if(bidirection)
+                    {
+                        RNN_mm_cpu<T>(&hx[hx_shift + hy_n * hy_h],
+                                      hy_h,
+                                      in_n.at(seqLength - 1 - ti),
+                                      uni_stride,
+                                      0,
+                                      &wei[wei_shift + hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h,
+                                      uni_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &rsvspace[hid_shift + baccbi * hy_stride + hy_h],
+                                      hy_h,
+                                      in_n.at(seqLength - 1 - ti),
+                                      hy_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        // from bias
+                        if(biased)
+                        {
+                            int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
+
+                            miopen::par_for(in_n.at(seqLength - 1 - ti), 4, [&](int bs) {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
+                                                bs * hy_stride + h) +=
+                                        wei.at(wei_shift_bias_temp + hy_h + h);
+                                }
+                            });
+                        }
+                    }
+                }
+            }
+            else
+            {
+                RNN_mm_cpu<T>(&hy_host[hx_shift],
+                              hy_h,
+                              in_n.at(ti),
+                              uni_stride,
+                              0,
+                              &wei[wei_shift],
+                              hy_h,
+                              hy_h,
+                              uni_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[hid_shift + bacc * hy_stride],
+                              hy_h,
+                              in_n.at(ti),
+                              hy_stride,
+                              0,
+                              1,
+                              1);
+
+                // from bias
+                if(biased)
+                {
+                    int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
+
+                    miopen::par_for(in_n.at(ti), 4, [&](int bs) {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias_temp + h);
+                        }
+                    });
+                }
+
+                if(bidirection)
+                {
+
+                    if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
+                    {
+                        RNN_mm_cpu<T>(
+                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
+                            hy_h,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            uni_stride,
+                            0,
+                            &wei[wei_shift + hy_h * uni_stride],
+                            hy_h,
+                            hy_h,
+                            uni_stride,
+                            RNN_MM_TRANSPOSE,
+                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
+                                      hy_h],
+                            hy_h,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            hy_stride,
+                            0,
+                            1,
+                            1);
+
+                        // from bias
+                        if(biased)
+                        {
+                            int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
+
+                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
+                                bs++)
+                            {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
+                                                bs * hy_stride + h) +=
+                                        wei.at(wei_shift_bias_temp + hy_h + h);
+                                }
+                            }
+                        }
+                    }
+
+                    RNN_mm_cpu<T>(&hy_host[hx_shift + hy_n * hy_h],
+                                  hy_h,
+                                  in_n.at(seqLength - ti),
+                                  uni_stride,
+                                  0,
+                                  &wei[wei_shift + hy_h * uni_stride],
+                                  hy_h,
+                                  hy_h,
+                                  uni_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[hid_shift + baccbi * hy_stride + hy_h],
+                                  hy_h,
+                                  in_n.at(seqLength - ti),
+                                  hy_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    // from bias
+                    if(biased)
+                    {
+                        int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
+
+                        miopen::par_for(in_n.at(seqLength - ti), 4, [&](int bs) {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
+                                            h) += wei.at(wei_shift_bias_temp + hy_h + h);
+                            }
+                        });
+                    }
+                }
+            }
+
+            // for(int bs = 0; bs < in_n[ti]; bs++)
+            miopen::par_for(in_n.at(ti), 4, [&](int bs) {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    hy_host.at(hx_shift + bs * uni_stride + h) =
+                        activfunc(rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h),
+                                  squash); // squash_func
+
+                    rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h +
+                                numlayer * batch_n * hy_h * bi) =
+                        activfunc(rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h),
+                                  squash); // squash_func
+                }
+            });
+
+            if(bidirection)
+            {
+                // for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                miopen::par_for(in_n.at(seqLength - 1 - ti), 4, [&](int bs) {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        hy_host.at(hx_shift + hy_n * hy_h + bs * uni_stride + h) = activfunc(
+                            rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h),
+                            squash); // squash_func
+
+                        rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h +
+                                    numlayer * batch_n * hy_h * bi) =
+                            activfunc(rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
+                                                  bs * hy_stride + h),
+                                      squash);
+                    }
+                });
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+
+    // output
+    int prelayer_shift = (numlayer - 1) * batch_n * hy_h * bi + numlayer * batch_n * hy_h * bi;
+
+    if(use_dropout)
+    {
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            rsvspace.at(numlayer * batch_n * hy_stride * 2 + i) = dropout_hid_state.at(i);
+        }
+        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            *(p_drop_rsv + i) = dropout_reservespace_host.at(i);
+        }
+    }
+    for(int bs = 0; bs < batch_n; bs++)
+    {
+        for(int h = 0; h < out_h; h++)
+        {
+            assert(!std::isnan(rsvspace.at(prelayer_shift + bs * hy_stride + h)));
+            assert(!std::isinf(rsvspace.at(prelayer_shift + bs * hy_stride + h)));
+            out_host.at(bs * out_stride + h) = rsvspace.at(prelayer_shift + bs * hy_stride + h);
+        }
+    }
+}
+
+/// Backward data pass of a vanilla RNN over the rsvspace of cpu_rnn_forward. Fills din_host
+/// and dhx_host, leaving the hidden state gradients in wkspace.
+template <typename T>
+void cpu_rnn_backward_data(bool use_dropout,
+                           const cpu_rnn_dropout<T>& dropout,
+                           std::vector<T>& din_host,
+                           const std::vector<T>& wei,
+                           const std::vector<T>& dhy,
+                           std::vector<T>& dhx_host,
+                           const std::vector<T>& dout,
+                           const std::vector<int>& in_n,
+                           int in_h,
+                           int seqLength,
+                           bool bidirection,
+                           int hy_d,
+                           int hy_n,
+                           int hy_h,
+                           int out_h,
+                           int squash,
+                           int inputMode,
+                           const std::vector<T>& rsvspace,
+                           std::vector<T>& wkspace,
+                           bool dhy_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int hy_stride  = hy_h * bi;
+    int out_stride = out_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    // initial dropoput
+    miopenTensorDescriptor_t dropout_inputTensor{};
+    std::vector<unsigned char> dropout_reservespace_host;
+    if(use_dropout)
+    {
+        std::array<int, 2> drop_in_len = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str = {{hy_stride, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(0));
+
+        auto p_drop_rsv = reinterpret_cast<const unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            dropout_reservespace_host.at(i) = *(p_drop_rsv + i);
+        }
+    }
+
+    // bwd data emulator
+    for(int li = numlayer - 1; li >= 0; li--)
+    {
+        int wei_shift = bi * (in_h + hy_h) * hy_h + li * bi * (bi * hy_h + hy_h) * hy_h;
+        int hid_shift = li * batch_n * hy_h * bi;
+        int hx_shift  = li * bi * in_n.at(0) * hy_h;
+
+        if(li == numlayer - 1)
+        {
+            for(int bs = 0; bs < batch_n; bs++)
+            {
+                for(int h = 0; h < out_h; h++)
+                {
+                    wkspace.at(hid_shift + bs * hy_stride + h) += dout.at(bs * out_stride + h);
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift = (li + 1) * batch_n * hy_h * bi;
+
+            RNN_mm_cpu<T>(&wkspace[prelayer_shift],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          &wei[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi,
+                          bi_stride,
+                          0,
+                          &wkspace[hid_shift],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          1,
+                          1);
+
+            if(use_dropout)
+            {
+                dropout.backward(dropout_inputTensor,
+                                 wkspace,
+                                 dropout_inputTensor,
+                                 wkspace,
+                                 dropout_reservespace_host,
+                                 hid_shift,
+                                 hid_shift,
+                                 li * batch_n * hy_h * bi);
+            }
+        }
+
+        int bacc   = batch_n;
+        int baccbi = 0;
+        for(int ti = seqLength - 1; ti >= 0; ti--)
+        {
+            bacc -= in_n.at(ti);
+
+            // from post state
+            if(ti == seqLength - 1)
+            {
+                if(!dhy_is_null)
+                {
+                    for(int bs = 0; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                dhy.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                if(!dhy_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                {
+                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                dhy.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                }
+
+                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                            dhx_host.at(hx_shift + bs * uni_stride + h);
+                    }
+                }
+            }
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) *= dervactivfunc(
+                        rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h), squash);
+                }
+            }
+
+            if(ti < seqLength - 1)
+            {
+                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
+                {
+                    std::fill_n(&dhx_host[hx_shift + bs * uni_stride], hy_h, static_cast<T>(0));
+                }
+            }
+
+            wei_shift = li == 0
+                            ? (in_h * hy_stride)
+                            : (bi * (in_h + hy_h) * hy_h +
+                               (li - 1) * bi * (bi * hy_h + hy_h) * hy_h + bi * hy_h * hy_stride);
+
+            RNN_mm_cpu<T>(&wkspace[hid_shift + bacc * hy_stride],
+                          hy_h,
+                          in_n.at(ti),
+                          hy_stride,
+                          0,
+                          &wei[wei_shift],
+                          hy_h,
+                          hy_h,
+                          uni_stride,
+                          0,
+                          &dhx_host[hx_shift],
+                          hy_h,
+                          in_n.at(ti),
+                          uni_stride,
+                          0,
+                          1,
+                          1);
+
+            if(bidirection)
+            {
+                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        // from post state
+                        if(ti == seqLength - 1)
+                        {
+                            if(!dhy_is_null)
+                            {
+                                wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
+                                           h) +=
+                                    dhy.at(hx_shift + hy_n * hy_h + bs * uni_stride + h);
+                            }
+                        }
+                        else
+                        {
+                            wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
+                                       h) +=
+                                dhx_host.at(hx_shift + hy_n * hy_h + bs * uni_stride + h);
+                        }
+
+                        wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h) *=
+                            dervactivfunc(rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
+                                                      bs * hy_stride + h),
+                                          squash);
+                    }
+                }
+
+                if(ti < seqLength - 1)
+                {
+                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                    {
+                        std::fill_n(&dhx_host[hx_shift + bs * uni_stride + hy_n * hy_h],
+                                    hy_h,
+                                    static_cast<T>(0));
+                    }
+                }
+
+                RNN_mm_cpu<T>(&wkspace[hid_shift + baccbi * hy_stride + hy_h],
+                              hy_h,
+                              in_n.at(seqLength - 1 - ti),
+                              hy_stride,
+                              0,
+                              &wei[wei_shift + hy_h * uni_stride],
+                              hy_h,
+                              hy_h,
+                              uni_stride,
+                              0,
+                              &dhx_host[hx_shift + hy_n * hy_h],
+                              hy_h,
+                              in_n.at(seqLength - 1 - ti),
+                              uni_stride,
+                              0,
+                              1,
+                              1);
+            }
+
+            baccbi += in_n.at(seqLength - 1 - ti);
+        }
+    }
+
+    // dinput
+    if(inputMode == 1)
+    {
+        for(int bs = 0; bs < batch_n; bs++)
+        {
+            for(int h = 0; h < hy_h; h++)
+            {
+                din_host.at(bs * in_stride + h) += wkspace.at(bs * hy_stride + h);
+                if(bidirection)
+                {
+                    din_host.at(bs * in_stride + h) += wkspace.at(bs * hy_stride + hy_h + h);
+                }
+            }
+        }
+    }
+    else
+    {
+        RNN_mm_cpu<T>(wkspace.data(),
+                      hy_h * bi,
+                      batch_n,
+                      hy_stride,
+                      0,
+                      wei.data(),
+                      in_h,
+                      hy_h * bi,
+                      in_stride,
+                      0,
+                      din_host.data(),
+                      in_h,
+                      batch_n,
+                      in_stride,
+                      0,
+                      1,
+                      1);
+    }
+}
+
+/// Backward weights pass of a vanilla RNN. Accumulates into dwei_host from the rsvspace of
+/// cpu_rnn_forward and the wkspace of cpu_rnn_backward_data.
+template <typename T>
+void cpu_rnn_backward_weights(bool use_dropout,
+                              const std::vector<T>& in,
+                              std::vector<T>& dwei_host,
+                              const std::vector<T>& hx,
+                              const std::vector<int>& in_n,
+                              int in_h,
+                              int seqLength,
+                              bool bidirection,
+                              bool biased,
+                              int hy_d,
+                              int hy_n,
+                              int hy_h,
+                              int inputMode,
+                              const std::vector<T>& rsvspace,
+                              const std::vector<T>& wkspace,
+                              bool hx_is_null = false)
+{
+    int batch_n  = sumvc(in_n);
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int hy_stride  = hy_h * bi;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_len        = (bi * (in_h + hy_h) + (numlayer - 1) * bi * (bi + 1) * hy_h) * hy_h;
+    int wei_shift_bias = wei_len;
+
+    // bwd weights emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        // between layers
+        if(li == 0)
+        {
+            if(inputMode != 1)
+            {
+                RNN_mm_cpu<T>(wkspace.data(),
+                              hy_h * bi,
+                              batch_n,
+                              hy_stride,
+                              RNN_MM_TRANSPOSE,
+                              in.data(),
+                              in_h,
+                              batch_n,
+                              in_stride,
+                              0,
+                              dwei_host.data(),
+                              in_h,
+                              hy_h * bi,
+                              in_stride,
+                              0,
+                              1,
+                              1);
+            }
+
+            if(biased)
+            {
+                for(int h = 0; h < hy_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei_host.at(wei_shift_bias + h) += wkspace.at(w * hy_stride + h);
+                    }
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift =
+                use_dropout ? 2 * numlayer * batch_n * hy_stride + (li - 1) * batch_n * hy_h * bi
+                            : (li - 1) * bi * batch_n * hy_h + numlayer * batch_n * hy_h * bi;
+            int hid_shift = li * bi * batch_n * hy_h;
+            int wei_shift = bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h;
+
+            RNN_mm_cpu<T>(&wkspace[hid_shift],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          RNN_MM_TRANSPOSE,
+                          &rsvspace[prelayer_shift],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          &dwei_host[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi,
+                          bi_stride,
+                          0,
+                          1,
+                          1);
+
+            if(biased)
+            {
+                wei_shift = wei_shift_bias + li * bi * 2 * hy_h;
+
+                for(int h = 0; h < hy_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei_host.at(wei_shift + h) += wkspace.at(hid_shift + w * hy_stride + h);
+                    }
+                }
+            }
+        }
+
+        int bacc = 0;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            int hid_shift = li * bi * batch_n * hy_h + bacc * hy_stride;
+            int hx_shift  = li * bi * in_n.at(0) * hy_h;
+            int wei_shift;
+            int pretime_shift;
+
+            wei_shift = li == 0
+                            ? (in_h * hy_stride)
+                            : (bi * (in_h + hy_h) * hy_h +
+                               (li - 1) * bi * (bi * hy_h + hy_h) * hy_h + bi * hy_h * hy_stride);
+
+            // between time
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu<T>(&wkspace[hid_shift],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  hy_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &hx[hx_shift],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  uni_stride,
+                                  0,
+                                  &dwei_host[wei_shift],
+                                  hy_h,
+                                  hy_h,
+                                  uni_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    if(biased)
+                    {
+                        int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
+
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti); w++)
+                            {
+                                dwei_host.at(bias_shift + h) +=
+                                    wkspace.at(hid_shift + w * hy_stride + h);
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                pretime_shift = li * bi * batch_n * hy_h + (bacc - in_n.at(ti - 1)) * hy_stride +
+                                numlayer * batch_n * hy_h * bi;
+
+                RNN_mm_cpu<T>(&wkspace[hid_shift],
+                              hy_h,
+                              in_n.at(ti),
+                              hy_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[pretime_shift],
+                              hy_h,
+                              in_n.at(ti),
+                              hy_stride,
+                              0,
+                              &dwei_host[wei_shift],
+                              hy_h,
+                              hy_h,
+                              uni_stride,
+                              0,
+                              1,
+                              1);
+
+                if(biased)
+                {
+                    int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
+
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        for(int w = 0; w < in_n.at(ti); w++)
+                        {
+                            dwei_host.at(bias_shift + h) +=
+                                wkspace.at(hid_shift + w * hy_stride + h);
+                        }
+                    }
+                }
+            }
+
+            if(bidirection)
+            {
+                if(ti == seqLength - 1)
+                {
+                    if(!hx_is_null)
+                    {
+                        RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h],
+                                      hy_h,
+                                      in_n.at(ti),
+                                      hy_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &hx[hx_shift + hy_n * hy_h],
+                                      hy_h,
+                                      in_n.at(ti),
+                                      uni_stride,
+                                      0,
+                                      &dwei_host[wei_shift + hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h,
+                                      uni_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        if(biased)
+                        {
+                            int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
+
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                for(int w = 0; w < in_n.at(ti); w++)
+                                {
+                                    dwei_host.at(bias_shift + hy_h + h) +=
+                                        wkspace.at(hid_shift + w * hy_stride + hy_h + h);
+                                }
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    if(!hx_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                    {
+                        RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h + in_n.at(ti + 1) * hy_stride],
+                                      hy_h,
+                                      (in_n.at(ti) - in_n.at(ti + 1)),
+                                      hy_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &hx[hx_shift + hy_n * hy_h + in_n.at(ti + 1) * hy_h],
+                                      hy_h,
+                                      (in_n.at(ti) - in_n.at(ti + 1)),
+                                      uni_stride,
+                                      0,
+                                      &dwei_host[wei_shift + hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h,
+                                      uni_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        if(biased)
+                        {
+                            int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
+
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                for(int w = in_n.at(ti + 1); w < in_n.at(ti); w++)
+                                {
+                                    dwei_host.at(bias_shift + hy_h + h) +=
+                                        wkspace.at(hid_shift + w * hy_stride + hy_h + h);
+                                }
+                            }
+                        }
+                    }
+
+                    pretime_shift = li * bi * batch_n * hy_h + (bacc + in_n.at(ti)) * hy_stride +
+                                    numlayer * batch_n * hy_h * bi;
+
+                    RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h],
+                                  hy_h,
+                                  in_n.at(ti + 1),
+                                  hy_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[pretime_shift + hy_h],
+                                  hy_h,
+                                  in_n.at(ti + 1),
+                                  hy_stride,
+                                  0,
+                                  &dwei_host[wei_shift + hy_h * uni_stride],
+                                  hy_h,
+                                  hy_h,
+                                  uni_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    if(biased)
+                    {
+                        int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
+
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti + 1); w++)
+                            {
+                                dwei_host.at(bias_shift + hy_h + h) +=
+                                    wkspace.at(hid_shift + w * hy_stride + hy_h + h);
+                            }
+                        }
+                    }
+                }
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+}
+
+/// Forward training pass of an LSTM. Fills out_host, the final hy_host and cy_host, and the
+/// gates and cell states that rsvspace keeps for the backward pass.
+template <typename T>
+void cpu_lstm_forward(bool use_dropout,
+                      const cpu_rnn_dropout<T>& dropout,
+                      const std::vector<T>& in,
+                      const std::vector<T>& wei,
+                      std::vector<T>& hy_host,
+                      const std::vector<T>& hx,
+                      std::vector<T>& cy_host,
+                      const std::vector<T>& cx,
+                      std::vector<T>& out_host,
+                      const std::vector<int>& in_n,
+                      int in_h,
+                      int seqLength,
+                      bool bidirection,
+                      bool biased,
+                      int hy_d,
+                      int hy_n,
+                      int hy_h,
+                      int out_h,
+                      int inputMode,
+                      std::vector<T>& rsvspace,
+                      bool hx_is_null = false,
+                      bool cx_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection == 1 ? hy_d / 2 : hy_d;
+    int bi       = bidirection == 1 ? 2 : 1;
+
+    int in_stride  = in_h;
+    int out_stride = out_h;
+    int wei_stride = bi * 4 * hy_h;
+    int hy_stride  = bi * 6 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
+
+    // initial dropoput
+    std::vector<prngStates> dropout_states_host;
+    std::vector<unsigned char> dropout_reservespace_host;
+    std::vector<T> dropout_hid_state;
+    miopenTensorDescriptor_t dropout_inputTensor{}, dropout_outputTensor{};
+    if(use_dropout)
+    {
+        dropout_states_host = dropout.init_states();
+
+        std::array<int, 2> drop_in_len  = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str  = {{hy_stride, 1}};
+        std::array<int, 2> drop_out_str = {{hy_h * bi, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenCreateTensorDescriptor(&dropout_outputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+        miopenSetTensorDescriptor(
+            dropout_outputTensor, miopenFloat, 2, drop_in_len.data(), drop_out_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(1));
+
+        dropout_hid_state = std::vector<T>((numlayer - 1) * batch_n * hy_h * bi, static_cast<T>(0));
+    }
+
+    // forward emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        int hid_shift = li * batch_n * hy_stride;
+        int hx_shift  = li * in_n.at(0) * h_stride;
+
+        // from input
+        if(li == 0)
+        {
+            if(inputMode == 1)
+            {
+                for(int bs = 0; bs < batch_n; bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        for(int gi = 0; gi < 4; gi++)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + gi * hy_h + h) +=
+                                in.at(bs * in_stride + h);
+                            if(bidirection == 1)
+                            {
+                                rsvspace.at(hid_shift + bs * hy_stride + (gi + 4) * hy_h + h) +=
+                                    in.at(bs * in_stride + h);
+                            }
+                        }
+                    }
+                }
+
+                // from bias
+                if(biased == 1)
+                {
+                    for(int bs = 0; bs < batch_n; bs++)
+                    {
+                        for(int h = 0; h < wei_stride; h++)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias + h);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                RNN_mm_cpu<T>(in.data(),
+                              in_h,
+                              batch_n,
+                              in_stride,
+                              0,
+                              wei.data(),
+                              in_h,
+                              hy_h * bi * 4,
+                              in_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[hid_shift],
+                              hy_h * bi * 4,
+                              batch_n,
+                              hy_stride,
+                              0,
+                              1,
+                              1);
+
+                // from bias
+                if(biased == 1)
+                {
+                    for(int bs = 0; bs < batch_n; bs++)
+                    {
+                        for(int h = 0; h < wei_stride; h++)
+                        {
+                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias + h);
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
+            int prelayer_shift = (li - 1) * batch_n * hy_stride + bi * 5 * hy_h;
+            if(use_dropout)
+            {
+                auto dropout_states_tmp = dropout_states_host;
+                size_t drop_out_offset  = (static_cast<size_t>(li) - 1) * batch_n * hy_h * bi;
+
+                dropout.forward(dropout_inputTensor,
+                                rsvspace,
+                                dropout_outputTensor,
+                                dropout_hid_state,
+                                dropout_reservespace_host,
+                                dropout_states_tmp,
+                                prelayer_shift,
+                                drop_out_offset,
+                                drop_out_offset);
+
+                prelayer_shift = drop_out_offset;
+            }
+
+            RNN_mm_cpu<T>(use_dropout ? &dropout_hid_state[prelayer_shift]
+                                      : &rsvspace[prelayer_shift],
+                          hy_h * bi,
+                          batch_n,
+                          use_dropout ? hy_h * bi : hy_stride,
+                          0,
+                          &wei[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi * 4,
+                          bi_stride,
+                          RNN_MM_TRANSPOSE,
+                          &rsvspace[hid_shift],
+                          hy_h * bi * 4,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          1,
+                          1);
+
+            // from bias
+            if(biased == 1)
+            {
+                int wei_shift_bias_temp = wei_shift_bias + li * 2 * wei_stride;
+
+                for(int bs = 0; bs < batch_n; bs++)
+                {
+                    for(int h = 0; h < wei_stride; h++)
+                    {
+                        rsvspace.at(hid_shift + bs * hy_stride + h) +=
+                            wei.at(wei_shift_bias_temp + h);
+                    }
+                }
+            }
+        }
+
+        // from hidden state
+        int bacc   = 0;
+        int baccbi = batch_n;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            baccbi -= in_n.at(seqLength - 1 - ti);
+            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu<T>(&hx[hx_shift],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  uni_stride,
+                                  0,
+                                  &wei[wei_shift],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[hid_shift + bacc * hy_stride],
+                                  hy_h * 4,
+                                  in_n.at(ti),
+                                  hy_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    // from bias
+                    if(biased == 1)
+                    {
+                        int wei_shift_bias_temp = wei_shift_bias + (li * 2 + 1) * wei_stride;
+
+                        for(int bs = 0; bs < in_n.at(ti); bs++)
+                        {
+                            for(int h = 0; h < 4 * hy_h; h++)
+                            {
+                                rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                    wei.at(wei_shift_bias_temp + h);
+                            }
+                        }
+                    }
+
+                    if(bidirection == 1)
+                    {
+                        RNN_mm_cpu<T>(&hx[hx_shift + hy_n * hy_h],
+                                      hy_h,
+                                      in_n.at(seqLength - 1 - ti),
+                                      uni_stride,
+                                      0,
+                                      &wei[wei_shift + 4 * hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h * 4,
+                                      uni_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &rsvspace[hid_shift + baccbi * hy_stride + 4 * hy_h],
+                                      hy_h * 4,
+                                      in_n.at(seqLength - 1 - ti),
+                                      hy_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        // from bias
+                        if(biased == 1)
+                        {
+                            int wei_shift_bias_temp = wei_shift_bias + (li * 2 + 1) * wei_stride;
+
+                            for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                            {
+                                for(int h = 0; h < 4 * hy_h; h++)
+                                {
+                                    rsvspace.at(hid_shift + baccbi * hy_stride + 4 * hy_h +
+                                                bs * hy_stride + h) +=
+                                        wei.at(wei_shift_bias_temp + 4 * hy_h + h);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                RNN_mm_cpu<T>(&hy_host[hx_shift],
+                              hy_h,
+                              in_n.at(ti),
+                              uni_stride,
+                              0,
+                              &wei[wei_shift],
+                              hy_h,
+                              hy_h * 4,
+                              uni_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[hid_shift + bacc * hy_stride],
+                              hy_h * 4,
+                              in_n.at(ti),
+                              hy_stride,
+                              0,
+                              1,
+                              1);
+
+                // from bias
+                if(biased == 1)
+                {
+                    int wei_shift_bias_temp = wei_shift_bias + (li * 2 + 1) * wei_stride;
+
+                    for(int bs = 0; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < 4 * hy_h; h++)
+                        {
+                            rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
+                                wei.at(wei_shift_bias_temp + h);
+                        }
+                    }
+                }
+
+                if(bidirection == 1)
+                {
+
+                    if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
+                    {
+                        RNN_mm_cpu<T>(&hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
+                                      hy_h,
+                                      (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                                      uni_stride,
+                                      0,
+                                      &wei[wei_shift + 4 * hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h * 4,
+                                      uni_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &rsvspace[hid_shift +
+                                                (baccbi + in_n.at(seqLength - ti)) * hy_stride +
+                                                4 * hy_h],
+                                      hy_h * 4,
+                                      (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                                      hy_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        // from bias
+                        if(biased == 1)
+                        {
+                            int wei_shift_bias_temp = wei_shift_bias + (li * 2 + 1) * wei_stride;
+
+                            for(int bs = in_n.at(seqLength - ti);
+                                bs < in_n.at(seqLength - 1 - ti);
+                                bs++)
+                            {
+                                for(int h = 0; h < 4 * hy_h; h++)
+                                {
+                                    rsvspace.at(hid_shift + baccbi * hy_stride + 4 * hy_h +
+                                                bs * hy_stride + h) +=
+                                        wei.at(wei_shift_bias_temp + 4 * hy_h + h);
+                                }
+                            }
+                        }
+                    }
+
+                    RNN_mm_cpu<T>(&hy_host[hx_shift + hy_n * hy_h],
+                                  hy_h,
+                                  in_n.at(seqLength - ti),
+                                  uni_stride,
+                                  0,
+                                  &wei[wei_shift + 4 * hy_h * uni_stride],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[hid_shift + baccbi * hy_stride + 4 * hy_h],
+                                  hy_h * 4,
+                                  in_n.at(seqLength - ti),
+                                  hy_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    // from bias
+                    if(biased == 1)
+                    {
+                        int wei_shift_bias_temp = wei_shift_bias + (li * 2 + 1) * wei_stride;
+
+                        for(int bs = 0; bs < in_n.at(seqLength - ti); bs++)
+                        {
+                            for(int h = 0; h < 4 * hy_h; h++)
+                            {
+                                rsvspace.at(hid_shift + baccbi * hy_stride + 4 * hy_h +
+                                            bs * hy_stride + h) +=
+                                    wei.at(wei_shift_bias_temp + 4 * hy_h + h);
+                            }
+                        }
+                    }
+                }
+            }
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2) *
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
+                                  1);
+                    if(ti == 0)
+                    {
+                        if(!cx_is_null)
+                        {
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                                activfunc(
+                                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
+                                    2) *
+                                cx.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                    else
+                    {
+                        int prec_shift = li * batch_n * hy_stride +
+                                         (bacc - in_n.at(ti - 1)) * hy_stride + bi * 4 * hy_h;
+
+                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                            activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h),
+                                      2) *
+                            rsvspace.at(prec_shift + bs * hy_stride + h);
+                    }
+
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) +=
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
+                                  2) *
+                        activfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
+                            1);
+
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h +
+                                numlayer * batch_n * hy_stride) =
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2);
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h +
+                                numlayer * batch_n * hy_stride) =
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h), 2);
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h +
+                                numlayer * batch_n * hy_stride) =
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
+                                  2);
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h +
+                                numlayer * batch_n * hy_stride) =
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
+                                  1);
+                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h +
+                                numlayer * batch_n * hy_stride) =
+                        activfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
+                            1);
+
+                    cy_host.at(hx_shift + bs * uni_stride + h) =
+                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h);
+                    hy_host.at(hx_shift + bs * uni_stride + h) =
+                        rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h);
+                }
+            }
+
+            if(bidirection == 1)
+            {
+                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
+                                    h) +=
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
+                                2) *
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
+                                1);
+                        if(ti == 0)
+                        {
+                            if(!cx_is_null)
+                            {
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                            hy_h + h) +=
+                                    activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                          5 * hy_h + h),
+                                              2) *
+                                    cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
+                            }
+                        }
+                        else
+                        {
+
+                            if(!cx_is_null &&
+                               in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
+                            {
+                                if(bs >= in_n.at(seqLength - ti))
+                                {
+                                    rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                bi * 4 * hy_h + hy_h + h) +=
+                                        activfunc(rsvspace.at(hid_shift +
+                                                              (baccbi + bs) * hy_stride + 5 * hy_h +
+                                                              h),
+                                                  2) *
+                                        cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
+                                }
+                            }
+
+                            if(bs < in_n.at(seqLength - ti))
+                            {
+                                int prec_shift =
+                                    li * batch_n * hy_stride +
+                                    (baccbi + in_n.at(seqLength - 1 - ti)) * hy_stride +
+                                    bi * 4 * hy_h + hy_h;
+
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                            hy_h + h) +=
+                                    activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                          5 * hy_h + h),
+                                              2) *
+                                    rsvspace.at(prec_shift + bs * hy_stride + h);
+                            }
+                        }
+
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h +
+                                    h) +=
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
+                                2) *
+                            activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                  bi * 4 * hy_h + hy_h + h),
+                                      1);
+
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
+                                    numlayer * batch_n * hy_stride) =
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
+                                2);
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h +
+                                    numlayer * batch_n * hy_stride) =
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h),
+                                2);
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h +
+                                    numlayer * batch_n * hy_stride) =
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
+                                2);
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h +
+                                    numlayer * batch_n * hy_stride) =
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
+                                1);
+                        rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
+                                    h + numlayer * batch_n * hy_stride) =
+                            activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                  bi * 4 * hy_h + hy_h + h),
+                                      1);
+
+                        cy_host.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = rsvspace.at(
+                            hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h + h);
+                        hy_host.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) = rsvspace.at(
+                            hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h + hy_h + h);
+                    }
+                }
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+
+    // output
+    int prelayer_shift = (numlayer - 1) * batch_n * hy_stride + bi * 5 * hy_h;
+
+    for(int bs = 0; bs < batch_n; bs++)
+    {
+        for(int h = 0; h < out_h; h++)
+        {
+            out_host.at(bs * out_stride + h) = rsvspace.at(prelayer_shift + bs * hy_stride + h);
+        }
+    }
+
+    if(use_dropout)
+    {
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            rsvspace.at(numlayer * batch_n * hy_stride * 2 + i) = dropout_hid_state.at(i);
+        }
+        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            *(p_drop_rsv + i) = dropout_reservespace_host.at(i);
+        }
+    }
+}
+
+/// Backward data pass of an LSTM over the rsvspace of cpu_lstm_forward. Fills din_host,
+/// dhx_host and dcx_host, leaving the gate gradients in wkspace.
+template <typename T>
+void cpu_lstm_backward_data(bool use_dropout,
+                            const cpu_rnn_dropout<T>& dropout,
+                            std::vector<T>& din_host,
+                            const std::vector<T>& wei,
+                            const std::vector<T>& dhy,
+                            std::vector<T>& dhx_host,
+                            const std::vector<T>& dcy,
+                            std::vector<T>& dcx_host,
+                            const std::vector<T>& cx,
+                            const std::vector<T>& dout,
+                            const std::vector<int>& in_n,
+                            int in_h,
+                            int seqLength,
+                            bool bidirection,
+                            int hy_d,
+                            int hy_n,
+                            int hy_h,
+                            int out_h,
+                            int inputMode,
+                            const std::vector<T>& rsvspace,
+                            std::vector<T>& wkspace,
+                            bool cx_is_null = false,
+                            bool dhy_is_null = false,
+                            bool dcy_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection == 1 ? hy_d / 2 : hy_d;
+    int bi       = bidirection == 1 ? 2 : 1;
+
+    int in_stride  = in_h;
+    int out_stride = out_h;
+    int wei_stride = bi * 4 * hy_h;
+    int hy_stride  = bi * 6 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    // initial dropoput
+    miopenTensorDescriptor_t dropout_inputTensor{};
+    std::vector<unsigned char> dropout_reservespace_host;
+    if(use_dropout)
+    {
+        std::array<int, 2> drop_in_len = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str = {{hy_stride, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(0));
+
+        auto p_drop_rsv = reinterpret_cast<const unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            dropout_reservespace_host.at(i) = *(p_drop_rsv + i);
+        }
+    }
+
+    // bwd data emulator
+    for(int li = numlayer - 1; li >= 0; li--)
+    {
+        int wei_shift = (in_h + hy_h) * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+        int hid_shift = li * batch_n * hy_stride;
+        int hx_shift  = li * in_n.at(0) * h_stride;
+
+        if(li == numlayer - 1)
+        {
+            for(int bs = 0; bs < batch_n; bs++)
+            {
+                for(int h = 0; h < out_h; h++)
+                {
+                    wkspace.at(hid_shift + bi * 5 * hy_h + bs * hy_stride + h) +=
+                        dout.at(bs * out_stride + h);
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift = (li + 1) * batch_n * hy_stride;
+
+            RNN_mm_cpu<T>(&wkspace[prelayer_shift],
+                          hy_h * bi * 4,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          &wei[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi * 4,
+                          bi_stride,
+                          0,
+                          &wkspace[hid_shift + bi * 5 * hy_h],
+                          hy_h * bi,
+                          batch_n,
+                          hy_stride,
+                          0,
+                          1,
+                          1);
+
+            if(use_dropout)
+            {
+                dropout.backward(dropout_inputTensor,
+                                 wkspace,
+                                 dropout_inputTensor,
+                                 wkspace,
+                                 dropout_reservespace_host,
+                                 hid_shift + bi * 5 * hy_h,
+                                 hid_shift + bi * 5 * hy_h,
+                                 li * batch_n * hy_h * bi);
+            }
+        }
+
+        // from hidden state
+        int bacc   = batch_n;
+        int baccbi = 0;
+        for(int ti = seqLength - 1; ti >= 0; ti--)
+        {
+            bacc -= in_n.at(ti);
+
+            if(ti == seqLength - 1)
+            {
+                for(int bs = 0; bs < in_n.at(ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        if(!dhy_is_null)
+                        {
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) +=
+                                dhy.at(hx_shift + bs * uni_stride + h);
+                        }
+                        if(!dcy_is_null)
+                        {
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                                dcy.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                }
+
+                if(bidirection == 1)
+                {
+                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            if(!dhy_is_null)
+                            {
+                                wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h +
+                                           hy_h + h) +=
+                                    dhy.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
+                            }
+                            if(!dcy_is_null)
+                            {
+                                wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                           hy_h + h) +=
+                                    dcy.at(hx_shift + bs * uni_stride + hy_n * hy_h + h);
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                if(!dhy_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                {
+                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) +=
+                                dhy.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                }
+
+                if(!dcy_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                {
+                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                                dcy.at(hx_shift + bs * uni_stride + h);
+                        }
+                    }
+                }
+
+                int pretime_shift = li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride;
+                int weitime_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+
+                RNN_mm_cpu<T>(&wkspace[pretime_shift],
+                              hy_h * 4,
+                              in_n.at(ti + 1),
+                              hy_stride,
+                              0,
+                              &wei[weitime_shift],
+                              hy_h,
+                              hy_h * 4,
+                              uni_stride,
+                              0,
+                              &wkspace[hid_shift + bacc * hy_stride + bi * 5 * hy_h],
+                              hy_h,
+                              in_n.at(ti + 1),
+                              hy_stride,
+                              0,
+                              1,
+                              1);
+
+                if(bidirection == 1)
+                {
+                    pretime_shift = li * batch_n * hy_stride +
+                                    (baccbi - in_n.at(seqLength - 2 - ti)) * hy_stride +
+                                    hy_h * 4;
+                    weitime_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride +
+                                    hy_h * 4 * uni_stride;
+
+                    RNN_mm_cpu<T>(&wkspace[pretime_shift],
+                                  hy_h * 4,
+                                  in_n.at(seqLength - 1 - ti),
+                                  hy_stride,
+                                  0,
+                                  &wei[weitime_shift],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  0,
+                                  &wkspace[hid_shift + baccbi * hy_stride + bi * 5 * hy_h + hy_h],
+                                  hy_h,
+                                  in_n.at(seqLength - 1 - ti),
+                                  hy_stride,
+                                  0,
+                                  1,
+                                  1);
+                }
+            }
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    if(ti < seqLength - 1)
+                    {
+                        if(bs < in_n.at(ti + 1))
+                        {
+                            int pretime_shift =
+                                li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride;
+
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                                wkspace.at(pretime_shift + bs * hy_stride + bi * 4 * hy_h + h) *
+                                activfunc(rsvspace.at(pretime_shift + bs * hy_stride + hy_h + h),
+                                          2);
+                        }
+                    }
+                    wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) +=
+                        wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) *
+                        dervactivfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
+                            1) *
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h),
+                                  2);
+
+                    if(ti == 0)
+                    {
+                        if(!cx_is_null)
+                        {
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h) +=
+                                wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h +
+                                           h) *
+                                cx.at(hx_shift + bs * uni_stride + h) *
+                                dervactivfunc(
+                                    rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h), 2);
+                        }
+                    }
+                    else
+                    {
+                        int pretime_shift =
+                            li * batch_n * hy_stride + (bacc - in_n.at(ti - 1)) * hy_stride;
+
+                        wkspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h) +=
+                            wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) *
+                            rsvspace.at(pretime_shift + bs * hy_stride + bi * 4 * hy_h + h) *
+                            dervactivfunc(
+                                rsvspace.at(hid_shift + (bacc + bs) * hy_stride + hy_h + h), 2);
+                    }
+                    wkspace.at(hid_shift + (bacc + bs) * hy_stride + h) +=
+                        wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) *
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h),
+                                  1) *
+                        dervactivfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2);
+                    wkspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h) +=
+                        wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 5 * hy_h + h) *
+                        activfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h),
+                            1) *
+                        dervactivfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h), 2);
+                    wkspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h) +=
+                        wkspace.at(hid_shift + (bacc + bs) * hy_stride + bi * 4 * hy_h + h) *
+                        activfunc(rsvspace.at(hid_shift + (bacc + bs) * hy_stride + h), 2) *
+                        dervactivfunc(
+                            rsvspace.at(hid_shift + (bacc + bs) * hy_stride + 3 * hy_h + h), 1);
+                }
+            }
+
+            if(bidirection == 1)
+            {
+                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        if(ti < seqLength - 1)
+                        {
+                            int pretime_shift = li * batch_n * hy_stride +
+                                                (baccbi - in_n.at(seqLength - 2 - ti)) * hy_stride;
+
+                            wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                       hy_h + h) +=
+                                wkspace.at(pretime_shift + bs * hy_stride + bi * 4 * hy_h + hy_h +
+                                           h) *
+                                activfunc(
+                                    rsvspace.at(pretime_shift + bs * hy_stride + 5 * hy_h + h), 2);
+                        }
+                        wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h + hy_h +
+                                   h) +=
+                            wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h +
+                                       hy_h + h) *
+                            dervactivfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                      bi * 4 * hy_h + hy_h + h),
+                                          1) *
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
+                                2);
+
+                        if(ti == 0)
+                        {
+                            if(!cx_is_null)
+                            {
+                                wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h) +=
+                                    wkspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                               bi * 4 * hy_h + hy_h + h) *
+                                    cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) *
+                                    dervactivfunc(rsvspace.at(hid_shift +
+                                                              (baccbi + bs) * hy_stride + 5 * hy_h +
+                                                              h),
+                                                  2);
+                            }
+                        }
+                        else
+                        {
+                            if(!cx_is_null &&
+                               in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti) &&
+                               bs >= in_n.at(seqLength - ti))
+                            {
+                                wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h) +=
+                                    wkspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                               bi * 4 * hy_h + hy_h + h) *
+                                    cx.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) *
+                                    dervactivfunc(rsvspace.at(hid_shift +
+                                                              (baccbi + bs) * hy_stride + 5 * hy_h +
+                                                              h),
+                                                  2);
+                            }
+
+                            if(bs < in_n.at(seqLength - ti))
+                            {
+                                int pretime_shift =
+                                    li * batch_n * hy_stride +
+                                    (baccbi + in_n.at(seqLength - 1 - ti)) * hy_stride;
+
+                                wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h) +=
+                                    wkspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                               bi * 4 * hy_h + hy_h + h) *
+                                    rsvspace.at(pretime_shift + bs * hy_stride + bi * 4 * hy_h +
+                                                hy_h + h) *
+                                    dervactivfunc(rsvspace.at(hid_shift +
+                                                              (baccbi + bs) * hy_stride + 5 * hy_h +
+                                                              h),
+                                                  2);
+                            }
+                        }
+                        wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h) +=
+                            wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                       hy_h + h) *
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
+                                1) *
+                            dervactivfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
+                                2);
+                        wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h) +=
+                            wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 5 * hy_h +
+                                       hy_h + h) *
+                            activfunc(rsvspace.at(hid_shift + (baccbi + bs) * hy_stride +
+                                                  bi * 4 * hy_h + hy_h + h),
+                                      1) *
+                            dervactivfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 6 * hy_h + h),
+                                2);
+                        wkspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h) +=
+                            wkspace.at(hid_shift + (baccbi + bs) * hy_stride + bi * 4 * hy_h +
+                                       hy_h + h) *
+                            activfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h),
+                                2) *
+                            dervactivfunc(
+                                rsvspace.at(hid_shift + (baccbi + bs) * hy_stride + 7 * hy_h + h),
+                                1);
+                    }
+                }
+            }
+
+            baccbi += in_n.at(seqLength - 1 - ti);
+        }
+
+        // dcx, dhx
+        int pretime_shift = li * batch_n * hy_stride;
+        int weitime_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+
+        RNN_mm_cpu<T>(&wkspace[pretime_shift],
+                      hy_h * 4,
+                      in_n.at(0),
+                      hy_stride,
+                      0,
+                      &wei[weitime_shift],
+                      hy_h,
+                      hy_h * 4,
+                      uni_stride,
+                      0,
+                      &dhx_host[hx_shift],
+                      hy_h,
+                      in_n.at(0),
+                      uni_stride,
+                      0,
+                      1,
+                      1);
+
+        for(int bs = 0; bs < in_n.at(0); bs++)
+        {
+            for(int h = 0; h < hy_h; h++)
+            {
+                dcx_host.at(hx_shift + bs * uni_stride + h) +=
+                    wkspace.at(pretime_shift + bs * hy_stride + bi * 4 * hy_h + h) *
+                    activfunc(rsvspace.at(pretime_shift + bs * hy_stride + hy_h + h), 2);
+            }
+        }
+
+        if(bidirection == 1)
+        {
+            int ti = seqLength - 1, cur_bat = 0, pre_bat = batch_n;
+
+            while(ti >= 0)
+            {
+                pre_bat -= in_n.at(ti);
+                if(in_n.at(ti) > cur_bat)
+                {
+                    pretime_shift = li * batch_n * hy_stride + (pre_bat + cur_bat) * hy_stride;
+
+                    RNN_mm_cpu<T>(&wkspace[pretime_shift + 4 * hy_h],
+                                  hy_h * 4,
+                                  (in_n.at(ti) - cur_bat),
+                                  hy_stride,
+                                  0,
+                                  &wei[weitime_shift + 4 * hy_h * uni_stride],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  0,
+                                  &dhx_host[hx_shift + hy_n * hy_h + cur_bat * hy_h],
+                                  hy_h,
+                                  (in_n.at(ti) - cur_bat),
+                                  uni_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    for(int bs = cur_bat; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            dcx_host.at(hx_shift + bs * uni_stride + hy_n * hy_h + h) +=
+                                wkspace.at(pretime_shift + (bs - cur_bat) * hy_stride +
+                                           bi * 4 * hy_h + hy_h + h) *
+                                activfunc(rsvspace.at(pretime_shift + (bs - cur_bat) * hy_stride +
+                                                      5 * hy_h + h),
+                                          2);
+                        }
+                    }
+                }
+                cur_bat = in_n.at(ti--);
+            }
+        }
+    }
+
+    // dinput
+    if(inputMode == 1)
+    {
+        for(int bs = 0; bs < batch_n; bs++)
+        {
+            for(int h = 0; h < hy_h; h++)
+            {
+                for(int gi = 0; gi < 4; gi++)
+                {
+                    din_host.at(bs * in_stride + h) += wkspace.at(bs * hy_stride + gi * hy_h + h);
+                    if(bidirection == 1)
+                    {
+                        din_host.at(bs * in_stride + h) +=
+                            wkspace.at(bs * hy_stride + (gi + 4) * hy_h + h);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        RNN_mm_cpu<T>(wkspace.data(),
+                      hy_h * bi * 4,
+                      batch_n,
+                      hy_stride,
+                      0,
+                      wei.data(),
+                      in_h,
+                      hy_h * bi * 4,
+                      in_stride,
+                      0,
+                      din_host.data(),
+                      in_h,
+                      batch_n,
+                      in_stride,
+                      0,
+                      1,
+                      1);
+    }
+}
+
+/// Backward weights pass of an LSTM. Accumulates into dwei_host from the rsvspace of
+/// cpu_lstm_forward and the wkspace of cpu_lstm_backward_data.
+template <typename T>
+void cpu_lstm_backward_weights(bool use_dropout,
+                               const std::vector<T>& in,
+                               std::vector<T>& dwei_host,
+                               const std::vector<T>& hx,
+                               const std::vector<int>& in_n,
+                               int in_h,
+                               int seqLength,
+                               bool bidirection,
+                               bool biased,
+                               int hy_d,
+                               int hy_n,
+                               int hy_h,
+                               int inputMode,
+                               const std::vector<T>& rsvspace,
+                               const std::vector<T>& wkspace,
+                               bool hx_is_null = false)
+{
+    int batch_n  = sumvc(in_n);
+    int numlayer = bidirection == 1 ? hy_d / 2 : hy_d;
+    int bi       = bidirection == 1 ? 2 : 1;
+
+    int in_stride  = in_h;
+    int wei_stride = bi * 4 * hy_h;
+    int hy_stride  = bi * 6 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
+
+    // bwd weights emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        // between layers
+        if(li == 0)
+        {
+            if(inputMode != 1)
+            {
+                RNN_mm_cpu<T>(wkspace.data(),
+                              hy_h * bi * 4,
+                              batch_n,
+                              hy_stride,
+                              RNN_MM_TRANSPOSE,
+                              in.data(),
+                              in_h,
+                              batch_n,
+                              in_stride,
+                              0,
+                              dwei_host.data(),
+                              in_h,
+                              hy_h * bi * 4,
+                              in_stride,
+                              0,
+                              1,
+                              1);
+            }
+
+            if(biased == 1)
+            {
+                for(int h = 0; h < wei_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei_host.at(wei_shift_bias + h) += wkspace.at(w * hy_stride + h);
+                    }
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift =
+                use_dropout ? 2 * numlayer * batch_n * hy_stride + (li - 1) * batch_n * hy_h * bi
+                            : (li - 1) * batch_n * hy_stride + bi * hy_h * 5;
+            int hid_shift = li * batch_n * hy_stride;
+            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
+
+            RNN_mm_cpu<T>(&wkspace[hid_shift],
+                          hy_h * bi * 4,
+                          batch_n,
+                          hy_stride,
+                          RNN_MM_TRANSPOSE,
+                          &rsvspace[prelayer_shift],
+                          hy_h * bi,
+                          batch_n,
+                          use_dropout ? hy_h * bi : hy_stride,
+                          0,
+                          &dwei_host[wei_shift],
+                          hy_h * bi,
+                          hy_h * bi * 4,
+                          bi_stride,
+                          0,
+                          1,
+                          1);
+
+            if(biased == 1)
+            {
+                wei_shift = wei_shift_bias + li * 2 * wei_stride;
+
+                for(int h = 0; h < wei_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei_host.at(wei_shift + h) += wkspace.at(hid_shift + w * hy_stride + h);
+                    }
+                }
+            }
+        }
+
+        // between time
+        int bacc = 0;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            int hid_shift = li * batch_n * hy_stride + bacc * hy_stride;
+            int hx_shift  = li * in_n.at(0) * h_stride;
+            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+            int pretime_shift;
+
+            // between time
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu<T>(&wkspace[hid_shift],
+                                  hy_h * 4,
+                                  in_n.at(ti),
+                                  hy_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &hx[hx_shift],
+                                  hy_h,
+                                  in_n.at(ti),
+                                  uni_stride,
+                                  0,
+                                  &dwei_host[wei_shift],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    if(biased == 1)
+                    {
+                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                        for(int h = 0; h < hy_h * 4; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti); w++)
+                            {
+                                dwei_host.at(bias_shift + h) +=
+                                    wkspace.at(hid_shift + w * hy_stride + h);
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                pretime_shift = li * batch_n * hy_stride +
+                                (bacc - in_n.at(ti - 1)) * hy_stride + bi * 5 * hy_h;
+
+                RNN_mm_cpu<T>(&wkspace[hid_shift],
+                              hy_h * 4,
+                              in_n.at(ti),
+                              hy_stride,
+                              RNN_MM_TRANSPOSE,
+                              &rsvspace[pretime_shift],
+                              hy_h,
+                              in_n.at(ti),
+                              hy_stride,
+                              0,
+                              &dwei_host[wei_shift],
+                              hy_h,
+                              hy_h * 4,
+                              uni_stride,
+                              0,
+                              1,
+                              1);
+
+                if(biased == 1)
+                {
+                    int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                    for(int h = 0; h < hy_h * 4; h++)
+                    {
+                        for(int w = 0; w < in_n.at(ti); w++)
+                        {
+                            dwei_host.at(bias_shift + h) +=
+                                wkspace.at(hid_shift + w * hy_stride + h);
+                        }
+                    }
+                }
+            }
+
+            if(bidirection == 1)
+            {
+                if(ti == seqLength - 1)
+                {
+                    if(!hx_is_null)
+                    {
+                        RNN_mm_cpu<T>(&wkspace[hid_shift + 4 * hy_h],
+                                      hy_h * 4,
+                                      in_n.at(ti),
+                                      hy_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &hx[hx_shift + hy_n * hy_h],
+                                      hy_h,
+                                      in_n.at(ti),
+                                      uni_stride,
+                                      0,
+                                      &dwei_host[wei_shift + 4 * hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h * 4,
+                                      uni_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        if(biased == 1)
+                        {
+                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                            for(int h = 0; h < hy_h * 4; h++)
+                            {
+                                for(int w = 0; w < in_n.at(ti); w++)
+                                {
+                                    dwei_host.at(bias_shift + hy_h * 4 + h) +=
+                                        wkspace.at(hid_shift + hy_h * 4 + w * hy_stride + h);
+                                }
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    if(!hx_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                    {
+                        RNN_mm_cpu<T>(&wkspace[hid_shift + 4 * hy_h + in_n.at(ti + 1) * hy_stride],
+                                      hy_h * 4,
+                                      (in_n.at(ti) - in_n.at(ti + 1)),
+                                      hy_stride,
+                                      RNN_MM_TRANSPOSE,
+                                      &hx[hx_shift + hy_n * hy_h + in_n.at(ti + 1) * hy_h],
+                                      hy_h,
+                                      (in_n.at(ti) - in_n.at(ti + 1)),
+                                      uni_stride,
+                                      0,
+                                      &dwei_host[wei_shift + 4 * hy_h * uni_stride],
+                                      hy_h,
+                                      hy_h * 4,
+                                      uni_stride,
+                                      0,
+                                      1,
+                                      1);
+
+                        if(biased == 1)
+                        {
+                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                            for(int h = 0; h < hy_h * 4; h++)
+                            {
+                                for(int w = in_n.at(ti + 1); w < in_n.at(ti); w++)
+                                {
+                                    dwei_host.at(bias_shift + hy_h * 4 + h) +=
+                                        wkspace.at(hid_shift + hy_h * 4 + w * hy_stride + h);
+                                }
+                            }
+                        }
+                    }
+
+                    pretime_shift = li * batch_n * hy_stride +
+                                    (bacc + in_n.at(ti)) * hy_stride + bi * 5 * hy_h;
+
+                    RNN_mm_cpu<T>(&wkspace[hid_shift + 4 * hy_h],
+                                  hy_h * 4,
+                                  in_n.at(ti + 1),
+                                  hy_stride,
+                                  RNN_MM_TRANSPOSE,
+                                  &rsvspace[pretime_shift + hy_h],
+                                  hy_h,
+                                  in_n.at(ti + 1),
+                                  hy_stride,
+                                  0,
+                                  &dwei_host[wei_shift + 4 * hy_h * uni_stride],
+                                  hy_h,
+                                  hy_h * 4,
+                                  uni_stride,
+                                  0,
+                                  1,
+                                  1);
+
+                    if(biased == 1)
+                    {
+                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                        for(int h = 0; h < hy_h * 4; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti + 1); w++)
+                            {
+                                dwei_host.at(bias_shift + hy_h * 4 + h) +=
+                                    wkspace.at(hid_shift + hy_h * 4 + w * hy_stride + h);
+                            }
+                        }
+                    }
+                }
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+}
+
+/// Forward training pass of a GRU. Fills out, the final hy and the gates that rsvspace keeps
+/// for the backward pass.
+template <typename T>
+void cpu_gru_forward(bool use_dropout,
+                     const cpu_rnn_dropout<T>& dropout,
+                     const std::vector<T>& in,
+                     const std::vector<T>& wei,
+                     std::vector<T>& hy,
+                     const std::vector<T>& hx,
+                     std::vector<T>& out,
+                     const std::vector<int>& in_n,
+                     int in_h,
+                     int seqLength,
+                     bool bidirection,
+                     bool biased,
+                     int hy_d,
+                     int hy_n,
+                     int hy_h,
+                     int out_h,
+                     int inputMode,
+                     std::vector<T>& rsvspace,
+                     bool hx_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int out_stride = out_h;
+    int wei_stride = bi * 3 * hy_h;
+    int hy_stride  = bi * 4 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
+
+    // initial dropoput
+    std::vector<prngStates> dropout_states_host;
+    std::vector<unsigned char> dropout_reservespace_host;
+    std::vector<T> dropout_hid_state;
+    miopenTensorDescriptor_t dropout_inputTensor{}, dropout_outputTensor{};
+    if(use_dropout)
+    {
+        dropout_states_host = dropout.init_states();
+
+        std::array<int, 2> drop_in_len  = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str  = {{hy_stride, 1}};
+        std::array<int, 2> drop_out_str = {{hy_h * bi, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenCreateTensorDescriptor(&dropout_outputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+        miopenSetTensorDescriptor(
+            dropout_outputTensor, miopenFloat, 2, drop_in_len.data(), drop_out_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(1));
+
+        dropout_hid_state = std::vector<T>((numlayer - 1) * batch_n * hy_h * bi, static_cast<T>(0));
+    }
+
+    // forward emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        int hid_shift           = li * batch_n * hy_stride;
+        int hx_shift            = li * in_n.at(0) * h_stride;
+        int wei_shift_bias_temp = wei_shift_bias + li * 2 * wei_stride;
+
+        // from input
+        if(li == 0)
+        {
+            if(inputMode == 1)
+            {
+                for(int bs = 0; bs < batch_n; bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        for(int gi = 0; gi < 3; gi++)
+                        {
+                            rsvspace[hid_shift + bs * hy_stride + gi * hy_h + h] +=
+                                in[bs * in_stride + h];
+                            if(bidirection)
+                            {
+                                rsvspace[hid_shift + bs * hy_stride + (gi + 3) * hy_h + h] +=
+                                    in[bs * in_stride + h];
+                            }
+                        }
+                    }
+                }
+
+                // from bias
+                if(biased)
+                {
+                    for(int bs = 0; bs < batch_n; bs++)
+                    {
+                        for(int h = 0; h < wei_stride; h++)
+                        {
+                            rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias + h];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                RNN_mm_cpu(in.data(),
+                           in_h,
+                           batch_n,
+                           in_stride,
+                           0,
+                           wei.data(), // wei_state.data(),
+                           in_h,
+                           hy_h * bi * 3,
+                           in_stride,
+                           RNN_MM_TRANSPOSE,
+                           &rsvspace[hid_shift],
+                           hy_h * bi * 3,
+                           batch_n,
+                           hy_stride,
+                           0,
+                           1,
+                           1);
+
+                // from bias
+                if(biased)
+                {
+                    for(int bs = 0; bs < batch_n; bs++)
+                    {
+                        for(int h = 0; h < wei_stride; h++)
+                        {
+                            rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias + h];
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
+            int prelayer_shift = (li - 1) * batch_n * hy_stride + bi * 3 * hy_h;
+            if(use_dropout)
+            {
+                auto dropout_states_tmp = dropout_states_host;
+                size_t drop_out_offset  = (static_cast<size_t>(li) - 1) * batch_n * hy_h * bi;
+
+                dropout.forward(dropout_inputTensor,
+                                rsvspace,
+                                dropout_outputTensor,
+                                dropout_hid_state,
+                                dropout_reservespace_host,
+                                dropout_states_tmp,
+                                prelayer_shift,
+                                drop_out_offset,
+                                drop_out_offset);
+
+                prelayer_shift = drop_out_offset;
+            }
+
+            RNN_mm_cpu(use_dropout ? &dropout_hid_state[prelayer_shift] : &rsvspace[prelayer_shift],
+                       hy_h * bi,
+                       batch_n,
+                       use_dropout ? hy_h * bi : hy_stride,
+                       0,
+                       &wei[wei_shift], //&wei_state[wei_shift],
+                       hy_h * bi,
+                       hy_h * bi * 3,
+                       bi_stride,
+                       RNN_MM_TRANSPOSE,
+                       &rsvspace[hid_shift],
+                       hy_h * bi * 3,
+                       batch_n,
+                       hy_stride,
+                       0,
+                       1,
+                       1);
+
+            // from bias
+            if(biased)
+            {
+                for(int bs = 0; bs < batch_n; bs++)
+                {
+                    for(int h = 0; h < wei_stride; h++)
+                    {
+                        rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias_temp + h];
+                    }
+                }
+            }
+        }
+
+        // from hidden state
+        int bacc   = 0;
+        int baccbi = batch_n;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            baccbi -= in_n.at(seqLength - 1 - ti);
+            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+            int pretime_shift;
+
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu(&hx[hx_shift],
+                               hy_h,
+                               in_n.at(ti),
+                               uni_stride,
+                               0,
+                               &wei[wei_shift],
+                               hy_h,
+                               hy_h * 2,
+                               uni_stride,
+                               RNN_MM_TRANSPOSE,
+                               &rsvspace[hid_shift + bacc * hy_stride],
+                               hy_h * 2,
+                               in_n.at(ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        for(int bs = 0; bs < in_n.at(ti); bs++)
+                        {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                for(int gi = 0; gi < 2; gi++)
+                                {
+                                    rsvspace[hid_shift + (bacc + bs) * hy_stride + gi * hy_h + h] +=
+                                        wei[wei_shift_bias_temp + wei_stride + gi * hy_h + h];
+                                }
+                            }
+                        }
+                    }
+
+                    RNN_mm_cpu(&hx[hx_shift],
+                               hy_h,
+                               in_n.at(ti),
+                               uni_stride,
+                               0,
+                               &wei[wei_shift + 2 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h,
+                               uni_stride,
+                               RNN_MM_TRANSPOSE,
+                               &rsvspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
+                               hy_h,
+                               in_n.at(ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        for(int bs = 0; bs < in_n.at(ti); bs++)
+                        {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                    wei[wei_shift_bias_temp + wei_stride + 2 * hy_h + h];
+                            }
+                        }
+                    }
+
+                    if(bidirection)
+                    {
+                        RNN_mm_cpu(&hx[hx_shift + hy_n * hy_h],
+                                   hy_h,
+                                   in_n.at(seqLength - 1 - ti),
+                                   uni_stride,
+                                   0,
+                                   &wei[wei_shift + 3 * hy_h * uni_stride],
+                                   hy_h,
+                                   hy_h * 2,
+                                   uni_stride,
+                                   RNN_MM_TRANSPOSE,
+                                   &rsvspace[hid_shift + baccbi * hy_stride + 3 * hy_h],
+                                   hy_h * 2,
+                                   in_n.at(seqLength - 1 - ti),
+                                   hy_stride,
+                                   0,
+                                   1,
+                                   1);
+
+                        if(biased)
+                        {
+                            for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                            {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    for(int gi = 0; gi < 2; gi++)
+                                    {
+                                        rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                 (3 + gi) * hy_h + h] +=
+                                            wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h +
+                                                h];
+                                    }
+                                }
+                            }
+                        }
+
+                        RNN_mm_cpu(&hx[hx_shift + hy_n * hy_h],
+                                   hy_h,
+                                   in_n.at(seqLength - 1 - ti),
+                                   uni_stride,
+                                   0,
+                                   &wei[wei_shift + 5 * hy_h * uni_stride],
+                                   hy_h,
+                                   hy_h,
+                                   uni_stride,
+                                   RNN_MM_TRANSPOSE,
+                                   &rsvspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
+                                   hy_h,
+                                   in_n.at(seqLength - 1 - ti),
+                                   hy_stride,
+                                   0,
+                                   1,
+                                   1);
+
+                        if(biased)
+                        {
+                            for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                            {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] +=
+                                        wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                RNN_mm_cpu(&hy[hx_shift],
+                           hy_h,
+                           in_n.at(ti),
+                           uni_stride,
+                           0,
+                           &wei[wei_shift],
+                           hy_h,
+                           hy_h * 2,
+                           uni_stride,
+                           RNN_MM_TRANSPOSE,
+                           &rsvspace[hid_shift + bacc * hy_stride],
+                           hy_h * 2,
+                           in_n.at(ti),
+                           hy_stride,
+                           0,
+                           1,
+                           1);
+
+                if(biased)
+                {
+                    for(int bs = 0; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            for(int gi = 0; gi < 2; gi++)
+                            {
+                                rsvspace[hid_shift + (bacc + bs) * hy_stride + gi * hy_h + h] +=
+                                    wei[wei_shift_bias_temp + wei_stride + gi * hy_h + h];
+                            }
+                        }
+                    }
+                }
+
+                RNN_mm_cpu(&hy[hx_shift],
+                           hy_h,
+                           in_n.at(ti),
+                           uni_stride,
+                           0,
+                           &wei[wei_shift + 2 * hy_h * uni_stride],
+                           hy_h,
+                           hy_h,
+                           uni_stride,
+                           RNN_MM_TRANSPOSE,
+                           &rsvspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
+                           hy_h,
+                           in_n.at(ti),
+                           hy_stride,
+                           0,
+                           1,
+                           1);
+
+                if(biased)
+                {
+                    for(int bs = 0; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                wei[wei_shift_bias_temp + wei_stride + 2 * hy_h + h];
+                        }
+                    }
+                }
+
+                if(bidirection)
+                {
+
+                    if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
+                    {
+                        RNN_mm_cpu(
+                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
+                            hy_h,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            uni_stride,
+                            0,
+                            &wei[wei_shift + 3 * hy_h * uni_stride],
+                            hy_h,
+                            hy_h * 2,
+                            uni_stride,
+                            RNN_MM_TRANSPOSE,
+                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
+                                      3 * hy_h],
+                            hy_h * 2,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            hy_stride,
+                            0,
+                            1,
+                            1);
+
+                        if(biased)
+                        {
+                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
+                                bs++)
+                            {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    for(int gi = 0; gi < 2; gi++)
+                                    {
+                                        rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                 (3 + gi) * hy_h + h] +=
+                                            wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h +
+                                                h];
+                                    }
+                                }
+                            }
+                        }
+
+                        RNN_mm_cpu(
+                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
+                            hy_h,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            uni_stride,
+                            0,
+                            &wei[wei_shift + 5 * hy_h * uni_stride],
+                            hy_h,
+                            hy_h,
+                            uni_stride,
+                            RNN_MM_TRANSPOSE,
+                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
+                                      bi * 3 * hy_h + hy_h],
+                            hy_h,
+                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
+                            hy_stride,
+                            0,
+                            1,
+                            1);
+
+                        if(biased)
+                        {
+                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
+                                bs++)
+                            {
+                                for(int h = 0; h < hy_h; h++)
+                                {
+                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] +=
+                                        wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
+                                }
+                            }
+                        }
+                    }
+
+                    RNN_mm_cpu(&hy[hx_shift + hy_n * hy_h],
+                               hy_h,
+                               in_n.at(seqLength - ti),
+                               uni_stride,
+                               0,
+                               &wei[wei_shift + 3 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h * 2,
+                               uni_stride,
+                               RNN_MM_TRANSPOSE,
+                               &rsvspace[hid_shift + baccbi * hy_stride + 3 * hy_h],
+                               hy_h * 2,
+                               in_n.at(seqLength - ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        for(int bs = 0; bs < in_n.at(seqLength - ti); bs++)
+                        {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                for(int gi = 0; gi < 2; gi++)
+                                {
+                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                             (3 + gi) * hy_h + h] +=
+                                        wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h + h];
+                                }
+                            }
+                        }
+                    }
+
+                    RNN_mm_cpu(&hy[hx_shift + hy_n * hy_h],
+                               hy_h,
+                               in_n.at(seqLength - ti),
+                               uni_stride,
+                               0,
+                               &wei[wei_shift + 5 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h,
+                               uni_stride,
+                               RNN_MM_TRANSPOSE,
+                               &rsvspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
+                               hy_h,
+                               in_n.at(seqLength - ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        for(int bs = 0; bs < in_n.at(seqLength - ti); bs++)
+                        {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] +=
+                                    wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
+                            }
+                        }
+                    }
+                }
+            }
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
+                             numlayer * batch_n * hy_stride] =
+                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
+
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] +=
+                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h], 2) *
+                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] = 0;
+
+                    if(ti == 0)
+                    {
+                        if(!hx_is_null)
+                        {
+                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                ((1 -
+                                  activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
+                                     activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride +
+                                                        2 * hy_h + h],
+                                               1) +
+                                 activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2) *
+                                     hx[hx_shift + bs * uni_stride + h]);
+                        }
+                        else
+                        {
+                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                ((1 -
+                                  activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
+                                 activfunc(
+                                     rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
+                                     1));
+                        }
+                    }
+                    else
+                    {
+
+                        pretime_shift = li * batch_n * hy_stride +
+                                        (bacc - in_n.at(ti - 1)) * hy_stride + bi * 3 * hy_h;
+
+                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                            ((1 - activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
+                                 activfunc(
+                                     rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
+                                     1) +
+                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2) *
+                                 rsvspace[pretime_shift + bs * hy_stride + h]);
+                    }
+
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + h +
+                             numlayer * batch_n * hy_stride] =
+                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2);
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h +
+                             numlayer * batch_n * hy_stride] =
+                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h], 2);
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h +
+                             numlayer * batch_n * hy_stride] =
+                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h], 1);
+
+                    // Update final state
+                    hy[hx_shift + bs * uni_stride + h] =
+                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
+                }
+            }
+
+            if(bidirection)
+            {
+                pretime_shift = li * batch_n * hy_stride +
+                                (baccbi + in_n.at(seqLength - 1 - ti)) * hy_stride + bi * 3 * hy_h +
+                                hy_h;
+
+                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h +
+                                 numlayer * batch_n * hy_stride] =
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                     h];
+
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] +=
+                            activfunc(
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h], 2) *
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                     h];
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h] =
+                            0;
+
+                        if(ti == 0)
+                        {
+                            if(!hx_is_null)
+                            {
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] +=
+                                    ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                             3 * hy_h + h],
+                                                    2)) *
+                                         activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                            5 * hy_h + h],
+                                                   1) +
+                                     activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                        3 * hy_h + h],
+                                               2) *
+                                         hx[hx_shift + bs * uni_stride + hy_n * hy_h + h]);
+                            }
+                            else
+                            {
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] +=
+                                    ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                             3 * hy_h + h],
+                                                    2)) *
+                                     activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                        5 * hy_h + h],
+                                               1));
+                            }
+                        }
+                        else
+                        {
+                            if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
+                            {
+                                if(bs >= in_n.at(seqLength - ti))
+                                {
+                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] +=
+                                        (activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                            3 * hy_h + h],
+                                                   2) *
+                                         hx[hx_shift + bs * uni_stride + hy_n * hy_h + h]);
+                                }
+                            }
+
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                     h] +=
+                                ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                         3 * hy_h + h],
+                                                2)) *
+                                 activfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
+                                     1));
+
+                            if(bs < in_n.at(seqLength - ti))
+                            {
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] +=
+                                    (activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                        3 * hy_h + h],
+                                               2) *
+                                     rsvspace[pretime_shift + bs * hy_stride + h]);
+                            }
+                        }
+
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h +
+                                 numlayer * batch_n * hy_stride] =
+                            activfunc(
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h], 2);
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
+                                 numlayer * batch_n * hy_stride] =
+                            activfunc(
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h], 2);
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h +
+                                 numlayer * batch_n * hy_stride] =
+                            activfunc(
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h], 1);
+
+                        // Update final hidden state
+                        hy[hx_shift + bs * uni_stride + hy_n * hy_h + h] =
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                     h];
+                    }
+                }
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+
+    // output
+    int prelayer_shift = (numlayer - 1) * batch_n * hy_stride + bi * 3 * hy_h;
+    for(int bs = 0; bs < batch_n; bs++)
+    {
+        for(int h = 0; h < out_h; h++)
+        {
+            out[bs * out_stride + h] = rsvspace[prelayer_shift + bs * hy_stride + h];
+        }
+    }
+
+    if(use_dropout)
+    {
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            rsvspace.at(numlayer * batch_n * hy_stride * 2 + i) = dropout_hid_state.at(i);
+        }
+        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            *(p_drop_rsv + i) = dropout_reservespace_host.at(i);
+        }
+    }
+}
+
+/// Backward data pass of a GRU over the rsvspace of cpu_gru_forward. Fills din and dhx,
+/// leaving the gate gradients in wkspace. Like the kernels, it also writes the second half
+/// of rsvspace.
+template <typename T>
+void cpu_gru_backward_data(bool use_dropout,
+                           const cpu_rnn_dropout<T>& dropout,
+                           std::vector<T>& din,
+                           const std::vector<T>& wei,
+                           const std::vector<T>& dhy,
+                           std::vector<T>& dhx,
+                           const std::vector<T>& hx,
+                           const std::vector<T>& dout,
+                           const std::vector<int>& in_n,
+                           int in_h,
+                           int seqLength,
+                           bool bidirection,
+                           int hy_d,
+                           int hy_n,
+                           int hy_h,
+                           int out_h,
+                           int inputMode,
+                           std::vector<T>& rsvspace,
+                           std::vector<T>& wkspace,
+                           bool hx_is_null = false,
+                           bool dhy_is_null = false)
+{
+    int batch_n = sumvc(in_n);
+
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int out_stride = out_h;
+    int wei_stride = bi * 3 * hy_h;
+    int hy_stride  = bi * 4 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    // initial hidden states
+    auto ihs = hy_d * hy_n * hy_h;
+    std::vector<T> dcx(ihs);
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    // initial dropoput
+    miopenTensorDescriptor_t dropout_inputTensor{};
+    std::vector<unsigned char> dropout_reservespace_host;
+    if(use_dropout)
+    {
+        std::array<int, 2> drop_in_len = {{batch_n, hy_h * bi}};
+        std::array<int, 2> drop_in_str = {{hy_stride, 1}};
+        miopenCreateTensorDescriptor(&dropout_inputTensor);
+        miopenSetTensorDescriptor(
+            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
+
+        size_t reserveSpaceSizeInBytes = 0;
+        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
+        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
+        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
+                                                               static_cast<unsigned char>(0));
+
+        auto p_drop_rsv = reinterpret_cast<const unsigned char*>(&rsvspace.at(
+            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
+        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
+        {
+            dropout_reservespace_host.at(i) = *(p_drop_rsv + i);
+        }
+    }
+
+    // bwd data emulator
+    for(int li = numlayer - 1; li >= 0; li--)
+    {
+        int wei_shift     = (in_h + hy_h) * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+        int hid_shift     = li * batch_n * hy_stride;
+        int hx_shift      = li * in_n.at(0) * h_stride;
+        int weitime_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+
+        if(li == numlayer - 1)
+        {
+            for(int bs = 0; bs < batch_n; bs++)
+            {
+                for(int h = 0; h < out_h; h++)
+                {
+                    wkspace[hid_shift + bi * 3 * hy_h + bs * hy_stride + h] +=
+                        dout[bs * out_stride + h];
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift = (li + 1) * batch_n * hy_stride;
+
+            RNN_mm_cpu(&wkspace[prelayer_shift],
+                       hy_h * bi * 3,
+                       batch_n,
+                       hy_stride,
+                       0,
+                       &wei[wei_shift],
+                       hy_h * bi,
+                       hy_h * bi * 3,
+                       bi_stride,
+                       0,
+                       &wkspace[hid_shift + bi * 3 * hy_h],
+                       hy_h * bi,
+                       batch_n,
+                       hy_stride,
+                       0,
+                       1,
+                       1);
+
+            if(use_dropout)
+            {
+                dropout.backward(dropout_inputTensor,
+                                 wkspace,
+                                 dropout_inputTensor,
+                                 wkspace,
+                                 dropout_reservespace_host,
+                                 hid_shift + bi * 3 * hy_h,
+                                 hid_shift + bi * 3 * hy_h,
+                                 li * batch_n * hy_h * bi);
+            }
+        }
+
+        // from hidden state
+        int bacc   = batch_n;
+        int baccbi = 0;
+        for(int ti = seqLength - 1; ti >= 0; ti--)
+        {
+            bacc -= in_n.at(ti);
+
+            if(ti == seqLength - 1)
+            {
+                if(!dhy_is_null)
+                {
+                    for(int bs = 0; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                dhy[hx_shift + bs * uni_stride + h];
+                        }
+                    }
+
+                    if(bidirection)
+                    {
+                        for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                        {
+                            for(int h = 0; h < hy_h; h++)
+                            {
+                                wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                        hy_h + h] +=
+                                    dhy[hx_shift + bs * uni_stride + hy_n * hy_h + h];
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                if(!dhy_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                {
+                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                                dhy[hx_shift + bs * uni_stride + h];
+                        }
+                    }
+                }
+
+                int pretime_shift = li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride;
+
+                RNN_mm_cpu(&wkspace[pretime_shift],
+                           hy_h * 2,
+                           in_n.at(ti + 1),
+                           hy_stride,
+                           0,
+                           &wei[weitime_shift],
+                           hy_h,
+                           hy_h * 2,
+                           uni_stride,
+                           0,
+                           &wkspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
+                           hy_h,
+                           in_n.at(ti + 1),
+                           hy_stride,
+                           0,
+                           1,
+                           1);
+
+                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
+                            wkspace[pretime_shift + bs * hy_stride + bi * 3 * hy_h + h] *
+                            activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
+
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] =
+                            wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
+                            activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
+                    }
+                }
+
+                RNN_mm_cpu(&wkspace[hid_shift + bacc * hy_stride + 2 * hy_h],
+                           hy_h,
+                           in_n.at(ti + 1),
+                           hy_stride,
+                           0,
+                           &wei[weitime_shift + 2 * hy_h * uni_stride],
+                           hy_h,
+                           hy_h,
+                           uni_stride,
+                           0,
+                           &wkspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
+                           hy_h,
+                           in_n.at(ti + 1),
+                           hy_stride,
+                           0,
+                           1,
+                           1);
+
+                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
+                {
+                    auto subidx = hid_shift + (bacc + bs) * hy_stride + 2 * hy_h;
+                    std::fill(wkspace.begin() + subidx, wkspace.begin() + subidx + hy_h, 0);
+                }
+
+                if(bidirection)
+                {
+                    pretime_shift = li * batch_n * hy_stride +
+                                    (baccbi - in_n.at(seqLength - 2 - ti)) * hy_stride + hy_h * 3;
+
+                    RNN_mm_cpu(&wkspace[pretime_shift],
+                               hy_h * 2,
+                               in_n.at(seqLength - 1 - ti),
+                               hy_stride,
+                               0,
+                               &wei[weitime_shift + hy_h * 3 * uni_stride],
+                               hy_h,
+                               hy_h * 2,
+                               uni_stride,
+                               0,
+                               &wkspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
+                               hy_h,
+                               in_n.at(seqLength - 1 - ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                    h] +=
+                                wkspace[pretime_shift + bs * hy_stride + 3 * hy_h + hy_h + h] *
+                                activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
+
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] =
+                                wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
+                                activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
+                        }
+                    }
+
+                    RNN_mm_cpu(&wkspace[hid_shift + baccbi * hy_stride + 5 * hy_h],
+                               hy_h,
+                               in_n.at(seqLength - 1 - ti),
+                               hy_stride,
+                               0,
+                               &wei[weitime_shift + 5 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h,
+                               uni_stride,
+                               0,
+                               &wkspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
+                               hy_h,
+                               in_n.at(seqLength - 1 - ti),
+                               hy_stride,
+                               0,
+                               1,
+                               1);
+
+                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                    {
+                        auto subidx = hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h;
+                        std::fill(wkspace.begin() + subidx, wkspace.begin() + (subidx + hy_h), 0);
+                    }
+                }
+            }
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] +=
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
+                        (1 - activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
+                        dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
+                                      1);
+
+                    wkspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h] =
+                        (rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
+                                  numlayer * batch_n * hy_stride] *
+                         wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] *
+                         dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h],
+                                       2));
+
+                    if(ti == 0)
+                    {
+                        if(!hx_is_null)
+                        {
+                            wkspace[hid_shift + (bacc + bs) * hy_stride + h] +=
+                                (wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
+                                 hx[hx_shift + bs * uni_stride + h] *
+                                 dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h],
+                                               2));
+                        }
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + h] -=
+                            (wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
+                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
+                                       1) *
+                             dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2));
+                    }
+                    else
+                    {
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + h] +=
+                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
+                            (rsvspace[hid_shift + (bacc - in_n.at(ti - 1) + bs) * hy_stride +
+                                      bi * 3 * hy_h + h] -
+                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
+                                       1)) *
+                            dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2);
+                    }
+
+                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
+                             numlayer * batch_n * hy_stride] =
+                        wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] *
+                        rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h +
+                                 numlayer * batch_n * hy_stride];
+                }
+            }
+
+            if(bidirection)
+            {
+                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] +=
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                    h] *
+                            (1 - activfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
+                                     2)) *
+                            dervactivfunc(
+                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h], 1);
+
+                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h] =
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
+                                     h + numlayer * batch_n * hy_stride];
+
+                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h] *=
+                            (wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] *
+                             dervactivfunc(
+                                 rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h],
+                                 2));
+
+                        if(ti == 0)
+                        {
+                            if(!hx_is_null)
+                            {
+                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
+                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] *
+                                     hx[hx_shift + bs * uni_stride + hy_n * hy_h + h] *
+                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                            3 * hy_h + h],
+                                                   2));
+                            }
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] -=
+                                (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] *
+                                 activfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
+                                     1) *
+                                 dervactivfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
+                                     2));
+                        }
+                        else
+                        {
+                            if(!hx_is_null &&
+                               in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti) &&
+                               bs >= in_n.at(seqLength - ti))
+                            {
+                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
+                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] *
+                                     hx[hx_shift + bs * uni_stride + hy_n * hy_h + h] *
+                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                            3 * hy_h + h],
+                                                   2));
+                            }
+
+                            if(bs < in_n.at(seqLength - ti))
+                            {
+                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
+                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                             hy_h + h] *
+                                     rsvspace[hid_shift +
+                                              (baccbi + in_n.at(seqLength - 1 - ti) + bs) *
+                                                  hy_stride +
+                                              bi * 3 * hy_h + hy_h + h] *
+                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
+                                                            3 * hy_h + h],
+                                                   2));
+                            }
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] -=
+                                (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
+                                         hy_h + h] *
+                                 activfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
+                                     1) *
+                                 dervactivfunc(
+                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
+                                     2));
+                        }
+
+                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h +
+                                 numlayer * batch_n * hy_stride] =
+                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] *
+                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
+                                     numlayer * batch_n * hy_stride];
+                    }
+                }
+            }
+
+            baccbi += in_n.at(seqLength - 1 - ti);
+        }
+
+        // dhx
+        int pretime_shift = li * batch_n * hy_stride;
+
+        RNN_mm_cpu(&wkspace[pretime_shift],
+                   hy_h * 2,
+                   in_n.at(0),
+                   hy_stride,
+                   0,
+                   &wei[weitime_shift],
+                   hy_h,
+                   hy_h * 2,
+                   uni_stride,
+                   0,
+                   &dhx[hx_shift],
+                   hy_h,
+                   in_n.at(0),
+                   uni_stride,
+                   0,
+                   1,
+                   1);
+
+        for(int bs = 0; bs < in_n.at(0); bs++)
+        {
+            for(int h = 0; h < hy_h; h++)
+            {
+                dhx[hx_shift + bs * uni_stride + h] +=
+                    wkspace[pretime_shift + bs * hy_stride + bi * 3 * hy_h + h] *
+                    activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
+
+                dcx[hx_shift + bs * uni_stride + h] =
+                    wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
+                    activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
+            }
+        }
+
+        RNN_mm_cpu(&dcx[hx_shift],
+                   hy_h,
+                   in_n.at(0),
+                   uni_stride,
+                   0,
+                   &wei[weitime_shift + 2 * hy_h * uni_stride],
+                   hy_h,
+                   hy_h,
+                   uni_stride,
+                   0,
+                   &dhx[hx_shift],
+                   hy_h,
+                   in_n.at(0),
+                   uni_stride,
+                   0,
+                   1,
+                   1);
+
+        if(bidirection)
+        {
+            int ti = seqLength - 1, cur_bat = 0, pre_bat = batch_n;
+
+            while(ti >= 0)
+            {
+                pre_bat -= in_n.at(ti);
+                if(in_n.at(ti) > cur_bat)
+                {
+                    pretime_shift = li * batch_n * hy_stride + (pre_bat + cur_bat) * hy_stride;
+
+                    RNN_mm_cpu(&wkspace[pretime_shift + 3 * hy_h],
+                               hy_h * 2,
+                               (in_n.at(ti) - cur_bat),
+                               hy_stride,
+                               0,
+                               &wei[weitime_shift + 3 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h * 2,
+                               uni_stride,
+                               0,
+                               &dhx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
+                               hy_h,
+                               (in_n.at(ti) - cur_bat),
+                               uni_stride,
+                               0,
+                               1,
+                               1);
+
+                    for(int bs = cur_bat; bs < in_n.at(ti); bs++)
+                    {
+                        for(int h = 0; h < hy_h; h++)
+                        {
+                            dhx[hx_shift + bs * uni_stride + hy_n * hy_h + h] +=
+                                wkspace[pretime_shift + (bs - cur_bat) * hy_stride + bi * 3 * hy_h +
+                                        hy_h + h] *
+                                activfunc(rsvspace[pretime_shift + (bs - cur_bat) * hy_stride +
+                                                   3 * hy_h + h],
+                                          2);
+
+                            dcx[hx_shift + bs * uni_stride + hy_n * hy_h + h] =
+                                wkspace[pretime_shift + (bs - cur_bat) * hy_stride + 5 * hy_h + h] *
+                                activfunc(rsvspace[pretime_shift + (bs - cur_bat) * hy_stride +
+                                                   4 * hy_h + h],
+                                          2);
+                        }
+                    }
+
+                    RNN_mm_cpu(&dcx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
+                               hy_h,
+                               (in_n.at(ti) - cur_bat),
+                               uni_stride,
+                               0,
+                               &wei[weitime_shift + 5 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h,
+                               uni_stride,
+                               0,
+                               &dhx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
+                               hy_h,
+                               (in_n.at(ti) - cur_bat),
+                               uni_stride,
+                               0,
+                               1,
+                               1);
+                }
+                cur_bat = in_n.at(ti--);
+            }
+        }
+    }
+
+    // dinput
+    if(inputMode == 1)
+    {
+        for(int bs = 0; bs < batch_n; bs++)
+        {
+            for(int h = 0; h < hy_h; h++)
+            {
+                for(int gi = 0; gi < 3; gi++)
+                {
+                    din[bs * in_stride + h] += wkspace[bs * hy_stride + gi * hy_h + h];
+                    if(bidirection)
+                    {
+                        din[bs * in_stride + h] += wkspace[bs * hy_stride + (gi + 3) * hy_h + h];
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        RNN_mm_cpu(wkspace.data(),
+                   hy_h * bi * 3,
+                   batch_n,
+                   hy_stride,
+                   0,
+                   wei.data(),
+                   in_h,
+                   hy_h * bi * 3,
+                   in_stride,
+                   0,
+                   din.data(),
+                   in_h,
+                   batch_n,
+                   in_stride,
+                   0,
+                   1,
+                   1);
+    }
+}
+
+/// Backward weights pass of a GRU. Accumulates into dwei from the rsvspace and the wkspace of
+/// cpu_gru_backward_data, scaling the gate gradients in wkspace as it goes.
+template <typename T>
+void cpu_gru_backward_weights(bool use_dropout,
+                              const std::vector<T>& in,
+                              std::vector<T>& dwei,
+                              const std::vector<T>& hx,
+                              const std::vector<int>& in_n,
+                              int in_h,
+                              int seqLength,
+                              bool bidirection,
+                              bool biased,
+                              int hy_d,
+                              int hy_n,
+                              int hy_h,
+                              int inputMode,
+                              const std::vector<T>& rsvspace,
+                              std::vector<T>& wkspace,
+                              bool hx_is_null = false)
+{
+    int batch_n  = sumvc(in_n);
+    int numlayer = bidirection ? hy_d / 2 : hy_d;
+    int bi       = bidirection ? 2 : 1;
+
+    int in_stride  = in_h;
+    int wei_stride = bi * 3 * hy_h;
+    int hy_stride  = bi * 4 * hy_h;
+    int h_stride   = bi * hy_h;
+    int uni_stride = hy_h;
+    int bi_stride  = hy_h * bi;
+
+    if(inputMode == 1)
+    {
+        if(in_h != hy_h)
+        {
+            std::cout
+                << "Verification cannot be completed: The input tensor size must equal to the "
+                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
+            return;
+        }
+        in_h = 0;
+    }
+
+    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
+
+    // bwd weights emulator
+    for(int li = 0; li < numlayer; li++)
+    {
+        // between layers
+        if(li == 0)
+        {
+            if(inputMode == 0)
+            {
+                RNN_mm_cpu(wkspace.data(),
+                           hy_h * bi * 3,
+                           batch_n,
+                           hy_stride,
+                           RNN_MM_TRANSPOSE,
+                           in.data(),
+                           in_h,
+                           batch_n,
+                           in_stride,
+                           0,
+                           dwei.data(),
+                           in_h,
+                           hy_h * bi * 3,
+                           in_stride,
+                           0,
+                           1,
+                           1);
+            }
+
+            if(biased)
+            {
+                for(int h = 0; h < wei_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei[wei_shift_bias + h] += wkspace[w * hy_stride + h];
+                    }
+                }
+            }
+        }
+        else
+        {
+            int prelayer_shift =
+                use_dropout ? 2 * numlayer * batch_n * hy_stride + (li - 1) * batch_n * hy_h * bi
+                            : (li - 1) * batch_n * hy_stride + bi * hy_h * 3;
+            int hid_shift = li * batch_n * hy_stride;
+            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
+
+            RNN_mm_cpu(&wkspace[hid_shift],
+                       hy_h * bi * 3,
+                       batch_n,
+                       hy_stride,
+                       RNN_MM_TRANSPOSE,
+                       &rsvspace[prelayer_shift],
+                       hy_h * bi,
+                       batch_n,
+                       use_dropout ? hy_h * bi : hy_stride,
+                       0,
+                       &dwei[wei_shift],
+                       hy_h * bi,
+                       hy_h * bi * 3,
+                       bi_stride,
+                       0,
+                       1,
+                       1);
+
+            if(biased)
+            {
+                wei_shift = wei_shift_bias + li * 2 * wei_stride;
+
+                for(int h = 0; h < wei_stride; h++)
+                {
+                    for(int w = 0; w < batch_n; w++)
+                    {
+                        dwei[wei_shift + h] += wkspace[hid_shift + w * hy_stride + h];
+                    }
+                }
+            }
+        }
+
+        // between time
+        int bacc = 0;
+        for(int ti = 0; ti < seqLength; ti++)
+        {
+            int hid_shift = li * batch_n * hy_stride + bacc * hy_stride;
+            int hx_shift  = li * in_n.at(0) * h_stride;
+            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
+            int pretime_shift;
+
+            for(int bs = 0; bs < in_n.at(ti); bs++)
+            {
+                for(int h = 0; h < hy_h; h++)
+                {
+                    wkspace[hid_shift + bs * hy_stride + 2 * hy_h + h] *=
+                        activfunc(rsvspace[hid_shift + bs * hy_stride + hy_h + h], 2);
+                }
+            }
+
+            // between time
+            if(ti == 0)
+            {
+                if(!hx_is_null)
+                {
+                    RNN_mm_cpu(&wkspace[hid_shift],
+                               hy_h * 3,
+                               in_n.at(ti),
+                               hy_stride,
+                               RNN_MM_TRANSPOSE,
+                               &hx[hx_shift],
+                               hy_h,
+                               in_n.at(ti),
+                               uni_stride,
+                               0,
+                               &dwei[wei_shift],
+                               hy_h,
+                               hy_h * 3,
+                               uni_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                        for(int h = 0; h < hy_h * 3; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti); w++)
+                            {
+                                dwei[bias_shift + h] += wkspace[hid_shift + w * hy_stride + h];
+                            }
+                        }
+                    }
+                }
+            }
+            else
+            {
+                pretime_shift =
+                    li * batch_n * hy_stride + (bacc - in_n.at(ti - 1)) * hy_stride + bi * 3 * hy_h;
+
+                RNN_mm_cpu(&wkspace[hid_shift],
+                           hy_h * 3,
+                           in_n.at(ti),
+                           hy_stride,
+                           RNN_MM_TRANSPOSE,
+                           &rsvspace[pretime_shift],
+                           hy_h,
+                           in_n.at(ti),
+                           hy_stride,
+                           0,
+                           &dwei[wei_shift],
+                           hy_h,
+                           hy_h * 3,
+                           uni_stride,
+                           0,
+                           1,
+                           1);
+
+                if(biased)
+                {
+                    int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                    for(int h = 0; h < hy_h * 3; h++)
+                    {
+                        for(int w = 0; w < in_n.at(ti); w++)
+                        {
+                            dwei[bias_shift + h] += wkspace[hid_shift + w * hy_stride + h];
+                        }
+                    }
+                }
+            }
+
+            if(bidirection)
+            {
+                for(int bs = 0; bs < in_n.at(ti); bs++)
+                {
+                    for(int h = 0; h < hy_h; h++)
+                    {
+                        wkspace[hid_shift + bs * hy_stride + 5 * hy_h + h] *=
+                            activfunc(rsvspace[hid_shift + bs * hy_stride + 4 * hy_h + h], 2);
+                    }
+                }
+
+                if(ti == seqLength - 1)
+                {
+                    if(!hx_is_null)
+                    {
+                        RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h],
+                                   hy_h * 3,
+                                   in_n.at(ti),
+                                   hy_stride,
+                                   RNN_MM_TRANSPOSE,
+                                   &hx[hx_shift + hy_n * hy_h],
+                                   hy_h,
+                                   in_n.at(ti),
+                                   uni_stride,
+                                   0,
+                                   &dwei[wei_shift + 3 * hy_h * uni_stride],
+                                   hy_h,
+                                   hy_h * 3,
+                                   uni_stride,
+                                   0,
+                                   1,
+                                   1);
+
+                        if(biased)
+                        {
+                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                            for(int h = 0; h < hy_h * 3; h++)
+                            {
+                                for(int w = 0; w < in_n.at(ti); w++)
+                                {
+                                    dwei[bias_shift + 3 * hy_h + h] +=
+                                        wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
+                                }
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    if(!hx_is_null && in_n.at(ti) > in_n.at(ti + 1))
+                    {
+                        RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h + in_n.at(ti + 1) * hy_stride],
+                                   hy_h * 3,
+                                   (in_n.at(ti) - in_n.at(ti + 1)),
+                                   hy_stride,
+                                   RNN_MM_TRANSPOSE,
+                                   &hx[hx_shift + hy_n * hy_h + in_n.at(ti + 1) * hy_h],
+                                   hy_h,
+                                   (in_n.at(ti) - in_n.at(ti + 1)),
+                                   uni_stride,
+                                   0,
+                                   &dwei[wei_shift + 3 * hy_h * uni_stride],
+                                   hy_h,
+                                   hy_h * 3,
+                                   uni_stride,
+                                   0,
+                                   1,
+                                   1);
+
+                        if(biased)
+                        {
+                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                            for(int h = 0; h < hy_h * 3; h++)
+                            {
+                                for(int w = in_n.at(ti + 1); w < in_n.at(ti); w++)
+                                {
+                                    dwei[bias_shift + 3 * hy_h + h] +=
+                                        wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
+                                }
+                            }
+                        }
+                    }
+
+                    pretime_shift =
+                        li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride + bi * 3 * hy_h;
+
+                    RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h],
+                               hy_h * 3,
+                               in_n.at(ti + 1),
+                               hy_stride,
+                               RNN_MM_TRANSPOSE,
+                               &rsvspace[pretime_shift + hy_h],
+                               hy_h,
+                               in_n.at(ti + 1),
+                               hy_stride,
+                               0,
+                               &dwei[wei_shift + 3 * hy_h * uni_stride],
+                               hy_h,
+                               hy_h * 3,
+                               uni_stride,
+                               0,
+                               1,
+                               1);
+
+                    if(biased)
+                    {
+                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
+
+                        for(int h = 0; h < hy_h * 3; h++)
+                        {
+                            for(int w = 0; w < in_n.at(ti + 1); w++)
+                            {
+                                dwei[bias_shift + 3 * hy_h + h] +=
+                                    wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
+                            }
+                        }
+                    }
+                }
+            }
+
+            bacc += in_n.at(ti);
+        }
+    }
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include "tensor_holder.hpp"
 #include "test.hpp"
 #include "verify.hpp"
+#include "verify_cache.hpp"
 
 #include <functional>
 #include <deque>
@@ -42,7 +43,7 @@
 #include <boost/filesystem.hpp>
 #include <miopen/functional.hpp>
 #include <miopen/expanduser.hpp>
-#include <miopen/md5.hpp>
+#include <miopen/content_hash.hpp>
 #include <miopen/type_name.hpp>
 #include <miopen/env.hpp>
 #include <miopen/rank.hpp>
@@ -98,6 +99,9 @@ auto cpu_async(V& v, Ts&&... xs) -> std::future<decltype(v.cpu(xs...))>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_PATH)
 
+// Seed of std::rand() the test data is generated with
+constexpr unsigned int test_data_seed = 65521;
+
 struct test_driver
 {
     test_driver()                   = default;
@@ -157,7 +161,7 @@ struct test_driver
     std::string program_name;
     std::deque<argument> arguments;
     std::unordered_map<std::string, std::size_t> argument_index;
-    int cache_version      = 1;
+    int cache_version      = 2;
     std::string cache_path = compute_cache_path();
     miopenDataType_t type  = miopenFloat;
     bool full_set          = false;
@@ -729,18 +733,23 @@ struct test_driver
         using result_type = decltype(v.cpu(xs...));
         if(is_cache_disabled() or not is_const_cpu(v, xs...))
             return cpu_async(v, xs...);
-        auto key = miopen::get_type_name<V>() + "-" + miopen::md5(get_command_args());
+        auto key = miopen::get_type_name<V>() + "-" + miopen::ContentHash(get_command_args());
         auto p =
             boost::filesystem::path{miopen::ExpandUser(cache_path)} / std::to_string(cache_version);
         if(!boost::filesystem::exists(p))
             boost::filesystem::create_directories(p);
-        auto f = p / key;
+        auto f    = p / key;
+        auto seed = (static_cast<std::uint64_t>(dataset_id) << 32) | test_data_seed;
         if(boost::filesystem::exists(f) and not retry)
         {
             miss = false;
-            return detach_async([=] {
+            return detach_async([&, f, seed] {
                 result_type result;
-                load(f.string(), result);
+                if(verify_cache::load(f, seed, result))
+                    return result;
+                // Stale or broken file
+                result = v.cpu(xs...);
+                verify_cache::save(f, seed, result);
                 return result;
             });
         }
@@ -748,7 +757,7 @@ struct test_driver
         {
             miss = true;
             return then(cpu_async(v, xs...), [=](auto data) {
-                save(f.string(), data);
+                verify_cache::save(f, seed, data);
                 return data;
             });
         }
@@ -913,9 +922,9 @@ struct test_driver
             }
             else
             {
-                std::srand(65521);
+                std::srand(test_data_seed);
                 static_cast<Derived*>(this)->run();
-                std::srand(65521);
+                std::srand(test_data_seed);
             }
         }
         this->iteration++;
@@ -1089,10 +1098,10 @@ build_configs(Driver& d,
     std::vector<typename Driver::argument*> data_args = get_data_args<Driver>(d, arg_map);
 
     run_data(data_args.begin(), data_args.end(), [&] {
-        std::srand(65521);
+        std::srand(test_data_seed);
         std::vector<std::string> config = d.get_config();
         configs.push_back(config);
-        std::srand(65521);
+        std::srand(test_data_seed);
     });
     std::cout << " done." << std::endl;
     return configs;
@@ -1148,9 +1157,9 @@ void run_config(std::vector<std::string>& config,
     for(int j = 0; j < test_repeat_count; j++)
     {
         run_data(config_data_args.begin(), config_data_args.end(), [&] {
-            std::srand(65521);
+            std::srand(test_data_seed);
             config_driver.run();
-            std::srand(65521);
+            std::srand(test_data_seed);
         });
     }
 }
@@ -1292,7 +1301,7 @@ void test_drive_impl_1(std::string program_name, std::vector<std::string> as)
             data_args.push_back(&arg);
         }
     }
-    std::srand(65521);
+    std::srand(test_data_seed);
     for(int i = 0; i < d.repeat; i++)
     {
         d.iteration = 0;
@@ -83,750 +83,25 @@ void GRUFwdCPUVerify(miopen::Handle& handle,
                      std::vector<T>& rsvspace,
                      bool hx_is_null = false)
 {
-    int batch_n = sumvc(in_n);
-
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int out_stride = out_h;
-    int wei_stride = bi * 3 * hy_h;
-    int hy_stride  = bi * 4 * hy_h;
-    int h_stride   = bi * hy_h;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
-
-    // initial dropoput
-    std::vector<prngStates> dropout_states_host;
-    std::vector<unsigned char> dropout_reservespace_host;
-    std::vector<T> dropout_hid_state;
-    miopenTensorDescriptor_t dropout_inputTensor{}, dropout_outputTensor{};
-    if(use_dropout)
-    {
-        size_t states_size  = dropoutDesc.stateSizeInBytes / sizeof(prngStates);
-        dropout_states_host = std::vector<prngStates>(states_size);
-        InitKernelStateEmulator(dropout_states_host, dropoutDesc);
-
-        std::array<int, 2> drop_in_len  = {{batch_n, hy_h * bi}};
-        std::array<int, 2> drop_in_str  = {{hy_stride, 1}};
-        std::array<int, 2> drop_out_str = {{hy_h * bi, 1}};
-        miopenCreateTensorDescriptor(&dropout_inputTensor);
-        miopenCreateTensorDescriptor(&dropout_outputTensor);
-        miopenSetTensorDescriptor(
-            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
-        miopenSetTensorDescriptor(
-            dropout_outputTensor, miopenFloat, 2, drop_in_len.data(), drop_out_str.data());
-
-        size_t reserveSpaceSizeInBytes = 0;
-        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
-        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
-        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
-                                                               static_cast<unsigned char>(1));
-
-        dropout_hid_state = std::vector<T>((numlayer - 1) * batch_n * hy_h * bi, static_cast<T>(0));
-    }
-
-    // forward emulator
-    for(int li = 0; li < numlayer; li++)
-    {
-        int hid_shift           = li * batch_n * hy_stride;
-        int hx_shift            = li * in_n.at(0) * h_stride;
-        int wei_shift_bias_temp = wei_shift_bias + li * 2 * wei_stride;
-
-        // from input
-        if(li == 0)
-        {
-            if(inputMode == 1)
-            {
-                for(int bs = 0; bs < batch_n; bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        for(int gi = 0; gi < 3; gi++)
-                        {
-                            rsvspace[hid_shift + bs * hy_stride + gi * hy_h + h] +=
-                                in[bs * in_stride + h];
-                            if(bidirection)
-                            {
-                                rsvspace[hid_shift + bs * hy_stride + (gi + 3) * hy_h + h] +=
-                                    in[bs * in_stride + h];
-                            }
-                        }
-                    }
-                }
-
-                // from bias
-                if(biased)
-                {
-                    for(int bs = 0; bs < batch_n; bs++)
-                    {
-                        for(int h = 0; h < wei_stride; h++)
-                        {
-                            rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias + h];
-                        }
-                    }
-                }
-            }
-            else
-            {
-                RNN_mm_cpu(in.data(),
-                           in_h,
-                           batch_n,
-                           in_stride,
-                           0,
-                           wei.data(), // wei_state.data(),
-                           in_h,
-                           hy_h * bi * 3,
-                           in_stride,
-                           RNN_MM_TRANSPOSE,
-                           &rsvspace[hid_shift],
-                           hy_h * bi * 3,
-                           batch_n,
-                           hy_stride,
-                           0,
-                           1,
-                           1);
-
-                // from bias
-                if(biased)
-                {
-                    for(int bs = 0; bs < batch_n; bs++)
-                    {
-                        for(int h = 0; h < wei_stride; h++)
-                        {
-                            rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias + h];
-                        }
-                    }
-                }
-            }
-        }
-        else
-        {
-            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
-            int prelayer_shift = (li - 1) * batch_n * hy_stride + bi * 3 * hy_h;
-            if(use_dropout)
-            {
-                auto dropout_states_tmp = dropout_states_host;
-                size_t drop_out_offset  = (static_cast<size_t>(li) - 1) * batch_n * hy_h * bi;
-
-                DropoutForwardVerify<T>(handle,
-                                        dropoutDesc,
-                                        miopen::deref(dropout_inputTensor),
-                                        rsvspace,
-                                        miopen::deref(dropout_outputTensor),
-                                        dropout_hid_state,
-                                        dropout_reservespace_host,
-                                        dropout_states_tmp,
-                                        prelayer_shift,
-                                        drop_out_offset,
-                                        drop_out_offset);
-
-                prelayer_shift = drop_out_offset;
-            }
-
-            RNN_mm_cpu(use_dropout ? &dropout_hid_state[prelayer_shift] : &rsvspace[prelayer_shift],
-                       hy_h * bi,
-                       batch_n,
-                       use_dropout ? hy_h * bi : hy_stride,
-                       0,
-                       &wei[wei_shift], //&wei_state[wei_shift],
-                       hy_h * bi,
-                       hy_h * bi * 3,
-                       bi_stride,
-                       RNN_MM_TRANSPOSE,
-                       &rsvspace[hid_shift],
-                       hy_h * bi * 3,
-                       batch_n,
-                       hy_stride,
-                       0,
-                       1,
-                       1);
-
-            // from bias
-            if(biased)
-            {
-                for(int bs = 0; bs < batch_n; bs++)
-                {
-                    for(int h = 0; h < wei_stride; h++)
-                    {
-                        rsvspace[hid_shift + bs * hy_stride + h] += wei[wei_shift_bias_temp + h];
-                    }
-                }
-            }
-        }
-
-        // from hidden state
-        int bacc   = 0;
-        int baccbi = batch_n;
-        for(int ti = 0; ti < seqLength; ti++)
-        {
-            baccbi -= in_n.at(seqLength - 1 - ti);
-            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
-            int pretime_shift;
-
-            if(ti == 0)
-            {
-                if(!hx_is_null)
-                {
-                    RNN_mm_cpu(&hx[hx_shift],
-                               hy_h,
-                               in_n.at(ti),
-                               uni_stride,
-                               0,
-                               &wei[wei_shift],
-                               hy_h,
-                               hy_h * 2,
-                               uni_stride,
-                               RNN_MM_TRANSPOSE,
-                               &rsvspace[hid_shift + bacc * hy_stride],
-                               hy_h * 2,
-                               in_n.at(ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        for(int bs = 0; bs < in_n.at(ti); bs++)
-                        {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                for(int gi = 0; gi < 2; gi++)
-                                {
-                                    rsvspace[hid_shift + (bacc + bs) * hy_stride + gi * hy_h + h] +=
-                                        wei[wei_shift_bias_temp + wei_stride + gi * hy_h + h];
-                                }
-                            }
-                        }
-                    }
-
-                    RNN_mm_cpu(&hx[hx_shift],
-                               hy_h,
-                               in_n.at(ti),
-                               uni_stride,
-                               0,
-                               &wei[wei_shift + 2 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h,
-                               uni_stride,
-                               RNN_MM_TRANSPOSE,
-                               &rsvspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
-                               hy_h,
-                               in_n.at(ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        for(int bs = 0; bs < in_n.at(ti); bs++)
-                        {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                    wei[wei_shift_bias_temp + wei_stride + 2 * hy_h + h];
-                            }
-                        }
-                    }
-
-                    if(bidirection)
-                    {
-                        RNN_mm_cpu(&hx[hx_shift + hy_n * hy_h],
-                                   hy_h,
-                                   in_n.at(seqLength - 1 - ti),
-                                   uni_stride,
-                                   0,
-                                   &wei[wei_shift + 3 * hy_h * uni_stride],
-                                   hy_h,
-                                   hy_h * 2,
-                                   uni_stride,
-                                   RNN_MM_TRANSPOSE,
-                                   &rsvspace[hid_shift + baccbi * hy_stride + 3 * hy_h],
-                                   hy_h * 2,
-                                   in_n.at(seqLength - 1 - ti),
-                                   hy_stride,
-                                   0,
-                                   1,
-                                   1);
-
-                        if(biased)
-                        {
-                            for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                            {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    for(int gi = 0; gi < 2; gi++)
-                                    {
-                                        rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                 (3 + gi) * hy_h + h] +=
-                                            wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h +
-                                                h];
-                                    }
-                                }
-                            }
-                        }
-
-                        RNN_mm_cpu(&hx[hx_shift + hy_n * hy_h],
-                                   hy_h,
-                                   in_n.at(seqLength - 1 - ti),
-                                   uni_stride,
-                                   0,
-                                   &wei[wei_shift + 5 * hy_h * uni_stride],
-                                   hy_h,
-                                   hy_h,
-                                   uni_stride,
-                                   RNN_MM_TRANSPOSE,
-                                   &rsvspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
-                                   hy_h,
-                                   in_n.at(seqLength - 1 - ti),
-                                   hy_stride,
-                                   0,
-                                   1,
-                                   1);
-
-                        if(biased)
-                        {
-                            for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                            {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] +=
-                                        wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                RNN_mm_cpu(&hy[hx_shift],
-                           hy_h,
-                           in_n.at(ti),
-                           uni_stride,
-                           0,
-                           &wei[wei_shift],
-                           hy_h,
-                           hy_h * 2,
-                           uni_stride,
-                           RNN_MM_TRANSPOSE,
-                           &rsvspace[hid_shift + bacc * hy_stride],
-                           hy_h * 2,
-                           in_n.at(ti),
-                           hy_stride,
-                           0,
-                           1,
-                           1);
-
-                if(biased)
-                {
-                    for(int bs = 0; bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            for(int gi = 0; gi < 2; gi++)
-                            {
-                                rsvspace[hid_shift + (bacc + bs) * hy_stride + gi * hy_h + h] +=
-                                    wei[wei_shift_bias_temp + wei_stride + gi * hy_h + h];
-                            }
-                        }
-                    }
-                }
-
-                RNN_mm_cpu(&hy[hx_shift],
-                           hy_h,
-                           in_n.at(ti),
-                           uni_stride,
-                           0,
-                           &wei[wei_shift + 2 * hy_h * uni_stride],
-                           hy_h,
-                           hy_h,
-                           uni_stride,
-                           RNN_MM_TRANSPOSE,
-                           &rsvspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
-                           hy_h,
-                           in_n.at(ti),
-                           hy_stride,
-                           0,
-                           1,
-                           1);
-
-                if(biased)
-                {
-                    for(int bs = 0; bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                wei[wei_shift_bias_temp + wei_stride + 2 * hy_h + h];
-                        }
-                    }
-                }
-
-                if(bidirection)
-                {
-
-                    if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
-                    {
-                        RNN_mm_cpu(
-                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
-                            hy_h,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            uni_stride,
-                            0,
-                            &wei[wei_shift + 3 * hy_h * uni_stride],
-                            hy_h,
-                            hy_h * 2,
-                            uni_stride,
-                            RNN_MM_TRANSPOSE,
-                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
-                                      3 * hy_h],
-                            hy_h * 2,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            hy_stride,
-                            0,
-                            1,
-                            1);
-
-                        if(biased)
-                        {
-                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
-                                bs++)
-                            {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    for(int gi = 0; gi < 2; gi++)
-                                    {
-                                        rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                 (3 + gi) * hy_h + h] +=
-                                            wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h +
-                                                h];
-                                    }
-                                }
-                            }
-                        }
-
-                        RNN_mm_cpu(
-                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
-                            hy_h,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            uni_stride,
-                            0,
-                            &wei[wei_shift + 5 * hy_h * uni_stride],
-                            hy_h,
-                            hy_h,
-                            uni_stride,
-                            RNN_MM_TRANSPOSE,
-                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
-                                      bi * 3 * hy_h + hy_h],
-                            hy_h,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            hy_stride,
-                            0,
-                            1,
-                            1);
-
-                        if(biased)
-                        {
-                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
-                                bs++)
-                            {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] +=
-                                        wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
-                                }
-                            }
-                        }
-                    }
-
-                    RNN_mm_cpu(&hy[hx_shift + hy_n * hy_h],
-                               hy_h,
-                               in_n.at(seqLength - ti),
-                               uni_stride,
-                               0,
-                               &wei[wei_shift + 3 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h * 2,
-                               uni_stride,
-                               RNN_MM_TRANSPOSE,
-                               &rsvspace[hid_shift + baccbi * hy_stride + 3 * hy_h],
-                               hy_h * 2,
-                               in_n.at(seqLength - ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        for(int bs = 0; bs < in_n.at(seqLength - ti); bs++)
-                        {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                for(int gi = 0; gi < 2; gi++)
-                                {
-                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                             (3 + gi) * hy_h + h] +=
-                                        wei[wei_shift_bias_temp + wei_stride + (3 + gi) * hy_h + h];
-                                }
-                            }
-                        }
-                    }
-
-                    RNN_mm_cpu(&hy[hx_shift + hy_n * hy_h],
-                               hy_h,
-                               in_n.at(seqLength - ti),
-                               uni_stride,
-                               0,
-                               &wei[wei_shift + 5 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h,
-                               uni_stride,
-                               RNN_MM_TRANSPOSE,
-                               &rsvspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
-                               hy_h,
-                               in_n.at(seqLength - ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        for(int bs = 0; bs < in_n.at(seqLength - ti); bs++)
-                        {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] +=
-                                    wei[wei_shift_bias_temp + wei_stride + 5 * hy_h + h];
-                            }
-                        }
-                    }
-                }
-            }
-
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
-                {
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
-                             numlayer * batch_n * hy_stride] =
-                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
-
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] +=
-                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h], 2) *
-                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] = 0;
-
-                    if(ti == 0)
-                    {
-                        if(!hx_is_null)
-                        {
-                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                ((1 -
-                                  activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
-                                     activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride +
-                                                        2 * hy_h + h],
-                                               1) +
-                                 activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2) *
-                                     hx[hx_shift + bs * uni_stride + h]);
-                        }
-                        else
-                        {
-                            rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                ((1 -
-                                  activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
-                                 activfunc(
-                                     rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
-                                     1));
-                        }
-                    }
-                    else
-                    {
-
-                        pretime_shift = li * batch_n * hy_stride +
-                                        (bacc - in_n.at(ti - 1)) * hy_stride + bi * 3 * hy_h;
-
-                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                            ((1 - activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
-                                 activfunc(
-                                     rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
-                                     1) +
-                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2) *
-                                 rsvspace[pretime_shift + bs * hy_stride + h]);
-                    }
-
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + h +
-                             numlayer * batch_n * hy_stride] =
-                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2);
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h +
-                             numlayer * batch_n * hy_stride] =
-                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h], 2);
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h +
-                             numlayer * batch_n * hy_stride] =
-                        activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h], 1);
-
-                    // Update final state
-                    hy[hx_shift + bs * uni_stride + h] =
-                        rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h];
-                }
-            }
-
-            if(bidirection)
-            {
-                pretime_shift = li * batch_n * hy_stride +
-                                (baccbi + in_n.at(seqLength - 1 - ti)) * hy_stride + bi * 3 * hy_h +
-                                hy_h;
-
-                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h +
-                                 numlayer * batch_n * hy_stride] =
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                     h];
-
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] +=
-                            activfunc(
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h], 2) *
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                     h];
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h] =
-                            0;
-
-                        if(ti == 0)
-                        {
-                            if(!hx_is_null)
-                            {
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] +=
-                                    ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                             3 * hy_h + h],
-                                                    2)) *
-                                         activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                            5 * hy_h + h],
-                                                   1) +
-                                     activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                        3 * hy_h + h],
-                                               2) *
-                                         hx[hx_shift + bs * uni_stride + hy_n * hy_h + h]);
-                            }
-                            else
-                            {
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] +=
-                                    ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                             3 * hy_h + h],
-                                                    2)) *
-                                     activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                        5 * hy_h + h],
-                                               1));
-                            }
-                        }
-                        else
-                        {
-                            if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
-                            {
-                                if(bs >= in_n.at(seqLength - ti))
-                                {
-                                    rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] +=
-                                        (activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                            3 * hy_h + h],
-                                                   2) *
-                                         hx[hx_shift + bs * uni_stride + hy_n * hy_h + h]);
-                                }
-                            }
-
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                     h] +=
-                                ((1 - activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                         3 * hy_h + h],
-                                                2)) *
-                                 activfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
-                                     1));
-
-                            if(bs < in_n.at(seqLength - ti))
-                            {
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] +=
-                                    (activfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                        3 * hy_h + h],
-                                               2) *
-                                     rsvspace[pretime_shift + bs * hy_stride + h]);
-                            }
-                        }
-
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h +
-                                 numlayer * batch_n * hy_stride] =
-                            activfunc(
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h], 2);
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
-                                 numlayer * batch_n * hy_stride] =
-                            activfunc(
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h], 2);
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h +
-                                 numlayer * batch_n * hy_stride] =
-                            activfunc(
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h], 1);
-
-                        // Update final hidden state
-                        hy[hx_shift + bs * uni_stride + hy_n * hy_h + h] =
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                     h];
-                    }
-                }
-            }
-
-            bacc += in_n.at(ti);
-        }
-    }
-
-    // output
-    int prelayer_shift = (numlayer - 1) * batch_n * hy_stride + bi * 3 * hy_h;
-    for(int bs = 0; bs < batch_n; bs++)
-    {
-        for(int h = 0; h < out_h; h++)
-        {
-            out[bs * out_stride + h] = rsvspace[prelayer_shift + bs * hy_stride + h];
-        }
-    }
-
-    if(use_dropout)
-    {
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            rsvspace.at(numlayer * batch_n * hy_stride * 2 + i) = dropout_hid_state.at(i);
-        }
-        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
-            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            *(p_drop_rsv + i) = dropout_reservespace_host.at(i);
-        }
-    }
+    cpu_gru_forward(use_dropout,
+                    rnn_dropout_verify<T>(handle, dropoutDesc),
+                    in,
+                    wei,
+                    hy,
+                    hx,
+                    out,
+                    in_n,
+                    in_h,
+                    seqLength,
+                    bidirection,
+                    biased,
+                    hy_d,
+                    hy_n,
+                    hy_h,
+                    out_h,
+                    inputMode,
+                    rsvspace,
+                    hx_is_null);
 }
 
 template <typename T>
@@ -859,598 +134,28 @@ void GRUBwdDataCPUVerify(bool use_dropout,
                          bool hx_is_null  = false,
                          bool dhy_is_null = false)
 {
-    int batch_n = sumvc(in_n);
     (void)out;
-
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int out_stride = out_h;
-    int wei_stride = bi * 3 * hy_h;
-    int hy_stride  = bi * 4 * hy_h;
-    int h_stride   = bi * hy_h;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
-    // initial hidden states
-    auto ihs = hy_d * hy_n * hy_h;
-    std::vector<T> dcx(ihs);
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    // initial dropoput
-    miopenTensorDescriptor_t dropout_inputTensor{};
-    std::vector<unsigned char> dropout_reservespace_host;
-    if(use_dropout)
-    {
-        std::array<int, 2> drop_in_len = {{batch_n, hy_h * bi}};
-        std::array<int, 2> drop_in_str = {{hy_stride, 1}};
-        miopenCreateTensorDescriptor(&dropout_inputTensor);
-        miopenSetTensorDescriptor(
-            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
-
-        size_t reserveSpaceSizeInBytes = 0;
-        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
-        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
-        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
-                                                               static_cast<unsigned char>(0));
-
-        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
-            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            dropout_reservespace_host.at(i) = *(p_drop_rsv + i);
-        }
-    }
-
-    // bwd data emulator
-    for(int li = numlayer - 1; li >= 0; li--)
-    {
-        int wei_shift     = (in_h + hy_h) * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
-        int hid_shift     = li * batch_n * hy_stride;
-        int hx_shift      = li * in_n.at(0) * h_stride;
-        int weitime_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
-
-        if(li == numlayer - 1)
-        {
-            for(int bs = 0; bs < batch_n; bs++)
-            {
-                for(int h = 0; h < out_h; h++)
-                {
-                    wkspace[hid_shift + bi * 3 * hy_h + bs * hy_stride + h] +=
-                        dout[bs * out_stride + h];
-                }
-            }
-        }
-        else
-        {
-            int prelayer_shift = (li + 1) * batch_n * hy_stride;
-
-            RNN_mm_cpu(&wkspace[prelayer_shift],
-                       hy_h * bi * 3,
-                       batch_n,
-                       hy_stride,
-                       0,
-                       &wei[wei_shift],
-                       hy_h * bi,
-                       hy_h * bi * 3,
-                       bi_stride,
-                       0,
-                       &wkspace[hid_shift + bi * 3 * hy_h],
-                       hy_h * bi,
-                       batch_n,
-                       hy_stride,
-                       0,
-                       1,
-                       1);
-
-            if(use_dropout)
-            {
-                DropoutBackwardVerify<T>(dropoutDesc,
-                                         miopen::deref(dropout_inputTensor),
-                                         wkspace,
-                                         miopen::deref(dropout_inputTensor),
-                                         wkspace,
-                                         dropout_reservespace_host,
-                                         hid_shift + bi * 3 * hy_h,
-                                         hid_shift + bi * 3 * hy_h,
-                                         li * batch_n * hy_h * bi);
-            }
-        }
-
-        // from hidden state
-        int bacc   = batch_n;
-        int baccbi = 0;
-        for(int ti = seqLength - 1; ti >= 0; ti--)
-        {
-            bacc -= in_n.at(ti);
-
-            if(ti == seqLength - 1)
-            {
-                if(!dhy_is_null)
-                {
-                    for(int bs = 0; bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                dhy[hx_shift + bs * uni_stride + h];
-                        }
-                    }
-
-                    if(bidirection)
-                    {
-                        for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                        {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                        hy_h + h] +=
-                                    dhy[hx_shift + bs * uni_stride + hy_n * hy_h + h];
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                if(!dhy_is_null && in_n.at(ti) > in_n.at(ti + 1))
-                {
-                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                                dhy[hx_shift + bs * uni_stride + h];
-                        }
-                    }
-                }
-
-                int pretime_shift = li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride;
-
-                RNN_mm_cpu(&wkspace[pretime_shift],
-                           hy_h * 2,
-                           in_n.at(ti + 1),
-                           hy_stride,
-                           0,
-                           &wei[weitime_shift],
-                           hy_h,
-                           hy_h * 2,
-                           uni_stride,
-                           0,
-                           &wkspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
-                           hy_h,
-                           in_n.at(ti + 1),
-                           hy_stride,
-                           0,
-                           1,
-                           1);
-
-                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] +=
-                            wkspace[pretime_shift + bs * hy_stride + bi * 3 * hy_h + h] *
-                            activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
-
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] =
-                            wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
-                            activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
-                    }
-                }
-
-                RNN_mm_cpu(&wkspace[hid_shift + bacc * hy_stride + 2 * hy_h],
-                           hy_h,
-                           in_n.at(ti + 1),
-                           hy_stride,
-                           0,
-                           &wei[weitime_shift + 2 * hy_h * uni_stride],
-                           hy_h,
-                           hy_h,
-                           uni_stride,
-                           0,
-                           &wkspace[hid_shift + bacc * hy_stride + bi * 3 * hy_h],
-                           hy_h,
-                           in_n.at(ti + 1),
-                           hy_stride,
-                           0,
-                           1,
-                           1);
-
-                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
-                {
-                    auto subidx = hid_shift + (bacc + bs) * hy_stride + 2 * hy_h;
-                    std::fill(wkspace.begin() + subidx, wkspace.begin() + subidx + hy_h, 0);
-                }
-
-                if(bidirection)
-                {
-                    pretime_shift = li * batch_n * hy_stride +
-                                    (baccbi - in_n.at(seqLength - 2 - ti)) * hy_stride + hy_h * 3;
-
-                    RNN_mm_cpu(&wkspace[pretime_shift],
-                               hy_h * 2,
-                               in_n.at(seqLength - 1 - ti),
-                               hy_stride,
-                               0,
-                               &wei[weitime_shift + hy_h * 3 * uni_stride],
-                               hy_h,
-                               hy_h * 2,
-                               uni_stride,
-                               0,
-                               &wkspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
-                               hy_h,
-                               in_n.at(seqLength - 1 - ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                    h] +=
-                                wkspace[pretime_shift + bs * hy_stride + 3 * hy_h + hy_h + h] *
-                                activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
-
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] =
-                                wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
-                                activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
-                        }
-                    }
-
-                    RNN_mm_cpu(&wkspace[hid_shift + baccbi * hy_stride + 5 * hy_h],
-                               hy_h,
-                               in_n.at(seqLength - 1 - ti),
-                               hy_stride,
-                               0,
-                               &wei[weitime_shift + 5 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h,
-                               uni_stride,
-                               0,
-                               &wkspace[hid_shift + baccbi * hy_stride + bi * 3 * hy_h + hy_h],
-                               hy_h,
-                               in_n.at(seqLength - 1 - ti),
-                               hy_stride,
-                               0,
-                               1,
-                               1);
-
-                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                    {
-                        auto subidx = hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h;
-                        std::fill(wkspace.begin() + subidx, wkspace.begin() + (subidx + hy_h), 0);
-                    }
-                }
-            }
-
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
-                {
-                    wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] +=
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
-                        (1 - activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2)) *
-                        dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
-                                      1);
-
-                    wkspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h] =
-                        (rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
-                                  numlayer * batch_n * hy_stride] *
-                         wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] *
-                         dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h],
-                                       2));
-
-                    if(ti == 0)
-                    {
-                        if(!hx_is_null)
-                        {
-                            wkspace[hid_shift + (bacc + bs) * hy_stride + h] +=
-                                (wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
-                                 hx[hx_shift + bs * uni_stride + h] *
-                                 dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h],
-                                               2));
-                        }
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + h] -=
-                            (wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
-                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
-                                       1) *
-                             dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2));
-                    }
-                    else
-                    {
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + h] +=
-                            wkspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h] *
-                            (rsvspace[hid_shift + (bacc - in_n.at(ti - 1) + bs) * hy_stride +
-                                      bi * 3 * hy_h + h] -
-                             activfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h],
-                                       1)) *
-                            dervactivfunc(rsvspace[hid_shift + (bacc + bs) * hy_stride + h], 2);
-                    }
-
-                    rsvspace[hid_shift + (bacc + bs) * hy_stride + bi * 3 * hy_h + h +
-                             numlayer * batch_n * hy_stride] =
-                        wkspace[hid_shift + (bacc + bs) * hy_stride + 2 * hy_h + h] *
-                        rsvspace[hid_shift + (bacc + bs) * hy_stride + hy_h + h +
-                                 numlayer * batch_n * hy_stride];
-                }
-            }
-
-            if(bidirection)
-            {
-                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] +=
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                    h] *
-                            (1 - activfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
-                                     2)) *
-                            dervactivfunc(
-                                rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h], 1);
-
-                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h] =
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h +
-                                     h + numlayer * batch_n * hy_stride];
-
-                        wkspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h] *=
-                            (wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] *
-                             dervactivfunc(
-                                 rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h],
-                                 2));
-
-                        if(ti == 0)
-                        {
-                            if(!hx_is_null)
-                            {
-                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
-                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] *
-                                     hx[hx_shift + bs * uni_stride + hy_n * hy_h + h] *
-                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                            3 * hy_h + h],
-                                                   2));
-                            }
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] -=
-                                (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] *
-                                 activfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
-                                     1) *
-                                 dervactivfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
-                                     2));
-                        }
-                        else
-                        {
-                            if(!hx_is_null &&
-                               in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti) &&
-                               bs >= in_n.at(seqLength - ti))
-                            {
-                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
-                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] *
-                                     hx[hx_shift + bs * uni_stride + hy_n * hy_h + h] *
-                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                            3 * hy_h + h],
-                                                   2));
-                            }
-
-                            if(bs < in_n.at(seqLength - ti))
-                            {
-                                wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] +=
-                                    (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                             hy_h + h] *
-                                     rsvspace[hid_shift +
-                                              (baccbi + in_n.at(seqLength - 1 - ti) + bs) *
-                                                  hy_stride +
-                                              bi * 3 * hy_h + hy_h + h] *
-                                     dervactivfunc(rsvspace[hid_shift + (baccbi + bs) * hy_stride +
-                                                            3 * hy_h + h],
-                                                   2));
-                            }
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h] -=
-                                (wkspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h +
-                                         hy_h + h] *
-                                 activfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h],
-                                     1) *
-                                 dervactivfunc(
-                                     rsvspace[hid_shift + (baccbi + bs) * hy_stride + 3 * hy_h + h],
-                                     2));
-                        }
-
-                        rsvspace[hid_shift + (baccbi + bs) * hy_stride + bi * 3 * hy_h + hy_h + h +
-                                 numlayer * batch_n * hy_stride] =
-                            wkspace[hid_shift + (baccbi + bs) * hy_stride + 5 * hy_h + h] *
-                            rsvspace[hid_shift + (baccbi + bs) * hy_stride + 4 * hy_h + h +
-                                     numlayer * batch_n * hy_stride];
-                    }
-                }
-            }
-
-            baccbi += in_n.at(seqLength - 1 - ti);
-        }
-
-        // dhx
-        int pretime_shift = li * batch_n * hy_stride;
-
-        RNN_mm_cpu(&wkspace[pretime_shift],
-                   hy_h * 2,
-                   in_n.at(0),
-                   hy_stride,
-                   0,
-                   &wei[weitime_shift],
-                   hy_h,
-                   hy_h * 2,
-                   uni_stride,
-                   0,
-                   &dhx[hx_shift],
-                   hy_h,
-                   in_n.at(0),
-                   uni_stride,
-                   0,
-                   1,
-                   1);
-
-        for(int bs = 0; bs < in_n.at(0); bs++)
-        {
-            for(int h = 0; h < hy_h; h++)
-            {
-                dhx[hx_shift + bs * uni_stride + h] +=
-                    wkspace[pretime_shift + bs * hy_stride + bi * 3 * hy_h + h] *
-                    activfunc(rsvspace[pretime_shift + bs * hy_stride + h], 2);
-
-                dcx[hx_shift + bs * uni_stride + h] =
-                    wkspace[pretime_shift + bs * hy_stride + 2 * hy_h + h] *
-                    activfunc(rsvspace[pretime_shift + bs * hy_stride + hy_h + h], 2);
-            }
-        }
-
-        RNN_mm_cpu(&dcx[hx_shift],
-                   hy_h,
-                   in_n.at(0),
-                   uni_stride,
-                   0,
-                   &wei[weitime_shift + 2 * hy_h * uni_stride],
-                   hy_h,
-                   hy_h,
-                   uni_stride,
-                   0,
-                   &dhx[hx_shift],
-                   hy_h,
-                   in_n.at(0),
-                   uni_stride,
-                   0,
-                   1,
-                   1);
-
-        if(bidirection)
-        {
-            int ti = seqLength - 1, cur_bat = 0, pre_bat = batch_n;
-
-            while(ti >= 0)
-            {
-                pre_bat -= in_n.at(ti);
-                if(in_n.at(ti) > cur_bat)
-                {
-                    pretime_shift = li * batch_n * hy_stride + (pre_bat + cur_bat) * hy_stride;
-
-                    RNN_mm_cpu(&wkspace[pretime_shift + 3 * hy_h],
-                               hy_h * 2,
-                               (in_n.at(ti) - cur_bat),
-                               hy_stride,
-                               0,
-                               &wei[weitime_shift + 3 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h * 2,
-                               uni_stride,
-                               0,
-                               &dhx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
-                               hy_h,
-                               (in_n.at(ti) - cur_bat),
-                               uni_stride,
-                               0,
-                               1,
-                               1);
-
-                    for(int bs = cur_bat; bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            dhx[hx_shift + bs * uni_stride + hy_n * hy_h + h] +=
-                                wkspace[pretime_shift + (bs - cur_bat) * hy_stride + bi * 3 * hy_h +
-                                        hy_h + h] *
-                                activfunc(rsvspace[pretime_shift + (bs - cur_bat) * hy_stride +
-                                                   3 * hy_h + h],
-                                          2);
-
-                            dcx[hx_shift + bs * uni_stride + hy_n * hy_h + h] =
-                                wkspace[pretime_shift + (bs - cur_bat) * hy_stride + 5 * hy_h + h] *
-                                activfunc(rsvspace[pretime_shift + (bs - cur_bat) * hy_stride +
-                                                   4 * hy_h + h],
-                                          2);
-                        }
-                    }
-
-                    RNN_mm_cpu(&dcx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
-                               hy_h,
-                               (in_n.at(ti) - cur_bat),
-                               uni_stride,
-                               0,
-                               &wei[weitime_shift + 5 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h,
-                               uni_stride,
-                               0,
-                               &dhx[hx_shift + hy_n * hy_h + cur_bat * hy_h],
-                               hy_h,
-                               (in_n.at(ti) - cur_bat),
-                               uni_stride,
-                               0,
-                               1,
-                               1);
-                }
-                cur_bat = in_n.at(ti--);
-            }
-        }
-    }
-
-    // dinput
-    if(inputMode == 1)
-    {
-        for(int bs = 0; bs < batch_n; bs++)
-        {
-            for(int h = 0; h < hy_h; h++)
-            {
-                for(int gi = 0; gi < 3; gi++)
-                {
-                    din[bs * in_stride + h] += wkspace[bs * hy_stride + gi * hy_h + h];
-                    if(bidirection)
-                    {
-                        din[bs * in_stride + h] += wkspace[bs * hy_stride + (gi + 3) * hy_h + h];
-                    }
-                }
-            }
-        }
-    }
-    else
-    {
-        RNN_mm_cpu(wkspace.data(),
-                   hy_h * bi * 3,
-                   batch_n,
-                   hy_stride,
-                   0,
-                   wei.data(),
-                   in_h,
-                   hy_h * bi * 3,
-                   in_stride,
-                   0,
-                   din.data(),
-                   in_h,
-                   batch_n,
-                   in_stride,
-                   0,
-                   1,
-                   1);
-    }
+    cpu_gru_backward_data(use_dropout,
+                          rnn_dropout_verify<T>(get_handle(), dropoutDesc),
+                          din,
+                          wei,
+                          dhy,
+                          dhx,
+                          hx,
+                          dout,
+                          in_n,
+                          in_h,
+                          seqLength,
+                          bidirection,
+                          hy_d,
+                          hy_n,
+                          hy_h,
+                          out_h,
+                          inputMode,
+                          rsvspace,
+                          wkspace,
+                          hx_is_null,
+                          dhy_is_null);
 }
 
 template <typename T>
@@ -1478,326 +183,22 @@ void GRUBwdWeightCPUVerify(bool use_dropout,
                            std::vector<T>& wkspace,
                            bool hx_is_null = false)
 {
-    int batch_n  = sumvc(in_n);
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int wei_stride = bi * 3 * hy_h;
-    int hy_stride  = bi * 4 * hy_h;
-    int h_stride   = bi * hy_h;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    int wei_shift_bias = (in_h + hy_h + (bi * hy_h + hy_h) * (numlayer - 1)) * wei_stride;
-
-    // bwd weights emulator
-    for(int li = 0; li < numlayer; li++)
-    {
-        // between layers
-        if(li == 0)
-        {
-            if(inputMode == 0)
-            {
-                RNN_mm_cpu(wkspace.data(),
-                           hy_h * bi * 3,
-                           batch_n,
-                           hy_stride,
-                           RNN_MM_TRANSPOSE,
-                           in.data(),
-                           in_h,
-                           batch_n,
-                           in_stride,
-                           0,
-                           dwei.data(),
-                           in_h,
-                           hy_h * bi * 3,
-                           in_stride,
-                           0,
-                           1,
-                           1);
-            }
-
-            if(biased)
-            {
-                for(int h = 0; h < wei_stride; h++)
-                {
-                    for(int w = 0; w < batch_n; w++)
-                    {
-                        dwei[wei_shift_bias + h] += wkspace[w * hy_stride + h];
-                    }
-                }
-            }
-        }
-        else
-        {
-            int prelayer_shift =
-                use_dropout ? 2 * numlayer * batch_n * hy_stride + (li - 1) * batch_n * hy_h * bi
-                            : (li - 1) * batch_n * hy_stride + bi * hy_h * 3;
-            int hid_shift = li * batch_n * hy_stride;
-            int wei_shift = (in_h + hy_h) * wei_stride + (li - 1) * (bi * hy_h + hy_h) * wei_stride;
-
-            RNN_mm_cpu(&wkspace[hid_shift],
-                       hy_h * bi * 3,
-                       batch_n,
-                       hy_stride,
-                       RNN_MM_TRANSPOSE,
-                       &rsvspace[prelayer_shift],
-                       hy_h * bi,
-                       batch_n,
-                       use_dropout ? hy_h * bi : hy_stride,
-                       0,
-                       &dwei[wei_shift],
-                       hy_h * bi,
-                       hy_h * bi * 3,
-                       bi_stride,
-                       0,
-                       1,
-                       1);
-
-            if(biased)
-            {
-                wei_shift = wei_shift_bias + li * 2 * wei_stride;
-
-                for(int h = 0; h < wei_stride; h++)
-                {
-                    for(int w = 0; w < batch_n; w++)
-                    {
-                        dwei[wei_shift + h] += wkspace[hid_shift + w * hy_stride + h];
-                    }
-                }
-            }
-        }
-
-        // between time
-        int bacc = 0;
-        for(int ti = 0; ti < seqLength; ti++)
-        {
-            int hid_shift = li * batch_n * hy_stride + bacc * hy_stride;
-            int hx_shift  = li * in_n.at(0) * h_stride;
-            int wei_shift = in_h * wei_stride + li * (bi * hy_h + hy_h) * wei_stride;
-            int pretime_shift;
-
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
-                {
-                    wkspace[hid_shift + bs * hy_stride + 2 * hy_h + h] *=
-                        activfunc(rsvspace[hid_shift + bs * hy_stride + hy_h + h], 2);
-                }
-            }
-
-            // between time
-            if(ti == 0)
-            {
-                if(!hx_is_null)
-                {
-                    RNN_mm_cpu(&wkspace[hid_shift],
-                               hy_h * 3,
-                               in_n.at(ti),
-                               hy_stride,
-                               RNN_MM_TRANSPOSE,
-                               &hx[hx_shift],
-                               hy_h,
-                               in_n.at(ti),
-                               uni_stride,
-                               0,
-                               &dwei[wei_shift],
-                               hy_h,
-                               hy_h * 3,
-                               uni_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
-
-                        for(int h = 0; h < hy_h * 3; h++)
-                        {
-                            for(int w = 0; w < in_n.at(ti); w++)
-                            {
-                                dwei[bias_shift + h] += wkspace[hid_shift + w * hy_stride + h];
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                pretime_shift =
-                    li * batch_n * hy_stride + (bacc - in_n.at(ti - 1)) * hy_stride + bi * 3 * hy_h;
-
-                RNN_mm_cpu(&wkspace[hid_shift],
-                           hy_h * 3,
-                           in_n.at(ti),
-                           hy_stride,
-                           RNN_MM_TRANSPOSE,
-                           &rsvspace[pretime_shift],
-                           hy_h,
-                           in_n.at(ti),
-                           hy_stride,
-                           0,
-                           &dwei[wei_shift],
-                           hy_h,
-                           hy_h * 3,
-                           uni_stride,
-                           0,
-                           1,
-                           1);
-
-                if(biased)
-                {
-                    int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
-
-                    for(int h = 0; h < hy_h * 3; h++)
-                    {
-                        for(int w = 0; w < in_n.at(ti); w++)
-                        {
-                            dwei[bias_shift + h] += wkspace[hid_shift + w * hy_stride + h];
-                        }
-                    }
-                }
-            }
-
-            if(bidirection)
-            {
-                for(int bs = 0; bs < in_n.at(ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        wkspace[hid_shift + bs * hy_stride + 5 * hy_h + h] *=
-                            activfunc(rsvspace[hid_shift + bs * hy_stride + 4 * hy_h + h], 2);
-                    }
-                }
-
-                if(ti == seqLength - 1)
-                {
-                    if(!hx_is_null)
-                    {
-                        RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h],
-                                   hy_h * 3,
-                                   in_n.at(ti),
-                                   hy_stride,
-                                   RNN_MM_TRANSPOSE,
-                                   &hx[hx_shift + hy_n * hy_h],
-                                   hy_h,
-                                   in_n.at(ti),
-                                   uni_stride,
-                                   0,
-                                   &dwei[wei_shift + 3 * hy_h * uni_stride],
-                                   hy_h,
-                                   hy_h * 3,
-                                   uni_stride,
-                                   0,
-                                   1,
-                                   1);
-
-                        if(biased)
-                        {
-                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
-
-                            for(int h = 0; h < hy_h * 3; h++)
-                            {
-                                for(int w = 0; w < in_n.at(ti); w++)
-                                {
-                                    dwei[bias_shift + 3 * hy_h + h] +=
-                                        wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
-                                }
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    if(!hx_is_null && in_n.at(ti) > in_n.at(ti + 1))
-                    {
-                        RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h + in_n.at(ti + 1) * hy_stride],
-                                   hy_h * 3,
-                                   (in_n.at(ti) - in_n.at(ti + 1)),
-                                   hy_stride,
-                                   RNN_MM_TRANSPOSE,
-                                   &hx[hx_shift + hy_n * hy_h + in_n.at(ti + 1) * hy_h],
-                                   hy_h,
-                                   (in_n.at(ti) - in_n.at(ti + 1)),
-                                   uni_stride,
-                                   0,
-                                   &dwei[wei_shift + 3 * hy_h * uni_stride],
-                                   hy_h,
-                                   hy_h * 3,
-                                   uni_stride,
-                                   0,
-                                   1,
-                                   1);
-
-                        if(biased)
-                        {
-                            int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
-
-                            for(int h = 0; h < hy_h * 3; h++)
-                            {
-                                for(int w = in_n.at(ti + 1); w < in_n.at(ti); w++)
-                                {
-                                    dwei[bias_shift + 3 * hy_h + h] +=
-                                        wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
-                                }
-                            }
-                        }
-                    }
-
-                    pretime_shift =
-                        li * batch_n * hy_stride + (bacc + in_n.at(ti)) * hy_stride + bi * 3 * hy_h;
-
-                    RNN_mm_cpu(&wkspace[hid_shift + 3 * hy_h],
-                               hy_h * 3,
-                               in_n.at(ti + 1),
-                               hy_stride,
-                               RNN_MM_TRANSPOSE,
-                               &rsvspace[pretime_shift + hy_h],
-                               hy_h,
-                               in_n.at(ti + 1),
-                               hy_stride,
-                               0,
-                               &dwei[wei_shift + 3 * hy_h * uni_stride],
-                               hy_h,
-                               hy_h * 3,
-                               uni_stride,
-                               0,
-                               1,
-                               1);
-
-                    if(biased)
-                    {
-                        int bias_shift = wei_shift_bias + li * 2 * wei_stride + wei_stride;
-
-                        for(int h = 0; h < hy_h * 3; h++)
-                        {
-                            for(int w = 0; w < in_n.at(ti + 1); w++)
-                            {
-                                dwei[bias_shift + 3 * hy_h + h] +=
-                                    wkspace[hid_shift + 3 * hy_h + w * hy_stride + h];
-                            }
-                        }
-                    }
-                }
-            }
-
-            bacc += in_n.at(ti);
-        }
-    }
+    cpu_gru_backward_weights(use_dropout,
+                             in,
+                             dwei,
+                             hx,
+                             in_n,
+                             in_h,
+                             seqLength,
+                             bidirection,
+                             biased,
+                             hy_d,
+                             hy_n,
+                             hy_h,
+                             inputMode,
+                             rsvspace,
+                             wkspace,
+                             hx_is_null);
 }
 
 //////=========END CPU VERIFICATION FUNCTIONS=============
@@ -0,0 +1,127 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/config.h>
+#include <miopen/kernel_info.hpp>
+#include <miopen/hipoc_program.hpp>
+#include "get_handle.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if MIOPEN_MODE_NOGPU
+
+namespace {
+
+struct MockCompiler
+{
+    std::atomic<int> calls{0};
+
+    miopen::CodeObjectBuilder Builder()
+    {
+        return [this](const std::string& filename,
+                      const std::string& src,
+                      const std::string& params,
+                      const miopen::TargetProperties&,
+                      std::vector<char>& binary) {
+            ++calls;
+            const auto blob = filename + '\n' + params + '\n' + std::to_string(src.size());
+            binary.assign(blob.begin(), blob.end());
+        };
+    }
+};
+
+/// Installs a builder for the lifetime of the scope, even if an assertion returns early.
+struct MockCompilerScope
+{
+    MockCompilerScope(miopen::CodeObjectBuilder builder)
+    {
+        miopen::SetCodeObjectBuilder(std::move(builder));
+    }
+    MockCompilerScope(MockCompiler& compiler) : MockCompilerScope(compiler.Builder()) {}
+    ~MockCompilerScope() { miopen::SetCodeObjectBuilder({}); }
+};
+
+std::string MockOptions(int i) { return "-DMIOPEN_MOCK_KERNEL=" + std::to_string(i); }
+
+class BuildPipeline : public ::testing::Test
+{
+protected:
+    // Mock binaries must neither come from nor go to the user's kernel cache. The variable is read
+    // once, so it is set before the first build of the process.
+    static void SetUpTestSuite()
+    {
+        setenv("MIOPEN_DISABLE_CACHE", "1", 1); // NOLINT (concurrency-mt-unsafe)
+    }
+};
+
+} // namespace
+
+TEST_F(BuildPipeline, PrecompileBuildsEachProgramOnce)
+{
+    auto&& handle = get_handle();
+    MockCompiler compiler;
+    const MockCompilerScope scope{compiler};
+
+    std::vector<miopen::solver::KernelInfo> kernels;
+    for(auto i = 0; i < 8; ++i)
+    {
+        miopen::solver::KernelInfo k;
+        k.kernel_file  = "MIOpenSoftmax.cl";
+        k.kernel_name  = "SoftmaxForward";
+        k.comp_options = MockOptions(i);
+        kernels.push_back(k);
+        kernels.push_back(k); // Same program requested by another solution.
+    }
+
+    const auto programs = miopen::solver::PrecompileKernels(handle, kernels);
+
+    ASSERT_EQ(programs.size(), kernels.size());
+    EXPECT_EQ(compiler.calls.load(), static_cast<int>(kernels.size() / 2));
+    for(const auto& program : programs)
+    {
+        EXPECT_TRUE(program.IsCodeObjectInMemory());
+        const auto& times = program.GetBuildStageTimes();
+        EXPECT_GE(times.source_ms, 0.0f);
+        EXPECT_GE(times.compile_ms, 0.0f);
+    }
+}
+
+TEST_F(BuildPipeline, MockCompilerFailureIsReported)
+{
+    auto&& handle = get_handle();
+    const MockCompilerScope scope{[](const std::string&,
+                                     const std::string&,
+                                     const std::string&,
+                                     const miopen::TargetProperties&,
+                                     std::vector<char>& binary) { binary.clear(); }};
+    EXPECT_ANY_THROW(handle.LoadProgram("MIOpenSoftmax.cl", MockOptions(0), false, ""));
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/allocator.hpp>
+#include <miopen/caching_allocator.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+namespace {
+
+struct HostMemory
+{
+    int allocations   = 0;
+    int deallocations = 0;
+
+    static void* Allocate(void* self, std::size_t size)
+    {
+        static_cast<HostMemory*>(self)->allocations++;
+        return std::malloc(size);
+    }
+
+    static void Deallocate(void* self, void* ptr)
+    {
+        static_cast<HostMemory*>(self)->deallocations++;
+        std::free(ptr);
+    }
+};
+
+constexpr std::size_t unlimited = std::size_t{1} << 40;
+
+} // namespace
+
+TEST(CachingAllocator, SizeClasses)
+{
+    EXPECT_EQ(miopen::CachingAllocator::SizeClass(1), 256);
+    EXPECT_EQ(miopen::CachingAllocator::SizeClass(256), 256);
+    EXPECT_EQ(miopen::CachingAllocator::SizeClass(257), 512);
+    EXPECT_EQ(miopen::CachingAllocator::SizeClass(3000), 4096);
+    EXPECT_EQ(miopen::CachingAllocator::SizeClass(std::size_t{1} << 30), std::size_t{1} << 30);
+}
+
+TEST(CachingAllocator, ReusesSizeClassOnSameStream)
+{
+    HostMemory host;
+    auto stream = 1;
+    miopen::CachingAllocator allocator{
+        HostMemory::Allocate, HostMemory::Deallocate, &host, unlimited, [&]() -> const void* {
+            return &stream;
+        }};
+
+    auto* first = allocator.Allocate(3000);
+    allocator.Deallocate(first);
+    auto* second = allocator.Allocate(4000);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(host.allocations, 1);
+
+    const auto stats = allocator.GetStats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.requested_bytes, 4000);
+    EXPECT_EQ(stats.in_use_bytes, 4096);
+    EXPECT_EQ(stats.cached_bytes, 0);
+    EXPECT_NEAR(stats.Fragmentation(), 96.0 / 4096, 1e-9);
+
+    allocator.Deallocate(second);
+    allocator.Trim();
+    EXPECT_EQ(host.deallocations, 1);
+}
+
+TEST(CachingAllocator, DoesNotReuseAcrossStreams)
+{
+    HostMemory host;
+    auto stream = 1;
+    miopen::CachingAllocator allocator{
+        HostMemory::Allocate, HostMemory::Deallocate, &host, unlimited, [&]() -> const void* {
+            return reinterpret_cast<const void*>(static_cast<std::intptr_t>(stream));
+        }};
+
+    auto* first = allocator.Allocate(1024);
+    allocator.Deallocate(first);
+    stream       = 2;
+    auto* second = allocator.Allocate(1024);
+    EXPECT_EQ(host.allocations, 2);
+    EXPECT_EQ(allocator.GetStats().hits, 0);
+
+    allocator.Deallocate(second);
+    stream = 1;
+    EXPECT_EQ(allocator.Allocate(1024), first);
+    allocator.Deallocate(first);
+}
+
+TEST(CachingAllocator, ReusesOnlyOnTheAllocatingStream)
+{
+    HostMemory host;
+    auto stream = 1;
+    miopen::CachingAllocator allocator{
+        HostMemory::Allocate, HostMemory::Deallocate, &host, unlimited, [&]() -> const void* {
+            return reinterpret_cast<const void*>(static_cast<std::intptr_t>(stream));
+        }};
+
+    // Work queued on the first stream may still use the buffer when it is freed on the second.
+    auto* first = allocator.Allocate(1024);
+    stream      = 2;
+    allocator.Deallocate(first);
+    auto* second = allocator.Allocate(1024);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(host.allocations, 2);
+    EXPECT_EQ(allocator.GetStats().hits, 0);
+
+    allocator.Deallocate(second);
+    stream = 1;
+    EXPECT_EQ(allocator.Allocate(1024), first);
+    allocator.Deallocate(first);
+}
+
+TEST(CachingAllocator, HonorsLimit)
+{
+    HostMemory host;
+    miopen::CachingAllocator allocator{HostMemory::Allocate, HostMemory::Deallocate, &host, 4096};
+
+    auto* a = allocator.Allocate(2048);
+    auto* b = allocator.Allocate(2048);
+    allocator.Deallocate(a);
+    // Caching b as well would still fit the limit.
+    allocator.Deallocate(b);
+    EXPECT_EQ(allocator.GetStats().cached_bytes, 4096);
+
+    // A new size class does not fit next to the cached buffers, so they are returned first.
+    auto* c = allocator.Allocate(4096);
+    EXPECT_EQ(host.deallocations, 2);
+    EXPECT_EQ(allocator.GetStats().cached_bytes, 0);
+    EXPECT_EQ(allocator.GetStats().peak_reserved_bytes, 4096);
+
+    auto* d = allocator.Allocate(1024);
+    allocator.Deallocate(d);
+    // Freed while c is in use, caching d would exceed the limit.
+    EXPECT_EQ(host.deallocations, 3);
+    EXPECT_EQ(allocator.GetStats().releases, 3);
+    allocator.Deallocate(c);
+}
+
+TEST(CachingAllocator, BuffersFreedAfterDetachAreReleased)
+{
+    HostMemory host;
+    auto detached = false;
+    miopen::CachingAllocator allocator{
+        HostMemory::Allocate, HostMemory::Deallocate, &host, unlimited, [&]() -> const void* {
+            EXPECT_FALSE(detached);
+            return nullptr;
+        }};
+
+    auto* cached = allocator.Allocate(1024);
+    auto* in_use = allocator.Allocate(1024);
+    allocator.Deallocate(cached);
+    allocator.Detach();
+    detached = true;
+    EXPECT_EQ(host.deallocations, 1);
+
+    allocator.Deallocate(in_use);
+    EXPECT_EQ(host.deallocations, 2);
+    EXPECT_EQ(allocator.GetStats().cached_bytes, 0);
+}
+
+TEST(CachingAllocator, BuffersKeepTheAllocatorAlive)
+{
+    HostMemory host;
+    auto weak = std::weak_ptr<miopen::CachingAllocator>{};
+    {
+        auto buffer = [&] {
+            const auto caching = std::make_shared<miopen::CachingAllocator>(
+                HostMemory::Allocate, HostMemory::Deallocate, &host, unlimited);
+            weak = caching;
+            return miopen::Allocator{miopen::CachingAllocator::AllocateCallback,
+                                     miopen::CachingAllocator::DeallocateCallback,
+                                     caching.get(),
+                                     caching}(1024);
+        }();
+        // Only the buffer refers to the caching allocator now, as when it outlives its handle.
+        EXPECT_FALSE(weak.expired());
+        EXPECT_EQ(host.deallocations, 0);
+    }
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(host.deallocations, 1);
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_compaction.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace {
+
+miopen::DbContents Read(const std::vector<std::string>& sources, miopen::DbCompactionStats& stats)
+{
+    auto contents = miopen::DbContents{};
+    for(const auto& source : sources)
+    {
+        auto ss = std::istringstream{source};
+        miopen::ReadTextDb(ss, contents, stats);
+    }
+    return contents;
+}
+
+std::string Write(const miopen::DbContents& contents)
+{
+    auto ss = std::ostringstream{};
+    miopen::WriteTextDb(ss, contents);
+    return ss.str();
+}
+
+void WriteFile(const boost::filesystem::path& path, const std::string& text)
+{
+    std::ofstream(path.string()) << text;
+}
+
+std::string ReadFile(const boost::filesystem::path& path)
+{
+    std::ifstream file(path.string());
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+} // namespace
+
+TEST(DbCompaction, LaterSourcesOverrideEarlierOnes)
+{
+    auto stats          = miopen::DbCompactionStats{};
+    const auto contents = Read({"b=S1:1;S2:2\na=S1:1\n", "b=S2:3;S3:4\n\nbroken\nb=S1:5\n"}, stats);
+
+    EXPECT_EQ(Write(contents), "a=S1:1\nb=S1:5;S2:3;S3:4\n");
+    EXPECT_EQ(stats.records_read, 4u);
+    EXPECT_EQ(stats.duplicate_keys, 2u);
+    EXPECT_EQ(stats.overridden, 2u);
+    EXPECT_EQ(stats.ill_formed, 1u);
+}
+
+TEST(DbCompaction, DropsUnknownSolvers)
+{
+    auto stats    = miopen::DbCompactionStats{};
+    auto contents = Read({"a=ConvBinWinograd3x3U:1;RetiredSolver:2\nb=RetiredSolver:3\n"}, stats);
+
+    miopen::DropUnknownSolvers(contents, stats);
+    EXPECT_EQ(Write(contents), "a=ConvBinWinograd3x3U:1\n");
+    EXPECT_EQ(stats.unknown_solvers, 2u);
+}
+
+TEST(DbCompaction, DropsFindDbEntriesThatDoNotParse)
+{
+    auto stats    = miopen::DbCompactionStats{};
+    auto contents = Read({"a=GemmFwd1x1_0_1:0.5,0,miopenConvolutionFwdAlgoGEMM;"
+                          "ConvDirectNaiveConvFwd:0.5,miopenConvolutionFwdAlgoDirect\n"},
+                         stats);
+
+    miopen::DropInvalidValues(miopen::DbKind::Find, nullptr, contents, stats);
+    EXPECT_EQ(Write(contents), "a=GemmFwd1x1_0_1:0.5,0,miopenConvolutionFwdAlgoGEMM\n");
+    EXPECT_EQ(stats.invalid_values, 1u);
+}
+
+TEST(DbCompaction, RestoresProblemsFromPerfDbKeys)
+{
+    const std::string keys[] = {
+        "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-F",
+        "64-56-56-3x3-64-56-56-16-1x1-1x1-1x1-0-NHWC-NHWC-NHWC-FP16-B",
+        "32-14-14-3x3-64-28-28-4-1x1-2x2-1x1-0-NCHW-FP32-W_g2",
+        "16-8-8-8-3x3x3-32-8-8-8-2-1x1x1-1x1x1-1x1x1-0-NCDHW-BF16-F",
+        "4-8-8-1x1-4-8-8-1-0x0-1x1-1x1-0-NHWC-NCHW-NCHW-INT8INT8INT32-F",
+    };
+
+    for(const auto& key : keys)
+    {
+        auto problem = miopen::conv::ProblemDescription{};
+        ASSERT_TRUE(miopen::ParsePerfDbKey(key, problem)) << key;
+        auto ss = std::ostringstream{};
+        problem.Serialize(ss);
+        EXPECT_EQ(ss.str(), key);
+    }
+}
+
+TEST(DbCompaction, RejectsKeysItCannotRestore)
+{
+    const std::string keys[] = {
+        "",
+        "576-4-4-1x1-192",
+        "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP99-F",
+        "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-X",
+        "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHWc-FP32-F",
+        "576-4-4-1x1-192-4-4-8-0x0-1x1-1x1-0-NCHW-FP32-F_g7",
+    };
+
+    for(const auto& key : keys)
+    {
+        auto problem = miopen::conv::ProblemDescription{};
+        EXPECT_FALSE(miopen::ParsePerfDbKey(key, problem)) << key;
+    }
+}
+
+TEST(DbCompaction, CompactsInPlaceAndReplacesExistingOutputs)
+{
+    const auto dir = boost::filesystem::temp_directory_path() /
+                     boost::filesystem::unique_path("miopen-db-compaction-%%%%-%%%%");
+    boost::filesystem::create_directories(dir);
+    const auto db     = dir / "user.txt";
+    const auto output = dir / "merged.txt";
+
+    WriteFile(db, "b=RetiredSolver:3\na=ConvBinWinograd3x3U:1;RetiredSolver:2\n");
+    miopen::CompactDbs({db.string()}, db.string(), {});
+    EXPECT_EQ(ReadFile(db), "a=ConvBinWinograd3x3U:1\n");
+
+    // Entries only in the previous output are not kept.
+    WriteFile(output, "z=ConvBinWinograd3x3U:2\n");
+    miopen::CompactDbs({db.string()}, output.string(), {});
+    EXPECT_EQ(ReadFile(output), "a=ConvBinWinograd3x3U:1\n");
+
+    EXPECT_EQ(std::distance(boost::filesystem::directory_iterator{dir},
+                            boost::filesystem::directory_iterator{}),
+              2);
+    boost::filesystem::remove_all(dir);
+}
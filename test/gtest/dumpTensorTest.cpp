@@ -100,8 +100,18 @@ void testDump(const std::string& test_file_name)
 
     compare(host_tensor, tensor_from_file);
 
+    // the descriptor is written next to the data
+    std::ifstream header(test_file_name + ".txt");
+    std::string line;
+    bool found_lengths = false;
+    while(std::getline(header, line))
+        found_lengths |= line == "lengths=1,1,20,20";
+    EXPECT_TRUE(found_lengths) << "Missing tensor lengths in " << test_file_name << ".txt";
+    header.close();
+
     // clean up
     boost::filesystem::remove(test_file_name);
+    boost::filesystem::remove(test_file_name + ".txt");
 }
 
 template <class T>
@@ -138,6 +148,7 @@ void testDumpWithNan(const std::string& test_file_name)
     }
     // clean up
     boost::filesystem::remove(test_file_name);
+    boost::filesystem::remove(test_file_name + ".txt");
 }
 
 TEST(DUMP_TENSOR_TEST, testDump_float) { testDump<float>(test_file_name_prefix + "float.bin"); }
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#pragma once
+
+#include <miopen/conv/context.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/search_cost_model.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// A solver for GenericSearch with no kernels to build, and a cost model to search it without a
+/// device.
+namespace fake_search {
+
+/// `a_size` x `b_size` configs "a,b".
+struct Problem
+{
+    int a_size = 8;
+    int b_size = 8;
+
+    void Serialize(std::ostream& stream) const { stream << "problem" << a_size << 'x' << b_size; }
+};
+
+/// Enumerated with b first.
+struct PerformanceConfig
+{
+    int a = -1;
+    int b = 0;
+
+    PerformanceConfig() = default;
+    PerformanceConfig(bool) : a(0) {}
+
+    bool SetNextValue(const Problem& problem)
+    {
+        if(++b < problem.b_size)
+            return true;
+        b = 0;
+        return ++a < problem.a_size;
+    }
+    bool IsValid(const miopen::ConvolutionContext&, const Problem&) const { return a >= 0; }
+    bool operator==(const PerformanceConfig& other) const { return a == other.a && b == other.b; }
+    void Serialize(std::ostream& stream) const { stream << a << ',' << b; }
+
+    friend std::ostream& operator<<(std::ostream& stream, const PerformanceConfig& config)
+    {
+        return stream << config.a << ',' << config.b;
+    }
+
+    static PerformanceConfig Parse(const std::string& config)
+    {
+        const auto comma = config.find(',');
+        auto parsed      = PerformanceConfig{};
+        parsed.a         = std::stoi(config.substr(0, comma));
+        parsed.b         = std::stoi(config.substr(comma + 1));
+        return parsed;
+    }
+};
+
+struct Solver
+{
+    const std::string& SolverDbId() const
+    {
+        static const std::string id = "FakeSolver";
+        return id;
+    }
+
+    PerformanceConfig GetDefaultPerformanceConfig(const miopen::ConvolutionContext&,
+                                                  const Problem&) const
+    {
+        return PerformanceConfig{true};
+    }
+
+    miopen::solver::ConvSolution GetSolution(const miopen::ConvolutionContext&,
+                                             const Problem& problem,
+                                             const PerformanceConfig& config) const
+    {
+        auto kernel = miopen::solver::KernelInfo{};
+        kernel.l_wk = {64, 1, 1};
+        kernel.g_wk = {64 * static_cast<std::size_t>(1 + config.a + problem.a_size * config.b),
+                       1,
+                       1};
+
+        auto solution = miopen::solver::ConvSolution{};
+        solution.construction_params.push_back(kernel);
+        return solution;
+    }
+};
+
+/// Times follow a function of the config, by default with the optimum at 5,2. Measuring a config
+/// in `failing` throws.
+struct CostModel : miopen::solver::SearchCostModel
+{
+    std::function<float(const PerformanceConfig&)> time = [](const PerformanceConfig& config) {
+        return 1.0f + std::abs(config.a - 5) + std::abs(config.b - 2);
+    };
+    std::vector<std::string> failing;
+
+    std::vector<miopen::solver::SearchCandidate> candidates;
+    /// Configs measured for the first time, in order.
+    std::vector<std::string> first_runs;
+    std::size_t kernels = 0;
+
+    float Measure(const miopen::solver::SearchCandidate& candidate) override
+    {
+        candidates.push_back(candidate);
+        if(candidate.repeat == 0 && !candidate.is_default)
+            first_runs.push_back(candidate.config);
+        if(candidate.solution != nullptr)
+            kernels += candidate.solution->construction_params.size();
+        if(std::find(failing.begin(), failing.end(), candidate.config) != failing.end())
+            MIOPEN_THROW("Failing config");
+        return time(PerformanceConfig::Parse(candidate.config));
+    }
+};
+
+} // namespace fake_search
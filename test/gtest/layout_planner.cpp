@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/convolution.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/layout_planner.hpp>
+#include <miopen/problem.hpp>
+
+#include "get_handle.hpp"
+
+#include <algorithm>
+
+namespace {
+
+miopen::LayoutPlanStep Step(std::vector<miopen::LayoutChoice> layouts, std::size_t bytes = 100)
+{
+    auto step        = miopen::LayoutPlanStep{};
+    step.layouts     = std::move(layouts);
+    step.input_bytes = step.output_bytes = bytes;
+    return step;
+}
+
+const auto nhwc_only = std::vector<miopen::LayoutChoice>{{"NHWC", 1.f}};
+const auto both      = std::vector<miopen::LayoutChoice>{{"NCHW", 2.f}, {"NHWC", 1.f}};
+
+miopen::Problem MakeConvProblem(miopenProblemDirection_t direction, bool with_y = true)
+{
+    auto problem = miopen::Problem{};
+    problem.SetOperatorDescriptor(miopen::ConvolutionDescriptor{{1, 1}});
+    problem.SetDirection(direction);
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionX,
+                                     miopen::TensorDescriptor{miopenFloat, {2, 8, 16, 16}});
+    problem.RegisterTensorDescriptor(miopenTensorConvolutionW,
+                                     miopen::TensorDescriptor{miopenFloat, {4, 8, 3, 3}});
+    if(with_y)
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionY,
+                                         miopen::TensorDescriptor{miopenFloat, {2, 4, 16, 16}});
+    return problem;
+}
+
+bool HasLayout(const miopen::LayoutPlanStep& step, const std::string& layout)
+{
+    return std::any_of(step.layouts.begin(), step.layouts.end(), [&](const auto& choice) {
+        return choice.layout == layout;
+    });
+}
+
+} // namespace
+
+TEST(LayoutPlanner, StaysInNhwcAcrossTheChain)
+{
+    const auto plan = miopen::PlanLayouts(
+        {Step(nhwc_only), Step(both), Step(nhwc_only), Step(nhwc_only)}, "NCHW", "NCHW");
+
+    EXPECT_EQ(plan.layouts, (std::vector<std::string>{"NHWC", "NHWC", "NHWC", "NHWC"}));
+    ASSERT_EQ(plan.transforms.size(), 2);
+    EXPECT_EQ(plan.transforms[0].position, 0);
+    EXPECT_EQ(plan.transforms[0].to, "NHWC");
+    EXPECT_EQ(plan.transforms[1].position, 4);
+    EXPECT_EQ(plan.transforms[1].to, "NCHW");
+    EXPECT_EQ(plan.bytes_moved, 400);
+    // Every step transposes in and out on its own.
+    EXPECT_EQ(plan.unplanned_bytes_moved, 1600);
+}
+
+TEST(LayoutPlanner, AvoidsTransposesWhenTheInputLayoutWorks)
+{
+    const auto plan = miopen::PlanLayouts({Step(both), Step(both)}, "NCHW", "NCHW");
+
+    EXPECT_EQ(plan.layouts, (std::vector<std::string>{"NCHW", "NCHW"}));
+    EXPECT_TRUE(plan.transforms.empty());
+    EXPECT_EQ(plan.bytes_moved, 0);
+}
+
+TEST(LayoutPlanner, TransposesTheSmallerTensor)
+{
+    const auto nchw_only = std::vector<miopen::LayoutChoice>{{"NCHW", 1.f}};
+    const auto plan      = miopen::PlanLayouts(
+        {Step(nhwc_only, 1000), Step(both, 10), Step(nchw_only, 1000)}, "NHWC", "NCHW");
+
+    EXPECT_EQ(plan.layouts, (std::vector<std::string>{"NHWC", "NCHW", "NCHW"}));
+    ASSERT_EQ(plan.transforms.size(), 1);
+    EXPECT_EQ(plan.transforms[0].position, 1);
+    EXPECT_EQ(plan.bytes_moved, 20);
+}
+
+TEST(LayoutPlanner, UsesTimeToBreakTies)
+{
+    const auto plan = miopen::PlanLayouts({Step(both)}, "NHWC", "NCHW");
+
+    // One transform either way, NHWC is faster.
+    EXPECT_EQ(plan.layouts, (std::vector<std::string>{"NHWC"}));
+    EXPECT_EQ(plan.transforms.size(), 1);
+}
+
+TEST(LayoutPlanner, RejectsStepsWithoutLayouts)
+{
+    EXPECT_THROW(miopen::PlanLayouts({Step(both), Step({})}, "NCHW", "NCHW"), miopen::Exception);
+    EXPECT_THROW(miopen::PlanLayouts({}, "NCHW", "NCHW"), miopen::Exception);
+}
+
+TEST(LayoutPlanner, MakesStepsFromConvolutionProblems)
+{
+    auto& handle = get_handle();
+
+    const auto forward = MakeConvProblem(miopenProblemDirectionForward)
+                             .MakeLayoutPlanStep(handle, {"NCHW", "NCDHW"});
+    EXPECT_EQ(forward.input_bytes, 2 * 8 * 16 * 16 * sizeof(float));
+    EXPECT_EQ(forward.output_bytes, 2 * 4 * 16 * 16 * sizeof(float));
+    // FP32 NCHW always has a native solver, a 5D layout never fits a 4D problem.
+    EXPECT_TRUE(HasLayout(forward, "NCHW"));
+    EXPECT_FALSE(HasLayout(forward, "NCDHW"));
+
+    // Backward data reads y and writes x.
+    const auto backward = MakeConvProblem(miopenProblemDirectionBackward)
+                              .MakeLayoutPlanStep(handle, {"NCHW"});
+    EXPECT_EQ(backward.input_bytes, forward.output_bytes);
+    EXPECT_EQ(backward.output_bytes, forward.input_bytes);
+    EXPECT_TRUE(HasLayout(backward, "NCHW"));
+}
+
+TEST(LayoutPlanner, RejectsProblemsThatCanNotBeChained)
+{
+    auto& handle = get_handle();
+
+    EXPECT_THROW(MakeConvProblem(miopenProblemDirectionBackwardWeights)
+                     .MakeLayoutPlanStep(handle, {"NCHW"}),
+                 miopen::Exception);
+    EXPECT_THROW(
+        MakeConvProblem(miopenProblemDirectionForward, false).MakeLayoutPlanStep(handle, {"NCHW"}),
+        miopen::Exception);
+}
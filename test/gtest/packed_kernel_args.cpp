@@ -0,0 +1,82 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/op_kernel_args.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// The layout the HIP backend builds from a std::vector<OpKernelArg> at every launch.
+std::vector<char> Repack(const std::vector<OpKernelArg>& args)
+{
+    std::vector<char> packed;
+    for(const auto& arg : args)
+    {
+        const auto alignment = arg.size();
+        packed.resize(packed.size() + (alignment - packed.size() % alignment) % alignment);
+        packed.insert(packed.end(), arg.buffer.begin(), arg.buffer.end());
+    }
+    return packed;
+}
+
+} // namespace
+
+TEST(PackedKernelArgs, Layout)
+{
+    using Layout = KernelArgsLayout<const void*, int, void*, short, char, double>;
+    EXPECT_EQ(Layout::offsets[0], 0);
+    EXPECT_EQ(Layout::offsets[1], 8);
+    EXPECT_EQ(Layout::offsets[2], 16);
+    EXPECT_EQ(Layout::offsets[3], 24);
+    EXPECT_EQ(Layout::offsets[4], 26);
+    EXPECT_EQ(Layout::offsets[5], 32);
+    EXPECT_EQ(Layout::size, 40);
+}
+
+TEST(PackedKernelArgs, MatchesOpKernelArgs)
+{
+    int a = 0;
+    int b = 0;
+
+    auto packed = PackKernelArgs(static_cast<const void*>(nullptr), 3, 7u, short{5}, 11, 0.5f);
+    packed.Set<0>(&a);
+
+    std::vector<OpKernelArg> args{&a, 3, 7u, short{5}, 11, 0.5f};
+    auto expected = Repack(args);
+    ASSERT_EQ(packed.size(), expected.size());
+    EXPECT_EQ(std::memcmp(packed.data(), expected.data(), expected.size()), 0);
+
+    packed.Set<0>(&b);
+    packed.Set<4>(13);
+    args[0]  = OpKernelArg(&b);
+    args[4]  = OpKernelArg(13);
+    expected = Repack(args);
+    EXPECT_EQ(std::memcmp(packed.data(), expected.data(), expected.size()), 0);
+    EXPECT_EQ(packed.Get<0>(), &b);
+    EXPECT_EQ(packed.Get<4>(), 13);
+}
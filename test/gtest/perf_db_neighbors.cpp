@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/perf_db_neighbors.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::string Key(int n, int c, int hw, int filter = 3, const std::string& direction = "F")
+{
+    const auto pad = std::to_string(filter / 2);
+    const auto f   = std::to_string(filter);
+    const auto s   = std::to_string(hw);
+    return std::to_string(c) + "-" + s + "-" + s + "-" + f + "x" + f + "-64-" + s + "-" + s + "-" +
+           std::to_string(n) + "-" + pad + "x" + pad + "-1x1-1x1-0-NCHW-FP32-" + direction;
+}
+
+miopen::conv::ProblemDescription Problem(const std::string& key)
+{
+    auto problem = miopen::conv::ProblemDescription{};
+    EXPECT_TRUE(miopen::ParsePerfDbKey(key, problem)) << key;
+    return problem;
+}
+
+std::vector<std::string> Values(const std::vector<miopen::PerfDbNeighbor>& neighbors)
+{
+    auto values = std::vector<std::string>{};
+    for(const auto& neighbor : neighbors)
+        values.push_back(neighbor.values);
+    return values;
+}
+
+} // namespace
+
+TEST(PerfDbNeighbors, FindsTheNearestRecordsFirst)
+{
+    auto contents = miopen::DbContents{};
+    for(const auto n : {1, 4, 16, 64, 256})
+        contents[Key(n, 64, 28)]["Solver"] = "n" + std::to_string(n);
+
+    const auto index = miopen::PerfDbNeighborIndex{contents};
+    EXPECT_EQ(index.Size(), 5u);
+
+    const auto neighbors = index.Find(Problem(Key(24, 64, 28)), "Solver", 3);
+    EXPECT_EQ(Values(neighbors), (std::vector<std::string>{"n16", "n64", "n4"}));
+    EXPECT_LT(neighbors[0].distance, neighbors[1].distance);
+}
+
+TEST(PerfDbNeighbors, PrefersTheSameFilterOverTheSameSize)
+{
+    auto contents                     = miopen::DbContents{};
+    contents[Key(32, 64, 28, 1)]["S"] = "1x1";
+    contents[Key(2, 64, 56, 3)]["S"]  = "3x3";
+
+    const auto index = miopen::PerfDbNeighborIndex{contents};
+    EXPECT_EQ(Values(index.Find(Problem(Key(32, 64, 28, 3)), "S", 1)),
+              std::vector<std::string>{"3x3"});
+}
+
+TEST(PerfDbNeighbors, OnlyConsidersTheSameSolverAndDirection)
+{
+    auto contents                         = miopen::DbContents{};
+    contents[Key(16, 64, 28)]["A"]        = "a";
+    contents[Key(16, 64, 28)]["B"]        = "b";
+    contents[Key(8, 64, 28, 3, "B")]["A"] = "a backward";
+
+    const auto index = miopen::PerfDbNeighborIndex{contents};
+    EXPECT_EQ(Values(index.Find(Problem(Key(8, 64, 28)), "A", 4)),
+              std::vector<std::string>{"a"});
+    EXPECT_TRUE(index.Find(Problem(Key(8, 64, 28)), "C", 4).empty());
+}
+
+TEST(PerfDbNeighbors, SkipsTheRecordOfTheProblem)
+{
+    auto contents                  = miopen::DbContents{};
+    contents[Key(16, 64, 28)]["S"] = "self";
+    contents[Key(32, 64, 28)]["S"] = "other";
+
+    const auto index = miopen::PerfDbNeighborIndex{contents};
+    EXPECT_EQ(Values(index.Find(Problem(Key(16, 64, 28)), "S", 4)),
+              std::vector<std::string>{"other"});
+}
+
+TEST(PerfDbNeighbors, MatchesAnExhaustiveSearch)
+{
+    auto contents = miopen::DbContents{};
+    auto keys     = std::vector<std::string>{};
+    for(const auto n : {1, 2, 8, 32, 128})
+        for(const auto c : {3, 16, 64, 256, 1024})
+            for(const auto hw : {7, 14, 56, 224})
+                for(const auto filter : {1, 3, 5})
+                {
+                    keys.push_back(Key(n, c, hw, filter));
+                    contents[keys.back()]["S"] = keys.back();
+                }
+
+    const auto index = miopen::PerfDbNeighborIndex{contents};
+    for(const auto& key : {Key(4, 32, 28), Key(64, 512, 112, 1), Key(1, 4, 224, 5)})
+    {
+        // With every record as a candidate, the distances are the ones of a full scan.
+        const auto all     = index.Find(Problem(key), "S", keys.size());
+        const auto nearest = index.Find(Problem(key), "S", 5);
+        ASSERT_EQ(all.size(), keys.size());
+        ASSERT_EQ(nearest.size(), 5u);
+        for(std::size_t i = 0; i < nearest.size(); ++i)
+            EXPECT_FLOAT_EQ(nearest[i].distance, all[i].distance);
+        for(std::size_t i = 1; i < all.size(); ++i)
+            EXPECT_LE(all[i - 1].distance, all[i].distance);
+    }
+}
+
+TEST(PerfDbNeighbors, ReplayComparesTheNeighborsWithTheTunedConfigs)
+{
+    auto contents                  = miopen::DbContents{};
+    contents[Key(1, 64, 28)]["S"]  = "small";
+    contents[Key(2, 64, 28)]["S"]  = "small";
+    contents[Key(64, 64, 28)]["S"] = "large";
+
+    const auto stats = miopen::ReplayPerfDbNeighbors(contents, 1, nullptr);
+    EXPECT_EQ(stats.entries, 3u);
+    EXPECT_EQ(stats.found, 3u);
+    EXPECT_EQ(stats.nearest_match, 2u);
+    EXPECT_EQ(stats.any_match, 2u);
+}
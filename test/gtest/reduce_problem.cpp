@@ -0,0 +1,122 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/names.hpp>
+#include <miopen/reduce/problem_description.hpp>
+
+#include <vector>
+
+namespace {
+
+using Lengths = std::vector<std::size_t>;
+
+miopen::reduce::ProblemDescription MakeProblem(const Lengths& in_lens,
+                                               const Lengths& out_lens,
+                                               const Lengths& in_strides  = {},
+                                               const Lengths& out_strides = {})
+{
+    const auto reduce = miopen::ReduceTensorDescriptor{MIOPEN_REDUCE_TENSOR_ADD,
+                                                       miopenFloat,
+                                                       MIOPEN_NOT_PROPAGATE_NAN,
+                                                       MIOPEN_REDUCE_TENSOR_NO_INDICES,
+                                                       MIOPEN_32BIT_INDICES};
+    const auto x      = in_strides.empty()
+                            ? miopen::TensorDescriptor{miopenFloat, in_lens}
+                            : miopen::TensorDescriptor{miopenFloat, in_lens, in_strides};
+    const auto y      = out_strides.empty()
+                            ? miopen::TensorDescriptor{miopenFloat, out_lens}
+                            : miopen::TensorDescriptor{miopenFloat, out_lens, out_strides};
+    return {reduce, x, y};
+}
+
+} // namespace
+
+TEST(ReduceProblem, FoldsContiguousDims)
+{
+    const auto problem = MakeProblem({2, 3, 4, 5}, {2, 3, 1, 1});
+
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{6, 20}));
+    EXPECT_EQ(problem.GetXDesc().GetStrides(), (Lengths{20, 1}));
+    EXPECT_EQ(problem.GetYDesc().GetLengths(), (Lengths{6, 1}));
+    EXPECT_EQ(problem.GetInvariantDims(), (std::vector<int>{0}));
+    EXPECT_EQ(problem.GetToReduceDims(), (std::vector<int>{1}));
+    EXPECT_EQ(problem.GetInvariantLength(), 6u);
+    EXPECT_EQ(problem.GetToReduceLength(), 20u);
+}
+
+TEST(ReduceProblem, KeepsInterleavedDims)
+{
+    const auto problem = MakeProblem({2, 3, 4, 5}, {2, 1, 4, 5});
+
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{2, 3, 20}));
+    EXPECT_EQ(problem.GetYDesc().GetLengths(), (Lengths{2, 1, 20}));
+    EXPECT_EQ(problem.GetYDesc().GetStrides(), (Lengths{20, 20, 1}));
+    EXPECT_EQ(problem.GetInvariantDims(), (std::vector<int>{0, 2}));
+    EXPECT_EQ(problem.GetToReduceDims(), (std::vector<int>{1}));
+}
+
+TEST(ReduceProblem, DropsUnitDims)
+{
+    const auto problem = MakeProblem({1, 8, 1, 16}, {1, 8, 1, 1});
+
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{8, 16}));
+    EXPECT_EQ(problem.GetInvariantDims(), (std::vector<int>{0}));
+    EXPECT_EQ(problem.GetToReduceDims(), (std::vector<int>{1}));
+}
+
+TEST(ReduceProblem, KeepsOneReducedDim)
+{
+    const auto problem = MakeProblem({4, 1}, {4, 1});
+
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{4, 1}));
+    EXPECT_EQ(problem.GetToReduceDims(), (std::vector<int>{1}));
+    EXPECT_EQ(problem.GetToReduceLength(), 1u);
+}
+
+TEST(ReduceProblem, DoesNotFoldStridedDims)
+{
+    const auto problem = MakeProblem({4, 8, 16}, {4, 1, 1}, {256, 32, 1});
+
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{4, 8, 16}));
+    EXPECT_EQ(problem.GetToReduceDims(), (std::vector<int>{1, 2}));
+}
+
+TEST(ReduceProblem, AllDimsReduced)
+{
+    const auto problem = MakeProblem({2, 3, 4}, {1, 1, 1});
+
+    EXPECT_TRUE(problem.IsAllDimsReduced());
+    EXPECT_EQ(problem.GetXDesc().GetLengths(), (Lengths{24}));
+}
+
+TEST(ReduceProblem, NetworkConfigDependsOnStrides)
+{
+    const auto packed  = MakeProblem({4, 8, 16}, {4, 1, 1});
+    const auto strided = MakeProblem({4, 8, 16}, {4, 1, 1}, {256, 32, 1});
+
+    EXPECT_NE(packed.MakeNetworkConfig().ToString(), strided.MakeNetworkConfig().ToString());
+}
@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/rnn_plan.hpp>
+
+#include <array>
+
+namespace {
+
+miopen::RNNPlanKey MakeKey(std::vector<int> batches)
+{
+    miopen::RNNPlanKey key;
+    key.in_h            = 16;
+    key.hy_d            = 1;
+    key.hy_n            = batches.front();
+    key.hy_h            = 32;
+    key.out_h           = 32;
+    key.batches         = std::move(batches);
+    key.workspace_size  = 4096;
+    key.present_buffers = 0x5;
+    return key;
+}
+
+miopen::RNNGemmCall MakeGemm(int m, int a_offset, int b_offset, int c_offset)
+{
+    static float a = 0, b = 0, c = 0;
+    return {miopen::GemmDescriptor{
+                false, false, true, m, 64, 16, 16, 16, 256, 1, 0, 0, 0, 1, 1, miopenFloat, false},
+            DataCast(&a),
+            a_offset,
+            DataCast(&b),
+            b_offset,
+            DataCast(&c),
+            c_offset,
+            miopen::GemmBackend_t::miopengemm};
+}
+
+} // namespace
+
+TEST(RNNPlan, BindingsResolveUniqueBuffers)
+{
+    std::array<float, 3> storage{};
+    miopen::RNNPlanBindings bindings;
+    bindings.Set(miopen::RNNPlanBuffer::X, &storage[0]);
+    bindings.Set(miopen::RNNPlanBuffer::Workspace, &storage[1]);
+
+    miopen::RNNPlanBuffer buffer{};
+    ASSERT_TRUE(bindings.Find(&storage[1], buffer));
+    EXPECT_EQ(buffer, miopen::RNNPlanBuffer::Workspace);
+    EXPECT_FALSE(bindings.Find(&storage[2], buffer));
+    EXPECT_FALSE(bindings.Find(nullptr, buffer));
+
+    // Aliased buffers can not be told apart on replay.
+    bindings.Set(miopen::RNNPlanBuffer::Y, &storage[0]);
+    EXPECT_FALSE(bindings.Find(&storage[0], buffer));
+}
+
+TEST(RNNPlan, CountsLaunchesPerKind)
+{
+    miopen::RNNPlan plan;
+    const auto noop = [](miopen::Handle&, const miopen::RNNPlanBindings&) {};
+    plan.Add(miopen::RNNPlanOp::Gemm, noop);
+    plan.Add(miopen::RNNPlanOp::Gemm, noop);
+    plan.Add(miopen::RNNPlanOp::OpTensor, noop);
+
+    EXPECT_EQ(plan.GetLaunchCount(), 3);
+    EXPECT_EQ(plan.GetLaunchCount(miopen::RNNPlanOp::Gemm), 2);
+    EXPECT_EQ(plan.GetLaunchCount(miopen::RNNPlanOp::OpTensor), 1);
+    EXPECT_EQ(plan.GetLaunchCount(miopen::RNNPlanOp::Activation), 0);
+}
+
+TEST(RNNPlan, CacheKeysOnBatchScheduleAndEvictsLeastRecentlyUsed)
+{
+    miopen::RNNPlanCache cache{2};
+    const auto plan = std::make_shared<const miopen::RNNPlan>();
+
+    cache.Insert(MakeKey({4, 4, 2}), plan);
+    cache.Insert(MakeKey({4, 3, 2}), plan);
+    EXPECT_EQ(cache.Find(MakeKey({4, 4, 2})), plan);
+    EXPECT_EQ(cache.Find(MakeKey({4, 4})), nullptr);
+
+    // {4, 3, 2} is now the least recently used entry.
+    cache.Insert(MakeKey({8}), plan);
+    EXPECT_EQ(cache.Size(), 2);
+    EXPECT_EQ(cache.Find(MakeKey({4, 3, 2})), nullptr);
+    EXPECT_EQ(cache.Find(MakeKey({4, 4, 2})), plan);
+    EXPECT_EQ(cache.Find(MakeKey({8})), plan);
+}
+
+TEST(RNNPlan, BatchesIndependentGemmsWithConstantStrides)
+{
+    const auto batched = miopen::BatchIndependentGemms({MakeGemm(8, 0, 0, 0),
+                                                        MakeGemm(4, 0, 0, 64),
+                                                        MakeGemm(8, 128, 1024, 64),
+                                                        MakeGemm(8, 256, 2048, 128),
+                                                        MakeGemm(8, 300, 3072, 192)});
+
+    ASSERT_EQ(batched.size(), 3);
+    EXPECT_EQ(batched[0].desc.batch_count, 3);
+    EXPECT_EQ(batched[0].desc.strideA, 128);
+    EXPECT_EQ(batched[0].desc.strideB, 1024);
+    EXPECT_EQ(batched[0].desc.strideC, 64);
+    EXPECT_EQ(batched[0].c_offset, 0);
+    // Different shape.
+    EXPECT_EQ(batched[1].desc.m, 4);
+    EXPECT_EQ(batched[1].desc.batch_count, 1);
+    // Breaks the stride of the first run.
+    EXPECT_EQ(batched[2].a_offset, 300);
+    EXPECT_EQ(batched[2].desc.batch_count, 1);
+}
+
+TEST(RNNPlan, KeepsGemmsWithNegativeStridesApart)
+{
+    const auto batched =
+        miopen::BatchIndependentGemms({MakeGemm(8, 512, 0, 256), MakeGemm(8, 0, 1024, 0)});
+
+    ASSERT_EQ(batched.size(), 2);
+    EXPECT_EQ(batched[0].desc.batch_count, 1);
+    EXPECT_EQ(batched[1].desc.batch_count, 1);
+}
+
+TEST(RNNPlan, TimeStepsReadThePreviousStepOfTheirDirection)
+{
+    const std::vector<int> in_n = {4, 3, 2};
+
+    // At ti = 1, 4 rows precede the step in both orders.
+    const auto forward = miopen::RNNTimeStep{in_n, 100, 10, 4, 4, 1, 0};
+    EXPECT_EQ(forward.cur_time, 1);
+    EXPECT_EQ(forward.offset, 140);
+    EXPECT_EQ(forward.use_time, 1);
+    EXPECT_EQ(forward.pretime_shift, 100);
+
+    const auto reverse = miopen::RNNTimeStep{in_n, 100, 10, 4, 4, 1, 1};
+    EXPECT_EQ(reverse.cur_time, 1);
+    EXPECT_EQ(reverse.offset, 140);
+    EXPECT_EQ(reverse.use_time, 2);
+    EXPECT_EQ(reverse.pretime_shift, 170);
+
+    const auto first = miopen::RNNTimeStep{in_n, 100, 10, 0, 7, 0, 1};
+    EXPECT_EQ(first.cur_time, 2);
+    EXPECT_EQ(first.offset, 170);
+    EXPECT_EQ(first.use_time, 0);
+    EXPECT_EQ(first.pretime_shift, 0);
+}
+
+TEST(RNNPlan, BatchesHiddenGemmsOfBothDirectionsWhileStridesAllow)
+{
+    static float hx = 0, w = 0, workspace = 0;
+    const std::vector<int> in_n = {4, 4, 4, 4};
+    const auto hy_stride        = 16 * 2 * 6;
+
+    const auto layer = miopen::RNNHiddenGemmLayer{miopenFloat,
+                                                  2,
+                                                  16,
+                                                  4,
+                                                  64,
+                                                  2 * 16 * 5,
+                                                  hy_stride,
+                                                  16,
+                                                  0,
+                                                  0,
+                                                  1024,
+                                                  DataCast(&hx),
+                                                  DataCast(&w),
+                                                  DataCast(&workspace)};
+
+    const auto first = miopen::RNNHiddenGemms(layer, in_n, 0, 12, 0);
+    ASSERT_EQ(first.size(), 2);
+    EXPECT_EQ(first[0].A, DataCast(&hx));
+    EXPECT_EQ(first[1].a_offset, 4 * 16);
+    EXPECT_EQ(first[1].c_offset, 12 * hy_stride + 64);
+
+    // The reverse direction reads rows after the forward one in the first half only.
+    const auto second = miopen::RNNHiddenGemms(layer, in_n, 4, 8, 1);
+    ASSERT_EQ(second.size(), 2);
+    EXPECT_EQ(second[1].a_offset, 12 * hy_stride + 2 * 16 * 5 + 16);
+    EXPECT_EQ(miopen::BatchIndependentGemms(second).size(), 1);
+
+    const auto last = miopen::RNNHiddenGemms(layer, in_n, 12, 0, 3);
+    ASSERT_EQ(last.size(), 2);
+    EXPECT_EQ(miopen::BatchIndependentGemms(last).size(), 2);
+}
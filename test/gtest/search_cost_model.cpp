@@ -0,0 +1,215 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/conv/context.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/search_cost_model.hpp>
+
+#include "fake_search.hpp"
+#include "get_handle.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+miopen::solver::SearchCandidate Candidate(const miopen::solver::ConvSolution& solution,
+                                          const std::string& config,
+                                          int repeat = 0)
+{
+    auto candidate     = miopen::solver::SearchCandidate{};
+    candidate.solver   = "Solver";
+    candidate.problem  = "problem";
+    candidate.config   = config;
+    candidate.solution = &solution;
+    candidate.repeat   = repeat;
+    return candidate;
+}
+
+miopen::solver::ConvSolution Solution(std::size_t local, std::size_t global)
+{
+    auto kernel = miopen::solver::KernelInfo{};
+    kernel.l_wk = {local, 1, 1};
+    kernel.g_wk = {global, 1, 1};
+
+    auto solution = miopen::solver::ConvSolution{};
+    solution.construction_params.push_back(kernel);
+    return solution;
+}
+
+} // namespace
+
+TEST(SearchCostModel, GenericSearchUsesTheModelInsteadOfTheDevice)
+{
+    auto model    = fake_search::CostModel{};
+    model.time    = [](const auto& config) { return 1.0f + std::abs(config.a - 11); };
+    model.failing = {"3,0"};
+
+    auto context              = miopen::ConvolutionContext{miopen::ExecutionContext{&get_handle()}};
+    context.search_cost_model = &model;
+
+    const auto problem = fake_search::Problem{16, 1};
+    const auto best = miopen::solver::GenericSearch(fake_search::Solver{}, context, problem, {});
+    EXPECT_EQ(best.a, 11);
+
+    for(const auto& candidate : model.candidates)
+    {
+        EXPECT_EQ(candidate.solver, "FakeSolver");
+        EXPECT_EQ(candidate.problem, "problem16x1");
+    }
+    auto first_runs = std::vector<int>{};
+    for(const auto& config : model.first_runs)
+        first_runs.push_back(fake_search::PerformanceConfig::Parse(config).a);
+    std::sort(first_runs.begin(), first_runs.end());
+    EXPECT_EQ(model.kernels, model.candidates.size());
+    EXPECT_EQ(first_runs.size(), 16u);
+    EXPECT_EQ(first_runs.front(), 0);
+    EXPECT_EQ(first_runs.back(), 15);
+
+    ASSERT_FALSE(model.candidates.empty());
+    EXPECT_TRUE(model.candidates.back().is_default);
+    EXPECT_EQ(model.candidates.back().config, "0,0");
+}
+
+TEST(SearchCostModel, GenericSearchFailsWhenEveryConfigFails)
+{
+    auto model    = fake_search::CostModel{};
+    model.failing = {"0,0", "1,0", "2,0", "3,0"};
+
+    auto context              = miopen::ConvolutionContext{miopen::ExecutionContext{&get_handle()}};
+    context.search_cost_model = &model;
+
+    const auto problem = fake_search::Problem{4, 1};
+    EXPECT_THROW(miopen::solver::GenericSearch(fake_search::Solver{}, context, problem, {}),
+                 miopen::Exception);
+}
+
+TEST(SearchCostModel, AnalyticModelPrefersFullWavefrontsAndRounds)
+{
+    // 4 CUs run 160 workgroups of one wavefront at a time.
+    auto model = miopen::solver::AnalyticCostModel{4, 1.0f, 0.0f};
+
+    const auto full    = Solution(64, 64 * 160);
+    const auto partial = Solution(48, 48 * 160);
+    const auto tail    = Solution(64, 64 * 161);
+
+    EXPECT_LT(model.Measure(Candidate(full, "a")), model.Measure(Candidate(partial, "b")));
+    EXPECT_LT(model.Measure(Candidate(full, "a")), model.Measure(Candidate(tail, "c")));
+    EXPECT_FLOAT_EQ(model.Measure(Candidate(full, "a")), model.Measure(Candidate(full, "b")));
+    EXPECT_THROW(model.Measure(Candidate({}, "a")), miopen::Exception);
+}
+
+TEST(SearchCostModel, AnalyticModelIsDeterministicPerConfig)
+{
+    auto flat_model  = miopen::solver::AnalyticCostModel{4, 1.0f, 0.0f};
+    auto rough_model = miopen::solver::AnalyticCostModel{4, 1.0f, 0.5f};
+    auto noisy_model = miopen::solver::AnalyticCostModel{4, 1.0f, 0.0f, 0.1f};
+
+    const auto solution = Solution(64, 4096);
+    const auto flat     = flat_model.Measure(Candidate(solution, "a"));
+    const auto rough    = rough_model.Measure(Candidate(solution, "a"));
+
+    EXPECT_FLOAT_EQ(rough_model.Measure(Candidate(solution, "a")), rough);
+    EXPECT_GE(rough, flat);
+    EXPECT_LT(rough, 1.5f * flat);
+
+    for(auto i = 0; i < 10; ++i)
+    {
+        const auto time = noisy_model.Measure(Candidate(solution, "a"));
+        EXPECT_GE(time, 0.9f * flat);
+        EXPECT_LE(time, 1.1f * flat);
+    }
+}
+
+TEST(SearchCostModel, RecordedModelAveragesTheRecordedTimes)
+{
+    const auto path =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    {
+        auto file = std::ofstream{path.string()};
+        file << "problem Solver 1,2 2.0\n";
+        file << "problem Solver 1,2 4.0\n";
+        file << "problem Solver 3,4 1.5\n";
+        file << "ill-formed\n";
+        file << "other Solver 1,2 8.0\n";
+    }
+
+    auto model = miopen::solver::RecordedCostModel{path.string()};
+    boost::filesystem::remove(path);
+
+    const auto solution = Solution(64, 64);
+    EXPECT_EQ(model.Size(), 3u);
+    EXPECT_FLOAT_EQ(model.Measure(Candidate(solution, "1,2")), 3.0f);
+    EXPECT_FLOAT_EQ(model.Measure(Candidate(solution, "3,4")), 1.5f);
+    EXPECT_THROW(model.Measure(Candidate(solution, "5,6")), miopen::Exception);
+    EXPECT_THROW(miopen::solver::RecordedCostModel{path.string()}, miopen::Exception);
+}
+
+TEST(SearchCostModel, TraceReportsTheBestConfigAndWhenItWasFound)
+{
+    auto model    = fake_search::CostModel{};
+    model.time    = [](const auto& config) { return static_cast<float>(config.a); };
+    model.failing = {"7,0"};
+    auto trace    = miopen::solver::SearchTrace{model};
+
+    const auto solution = Solution(64, 64);
+    for(const auto value : {5, 7, 3, 4})
+    {
+        const auto config = std::to_string(value) + ",0";
+        try
+        {
+            trace.Measure(Candidate(solution, config));
+            if(value == 3)
+                trace.Measure(Candidate(solution, config, 1));
+        }
+        catch(const miopen::Exception&)
+        {
+        }
+    }
+    auto candidate       = Candidate(solution, "9,0");
+    candidate.is_default = true;
+    trace.Measure(candidate);
+
+    const auto stats = trace.GetStats();
+    EXPECT_EQ(stats.evaluated, 4u);
+    EXPECT_EQ(stats.failed, 1u);
+    EXPECT_FLOAT_EQ(stats.best, 3.0f);
+    EXPECT_EQ(stats.evaluations_best, 3u);
+    EXPECT_FLOAT_EQ(stats.default_time, 9.0f);
+    EXPECT_FLOAT_EQ(trace.BestAfter(0), 0.0f);
+    EXPECT_FLOAT_EQ(trace.BestAfter(2), 5.0f);
+    EXPECT_FLOAT_EQ(trace.BestAfter(10), 3.0f);
+
+    trace.Clear();
+    EXPECT_EQ(trace.GetStats().evaluated, 0u);
+}
@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/conv/context.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/search_strategy.hpp>
+
+#include "fake_search.hpp"
+#include "get_handle.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+const auto strategies = std::vector<std::string>{"random", "local", "evolution", "surrogate"};
+
+/// A grid of configs, "a,b,c", with a separable landscape whose optimum is 11,4,6 (or its
+/// nearest point).
+struct Grid
+{
+    std::vector<std::string> keys;
+    std::vector<float> times;
+
+    Grid(int na, int nb, int nc)
+    {
+        for(auto a = 0; a < na; ++a)
+        {
+            for(auto b = 0; b < nb; ++b)
+            {
+                for(auto c = 0; c < nc; ++c)
+                {
+                    keys.push_back(std::to_string(a) + "," + std::to_string(b) + "," +
+                                   std::to_string(c));
+                    times.push_back(1.0f + std::abs(a - 11) + 2 * std::abs(b - 4) +
+                                    0.5f * std::abs(c - 6));
+                }
+            }
+        }
+    }
+
+    /// Runs the strategy in batches of `batch` configs and returns the number of evaluations it
+    /// took to reach the optimum.
+    std::size_t EvaluationsToOptimum(miopen::solver::SearchStrategy& strategy,
+                                     std::size_t batch) const
+    {
+        auto evaluated = std::size_t{0};
+        while(true)
+        {
+            const auto proposed = strategy.Propose(batch);
+            if(proposed.empty())
+                return evaluated;
+            for(const auto index : proposed)
+            {
+                ++evaluated;
+                if(times[index] == *std::min_element(times.begin(), times.end()))
+                    return evaluated;
+                strategy.Report(index, times[index], false);
+            }
+        }
+    }
+};
+
+} // namespace
+
+TEST(SearchStrategy, ProposesEveryConfigOnce)
+{
+    const auto grid = Grid{6, 6, 4};
+    for(const auto& name : strategies)
+    {
+        for(const auto batch : {1, 7})
+        {
+            const auto strategy = miopen::solver::MakeSearchStrategy(name, grid.keys, 1);
+            EXPECT_EQ(strategy->Name(), name);
+
+            auto seen = std::vector<int>(grid.keys.size());
+            while(true)
+            {
+                const auto proposed = strategy->Propose(batch);
+                if(proposed.empty())
+                    break;
+                EXPECT_LE(proposed.size(), static_cast<std::size_t>(batch)) << name;
+                for(const auto index : proposed)
+                {
+                    ASSERT_LT(index, grid.keys.size()) << name;
+                    ++seen[index];
+                    strategy->Report(index, grid.times[index], index % 13 == 0);
+                }
+            }
+            EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](int n) { return n == 1; }))
+                << name;
+        }
+    }
+}
+
+TEST(SearchStrategy, AdaptiveStrategiesReachTheOptimumSoonerThanRandomOrder)
+{
+    // Random order needs half of the 2048 configs on average.
+    const auto grid = Grid{16, 16, 8};
+    for(const auto& name : strategies)
+    {
+        if(name == "random")
+            continue;
+        auto total = std::size_t{0};
+        for(auto seed = 0u; seed < 8; ++seed)
+        {
+            const auto strategy = miopen::solver::MakeSearchStrategy(name, grid.keys, seed);
+            total += grid.EvaluationsToOptimum(*strategy, 4);
+        }
+        EXPECT_LT(total / 8, grid.keys.size() / 8) << name;
+    }
+}
+
+TEST(SearchStrategy, ContextOverridesTheDefault)
+{
+    auto context = miopen::ExecutionContext{};
+    EXPECT_EQ(miopen::solver::GetSearchStrategyName(context), "random");
+    context.search_strategy = "surrogate";
+    EXPECT_EQ(miopen::solver::GetSearchStrategyName(context), "surrogate");
+    EXPECT_THROW(miopen::solver::MakeSearchStrategy("annealing", {"1"}, 0), miopen::Exception);
+}
+
+TEST(SearchStrategy, GenericSearchFollowsTheStrategy)
+{
+    for(const auto& name : strategies)
+    {
+        auto model   = fake_search::CostModel{};
+        auto context = miopen::ConvolutionContext{miopen::ExecutionContext{&get_handle()}};
+
+        context.search_cost_model = &model;
+        context.search_strategy   = name;
+
+        const auto best = miopen::solver::GenericSearch(
+            fake_search::Solver{}, context, fake_search::Problem{}, {});
+        EXPECT_EQ(best.a, 5) << name;
+        EXPECT_EQ(best.b, 2) << name;
+        EXPECT_EQ(model.first_runs.size(), 64u) << name;
+    }
+}
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+#include <miopen/errors.hpp>
+// datatype.hpp relies on MIOPEN_THROW without including errors.hpp.
+#include <miopen/datatype.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_cache.hpp>
+#include <miopen/shared_program_cache.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+
+miopen::SharedProgramCache::Key MakeKey(const std::string& name)
+{
+    return {"gtest", name, "-DTEST=1"};
+}
+
+class SharedProgramCacheHandles : public ::testing::Test
+{
+protected:
+    // Handles read the variable when they are created.
+    static void SetUpTestSuite() { setenv("MIOPEN_SHARED_PROGRAM_CACHE", "1", 1); }
+};
+
+} // namespace
+
+TEST(SharedProgramCache, BuildsOnceForConcurrentHandles)
+{
+    auto& cache    = miopen::SharedProgramCache::Instance();
+    const auto key = MakeKey("concurrent.cl");
+    std::atomic<int> builds{0};
+
+    std::vector<std::thread> threads;
+    for(auto i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&]() {
+            cache.Acquire(key, [&]() {
+                builds++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return miopen::Program{};
+            });
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(builds, 1);
+    EXPECT_TRUE(cache.Contains(key));
+
+    for(auto i = 0; i < 3; i++)
+    {
+        cache.Release(key);
+        EXPECT_TRUE(cache.Contains(key));
+    }
+    cache.Release(key);
+    EXPECT_FALSE(cache.Contains(key));
+}
+
+TEST(SharedProgramCache, FailedBuildIsRetried)
+{
+    auto& cache    = miopen::SharedProgramCache::Instance();
+    const auto key = MakeKey("failing.cl");
+
+    EXPECT_THROW(cache.Acquire(key, []() -> miopen::Program { MIOPEN_THROW("build failed"); }),
+                 miopen::Exception);
+    EXPECT_FALSE(cache.Contains(key));
+
+    auto builds = 0;
+    cache.Acquire(key, [&]() {
+        builds++;
+        return miopen::Program{};
+    });
+    EXPECT_EQ(builds, 1);
+    cache.Release(key);
+    EXPECT_FALSE(cache.Contains(key));
+}
+
+TEST(SharedProgramCache, KernelCachesHoldReferencesUntilReleased)
+{
+    const auto& cache = miopen::SharedProgramCache::Instance();
+    const auto key    = MakeKey("kernel_caches.cl");
+    const auto& name  = std::get<1>(key);
+    const auto& opts  = std::get<2>(key);
+
+    miopen::KernelCache first;
+    auto second = std::make_unique<miopen::KernelCache>();
+    first.SharePrograms(std::get<0>(key));
+    second->SharePrograms(std::get<0>(key));
+
+    first.AddProgram(miopen::Program{}, name, opts);
+    EXPECT_TRUE(cache.Contains(key));
+    EXPECT_TRUE(second->HasProgram(name, opts));
+
+    second->AddProgram(miopen::Program{}, name, opts);
+    first.ClearProgram(name, opts);
+    // The second cache still holds a reference.
+    EXPECT_TRUE(cache.Contains(key));
+    EXPECT_TRUE(first.HasProgram(name, opts));
+
+    // Clearing a program twice does not release a reference the cache does not hold.
+    first.ClearProgram(name, opts);
+    EXPECT_TRUE(cache.Contains(key));
+
+    second.reset();
+    EXPECT_FALSE(cache.Contains(key));
+    EXPECT_FALSE(first.HasProgram(name, opts));
+}
+
+TEST_F(SharedProgramCacheHandles, HandlesShareProgramsOfTheirKernels)
+{
+    const auto& cache             = miopen::SharedProgramCache::Instance();
+    const std::string program     = "MIOpenCheckNumerics.cl";
+    const std::string params      = miopen::GetDataTypeKernelParams(miopenFloat);
+    const std::vector<size_t> vld = {256, 1, 1};
+    const std::vector<size_t> vgd = {256, 1, 1};
+
+    auto first               = std::make_unique<miopen::Handle>();
+    auto second              = std::make_unique<miopen::Handle>();
+    const auto shared_before = cache.Size();
+
+    first->AddKernel("", "", program, "MIOpenCheckNumerics", vld, vgd, params);
+    EXPECT_EQ(cache.Size(), shared_before + 1);
+    EXPECT_TRUE(second->HasProgram(program, params));
+
+    // The second handle takes the program built by the first one.
+    second->AddKernel("", "", program, "MIOpenCheckNumerics", vld, vgd, params);
+    EXPECT_EQ(cache.Size(), shared_before + 1);
+
+    first->ClearProgram(program, params);
+    EXPECT_TRUE(second->HasProgram(program, params));
+
+    // Destroying the last handle that uses the program drops it.
+    second.reset();
+    EXPECT_EQ(cache.Size(), shared_before);
+    EXPECT_FALSE(first->HasProgram(program, params));
+}
@@ -0,0 +1,220 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/conv/context.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/solver.hpp>
+#include <miopen/tuning_queue.hpp>
+
+#include "fake_search.hpp"
+#include "get_handle.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+struct TempDir
+{
+    fs::path path = fs::temp_directory_path() / fs::unique_path("miopen-tuning-queue-%%%%-%%%%");
+
+    TempDir() { fs::create_directories(path); }
+    ~TempDir() { fs::remove_all(path); }
+};
+
+/// Runs the slice of the checkpoint and returns the configs it evaluated.
+std::vector<std::string> Tune(miopen::TuningCheckpoint& checkpoint)
+{
+    auto model                = fake_search::CostModel{};
+    auto context              = miopen::ConvolutionContext{miopen::ExecutionContext{&get_handle()}};
+    context.search_cost_model = &model;
+    context.search_checkpoint = &checkpoint;
+    std::ignore =
+        miopen::solver::GenericSearch(fake_search::Solver{}, context, fake_search::Problem{}, {});
+    return model.first_runs;
+}
+
+std::vector<miopen::TuningJob> MakeJobs(const std::string& problem, std::size_t slices)
+{
+    auto jobs = std::vector<miopen::TuningJob>{};
+    for(auto slice = std::size_t{0}; slice < slices; ++slice)
+        jobs.push_back({0, "FakeSolver", problem, slice, slices});
+    return jobs;
+}
+
+} // namespace
+
+TEST(TuningQueue, HandsOutEveryJobOnce)
+{
+    const auto dir = TempDir{};
+    auto queue     = miopen::TuningQueue{dir.path};
+    EXPECT_EQ(queue.Enqueue(MakeJobs("{\"a\":1}", 2)), 2u);
+    EXPECT_EQ(queue.Enqueue(MakeJobs("{\"a\":2}", 2)), 2u);
+    EXPECT_EQ(queue.Enqueue(MakeJobs("{\"a\":1}", 2)), 0u);
+
+    auto ids = std::vector<std::size_t>{};
+    for(const auto& worker : {"gpu0", "gpu1", "gpu2", "gpu3"})
+    {
+        const auto job = queue.Claim(worker);
+        ASSERT_TRUE(job);
+        ids.push_back(job->id);
+    }
+    EXPECT_EQ(ids, (std::vector<std::size_t>{0, 1, 2, 3}));
+    EXPECT_FALSE(queue.Claim("gpu4"));
+
+    // A restarted worker gets its own job back.
+    const auto again = queue.Claim("gpu2");
+    ASSERT_TRUE(again);
+    EXPECT_EQ(again->id, 2u);
+    EXPECT_EQ(again->problem, "{\"a\":2}");
+    EXPECT_EQ(again->slice, 0u);
+
+    queue.Complete(*again, "gpu2");
+    const auto status = queue.GetStatus();
+    ASSERT_EQ(status.size(), 4u);
+    EXPECT_EQ(status[2].state, miopen::TuningJobState::Done);
+    EXPECT_EQ(status[3].state, miopen::TuningJobState::Running);
+    EXPECT_EQ(status[3].worker, "gpu3");
+    EXPECT_FALSE(queue.Claim("gpu2"));
+}
+
+TEST(TuningQueue, ExpiredClaimsAreTakenOver)
+{
+    const auto dir = TempDir{};
+    auto queue     = miopen::TuningQueue{dir.path};
+    queue.Enqueue(MakeJobs("{}", 1));
+    ASSERT_TRUE(queue.Claim("preempted"));
+    EXPECT_FALSE(queue.Claim("other"));
+
+    auto expired   = miopen::TuningQueue{dir.path, std::chrono::seconds{0}};
+    const auto job = expired.Claim("other");
+    ASSERT_TRUE(job);
+    EXPECT_EQ(job->id, 0u);
+    EXPECT_EQ(expired.GetStatus().front().worker, "other");
+}
+
+TEST(TuningQueue, SlicesSplitTheConfigsOfASearch)
+{
+    const auto dir = TempDir{};
+    auto evaluated = std::vector<std::string>{};
+    for(auto slice = std::size_t{0}; slice < 3; ++slice)
+    {
+        auto checkpoint    = miopen::TuningCheckpoint{dir.path / std::to_string(slice), slice, 3};
+        const auto configs = Tune(checkpoint);
+        EXPECT_TRUE(checkpoint.IsComplete());
+        EXPECT_EQ(checkpoint.Size(), configs.size());
+        evaluated.insert(evaluated.end(), configs.begin(), configs.end());
+    }
+
+    std::sort(evaluated.begin(), evaluated.end());
+    EXPECT_EQ(evaluated.size(), 64u);
+    EXPECT_EQ(std::unique(evaluated.begin(), evaluated.end()), evaluated.end());
+}
+
+TEST(TuningQueue, SearchesResumeFromTheirCheckpoint)
+{
+    const auto dir  = TempDir{};
+    const auto path = dir.path / "checkpoint";
+    {
+        // Two configs were evaluated before the worker was preempted while writing the third.
+        std::ofstream file(path.string());
+        file << "0,1\t7\n1,0\t-1\n1,1";
+    }
+
+    auto checkpoint = miopen::TuningCheckpoint{path, 0, 2};
+    EXPECT_EQ(checkpoint.Size(), 2u);
+    EXPECT_FALSE(checkpoint.Find("1,1"));
+
+    const auto configs = Tune(checkpoint);
+    EXPECT_EQ(configs.size(), 30u);
+    EXPECT_EQ(std::count(configs.begin(), configs.end(), "0,1"), 0);
+    EXPECT_EQ(std::count(configs.begin(), configs.end(), "1,1"), 1);
+    EXPECT_TRUE(checkpoint.IsComplete());
+
+    // The slice holds configs 0,0 to 3,7, the best of which is 3,2.
+    const auto reopened = miopen::TuningCheckpoint{path, 0, 2};
+    EXPECT_EQ(reopened.Size(), 32u);
+    ASSERT_TRUE(reopened.GetBest());
+    EXPECT_EQ(reopened.GetBest()->first, "3,2");
+    EXPECT_EQ(*reopened.Find("1,0"), -1.0f);
+}
+
+TEST(TuningQueue, ResultsTakeTheBestOfAllSlices)
+{
+    const auto dir = TempDir{};
+    auto queue     = miopen::TuningQueue{dir.path};
+    queue.Enqueue(MakeJobs("{}", 2));
+
+    // Only the first slice is done, the best config is in the second one.
+    {
+        const auto job = queue.Claim("gpu0");
+        ASSERT_TRUE(job);
+        auto checkpoint = queue.OpenCheckpoint(*job);
+        Tune(checkpoint);
+        queue.Complete(*job, "gpu0");
+    }
+    auto results = queue.GetResults();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].config, "3,2");
+    EXPECT_EQ(results[0].slices_left, 1u);
+
+    {
+        const auto job = queue.Claim("gpu1");
+        ASSERT_TRUE(job);
+        auto checkpoint = queue.OpenCheckpoint(*job);
+        Tune(checkpoint);
+        queue.Complete(*job, "gpu1");
+    }
+    results = queue.GetResults();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].solver, "FakeSolver");
+    EXPECT_EQ(results[0].config, "5,2");
+    EXPECT_EQ(results[0].time, 1.0f);
+    EXPECT_EQ(results[0].slices_left, 0u);
+}
+
+TEST(TuningQueue, LegacySearchesRunInTheFirstSlice)
+{
+    const auto legacy = miopen::solver::ConvOclDirectFwd{}.SolverDbId();
+    EXPECT_TRUE(miopen::SearchesInSlices("FakeSolver"));
+    EXPECT_FALSE(miopen::SearchesInSlices(legacy));
+
+    // The other slices of a legacy search complete without searching again.
+    const auto dir  = TempDir{};
+    auto checkpoint = miopen::TuningCheckpoint{dir.path / "checkpoint", 1, 2};
+    EXPECT_TRUE(miopen::RunTuningJob(get_handle(), {0, legacy, "{}", 1, 2}, checkpoint));
+    EXPECT_EQ(checkpoint.Size(), 0u);
+}
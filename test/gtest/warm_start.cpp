@@ -0,0 +1,213 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2022 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <miopen/miopen.h>
+#include <miopen/miopen_internal.h>
+#include <miopen/problem.hpp>
+
+#include "../driver/warmstart_driver.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+miopenTensorDescriptor_t MakeTensor(int n, int c, int h, int w)
+{
+    miopenTensorDescriptor_t desc;
+    EXPECT_EQ(miopenCreateTensorDescriptor(&desc), miopenStatusSuccess);
+    EXPECT_EQ(miopenSet4dTensorDescriptor(desc, miopenFloat, n, c, h, w), miopenStatusSuccess);
+    return desc;
+}
+
+/// A 3x3 forward convolution. Without an output tensor the problem cannot be solved.
+miopenProblem_t MakeConvProblem(bool with_output = true)
+{
+    miopenConvolutionDescriptor_t conv;
+    EXPECT_EQ(miopenCreateConvolutionDescriptor(&conv), miopenStatusSuccess);
+    EXPECT_EQ(miopenInitConvolutionDescriptor(conv, miopenConvolution, 0, 0, 1, 1, 1, 1),
+              miopenStatusSuccess);
+
+    miopenProblem_t problem;
+    EXPECT_EQ(miopenCreateConvProblem(&problem, conv, miopenProblemDirectionForward),
+              miopenStatusSuccess);
+
+    const auto x = MakeTensor(1, 8, 16, 16);
+    const auto w = MakeTensor(8, 8, 3, 3);
+    const auto y = MakeTensor(1, 8, 14, 14);
+    EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionX, x),
+              miopenStatusSuccess);
+    EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionW, w),
+              miopenStatusSuccess);
+    if(with_output)
+    {
+        EXPECT_EQ(miopenSetProblemTensorDescriptor(problem, miopenTensorConvolutionY, y),
+                  miopenStatusSuccess);
+    }
+
+    miopenDestroyTensorDescriptor(x);
+    miopenDestroyTensorDescriptor(w);
+    miopenDestroyTensorDescriptor(y);
+    miopenDestroyConvolutionDescriptor(conv);
+    return problem;
+}
+
+std::string Serialize(miopenProblem_t problem)
+{
+    return nlohmann::json(miopen::deref(problem)).dump();
+}
+
+struct DriverHandle
+{
+    DriverHandle() { SharedDriverHandle() = CreateDriverHandle(); }
+    ~DriverHandle()
+    {
+        miopenDestroy(SharedDriverHandle());
+        SharedDriverHandle() = nullptr;
+    }
+};
+
+/// Accepts any command line and makes the given number of problems.
+class FakeDriver : public Driver
+{
+public:
+    FakeDriver(std::size_t problems_) : problems(problems_) {}
+
+    int AddCmdLineArgs() override { return 0; }
+    int ParseCmdLineArgs(int, char*[]) override { return 0; }
+    InputFlags& GetInputFlags() override { std::abort(); }
+    int GetandSetData() override { return 0; }
+    int AllocateBuffersAndCopy() override { return 0; }
+    int RunForwardGPU() override { return 0; }
+    int VerifyForward() override { return 0; }
+    int RunBackwardGPU() override { return 0; }
+    int VerifyBackward() override { return 0; }
+
+    std::vector<miopenProblem_t> MakeProblems() override
+    {
+        auto made = std::vector<miopenProblem_t>{};
+        for(std::size_t i = 0; i < problems; ++i)
+            made.push_back(MakeConvProblem());
+        return made;
+    }
+
+private:
+    std::size_t problems;
+};
+
+void DestroyProblems(const std::vector<WarmStartEntry>& layers)
+{
+    for(const auto& layer : layers)
+        miopenDestroyProblem(layer.problem);
+}
+
+} // namespace
+
+TEST(WarmStart, LoadProblemReadsSerializedProblems)
+{
+    const auto problem = MakeConvProblem();
+    const auto json    = Serialize(problem);
+
+    miopenProblem_t loaded = nullptr;
+    ASSERT_EQ(miopenLoadProblem(&loaded, json.data(), json.size()), miopenStatusSuccess);
+    EXPECT_EQ(Serialize(loaded), json);
+    EXPECT_EQ(miopen::deref(loaded).GetDirection(), miopenProblemDirectionForward);
+    EXPECT_EQ(miopen::deref(loaded).GetTensorDescriptor(miopenTensorConvolutionY).GetLengths(),
+              miopen::deref(problem).GetTensorDescriptor(miopenTensorConvolutionY).GetLengths());
+    miopenDestroyProblem(loaded);
+    miopenDestroyProblem(problem);
+
+    const auto broken = std::string{"{\"direction\":"};
+    EXPECT_NE(miopenLoadProblem(&loaded, broken.data(), broken.size()), miopenStatusSuccess);
+    EXPECT_EQ(miopenLoadProblem(&loaded, nullptr, 0), miopenStatusBadParm);
+}
+
+TEST(WarmStart, FailedLayersDoNotStopTheOthers)
+{
+    miopenHandle_t handle;
+    ASSERT_EQ(miopenCreate(&handle), miopenStatusSuccess);
+
+    const auto problems = std::vector<miopenProblem_t>{MakeConvProblem(), MakeConvProblem(false)};
+    auto times          = std::vector<float>(problems.size());
+    auto compile_time   = -1.f;
+
+    ASSERT_EQ(miopenWarmStartProblems(
+                  handle, problems.data(), problems.size(), times.data(), &compile_time),
+              miopenStatusSuccess);
+    EXPECT_GE(times[0], 0.f);
+    EXPECT_EQ(times[1], -1.f);
+    EXPECT_GE(compile_time, 0.f);
+
+    // The invoker is in the handle now, a second warm start has nothing left to prepare.
+    ASSERT_EQ(miopenWarmStartProblems(handle, problems.data(), 1, times.data(), nullptr),
+              miopenStatusSuccess);
+    EXPECT_GE(times[0], 0.f);
+
+    for(const auto problem : problems)
+        miopenDestroyProblem(problem);
+    miopenDestroy(handle);
+}
+
+TEST(WarmStart, ParsesManifestLines)
+{
+    const DriverHandle driver_handle;
+    auto made = std::vector<std::string>{};
+    const auto make_driver = [&](const std::string& base_arg) -> Driver* {
+        made.push_back(base_arg);
+        return base_arg == "fake" ? new FakeDriver{2} : nullptr;
+    };
+
+    auto layers = std::vector<WarmStartEntry>{};
+    EXPECT_EQ(ParseWarmStartLine("", make_driver, layers), 0);
+    EXPECT_EQ(ParseWarmStartLine("  # conv -n 1", make_driver, layers), 0);
+    EXPECT_TRUE(layers.empty());
+    EXPECT_TRUE(made.empty());
+
+    const auto problem = MakeConvProblem();
+    const auto json    = Serialize(problem);
+    miopenDestroyProblem(problem);
+    EXPECT_EQ(ParseWarmStartLine("  " + json, make_driver, layers), 0);
+    ASSERT_EQ(layers.size(), 1);
+    EXPECT_EQ(layers[0].source, json);
+    EXPECT_EQ(Serialize(layers[0].problem), json);
+
+    EXPECT_EQ(ParseWarmStartLine("{\"direction\":", make_driver, layers), EXIT_FAILURE);
+    EXPECT_EQ(ParseWarmStartLine("./bin/MIOpenDriver unknown -n 1", make_driver, layers),
+              EXIT_FAILURE);
+    EXPECT_EQ(layers.size(), 1);
+
+    EXPECT_EQ(ParseWarmStartLine("./bin/MIOpenDriver fake -n 2", make_driver, layers), 0);
+    ASSERT_EQ(layers.size(), 3);
+    EXPECT_EQ(layers[1].source, "fake -n 2");
+    EXPECT_EQ(layers[2].source, "fake -n 2");
+    EXPECT_EQ(made, (std::vector<std::string>{"unknown", "fake"}));
+
+    DestroyProblems(layers);
+}
@@ -33,11 +33,10 @@
 #include <set>
 #include <vector>
 #include <cstdlib>
+#include "cpu_rnn.hpp"
+#include "dropout_util.hpp"
 #include "random.hpp"
 
-#define RNN_MM_TRANSPOSE 1
-#define RNN_MM_USEPARAGEMM 0
-
 inline void createTensorDescArray(std::vector<miopen::TensorDescriptor>& td,
                                   std::vector<miopenTensorDescriptor_t>& ptd,
                                   const std::vector<int> bs,
@@ -108,203 +107,58 @@ inline std::vector<std::vector<int>> generate_batchSeq(const int batchSize, cons
     return {batchSeq};
 }
 
-inline int sumvc(const std::vector<int>& x) { return std::accumulate(x.begin(), x.end(), 0); }
-
-template <typename T>
-inline T activfunc(T x, int actvf)
-{
-    T alpha = static_cast<T>(1), beta0 = static_cast<T>(0), beta1 = static_cast<T>(1);
-    if(actvf == 0)
-    {
-        return (x > 0) ? x : x * beta0;
-    }
-    else if(actvf == 2)
-    {
-        return static_cast<T>(1 / (1 + std::exp(-x)));
-    }
-    return static_cast<T>(alpha * std::tanh(beta1 * x));
-}
-
+/// Dropout hooks for the reference RNNs in cpu_rnn.hpp, backed by the emulation in
+/// dropout_util.hpp.
 template <typename T>
-inline T dervactivfunc(T x, int actvf)
-{
-    if(actvf == 0)
-    {
-        return static_cast<T>(x > 0 ? 1 : 0);
-    }
-    else if(actvf == 2)
-    {
-        return static_cast<T>(std::exp(-x) / (1 + std::exp(-x)) / (1 + std::exp(-x)));
-    }
-
-    return static_cast<T>(1 / std::cosh(x) / std::cosh(x));
-}
-
-template <typename Dtype>
-void RNN_mm_cpu(const Dtype* a_ptr,
-                size_t a_cols,
-                size_t a_rows,
-                size_t a_stride,
-                int a_flags,
-                const Dtype* b_ptr,
-                size_t b_cols,
-                size_t b_rows,
-                size_t b_stride,
-                int b_flags,
-                Dtype* c_ptr,
-                size_t c_cols,
-                size_t c_rows,
-                size_t c_stride,
-                int /*c_flags*/,
-                double d_alpha,
-                double d_beta)
+cpu_rnn_dropout<T> rnn_dropout_verify(miopen::Handle& handle,
+                                      const miopen::DropoutDescriptor& dropoutDesc)
 {
-
-    auto alpha = Dtype(d_alpha);
-    auto beta  = Dtype(d_beta);
-    if((!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE) &&
-        ((a_cols != b_rows) || (a_rows != c_rows) || (b_cols != c_cols))) ||
-       ((a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE) &&
-        ((a_rows != b_cols) || (a_cols != c_rows) || (b_rows != c_cols))) ||
-       ((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE) &&
-        ((a_rows != b_rows) || (a_cols != c_rows) || (b_cols != c_cols))) ||
-       (!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE) &&
-        ((a_cols != b_cols) || (a_rows != c_rows) || (b_rows != c_cols))))
-    {
-        std::cout << "MM_CPU ERROR: " << a_cols << ", " << a_rows << "   " << b_cols << ", "
-                  << b_rows << "   " << c_cols << ", " << c_rows << std::endl;
-        return;
-    }
-
-    size_t inner_loop = (!(a_flags & RNN_MM_TRANSPOSE)) ? a_cols : a_rows;
-#if(!RNN_MM_USEPARAGEMM)
-    if(!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[m * b_stride + k];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[m * a_stride + n] * b_ptr[m * b_stride + k];
-#if 0
-					if (
-						(n == 0 && k == 33
-						|| n == 1 && k == 32
-						|| n == 3 && k == 1
-						|| n == 4 && k == 0
-
-						)
-						&& a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] != 0
-						)
-					{
-                        std::cout << "C:mm: " << n << ", " << k << ", " << m << ", " <<
-							mm_e, a_ptr[m*a_stride + n] << ", " <<
-                                b_ptr[m*b_stride + k] << ", " <<
-                                a_ptr[m*a_stride + n] * b_ptr[m*b_stride + k] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else if(!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE))
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    mm_e += a_ptr[n * a_stride + m] * b_ptr[k * b_stride + m];
-#if 0
-					if (n == 0 && k == 6 && a_ptr[n*a_stride + m] * b_ptr[k*b_stride + m] != 0)
-					{
-                        std::cout << m << ", " << mm_e << ", " << ", " << a_ptr[n*a_stride + m] << ", " << b_ptr[k*b_stride + m] << std::endl;
-					}
-#endif
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-    }
-    else
-    {
-        for(size_t n = 0; n < c_rows; ++n)
-        {
-            for(size_t k = 0; k < c_cols; ++k)
-            {
-                double mm_e = 0;
-                for(size_t m = 0; m < inner_loop; ++m)
-                {
-                    c_ptr[n * c_stride + k] += a_ptr[m * a_stride + n] * b_ptr[k * b_stride + m];
-                }
-                c_ptr[n * c_stride + k] = beta * c_ptr[n * c_stride + k] + alpha * mm_e;
-            }
-        }
-#else
-    auto c_out = [&](int i, int j, double x) {
-        c_ptr[i * c_stride + j] = beta * c_ptr[i * c_stride + j] + alpha * x;
+    cpu_rnn_dropout<T> dropout;
+    dropout.init_states = [&] {
+        std::vector<prngStates> states(dropoutDesc.stateSizeInBytes / sizeof(prngStates));
+        InitKernelStateEmulator(states, dropoutDesc);
+        return states;
     };
-
-    if(!(a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             with_stride(a_ptr, a_stride),
-             with_stride(b_ptr, b_stride),
-             c_out);
-    }
-    else if((a_flags & RNN_MM_TRANSPOSE) && !(b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             miopen::flip(with_stride(a_ptr, a_stride)),
-             with_stride(b_ptr, b_stride),
-             c_out);
-    }
-    else if(!(a_flags & RNN_MM_TRANSPOSE) && (b_flags & RNN_MM_TRANSPOSE))
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             with_stride(a_ptr, a_stride),
-             miopen::flip(with_stride(b_ptr, b_stride)),
-             c_out);
-    }
-    else
-    {
-        gemm(c_rows,
-             c_cols,
-             inner_loop,
-             miopen::flip(with_stride(a_ptr, a_stride)),
-             miopen::flip(with_stride(b_ptr, b_stride)),
-             c_out);
-#endif
-    }
+    dropout.forward = [&](miopenTensorDescriptor_t x_desc,
+                          const std::vector<T>& x,
+                          miopenTensorDescriptor_t y_desc,
+                          std::vector<T>& y,
+                          std::vector<unsigned char>& reserve,
+                          std::vector<prngStates>& states,
+                          std::size_t x_offset,
+                          std::size_t y_offset,
+                          std::size_t reserve_offset) {
+        DropoutForwardVerify<T>(handle,
+                                dropoutDesc,
+                                miopen::deref(x_desc),
+                                x,
+                                miopen::deref(y_desc),
+                                y,
+                                reserve,
+                                states,
+                                x_offset,
+                                y_offset,
+                                reserve_offset);
+    };
+    dropout.backward = [&](miopenTensorDescriptor_t dy_desc,
+                           const std::vector<T>& dy,
+                           miopenTensorDescriptor_t dx_desc,
+                           std::vector<T>& dx,
+                           std::vector<unsigned char>& reserve,
+                           std::size_t dx_offset,
+                           std::size_t dy_offset,
+                           std::size_t reserve_offset) {
+        DropoutBackwardVerify<T>(dropoutDesc,
+                                 miopen::deref(dy_desc),
+                                 dy,
+                                 miopen::deref(dx_desc),
+                                 dx,
+                                 reserve,
+                                 dx_offset,
+                                 dy_offset,
+                                 reserve_offset);
+    };
+    return dropout;
 }
 
 #endif
@@ -84,468 +84,26 @@ void RNNFwdTrainCPUVerify(miopen::Handle& handle,
                           std::vector<T>& rsvspace,
                           bool hx_is_null = false)
 {
-
-#if(MIO_RNN_TEST_DEBUG > 0)
-    printf("seqLen: %d, in_h: %d, hy_d: %d, hy_n: %d, hy_h: %d, out_h: %d\n",
-           seqLength,
-           in_h,
-           hy_d,
-           hy_n,
-           hy_h,
-           out_h);
-    printf("dirmode: %d, hx size: %d, hy_host size: %d, reserveSpace: %d\n",
-           bidirection ? 2 : 1,
-           hx.size(),
-           hy_host.size(),
-           rsvspace.size());
-    printf("input size: %d\n", in.size());
-    printf("output size: %d\n", out_host.size());
-#endif
-    int batch_n = sumvc(in_n);
-
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int hy_stride  = hy_h * bi;
-    int out_stride = out_h;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    int wei_shift_bias = ((in_h + hy_h) * bi + (bi * hy_h + hy_h) * bi * (numlayer - 1)) * hy_h;
-
-    // initial dropoput
-    std::vector<prngStates> dropout_states_host;
-    std::vector<unsigned char> dropout_reservespace_host;
-    std::vector<T> dropout_hid_state;
-    miopenTensorDescriptor_t dropout_inputTensor{}, dropout_outputTensor{};
-    if(use_dropout)
-    {
-        size_t states_size  = dropoutDesc.stateSizeInBytes / sizeof(prngStates);
-        dropout_states_host = std::vector<prngStates>(states_size);
-        InitKernelStateEmulator(dropout_states_host, dropoutDesc);
-
-        std::array<int, 2> drop_in_len  = {{batch_n, hy_h * bi}};
-        std::array<int, 2> drop_in_str  = {{hy_stride, 1}};
-        std::array<int, 2> drop_out_str = {{hy_h * bi, 1}};
-        miopenCreateTensorDescriptor(&dropout_inputTensor);
-        miopenCreateTensorDescriptor(&dropout_outputTensor);
-        miopenSetTensorDescriptor(
-            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
-        miopenSetTensorDescriptor(
-            dropout_outputTensor, miopenFloat, 2, drop_in_len.data(), drop_out_str.data());
-
-        size_t reserveSpaceSizeInBytes = 0;
-        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
-        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
-        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
-                                                               static_cast<unsigned char>(1));
-
-        dropout_hid_state = std::vector<T>((numlayer - 1) * batch_n * hy_h * bi, static_cast<T>(0));
-    }
-
-    // forward emulator
-    for(int li = 0; li < numlayer; li++)
-    {
-        int hid_shift = li * batch_n * hy_h * bi;
-        int hx_shift  = li * bi * in_n.at(0) * hy_h;
-
-        // from input
-        if(li == 0)
-        {
-            if(inputMode == 1)
-            {
-                // for(int bs = 0; bs < batch_n; bs++)
-                par_for(batch_n, 4, [&](int bs) {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        rsvspace.at(hid_shift + bs * hy_stride + h) += in.at(bs * in_stride + h);
-                        if(bidirection)
-                        {
-                            rsvspace.at(hid_shift + bs * hy_stride + hy_h + h) +=
-                                in.at(bs * in_stride + h);
-                        }
-                    }
-                });
-
-                // from bias
-                if(biased)
-                {
-                    // for(int bs = 0; bs < batch_n; bs++)
-                    par_for(batch_n, 4, [&](int bs) {
-                        for(int h = 0; h < hy_stride; h++)
-                        {
-                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
-                                wei.at(wei_shift_bias + h);
-                        }
-                    });
-                }
-            }
-            else
-            {
-                RNN_mm_cpu<T>(in.data(),
-                              in_h,
-                              batch_n,
-                              in_stride,
-                              0,
-                              wei.data(),
-                              in_h,
-                              hy_h * bi,
-                              in_stride,
-                              RNN_MM_TRANSPOSE,
-                              &rsvspace[hid_shift],
-                              hy_h * bi,
-                              batch_n,
-                              hy_stride,
-                              0,
-                              1,
-                              1);
-
-                // from bias
-                if(biased)
-                {
-                    // for(int bs = 0; bs < batch_n; bs++)
-                    par_for(batch_n, 4, [&](int bs) {
-                        for(int h = 0; h < hy_stride; h++)
-                        {
-                            rsvspace.at(hid_shift + bs * hy_stride + h) +=
-                                wei.at(wei_shift_bias + h);
-                        }
-                    });
-                }
-            }
-        }
-        else
-        {
-            int wei_shift = bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h;
-            int prelayer_shift = (li - 1) * batch_n * hy_h * bi + numlayer * batch_n * hy_h * bi;
-            if(use_dropout)
-            {
-                auto dropout_states_tmp = dropout_states_host;
-                size_t drop_out_offset  = (li - 1ULL) * batch_n * hy_h * bi;
-
-                DropoutForwardVerify<T>(handle,
-                                        dropoutDesc,
-                                        miopen::deref(dropout_inputTensor),
-                                        rsvspace,
-                                        miopen::deref(dropout_outputTensor),
-                                        dropout_hid_state,
-                                        dropout_reservespace_host,
-                                        dropout_states_tmp,
-                                        prelayer_shift,
-                                        drop_out_offset,
-                                        drop_out_offset);
-
-                prelayer_shift = drop_out_offset;
-            }
-
-            RNN_mm_cpu<T>(use_dropout ? &dropout_hid_state[prelayer_shift]
-                                      : &rsvspace[prelayer_shift],
-                          hy_h * bi,
-                          batch_n,
-                          use_dropout ? hy_h * bi : hy_stride,
-                          0,
-                          &wei[wei_shift],
-                          hy_h * bi,
-                          hy_h * bi,
-                          bi_stride,
-                          RNN_MM_TRANSPOSE,
-                          &rsvspace[hid_shift],
-                          hy_h * bi,
-                          batch_n,
-                          hy_stride,
-                          0,
-                          1,
-                          1);
-
-            // from bias
-            if(biased)
-            {
-                int wei_shift_bias_temp = wei_shift_bias + bi * li * 2 * hy_h;
-
-                // for(int bs = 0; bs < batch_n; bs++)
-                par_for(batch_n, 4, [&](int bs) {
-                    for(int h = 0; h < hy_stride; h++)
-                    {
-                        rsvspace.at(hid_shift + bs * hy_stride + h) +=
-                            wei.at(wei_shift_bias_temp + h);
-                    }
-                });
-            }
-        }
-
-        // from hidden state
-        int bacc   = 0;
-        int baccbi = batch_n;
-        for(int ti = 0; ti < seqLength; ti++)
-        {
-            baccbi -= in_n.at(seqLength - 1 - ti);
-
-            int wei_shift =
-                li == 0 ? (in_h * hy_h * bi)
-                        : (bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h +
-                           bi * hy_h * hy_stride);
-
-            if(ti == 0)
-            {
-                if(!hx_is_null)
-                {
-                    RNN_mm_cpu<T>(&hx[hx_shift],
-                                  hy_h,
-                                  in_n.at(ti),
-                                  uni_stride,
-                                  0,
-                                  &wei[wei_shift],
-                                  hy_h,
-                                  hy_h,
-                                  uni_stride,
-                                  RNN_MM_TRANSPOSE,
-                                  &rsvspace[hid_shift + bacc * hy_stride],
-                                  hy_h,
-                                  in_n.at(ti),
-                                  hy_stride,
-                                  0,
-                                  1,
-                                  1);
-
-                    // from bias
-                    if(biased)
-                    {
-                        int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
-
-                        par_for(in_n.at(ti), 4, [&](int bs) {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
-                                    wei.at(wei_shift_bias_temp + h);
-                            }
-                        });
-                    }
-
-                    if(bidirection)
-                    {
-                        RNN_mm_cpu<T>(&hx[hx_shift + hy_n * hy_h],
-                                      hy_h,
-                                      in_n.at(seqLength - 1 - ti),
-                                      uni_stride,
-                                      0,
-                                      &wei[wei_shift + hy_h * uni_stride],
-                                      hy_h,
-                                      hy_h,
-                                      uni_stride,
-                                      RNN_MM_TRANSPOSE,
-                                      &rsvspace[hid_shift + baccbi * hy_stride + hy_h],
-                                      hy_h,
-                                      in_n.at(seqLength - 1 - ti),
-                                      hy_stride,
-                                      0,
-                                      1,
-                                      1);
-
-                        // from bias
-                        if(biased)
-                        {
-                            int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
-
-                            par_for(in_n.at(seqLength - 1 - ti), 4, [&](int bs) {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
-                                                bs * hy_stride + h) +=
-                                        wei.at(wei_shift_bias_temp + hy_h + h);
-                                }
-                            });
-                        }
-                    }
-                }
-            }
-            else
-            {
-                RNN_mm_cpu<T>(&hy_host[hx_shift],
-                              hy_h,
-                              in_n.at(ti),
-                              uni_stride,
-                              0,
-                              &wei[wei_shift],
-                              hy_h,
-                              hy_h,
-                              uni_stride,
-                              RNN_MM_TRANSPOSE,
-                              &rsvspace[hid_shift + bacc * hy_stride],
-                              hy_h,
-                              in_n.at(ti),
-                              hy_stride,
-                              0,
-                              1,
-                              1);
-
-                // from bias
-                if(biased)
-                {
-                    int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
-
-                    par_for(in_n.at(ti), 4, [&](int bs) {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
-                                wei.at(wei_shift_bias_temp + h);
-                        }
-                    });
-                }
-
-                if(bidirection)
-                {
-
-                    if(!hx_is_null && in_n.at(seqLength - 1 - ti) > in_n.at(seqLength - ti))
-                    {
-                        RNN_mm_cpu<T>(
-                            &hx[hx_shift + hy_n * hy_h + in_n.at(seqLength - ti) * hy_h],
-                            hy_h,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            uni_stride,
-                            0,
-                            &wei[wei_shift + hy_h * uni_stride],
-                            hy_h,
-                            hy_h,
-                            uni_stride,
-                            RNN_MM_TRANSPOSE,
-                            &rsvspace[hid_shift + (baccbi + in_n.at(seqLength - ti)) * hy_stride +
-                                      hy_h],
-                            hy_h,
-                            (in_n.at(seqLength - 1 - ti) - in_n.at(seqLength - ti)),
-                            hy_stride,
-                            0,
-                            1,
-                            1);
-
-                        // from bias
-                        if(biased)
-                        {
-                            int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
-
-                            for(int bs = in_n.at(seqLength - ti); bs < in_n.at(seqLength - 1 - ti);
-                                bs++)
-                            {
-                                for(int h = 0; h < hy_h; h++)
-                                {
-                                    rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
-                                                bs * hy_stride + h) +=
-                                        wei.at(wei_shift_bias_temp + hy_h + h);
-                                }
-                            }
-                        }
-                    }
-
-                    RNN_mm_cpu<T>(&hy_host[hx_shift + hy_n * hy_h],
-                                  hy_h,
-                                  in_n.at(seqLength - ti),
-                                  uni_stride,
-                                  0,
-                                  &wei[wei_shift + hy_h * uni_stride],
-                                  hy_h,
-                                  hy_h,
-                                  uni_stride,
-                                  RNN_MM_TRANSPOSE,
-                                  &rsvspace[hid_shift + baccbi * hy_stride + hy_h],
-                                  hy_h,
-                                  in_n.at(seqLength - ti),
-                                  hy_stride,
-                                  0,
-                                  1,
-                                  1);
-
-                    // from bias
-                    if(biased)
-                    {
-                        int wei_shift_bias_temp = wei_shift_bias + bi * (li * 2 + 1) * hy_h;
-
-                        par_for(in_n.at(seqLength - ti), 4, [&](int bs) {
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
-                                            h) += wei.at(wei_shift_bias_temp + hy_h + h);
-                            }
-                        });
-                    }
-                }
-            }
-
-            // for(int bs = 0; bs < in_n[ti]; bs++)
-            par_for(in_n.at(ti), 4, [&](int bs) {
-                for(int h = 0; h < hy_h; h++)
-                {
-                    hy_host.at(hx_shift + bs * uni_stride + h) =
-                        activfunc(rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h),
-                                  squash); // squash_func
-
-                    rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h +
-                                numlayer * batch_n * hy_h * bi) =
-                        activfunc(rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h),
-                                  squash); // squash_func
-                }
-            });
-
-            if(bidirection)
-            {
-                // for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                par_for(in_n.at(seqLength - 1 - ti), 4, [&](int bs) {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        hy_host.at(hx_shift + hy_n * hy_h + bs * uni_stride + h) = activfunc(
-                            rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h),
-                            squash); // squash_func
-
-                        rsvspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h +
-                                    numlayer * batch_n * hy_h * bi) =
-                            activfunc(rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
-                                                  bs * hy_stride + h),
-                                      squash);
-                    }
-                });
-            }
-
-            bacc += in_n.at(ti);
-        }
-    }
-
-    // output
-    int prelayer_shift = (numlayer - 1) * batch_n * hy_h * bi + numlayer * batch_n * hy_h * bi;
-
-    if(use_dropout)
-    {
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            rsvspace.at(numlayer * batch_n * hy_stride * 2 + i) = dropout_hid_state.at(i);
-        }
-        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
-            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            *(p_drop_rsv + i) = dropout_reservespace_host.at(i);
-        }
-    }
-    for(int bs = 0; bs < batch_n; bs++)
-    {
-        for(int h = 0; h < out_h; h++)
-        {
-            assert(!std::isnan(rsvspace.at(prelayer_shift + bs * hy_stride + h)));
-            assert(!std::isinf(rsvspace.at(prelayer_shift + bs * hy_stride + h)));
-            out_host.at(bs * out_stride + h) = rsvspace.at(prelayer_shift + bs * hy_stride + h);
-            //  printf("out_host[%d]: %f\n", bs * out_stride + h, out_host.at(bs * out_stride + h));
-        }
-    }
+    cpu_rnn_forward(use_dropout,
+                    rnn_dropout_verify<T>(handle, dropoutDesc),
+                    in,
+                    wei,
+                    hy_host,
+                    hx,
+                    out_host,
+                    in_n,
+                    in_h,
+                    seqLength,
+                    bidirection != 0,
+                    biased != 0,
+                    hy_d,
+                    hy_n,
+                    hy_h,
+                    out_h,
+                    squash,
+                    inputMode,
+                    rsvspace,
+                    hx_is_null);
 }
 
 template <typename T>
@@ -578,326 +136,28 @@ void RNNBwdDataCPUVerify(bool use_dropout,
                          std::vector<T>& wkspace,
                          bool dhy_is_null = false)
 {
-
-#if(MIO_RNN_TEST_DEBUG > 0)
-    printf("BWD DATA CPU driver:\n");
-    printf("seqLen: %d, in_h: %d, hy_d: %d, hy_n: %d, hy_h: %d, out_h: %d\n",
-           seqLength,
-           in_h,
-           hy_d,
-           hy_n,
-           hy_h,
-           out_h);
-    printf("hx size: %d, dhx size: %d, dhy size: %d, reserveSpace: %d, workSpace: %d\n",
-           hx.size(),
-           dhx_host.size(),
-           dhy.size(),
-           rsvspace.size(),
-           wkspace.size());
-    printf("dinput size: %d\n", din_host.size());
-#endif
-
-    int batch_n = sumvc(in_n);
-
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int hy_stride  = hy_h * bi;
-    int out_stride = out_h;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
     (void)hx;
     (void)out;
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    // initial dropoput
-    miopenTensorDescriptor_t dropout_inputTensor{};
-    std::vector<unsigned char> dropout_reservespace_host;
-    if(use_dropout)
-    {
-        std::array<int, 2> drop_in_len = {{batch_n, hy_h * bi}};
-        std::array<int, 2> drop_in_str = {{hy_stride, 1}};
-        miopenCreateTensorDescriptor(&dropout_inputTensor);
-        miopenSetTensorDescriptor(
-            dropout_inputTensor, miopenFloat, 2, drop_in_len.data(), drop_in_str.data());
-
-        size_t reserveSpaceSizeInBytes = 0;
-        miopenDropoutGetReserveSpaceSize(dropout_inputTensor, &reserveSpaceSizeInBytes);
-        size_t reserve_size       = reserveSpaceSizeInBytes / sizeof(unsigned char);
-        dropout_reservespace_host = std::vector<unsigned char>(reserve_size * (numlayer - 1),
-                                                               static_cast<unsigned char>(0));
-
-        auto p_drop_rsv = reinterpret_cast<unsigned char*>(&rsvspace.at(
-            numlayer * batch_n * hy_stride * 2 + (numlayer - 1) * batch_n * hy_h * bi));
-        for(int i = 0; i < (numlayer - 1) * batch_n * hy_h * bi; i++)
-        {
-            dropout_reservespace_host.at(i) = *(p_drop_rsv + i);
-        }
-    }
-
-    // bwd data emulator
-    for(int li = numlayer - 1; li >= 0; li--)
-    {
-        int wei_shift = bi * (in_h + hy_h) * hy_h + li * bi * (bi * hy_h + hy_h) * hy_h;
-        int hid_shift = li * batch_n * hy_h * bi;
-        int hx_shift  = li * bi * in_n.at(0) * hy_h;
-
-        if(li == numlayer - 1)
-        {
-            for(int bs = 0; bs < batch_n; bs++)
-            {
-                for(int h = 0; h < out_h; h++)
-                {
-                    wkspace.at(hid_shift + bs * hy_stride + h) += dout.at(bs * out_stride + h);
-                }
-            }
-        }
-        else
-        {
-            int prelayer_shift = (li + 1) * batch_n * hy_h * bi;
-
-            RNN_mm_cpu<T>(&wkspace[prelayer_shift],
-                          hy_h * bi,
-                          batch_n,
-                          hy_stride,
-                          0,
-                          &wei[wei_shift],
-                          hy_h * bi,
-                          hy_h * bi,
-                          bi_stride,
-                          0,
-                          &wkspace[hid_shift],
-                          hy_h * bi,
-                          batch_n,
-                          hy_stride,
-                          0,
-                          1,
-                          1);
-
-            if(use_dropout)
-            {
-                DropoutBackwardVerify<T>(dropoutDesc,
-                                         miopen::deref(dropout_inputTensor),
-                                         wkspace,
-                                         miopen::deref(dropout_inputTensor),
-                                         wkspace,
-                                         dropout_reservespace_host,
-                                         hid_shift,
-                                         hid_shift,
-                                         li * batch_n * hy_h * bi);
-            }
-        }
-
-        int bacc   = batch_n;
-        int baccbi = 0;
-        for(int ti = seqLength - 1; ti >= 0; ti--)
-        {
-            bacc -= in_n.at(ti);
-
-            // from post state
-            if(ti == seqLength - 1)
-            {
-                if(!dhy_is_null)
-                {
-                    for(int bs = 0; bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
-                                dhy.at(hx_shift + bs * uni_stride + h);
-                        }
-                    }
-                }
-            }
-            else
-            {
-                if(!dhy_is_null && in_n.at(ti) > in_n.at(ti + 1))
-                {
-                    for(int bs = in_n.at(ti + 1); bs < in_n.at(ti); bs++)
-                    {
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
-                                dhy.at(hx_shift + bs * uni_stride + h);
-                        }
-                    }
-                }
-
-                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) +=
-                            dhx_host.at(hx_shift + bs * uni_stride + h);
-                    }
-                }
-            }
-
-            for(int bs = 0; bs < in_n.at(ti); bs++)
-            {
-                for(int h = 0; h < hy_h; h++)
-                {
-                    wkspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h) *= dervactivfunc(
-                        rsvspace.at(hid_shift + bacc * hy_stride + bs * hy_stride + h), squash);
-                }
-            }
-
-            if(ti < seqLength - 1)
-            {
-                for(int bs = 0; bs < in_n.at(ti + 1); bs++)
-                {
-#if defined(__GNUC__) && !defined(__INTEL_COMPILER) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 800)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-                    memset(&dhx_host[hx_shift + bs * uni_stride], 0, hy_h * sizeof(T));
-#if defined(__GNUC__) && !defined(__INTEL_COMPILER) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 800)
-#pragma GCC diagnostic pop
-#endif
-                }
-            }
-
-            wei_shift = li == 0
-                            ? (in_h * hy_stride)
-                            : (bi * (in_h + hy_h) * hy_h +
-                               (li - 1) * bi * (bi * hy_h + hy_h) * hy_h + bi * hy_h * hy_stride);
-
-            RNN_mm_cpu<T>(&wkspace[hid_shift + bacc * hy_stride],
-                          hy_h,
-                          in_n.at(ti),
-                          hy_stride,
-                          0,
-                          &wei[wei_shift],
-                          hy_h,
+    cpu_rnn_backward_data(use_dropout,
+                          rnn_dropout_verify<T>(get_handle(), dropoutDesc),
+                          din_host,
+                          wei,
+                          dhy,
+                          dhx_host,
+                          dout,
+                          in_n,
+                          in_h,
+                          seqLength,
+                          bidirection != 0,
+                          hy_d,
+                          hy_n,
                           hy_h,
-                          uni_stride,
-                          0,
-                          &dhx_host[hx_shift],
-                          hy_h,
-                          in_n.at(ti),
-                          uni_stride,
-                          0,
-                          1,
-                          1);
-
-            if(bidirection)
-            {
-                for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                {
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        // from post state
-                        if(ti == seqLength - 1)
-                        {
-                            if(!dhy_is_null)
-                            {
-                                wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
-                                           h) +=
-                                    dhy.at(hx_shift + hy_n * hy_h + bs * uni_stride + h);
-                            }
-                        }
-                        else
-                        {
-                            wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride +
-                                       h) +=
-                                dhx_host.at(hx_shift + hy_n * hy_h + bs * uni_stride + h);
-                        }
-
-                        wkspace.at(hid_shift + baccbi * hy_stride + hy_h + bs * hy_stride + h) *=
-                            dervactivfunc(rsvspace.at(hid_shift + baccbi * hy_stride + hy_h +
-                                                      bs * hy_stride + h),
-                                          squash);
-                    }
-                }
-
-                if(ti < seqLength - 1)
-                {
-                    for(int bs = 0; bs < in_n.at(seqLength - 1 - ti); bs++)
-                    {
-#if defined(__GNUC__) && !defined(__INTEL_COMPILER) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 800)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-                        memset(&dhx_host[hx_shift + bs * uni_stride + hy_n * hy_h],
-                               0,
-                               hy_h * sizeof(T));
-#if defined(__GNUC__) && !defined(__INTEL_COMPILER) && (((__GNUC__ * 100) + __GNUC_MINOR__) >= 800)
-#pragma GCC diagnostic pop
-#endif
-                    }
-                }
-
-                RNN_mm_cpu<T>(&wkspace[hid_shift + baccbi * hy_stride + hy_h],
-                              hy_h,
-                              in_n.at(seqLength - 1 - ti),
-                              hy_stride,
-                              0,
-                              &wei[wei_shift + hy_h * uni_stride],
-                              hy_h,
-                              hy_h,
-                              uni_stride,
-                              0,
-                              &dhx_host[hx_shift + hy_n * hy_h],
-                              hy_h,
-                              in_n.at(seqLength - 1 - ti),
-                              uni_stride,
-                              0,
-                              1,
-                              1);
-            }
-
-            baccbi += in_n.at(seqLength - 1 - ti);
-        }
-    }
-
-    // dinput
-    if(inputMode == 1)
-    {
-        for(int bs = 0; bs < batch_n; bs++)
-        {
-            for(int h = 0; h < hy_h; h++)
-            {
-                din_host.at(bs * in_stride + h) += wkspace.at(bs * hy_stride + h);
-                if(bidirection)
-                {
-                    din_host.at(bs * in_stride + h) += wkspace.at(bs * hy_stride + hy_h + h);
-                }
-            }
-        }
-    }
-    else
-    {
-        RNN_mm_cpu<T>(wkspace.data(),
-                      hy_h * bi,
-                      batch_n,
-                      hy_stride,
-                      0,
-                      wei.data(),
-                      in_h,
-                      hy_h * bi,
-                      in_stride,
-                      0,
-                      din_host.data(),
-                      in_h,
-                      batch_n,
-                      in_stride,
-                      0,
-                      1,
-                      1);
-    }
+                          out_h,
+                          squash,
+                          inputMode,
+                          rsvspace,
+                          wkspace,
+                          dhy_is_null);
 }
 
 template <typename T>
@@ -928,335 +188,25 @@ void RNNBwdWeightCPUVerify(bool use_dropout,
                            std::vector<T>& wkspace,
                            bool hx_is_null = false)
 {
-#if(MIO_RNN_TEST_DEBUG > 0)
-    printf("BWD WEGIHTS CPU ctest:\n");
-    printf("seqLen: %d, in_h: %d, hy_d: %d, hy_n: %d, hy_h: %d, out_h: %d\n",
-           seqLength,
-           in_h,
-           hy_d,
-           hy_n,
-           hy_h,
-           out_h);
-    printf("dirmode: %d, hx size: %d, dout size: %d, reserveSpace: %d, workSpace: %d\n",
-           bidirection ? 2 : 1,
-           hx.size(),
-           dout.size(),
-           rsvspace.size(),
-           wkspace.size());
-    printf("input size: %d\n", in.size());
-#endif
-    int batch_n  = sumvc(in_n);
-    int numlayer = bidirection ? hy_d / 2 : hy_d;
-    int bi       = bidirection ? 2 : 1;
-
-    int in_stride  = in_h;
-    int hy_stride  = hy_h * bi;
-    int uni_stride = hy_h;
-    int bi_stride  = hy_h * bi;
-
-    (void)hy_n;
-    (void)out_h;
     (void)dout;
+    (void)out_h;
     (void)squash;
-
-    if(inputMode == 1)
-    {
-        if(in_h != hy_h)
-        {
-            std::cout
-                << "Verification cannot be completed: The input tensor size must equal to the "
-                << "hidden state size of the network in SKIP_INPUT mode!" << std::endl;
-            return;
-        }
-        in_h = 0;
-    }
-
-    int wei_len        = (bi * (in_h + hy_h) + (numlayer - 1) * bi * (bi + 1) * hy_h) * hy_h;
-    int wei_shift_bias = wei_len;
-
-    // bwd weights emulator
-    for(int li = 0; li < numlayer; li++)
-    {
-        // between layers
-        if(li == 0)
-        {
-            if(inputMode != 1)
-            {
-                RNN_mm_cpu<T>(wkspace.data(),
-                              hy_h * bi,
-                              batch_n,
-                              hy_stride,
-                              RNN_MM_TRANSPOSE,
-                              in.data(),
-                              in_h,
-                              batch_n,
-                              in_stride,
-                              0,
-                              dwei_host.data(),
-                              in_h,
-                              hy_h * bi,
-                              in_stride,
-                              0,
-                              1,
-                              1);
-            }
-
-            if(biased)
-            {
-                for(int h = 0; h < hy_stride; h++)
-                {
-                    for(int w = 0; w < batch_n; w++)
-                    {
-                        dwei_host.at(wei_shift_bias + h) += wkspace.at(w * hy_stride + h);
-                    }
-                }
-            }
-        }
-        else
-        {
-            int prelayer_shift =
-                use_dropout ? 2 * numlayer * batch_n * hy_stride + (li - 1) * batch_n * hy_h * bi
-                            : (li - 1) * bi * batch_n * hy_h + numlayer * batch_n * hy_h * bi;
-            int hid_shift = li * bi * batch_n * hy_h;
-            int wei_shift = bi * (in_h + hy_h) * hy_h + (li - 1) * bi * (bi * hy_h + hy_h) * hy_h;
-
-            RNN_mm_cpu<T>(&wkspace[hid_shift],
-                          hy_h * bi,
-                          batch_n,
-                          hy_stride,
-                          RNN_MM_TRANSPOSE,
-                          &rsvspace[prelayer_shift],
-                          hy_h * bi,
-                          batch_n,
-                          hy_stride,
-                          0,
-                          &dwei_host[wei_shift],
-                          hy_h * bi,
-                          hy_h * bi,
-                          bi_stride,
-                          0,
-                          1,
-                          1);
-
-            if(biased)
-            {
-                wei_shift = wei_shift_bias + li * bi * 2 * hy_h;
-
-                for(int h = 0; h < hy_stride; h++)
-                {
-                    for(int w = 0; w < batch_n; w++)
-                    {
-                        dwei_host.at(wei_shift + h) += wkspace.at(hid_shift + w * hy_stride + h);
-                    }
-                }
-            }
-        }
-
-        int bacc = 0;
-        for(int ti = 0; ti < seqLength; ti++)
-        {
-            int hid_shift = li * bi * batch_n * hy_h + bacc * hy_stride;
-            int hx_shift  = li * bi * in_n.at(0) * hy_h;
-            int wei_shift;
-            int pretime_shift;
-
-            wei_shift = li == 0
-                            ? (in_h * hy_stride)
-                            : (bi * (in_h + hy_h) * hy_h +
-                               (li - 1) * bi * (bi * hy_h + hy_h) * hy_h + bi * hy_h * hy_stride);
-
-            // between time
-            if(ti == 0)
-            {
-                if(!hx_is_null)
-                {
-                    RNN_mm_cpu<T>(&wkspace[hid_shift],
-                                  hy_h,
-                                  in_n.at(ti),
-                                  hy_stride,
-                                  RNN_MM_TRANSPOSE,
-                                  &hx[hx_shift],
-                                  hy_h,
-                                  in_n.at(ti),
-                                  uni_stride,
-                                  0,
-                                  &dwei_host[wei_shift],
-                                  hy_h,
-                                  hy_h,
-                                  uni_stride,
-                                  0,
-                                  1,
-                                  1);
-
-                    if(biased)
-                    {
-                        int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
-
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            for(int w = 0; w < in_n.at(ti); w++)
-                            {
-                                dwei_host.at(bias_shift + h) +=
-                                    wkspace.at(hid_shift + w * hy_stride + h);
-                            }
-                        }
-                    }
-                }
-            }
-            else
-            {
-                pretime_shift = li * bi * batch_n * hy_h + (bacc - in_n.at(ti - 1)) * hy_stride +
-                                numlayer * batch_n * hy_h * bi;
-
-                RNN_mm_cpu<T>(&wkspace[hid_shift],
-                              hy_h,
-                              in_n.at(ti),
-                              hy_stride,
-                              RNN_MM_TRANSPOSE,
-                              &rsvspace[pretime_shift],
-                              hy_h,
-                              in_n.at(ti),
-                              hy_stride,
-                              0,
-                              &dwei_host[wei_shift],
-                              hy_h,
-                              hy_h,
-                              uni_stride,
-                              0,
-                              1,
-                              1);
-
-                if(biased)
-                {
-                    int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
-
-                    for(int h = 0; h < hy_h; h++)
-                    {
-                        for(int w = 0; w < in_n.at(ti); w++)
-                        {
-                            dwei_host.at(bias_shift + h) +=
-                                wkspace.at(hid_shift + w * hy_stride + h);
-                        }
-                    }
-                }
-            }
-
-            if(bidirection)
-            {
-                if(ti == seqLength - 1)
-                {
-                    if(!hx_is_null)
-                    {
-                        RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h],
-                                      hy_h,
-                                      in_n.at(ti),
-                                      hy_stride,
-                                      RNN_MM_TRANSPOSE,
-                                      &hx[hx_shift + hy_n * hy_h],
-                                      hy_h,
-                                      in_n.at(ti),
-                                      uni_stride,
-                                      0,
-                                      &dwei_host[wei_shift + hy_h * uni_stride],
-                                      hy_h,
-                                      hy_h,
-                                      uni_stride,
-                                      0,
-                                      1,
-                                      1);
-
-                        if(biased)
-                        {
-                            int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
-
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                for(int w = 0; w < in_n.at(ti); w++)
-                                {
-                                    dwei_host.at(bias_shift + hy_h + h) +=
-                                        wkspace.at(hid_shift + w * hy_stride + hy_h + h);
-                                }
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    if(!hx_is_null && in_n.at(ti) > in_n.at(ti + 1))
-                    {
-                        RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h + in_n.at(ti + 1) * hy_stride],
-                                      hy_h,
-                                      (in_n.at(ti) - in_n.at(ti + 1)),
-                                      hy_stride,
-                                      RNN_MM_TRANSPOSE,
-                                      &hx[hx_shift + hy_n * hy_h + in_n.at(ti + 1) * hy_h],
-                                      hy_h,
-                                      (in_n.at(ti) - in_n.at(ti + 1)),
-                                      uni_stride,
-                                      0,
-                                      &dwei_host[wei_shift + hy_h * uni_stride],
-                                      hy_h,
-                                      hy_h,
-                                      uni_stride,
-                                      0,
-                                      1,
-                                      1);
-
-                        if(biased)
-                        {
-                            int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
-
-                            for(int h = 0; h < hy_h; h++)
-                            {
-                                for(int w = in_n.at(ti + 1); w < in_n.at(ti); w++)
-                                {
-                                    dwei_host.at(bias_shift + hy_h + h) +=
-                                        wkspace.at(hid_shift + w * hy_stride + hy_h + h);
-                                }
-                            }
-                        }
-                    }
-
-                    pretime_shift = li * bi * batch_n * hy_h + (bacc + in_n.at(ti)) * hy_stride +
-                                    numlayer * batch_n * hy_h * bi;
-
-                    RNN_mm_cpu<T>(&wkspace[hid_shift + hy_h],
-                                  hy_h,
-                                  in_n.at(ti + 1),
-                                  hy_stride,
-                                  RNN_MM_TRANSPOSE,
-                                  &rsvspace[pretime_shift + hy_h],
-                                  hy_h,
-                                  in_n.at(ti + 1),
-                                  hy_stride,
-                                  0,
-                                  &dwei_host[wei_shift + hy_h * uni_stride],
-                                  hy_h,
-                                  hy_h,
-                                  uni_stride,
-                                  0,
-                                  1,
-                                  1);
-
-                    if(biased)
-                    {
-                        int bias_shift = wei_shift_bias + li * bi * 2 * hy_h + bi * hy_h;
-
-                        for(int h = 0; h < hy_h; h++)
-                        {
-                            for(int w = 0; w < in_n.at(ti + 1); w++)
-                            {
-                                dwei_host.at(bias_shift + hy_h + h) +=
-                                    wkspace.at(hid_shift + w * hy_stride + hy_h + h);
-                            }
-                        }
-                    }
-                }
-            }
-
-            bacc += in_n.at(ti);
-        }
-    }
+    cpu_rnn_backward_weights(use_dropout,
+                             in,
+                             dwei_host,
+                             hx,
+                             in_n,
+                             in_h,
+                             seqLength,
+                             bidirection,
+                             biased,
+                             hy_d,
+                             hy_n,
+                             hy_h,
+                             inputMode,
+                             rsvspace,
+                             wkspace,
+                             hx_is_null);
 }
 
 //////=========END CPU VERIFICATION FUNCTIONS=============
@@ -51,6 +51,14 @@ std::enable_if_t<is_trivial_serializable<T>{}> serialize(std::ostream& os, const
     os.write(reinterpret_cast<const char*>(&x), sizeof(T));
 }
 
+template <class T>
+std::enable_if_t<is_trivial_serializable<T>{}> serialize(std::ostream& os, const std::vector<T>& x)
+{
+    std::size_t n = x.size();
+    serialize(os, n);
+    os.write(reinterpret_cast<const char*>(x.data()), sizeof(T) * n);
+}
+
 template <class T>
 auto serialize(std::ostream& os, const T& x)
     -> decltype(x.begin(), x.end(), T(x.begin(), x.end()), void())
@@ -115,14 +123,14 @@ serialize(std::istream& is,
 template <class T>
 void load(std::string name, T& x)
 {
-    std::ifstream is{name.c_str()};
+    std::ifstream is{name.c_str(), std::ios::binary};
     serialize(is, x);
 }
 
 template <class T>
 void save(std::string name, const T& x)
 {
-    std::ofstream os{name.c_str()};
+    std::ofstream os{name.c_str(), std::ios::binary};
     serialize(os, x);
 }
 
@@ -977,6 +977,15 @@ struct check_tensor_support : tensor_base
     }
 };
 
+void check_empty_tensor()
+{
+    // A descriptor without lengths has the sizes of one element.
+    const auto empty = miopen::TensorDescriptor{};
+    EXPECT(empty.GetElementSize() == 1);
+    EXPECT(empty.GetElementSpace() == 1);
+    EXPECT(miopen::TensorDescriptor{miopenHalf}.GetElementSpace() == 1);
+}
+
 void check_null_tensor()
 {
     EXPECT(miopenSet4dTensorDescriptor(nullptr, miopenFloat, 100, 32, 8, 8) != miopenStatusSuccess);
@@ -1019,4 +1028,5 @@ int main()
     tensor_test_suit_5d_bytes<tensor_fixture_n5d_numBytes>::run_tests();
     run_test<check_tensor_support>();
     check_null_tensor();
+    check_empty_tensor();
 }
@@ -0,0 +1,285 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2023 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_TEST_VERIFY_CACHE_HPP
+#define GUARD_MIOPEN_TEST_VERIFY_CACHE_HPP
+
+#include "serialize.hpp"
+
+#include <miopen/config.h>
+#include <miopen/env.hpp>
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_ENABLE_SQLITE_KERN_CACHE
+#include <miopen/bz2.hpp>
+#define MIOPEN_VERIFY_CACHE_BZ2 1
+#else
+#define MIOPEN_VERIFY_CACHE_BZ2 0
+#endif
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/streams/bufferstream.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_COMPRESS)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_VERIFY_CACHE_LIMIT_MB)
+
+// Verification cache files hold the serialized CPU reference results:
+//
+//   header | chunk table | chunk data
+//
+// The serialized bytes are cut into chunks of at most chunk_size bytes, each of them stored either
+// as is or bz2-compressed (MIOPEN_VERIFY_CACHE_COMPRESS=1) together with the checksum of its
+// uncompressed bytes. Files are mapped into memory when loading; when no chunk is compressed the
+// results are deserialized straight from the mapping.
+//
+// Files are used in LRU order: a hit refreshes the modification time of the file and, after a
+// store, the least recently used files are removed until the cache directory fits into
+// MIOPEN_VERIFY_CACHE_LIMIT_MB (default 16 GiB, 0 means no limit).
+namespace verify_cache {
+
+constexpr std::uint64_t magic          = 0x3143564e45504f4dULL; // "MOPENVC1"
+constexpr std::size_t chunk_size       = std::size_t{64} << 20;
+constexpr std::size_t default_limit_mb = 16 * 1024;
+
+struct header
+{
+    std::uint64_t magic;
+    std::uint64_t seed;
+    std::uint64_t size;
+    std::uint64_t num_chunks;
+};
+
+struct chunk
+{
+    std::uint64_t stored_size;
+    std::uint64_t size;
+    std::uint64_t checksum;
+    std::uint64_t compressed;
+};
+
+inline std::uint64_t checksum(const char* data, std::size_t size)
+{
+    // FNV-1a over 64-bit words, the tail is mixed in byte by byte
+    constexpr std::uint64_t prime = 0x100000001b3ULL;
+    std::uint64_t h               = 0xcbf29ce484222325ULL;
+    std::size_t i                 = 0;
+    for(; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        h = (h ^ word) * prime;
+    }
+    for(; i < size; i++)
+        h = (h ^ static_cast<unsigned char>(data[i])) * prime;
+    return h;
+}
+
+inline void evict(const boost::filesystem::path& dir, std::uintmax_t limit)
+{
+    namespace fs = boost::filesystem;
+
+    std::vector<std::pair<std::time_t, fs::path>> files;
+    std::uintmax_t total = 0;
+    boost::system::error_code ec;
+
+    for(fs::directory_iterator it{dir, ec}, end; !ec && it != end; it.increment(ec))
+    {
+        if(!fs::is_regular_file(it->path(), ec) || it->path().extension() == ".tmp")
+            continue;
+        total += fs::file_size(it->path(), ec);
+        files.emplace_back(fs::last_write_time(it->path(), ec), it->path());
+    }
+
+    if(total <= limit)
+        return;
+
+    std::sort(files.begin(), files.end());
+    for(const auto& file : files)
+    {
+        if(total <= limit)
+            break;
+        const auto size = fs::file_size(file.second, ec);
+        if(fs::remove(file.second, ec))
+            total -= std::min(size, total);
+    }
+}
+
+template <class T>
+void save(const boost::filesystem::path& file, std::uint64_t seed, const T& x)
+{
+    std::ostringstream ss{std::ios::binary};
+    serialize(ss, x);
+    const auto payload = ss.str();
+
+#if MIOPEN_VERIFY_CACHE_BZ2
+    const bool compress = miopen::IsEnabled(MIOPEN_VERIFY_CACHE_COMPRESS{});
+#else
+    const bool compress = false;
+#endif
+
+    std::vector<chunk> chunks;
+    std::vector<std::string> compressed_chunks;
+    for(std::size_t offset = 0; offset < payload.size(); offset += chunk_size)
+    {
+        const auto size = std::min(chunk_size, payload.size() - offset);
+        chunks.push_back({size, size, checksum(payload.data() + offset, size), 0});
+
+        if(compress)
+        {
+#if MIOPEN_VERIFY_CACHE_BZ2
+            bool compressed = false;
+            compressed_chunks.push_back(
+                miopen::compress(payload.substr(offset, size), &compressed));
+            chunks.back().compressed  = compressed ? 1 : 0;
+            chunks.back().stored_size = compressed ? compressed_chunks.back().size() : size;
+#endif
+        }
+    }
+
+    // Concurrent test processes may store the same key, the rename makes the store atomic
+    auto tmp = file;
+    tmp += boost::filesystem::unique_path(".%%%%-%%%%-%%%%.tmp");
+
+    {
+        std::ofstream os{tmp.string(), std::ios::binary};
+        const auto h = header{magic, seed, payload.size(), chunks.size()};
+        os.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        os.write(reinterpret_cast<const char*>(chunks.data()), sizeof(chunk) * chunks.size());
+        for(std::size_t i = 0; i < chunks.size(); i++)
+        {
+            if(chunks[i].compressed != 0)
+                os.write(compressed_chunks[i].data(), chunks[i].stored_size);
+            else
+                os.write(payload.data() + i * chunk_size, chunks[i].size);
+        }
+        if(!os)
+        {
+            boost::system::error_code ec;
+            boost::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(tmp, file, ec);
+    if(ec)
+    {
+        boost::filesystem::remove(tmp, ec);
+        return;
+    }
+
+    const auto limit_mb = miopen::Value(MIOPEN_VERIFY_CACHE_LIMIT_MB{}, default_limit_mb);
+    if(limit_mb != 0)
+        evict(file.parent_path(), static_cast<std::uintmax_t>(limit_mb) << 20);
+}
+
+// Returns false if the file is missing, was stored for another seed or fails the checks.
+template <class T>
+bool load(const boost::filesystem::path& file, std::uint64_t seed, T& x)
+{
+    namespace ipc = boost::interprocess;
+
+    try
+    {
+        const auto mapping = ipc::file_mapping{file.string().c_str(), ipc::read_only};
+        const auto region  = ipc::mapped_region{mapping, ipc::read_only};
+        const auto* data   = static_cast<const char*>(region.get_address());
+        const auto size    = region.get_size();
+
+        header h;
+        if(size < sizeof(h))
+            return false;
+        std::memcpy(&h, data, sizeof(h));
+        if(h.magic != magic || h.seed != seed ||
+           h.num_chunks != (h.size + chunk_size - 1) / chunk_size ||
+           size < sizeof(h) + sizeof(chunk) * h.num_chunks)
+            return false;
+
+        std::vector<chunk> chunks(h.num_chunks);
+        std::memcpy(chunks.data(), data + sizeof(h), sizeof(chunk) * h.num_chunks);
+
+        std::string unpacked;
+        auto offset      = sizeof(h) + sizeof(chunk) * h.num_chunks;
+        const auto begin = offset;
+        const bool any_compressed =
+            std::any_of(chunks.begin(), chunks.end(), [](auto c) { return c.compressed != 0; });
+
+        for(const auto& c : chunks)
+        {
+            if(offset + c.stored_size > size || (c.compressed == 0 && c.stored_size != c.size))
+                return false;
+
+            const char* raw = data + offset;
+            std::string decompressed;
+            if(c.compressed != 0)
+            {
+#if MIOPEN_VERIFY_CACHE_BZ2
+                decompressed = miopen::decompress(std::string(raw, c.stored_size),
+                                                  static_cast<unsigned int>(c.size));
+                if(decompressed.size() != c.size)
+                    return false;
+                raw = decompressed.data();
+#else
+                return false;
+#endif
+            }
+
+            if(checksum(raw, c.size) != c.checksum)
+                return false;
+            if(any_compressed)
+                unpacked.append(raw, c.size);
+
+            offset += c.stored_size;
+        }
+
+        auto is = ipc::ibufferstream{any_compressed ? unpacked.data() : data + begin, h.size};
+        serialize(is, x);
+        if(!is)
+            return false;
+    }
+    catch(const std::exception&)
+    {
+        return false;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::last_write_time(file, std::time(nullptr), ec);
+    return true;
+}
+
+} // namespace verify_cache
+
+#endif // GUARD_MIOPEN_TEST_VERIFY_CACHE_HPP